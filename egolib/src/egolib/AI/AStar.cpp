@@ -18,48 +18,146 @@
 //********************************************************************************************
 
 /// @file egolib/AI/AStar.c
-/// @brief
+/// @brief A* pathfinding over the tiles of a mesh.
 /// @details
 
 #include "egolib/AI/AStar.hpp"
 
 #include "game/renderer_3d.h" // for point debugging
 #include "egolib/Script/script.h"  // for waypoint list control
-#include "game/mesh.h"
 
-AStar::AStar() : 
-    final_node(nullptr), 
-    start_node(nullptr)
-{}
+AStar::AStar() :
+    _nodes(),
+    _openHeap(),
+    _path(),
+    _generation(0),
+    _tileCountX(0),
+    _startTile(-1),
+    _finalTile(-1)
+{
+    //ctor
+}
 
-void AStar::reset()
+void AStar::reset(size_t tileCount)
 {
     /// @author ZF
-    /// @details Reset AStar memory.
-    final_node = nullptr;
-    start_node = nullptr;
+    /// @details Reset AStar memory. Nodes are not cleared, bumping the generation invalidates all of them at once.
+    if (_nodes.size() != tileCount)
+    {
+        _nodes.assign(tileCount, Node());
+        _generation = 0;
+    }
+
+    _generation++;
+    if (0 == _generation)
+    {
+        // the counter wrapped around, old generations might look current again
+        for (Node& node : _nodes) node.generation = 0;
+        _generation = 1;
+    }
+
+    _openHeap.clear();
+    _startTile = -1;
+    _finalTile = -1;
+}
+
+bool AStar::isOpen(const int32_t tile) const
+{
+    const Node& node = _nodes[tile];
+    return node.generation == _generation && node.heapIndex >= 0;
 }
 
-/// Functor to determine the distance of point (sourceX, sourceY) to point (targetX, targetY).
-struct Distance {
-    float operator()(int sourceX, int sourceY, int targetX, int targetY) const {
-        int distanceX = targetX - sourceX,
-            distanceY = targetY - sourceY;
-        float distance = std::sqrt(distanceX * distanceX + distanceY * distanceY);
-        return distance;
+void AStar::pushOpen(const int32_t tile)
+{
+    _nodes[tile].heapIndex = static_cast<int32_t>(_openHeap.size());
+    _openHeap.push_back(tile);
+    siftUp(_openHeap.size() - 1);
+}
+
+int32_t AStar::popOpen()
+{
+    const int32_t tile = _openHeap.front();
+    _nodes[tile].heapIndex = -1;
+
+    const int32_t last = _openHeap.back();
+    _openHeap.pop_back();
+    if (!_openHeap.empty())
+    {
+        _openHeap[0] = last;
+        _nodes[last].heapIndex = 0;
+        siftDown(0);
     }
-};
+    return tile;
+}
 
-bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedby, const int src_ix, const int src_iy, int dst_ix, int dst_iy)
+void AStar::siftUp(size_t index)
 {
-    /// @author ZF
-    /// @details Explores up to MAX_ASTAR_NODES number of nodes to find a path between the source coordinates and destination coordinates.
-    //              The result is stored in a node list and can be accessed through AStar_get_path(). Returns false if no path was found.
+    const int32_t tile = _openHeap[index];
+    const float estimate = _nodes[tile].estimate;
+    while (index > 0)
+    {
+        const size_t parent = (index - 1) / 2;
+        if (_nodes[_openHeap[parent]].estimate <= estimate) break;
+        _openHeap[index] = _openHeap[parent];
+        _nodes[_openHeap[index]].heapIndex = static_cast<int32_t>(index);
+        index = parent;
+    }
+    _openHeap[index] = tile;
+    _nodes[tile].heapIndex = static_cast<int32_t>(index);
+}
 
-    float weight;
+void AStar::siftDown(size_t index)
+{
+    const size_t size = _openHeap.size();
+    const int32_t tile = _openHeap[index];
+    const float estimate = _nodes[tile].estimate;
+    while (true)
+    {
+        size_t child = 2 * index + 1;
+        if (child >= size) break;
+        if (child + 1 < size && _nodes[_openHeap[child + 1]].estimate < _nodes[_openHeap[child]].estimate) child++;
+        if (estimate <= _nodes[_openHeap[child]].estimate) break;
+        _openHeap[index] = _openHeap[child];
+        _nodes[_openHeap[index]].heapIndex = static_cast<int32_t>(index);
+        index = child;
+    }
+    _openHeap[index] = tile;
+    _nodes[tile].heapIndex = static_cast<int32_t>(index);
+}
+
+float AStar::estimate(int sourceX, int sourceY, int targetX, int targetY, bool diagonal)
+{
+    const int distanceX = std::abs(targetX - sourceX),
+              distanceY = std::abs(targetY - sourceY);
+    if (!diagonal) {
+        return static_cast<float>(distanceX + distanceY);
+    }
+    const int straight = std::abs(distanceX - distanceY),
+              skewed = std::min(distanceX, distanceY);
+    return straight + skewed * Ego::Math::sqrtTwo<float>();
+}
+
+float AStar::cost(const std::vector<int32_t>& tiles, const int tileCountX)
+{
+    float result = 0.0f;
+    for (size_t i = 1; i < tiles.size(); ++i)
+    {
+        const bool isDiagonal = (tiles[i] % tileCountX != tiles[i - 1] % tileCountX)
+                             && (tiles[i] / tileCountX != tiles[i - 1] / tileCountX);
+        result += isDiagonal ? Ego::Math::sqrtTwo<float>() : 1.0f;
+    }
+    return result;
+}
+
+bool AStar::find_path(const PathGrid& grid, uint32_t stoppedby, const int src_ix, const int src_iy, int dst_ix, int dst_iy, bool diagonal)
+{
+    /// @author ZF
+    /// @details Expands up to MAX_ASTAR_NODES number of nodes to find a path between the source coordinates and destination coordinates.
+    //              The result is stored in the node array and can be accessed through AStar_get_path(). Returns false if no path was found.
 
     // do not start if the initial point is off the mesh
-    if (Index1D::Invalid == mesh->getTileIndex(Index2D(src_ix, src_iy)))
+    const int32_t srcTile = grid.getTileIndex(src_ix, src_iy);
+    if (srcTile < 0)
     {
 #ifdef DEBUG_ASTAR
         printf("AStar failed because source position is off the mesh.\n");
@@ -76,24 +174,12 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
 
     //Explore all nearby nodes, including diagonal ones
     static const std::array<Offset, 8> EXPLORE_NODES = {
-        Offset(-1, -1), Offset(-1, 0), Offset(-1, 1),
-        Offset(0, -1), Offset(1, -1), Offset(1, 1),
-        Offset(1, 0), Offset(0, 1)
-    };
-
-    //Node sorting algorithm (lowest weight first)
-    auto comparator = [](const std::shared_ptr<Node> &first, const std::shared_ptr<Node> &second){
-        return first->weight < second->weight;
+        Offset(-1, 0), Offset(1, 0), Offset(0, -1), Offset(0, 1),
+        Offset(-1, -1), Offset(1, -1), Offset(-1, 1), Offset(1, 1)
     };
 
-    //Set of closed nodes
-    std::unordered_set<int> closedNodes;
-    std::priority_queue<std::shared_ptr<Node>, 
-                        std::vector<std::shared_ptr<Node>>,
-                        decltype(comparator)> openNodes(comparator);
-
     //be a bit flexible if the destination is inside a wall
-    if (mesh->tile_has_bits(Index2D(dst_ix, dst_iy), stoppedby))
+    if (grid.isStopped(dst_ix, dst_iy, stoppedby))
     {
         bool foundOpenSpace = false;
 
@@ -101,7 +187,7 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
         for(const auto& offset: EXPLORE_NODES) {
 
             //Did we find a free tile?
-            if (!mesh->tile_has_bits(Index2D(dst_ix + offset.x, dst_iy + offset.y), stoppedby))
+            if (!grid.isStopped(dst_ix + offset.x, dst_iy + offset.y, stoppedby))
             {
                 dst_ix = dst_ix + offset.x;
                 dst_iy = dst_iy + offset.y;
@@ -118,194 +204,172 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
         }
     }
 
+    const int32_t dstTile = grid.getTileIndex(dst_ix, dst_iy);
+    if (dstTile < 0)
+    {
+        return false;
+    }
+
+    //Can we walk on this tile? The destination is always accepted
+    auto isWalkable = [&grid, stoppedby, dstTile](int x, int y) {
+        const int32_t itile = grid.getTileIndex(x, y);
+        if (itile < 0) return false;
+        if (itile == dstTile) return true;
+
+        //Dont walk into pits, walls or impassable tiles
+        //@todo: might need to check tile Z level here instead
+        /// @todo  I need to check for collisions with static objects, like trees
+        return grid.isWalkable(itile, stoppedby);
+    };
+
     // restart the algorithm
-    reset();
+    reset(static_cast<size_t>(grid.getTileCountX()) * grid.getTileCountY());
+    _tileCountX = grid.getTileCountX();
 
     // initialize the starting node
-    weight = Distance()(src_ix, src_iy, dst_ix, dst_iy);
-    start_node = std::make_shared<AStar::Node>(src_ix, src_iy, weight, nullptr);
-    openNodes.push(start_node);
+    _startTile = srcTile;
+    Node& startNode = _nodes[_startTile];
+    startNode.generation = _generation;
+    startNode.cost = 0.0f;
+    startNode.estimate = estimate(src_ix, src_iy, dst_ix, dst_iy, diagonal);
+    startNode.parent = -1;
+    pushOpen(_startTile);
 
     // do the algorithm
-    while (!openNodes.empty())
+    size_t expandedNodes = 0;
+    while (!_openHeap.empty())
     {
-        // list is completely full... we failed
-        if (closedNodes.size() >= MAX_ASTAR_NODES) break;
+        //Get the cheapest open node and close it
+        const int32_t currentTile = popOpen();
+
+        // is this the destination node?
+        if (currentTile == dstTile)
+        {
+            _finalTile = currentTile;
+            return true;
+        }
 
-        //Get the cheapest open node
-        std::shared_ptr<Node> currentNode = openNodes.top();
-        openNodes.pop();
+        // budget is used up... we failed
+        if (++expandedNodes > MAX_ASTAR_NODES) break;
 
-        // find some child nodes
-        for(const auto& offset: EXPLORE_NODES) {
+        // tiles are stored row by row
+        const int current_ix = currentTile % _tileCountX;
+        const int current_iy = currentTile / _tileCountX;
+        const float currentCost = _nodes[currentTile].cost;
 
-            // do not check diagonals
-            if (offset.x != 0 && offset.y != 0) continue;
+        // find some child nodes
+        for (size_t i = 0; i < EXPLORE_NODES.size(); ++i) {
+            const Offset& offset = EXPLORE_NODES[i];
+            const bool isDiagonal = (offset.x != 0 && offset.y != 0);
+            if (isDiagonal && !diagonal) break;
 
             //The node to explore
-            int tmp_x = currentNode->ix + offset.x;
-            int tmp_y = currentNode->iy + offset.y;
+            const int tmp_x = current_ix + offset.x;
+            const int tmp_y = current_iy + offset.y;
+            if (!isWalkable(tmp_x, tmp_y)) continue;
 
-            //Do not explore any node more than once
-            if(closedNodes.find(tmp_x | tmp_y << 16) != closedNodes.end()) {
-                continue;
-            }
-            closedNodes.insert(tmp_x | tmp_y << 16);
+            //Do not cut corners of blocked tiles
+            if (isDiagonal && !(isWalkable(current_ix + offset.x, current_iy) && isWalkable(current_ix, current_iy + offset.y))) continue;
 
-            // check for the simplest case, is this the destination node?
-            if (tmp_x == dst_ix && tmp_y == dst_iy)
-            {
-                weight = Distance()(tmp_x, tmp_y, currentNode->ix, currentNode->iy);
-                final_node = std::make_shared<AStar::Node>(tmp_x, tmp_y, weight, currentNode);
-                return true;
-            }
-
-            // is the test node on the mesh?
-            Index1D itile = mesh->getTileIndex(Index2D(tmp_x, tmp_y));
-            if (Index1D::Invalid == itile)
-            {
-                continue;
-            }
+            const int32_t tmpTile = tmp_y * _tileCountX + tmp_x;
+            const float cost = currentCost + (isDiagonal ? Ego::Math::sqrtTwo<float>() : 1.0f);
+            Node& node = _nodes[tmpTile];
 
-            //Dont walk into pits
-            //@todo: might need to check tile Z level here instead
-            const ego_tile_info_t& ptile = mesh->getTileInfo(itile);
-            if (ptile.isFanOff())
+            if (node.generation != _generation)
             {
-                // add the invalid tile to the list as a closed tile
-                continue;
+                // first visit in this search
+                node.generation = _generation;
+                node.cost = cost;
+                node.estimate = cost + estimate(tmp_x, tmp_y, dst_ix, dst_iy, diagonal);
+                node.parent = currentTile;
+                pushOpen(tmpTile);
             }
-
-            // is this a wall or impassable?
-            if (mesh->tile_has_bits(Index2D(tmp_x, tmp_y), stoppedby))
+            else if (isOpen(tmpTile) && cost < node.cost)
             {
-                // add the invalid tile to the list as a closed tile
-                continue;
+                // found a cheaper way to an open node
+                node.estimate += cost - node.cost;
+                node.cost = cost;
+                node.parent = currentTile;
+                siftUp(node.heapIndex);
             }
-
-            ///
-            /// @todo  I need to check for collisions with static objects, like trees
-
-            // OK. determine the weight (F + H)
-            weight = Distance()(tmp_x, tmp_y, currentNode->ix, currentNode->iy)
-                   + Distance()(tmp_x, tmp_y, dst_ix, dst_iy);
-            openNodes.push(std::make_shared<AStar::Node>(tmp_x, tmp_y, weight, currentNode));
         }
     }
 
 #ifdef DEBUG_ASTAR
-    if (closedNodes.size() >= MAX_ASTAR_NODES) printf("AStar failed because maximum number of nodes were explored (%d)\n", MAX_ASTAR_NODES);
+    if (expandedNodes > MAX_ASTAR_NODES) printf("AStar failed because maximum number of nodes were expanded (%d)\n", MAX_ASTAR_NODES);
 #endif
 
     return false;
 }
 
-bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
+bool AStar::get_tiles(std::vector<int32_t>& tiles) const
 {
-    /// @author ZF
-    /// @details Fills a waypoint list with sensible waypoints. It will return false if it failed to add at least one waypoint.
-    //              The function goes through all the AStar_nodes and finds out which one are critical. A critical node is one that
-    //              creates a corner. The function automatically prunes away all non-critical nodes. The final waypoint will always be
-    //              the destination coordinates.
-
-    int i;
-    size_t path_length, waypoint_num;
-    //bool diagonal_movement = false;
-
-    Node *current_node, *last_waypoint, *safe_waypoint;
-    Node *node_path[MAX_ASTAR_PATH];
+    tiles.clear();
+    if (_startTile < 0 || _finalTile < 0) return false;
 
-    //Fill the waypoint list as much as we can, the final waypoint will always be the destination waypoint
-    waypoint_num = 0;
-    current_node = final_node.get();
-    last_waypoint = start_node.get();
-
-    //Build the local node path tree
-    path_length = 0;
-    while (path_length < MAX_ASTAR_PATH && current_node != start_node.get())
+    //Walk from the destination back to the start
+    for (int32_t tile = _finalTile; tile >= 0; tile = _nodes[tile].parent)
     {
-        // add the node to the end of the path
-        node_path[path_length++] = current_node;
-
-        // get next node
-        current_node = current_node->parent.get();
+        tiles.push_back(tile);
+        if (tile == _startTile) break;
     }
+    std::reverse(tiles.begin(), tiles.end());
+    return true;
+}
 
-    //Begin at the end of the list, which contains the starting node
-    safe_waypoint = nullptr;
-    for (i = path_length - 1; i >= 0 && waypoint_num < MAXWAY; i--)
-    {
-        bool change_direction;
-
-        //get current node
-        current_node = node_path[i];
-
-        //the first node should be safe
-        if (nullptr == safe_waypoint) safe_waypoint = current_node;
+bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
+{
+    return get_tiles(_path) && get_path(_path, _tileCountX, pos_x, dst_y, wplst);
+}
 
-        //is there a change in direction?
-        change_direction = (last_waypoint->ix != current_node->ix && last_waypoint->iy != current_node->iy);
+bool AStar::get_path(const std::vector<int32_t>& tiles, const int tileCountX, const int pos_x, const int dst_y, waypoint_list_t& wplst)
+{
+    /// @author ZF
+    /// @details Fills a waypoint list with sensible waypoints. It will return false if it failed to add at least one waypoint.
+    //              The function goes through the path from the start to the destination and finds out which tiles are critical.
+    //              A critical tile is one where the direction of movement changes. All non-critical tiles are pruned away.
+    //              The final waypoint will always be the destination coordinates.
 
-        //are we moving diagonally? if so, then don't fill the waypoint list with unessecary waypoints
-        /*if( i != 0 )
-        {
-            if( diagonal_movement ) diagonal_movement = (ABS(current_node->ix - safe_waypoint->ix) == 1)  && (ABS(current_node->iy - safe_waypoint->iy) == 1);
-            else                    diagonal_movement = (ABS(current_node->ix - last_waypoint->ix) == 1)  && (ABS(current_node->iy - last_waypoint->iy) == 1);
+    size_t waypoint_num = 0;
+    for (size_t i = 1; i < tiles.size() && waypoint_num < MAXWAY; ++i)
+    {
+        const int current_ix = tiles[i] % tileCountX;
+        const int current_iy = tiles[i] / tileCountX;
 
-            if( diagonal_movement )
-            {
-                safe_waypoint = current_node;
-                continue;
-            }
-        }*/
+        int way_x;
+        int way_y;
 
-        //If we have a change in direction, we need to add it as a waypoint, always add the last waypoint
-        if (i == 0 || change_direction)
+        if (i + 1 == tiles.size())
         {
-            int way_x;
-            int way_y;
-
             //Special exception for final waypoint, use raw integer
-            if (i == 0)
-            {
-                way_x = pos_x;
-                way_y = dst_y;
-            }
-            else
-            {
-                // translate to raw coordinates
-                way_x = safe_waypoint->ix * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
-                way_y = safe_waypoint->iy * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
-            }
-
-#ifdef DEBUG_ASTAR
-            // using >> for division only works if you know for certainty that the value
-            // you are shifting is not intended to be neative
-            printf("Waypoint %d: X: %d, Y: %d \n", waypoint_num, static_cast<int>(way_x / GRID_ISIZE), static_cast<int>(way_y / GRID_ISIZE));
-            point_list_add(way_x, way_y, 200, 800);
-            line_list_add(last_waypoint->ix*GRID_FSIZE + (GRID_ISIZE / 2), last_waypoint->iy*GRID_FSIZE + (GRID_ISIZE / 2), 200, way_x, way_y, 200, 800);
-#endif
-
-            // add the node to the waypoint list
-            last_waypoint = safe_waypoint;
-            waypoint_list_t::push(wplst, way_x, way_y);
-            waypoint_num++;
-
-            //This one is now safe
-            safe_waypoint = current_node;
+            way_x = pos_x;
+            way_y = dst_y;
         }
-
-        //keep track of the last safe node from our previous waypoint
         else
         {
-            safe_waypoint = current_node;
+            //is there a change in direction?
+            const int last_ix = tiles[i - 1] % tileCountX;
+            const int last_iy = tiles[i - 1] / tileCountX;
+            const int next_ix = tiles[i + 1] % tileCountX;
+            const int next_iy = tiles[i + 1] / tileCountX;
+            const bool change_direction = (current_ix - last_ix != next_ix - current_ix) || (current_iy - last_iy != next_iy - current_iy);
+            if (!change_direction) continue;
+
+            // translate to raw coordinates
+            way_x = current_ix * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
+            way_y = current_iy * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
         }
-    }
 
 #ifdef DEBUG_ASTAR
-    if (waypoint_num > 0) point_list_add(start_node->ix*GRID_FSIZE + (GRID_ISIZE / 2), start_node->iy*GRID_FSIZE + (GRID_ISIZE / 2), 200, 80);
+        printf("Waypoint %d: X: %d, Y: %d \n", waypoint_num, static_cast<int>(way_x / GRID_ISIZE), static_cast<int>(way_y / GRID_ISIZE));
+        point_list_add(way_x, way_y, 200, 800);
 #endif
 
+        // add the node to the waypoint list
+        waypoint_list_t::push(wplst, way_x, way_y);
+        waypoint_num++;
+    }
+
     return waypoint_num > 0;
 }
 
@@ -19,50 +19,116 @@
 
 /// @file egolib/AI/AStar.h
 /// @brief A* pathfinding.
-/// @details A very ugly implementation of the A* pathfinding agorithm.
-///          There is lots of room for improvement.
+/// @details Searches the tile grid of a mesh. All search state lives in a flat node array
+///          with one node per tile which is reused between searches, so a search does not
+///          allocate once the arrays have grown to the size of the mesh.
 
 #pragma once
 
 #include "egolib/AI/WaypointList.h"
-
-// Forward declarations.
-class ego_mesh_t;
-struct waypoint_list_t;
+#include "egolib/AI/PathGrid.hpp"
 
 /// Implementation of A* pathfinding algorithm.
 class AStar {
 
 public:
+    /// Search state of a single tile.
     struct Node {
-        Node(int x, int y, float setWeight, const std::shared_ptr<Node>& setParent) :
-            ix(x),
-            iy(y),
-            weight(setWeight),
-            parent(setParent)
+        Node() :
+            cost(0.0f),
+            estimate(0.0f),
+            parent(-1),
+            heapIndex(-1),
+            generation(0)
         {
             //ctor
         }
 
-        float weight;
-        int ix, iy;
-        std::shared_ptr<Node> parent;
+        float cost;             ///< Cost of the cheapest known path from the start to this tile
+        float estimate;         ///< @a cost plus the heuristic distance to the goal
+        int32_t parent;         ///< Tile index of the predecessor on that path, @a -1 for the start
+        int32_t heapIndex;      ///< Position in the open heap, @a -1 once the node is closed
+        uint32_t generation;    ///< The node is only valid if this matches AStar::_generation
     };
 
 public:
     AStar();
-    bool find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedBy, const int src_ix, const int src_iy, int dst_ix, int dst_iy);
+
+    /**
+     * @brief
+     *  Search a path between two tiles. The result can be retrieved with get_path().
+     * @param diagonal
+     *  if @a true, diagonal moves are allowed. A diagonal move never cuts the corner of a blocked tile.
+     * @return
+     *  @a true if a path was found, @a false otherwise
+     */
+    bool find_path(const PathGrid& grid, uint32_t stoppedBy, const int src_ix, const int src_iy, int dst_ix, int dst_iy, bool diagonal = false);
     bool get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst);
 
+    /**
+     * @brief
+     *  Get the tiles of the last path found by find_path().
+     * @param tiles
+     *  receives the tile indices of the path, the start tile first and the destination tile last
+     * @return
+     *  @a true if the last search found a path, @a false otherwise
+     */
+    bool get_tiles(std::vector<int32_t>& tiles) const;
+
+    /**
+     * @brief
+     *  Fill a waypoint list with the tiles of a path where the direction of movement changes.
+     *  The final waypoint is always the destination coordinates.
+     * @param tiles
+     *  the tile indices of the path, the start tile first
+     * @param tileCountX
+     *  the width of the mesh in tiles
+     * @return
+     *  @a true if at least one waypoint was added, @a false otherwise
+     */
+    static bool get_path(const std::vector<int32_t>& tiles, const int tileCountX, const int pos_x, const int dst_y, waypoint_list_t& wplst);
+
+    /**
+     * @brief
+     *  Estimate the cost of a path between two tiles.
+     * @return
+     *  the Manhattan distance for 4-way moves, the octile distance if diagonal moves are allowed.
+     * @remark
+     *  Both are consistent: the estimate of a tile never exceeds the cost of a move to a neighbour
+     *  plus the estimate of that neighbour. find_path() never re-opens a closed tile and relies on
+     *  this, a tile is closed with its cheapest cost once it is taken from the open list.
+     */
+    static float estimate(int sourceX, int sourceY, int targetX, int targetY, bool diagonal);
+
+    /**
+     * @brief
+     *  Get the cost of a path, @a 1 per straight and @a sqrt(2) per diagonal move.
+     * @param tiles
+     *  the tile indices of the path
+     * @param tileCountX
+     *  the width of the mesh in tiles
+     */
+    static float cost(const std::vector<int32_t>& tiles, const int tileCountX);
+
 private:
-    static constexpr size_t MAX_ASTAR_NODES = 512;   ///< Maximum number of nodes to explore
-    static constexpr size_t MAX_ASTAR_PATH = 128;    ///< Maximum length of the final path (before pruning)
+    static constexpr size_t MAX_ASTAR_NODES = 8192;  ///< Maximum number of nodes to expand
+
+    std::vector<Node> _nodes;           ///< One node per tile of the mesh
+    std::vector<int32_t> _openHeap;     ///< Binary min-heap of tile indices ordered by Node::estimate
+    std::vector<int32_t> _path;         ///< Tile indices of the last path, start first
+    uint32_t _generation;               ///< Generation of the current search
+    int _tileCountX;                    ///< Width of the mesh searched last
 
-    std::shared_ptr<Node> final_node;
-    std::shared_ptr<Node> start_node;
+    int32_t _startTile;
+    int32_t _finalTile;
 
 private:
-    void reset();
+    void reset(size_t tileCount);
+    bool isOpen(const int32_t tile) const;
+    void pushOpen(const int32_t tile);
+    int32_t popOpen();
+    void siftUp(size_t index);
+    void siftDown(size_t index);
 };
 
 extern AStar g_astar;
@@ -0,0 +1,81 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/AI/PathGrid.hpp
+/// @brief The tiles searched by AStar and PathService.
+
+#pragma once
+
+#include "egolib/typedef.h"
+
+/**
+ * @brief
+ *  The tile grid of a mesh as seen by path finding. Tiles are stored row by row, the tile at
+ *  <tt>(x, y)</tt> has the index <tt>y * getTileCountX() + x</tt>.
+ */
+class PathGrid {
+
+public:
+    virtual ~PathGrid() {}
+
+    /// @brief Get the number of tiles along the x-axis.
+    virtual int getTileCountX() const = 0;
+
+    /// @brief Get the number of tiles along the y-axis.
+    virtual int getTileCountY() const = 0;
+
+    /**
+     * @brief
+     *  Get if a tile has any of the FX bits which stop a mover.
+     * @return
+     *  @a true if the tile has any of the bits. Tiles off the grid are walls and impassable.
+     */
+    virtual bool isStopped(int x, int y, uint32_t stoppedBy) const = 0;
+
+    /**
+     * @brief
+     *  Get if a mover can walk on a tile.
+     * @param tile
+     *  the index of a tile on the grid
+     * @return
+     *  @a true if the tile is neither a pit nor has any of the FX bits which stop the mover
+     */
+    virtual bool isWalkable(int32_t tile, uint32_t stoppedBy) const = 0;
+
+    /**
+     * @brief
+     *  Get the object the grid belongs to. Anything known about the grid is stale once that object is gone.
+     */
+    virtual std::shared_ptr<const void> getOwner() const = 0;
+
+    /**
+     * @brief
+     *  Get the revision of the grid.
+     * @return
+     *  a counter which changes whenever the result of isStopped() or isWalkable() changes for any tile
+     */
+    virtual uint32_t getRevision() const = 0;
+
+    /// @brief Get the index of a tile.
+    /// @return the index of the tile, @a -1 if the tile is off the grid
+    int32_t getTileIndex(int x, int y) const {
+        if (x < 0 || x >= getTileCountX() || y < 0 || y >= getTileCountY()) return -1;
+        return y * getTileCountX() + x;
+    }
+};
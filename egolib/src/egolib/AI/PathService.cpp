@@ -0,0 +1,301 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/AI/PathService.cpp
+/// @brief Shared path planning on top of AStar.
+
+#include "egolib/AI/PathService.hpp"
+
+PathService::PathService(AStar& astar) :
+    _astar(astar),
+    _owner(),
+    _revision(0),
+    _tileCountX(0),
+    _graphs(),
+    _cache(),
+    _cacheIndex(),
+    _tiles(),
+    _searchTiles(),
+    _cacheHits(0),
+    _cacheMisses(0)
+{
+    //ctor
+}
+
+void PathService::clear()
+{
+    _graphs.clear();
+    _cache.clear();
+    _cacheIndex.clear();
+}
+
+void PathService::validate(const PathGrid& grid)
+{
+    // everything we know is stale if this is another grid or if walls and passages changed
+    const std::shared_ptr<const void> owner = grid.getOwner();
+    if (_owner.lock() != owner || _revision != grid.getRevision())
+    {
+        clear();
+        _owner = owner;
+        _revision = grid.getRevision();
+        _tileCountX = grid.getTileCountX();
+    }
+}
+
+const PathService::ClusterGraph& PathService::getGraph(const PathGrid& grid, uint32_t stoppedBy)
+{
+    for (const ClusterGraph& graph : _graphs)
+    {
+        if (graph.stoppedBy == stoppedBy) return graph;
+    }
+
+    _graphs.emplace_back();
+    ClusterGraph& graph = _graphs.back();
+    graph.stoppedBy = stoppedBy;
+    buildGraph(grid, graph);
+    return graph;
+}
+
+void PathService::buildGraph(const PathGrid& grid, ClusterGraph& graph) const
+{
+    static constexpr int32_t NOT_WALKABLE = -1;
+    static constexpr int32_t UNLABELED = -2;
+
+    const int tileCountX = grid.getTileCountX();
+    const int tileCountY = grid.getTileCountY();
+
+    // find the walkable tiles, using the same rules as AStar
+    graph.regionOfTile.resize(static_cast<size_t>(tileCountX) * tileCountY);
+    for (int32_t tile = 0; tile < static_cast<int32_t>(graph.regionOfTile.size()); ++tile)
+    {
+        graph.regionOfTile[tile] = grid.isWalkable(tile, graph.stoppedBy) ? UNLABELED : NOT_WALKABLE;
+    }
+
+    // flood fill the regions of each cluster
+    int32_t regionCount = 0;
+    std::vector<int32_t> stack;
+    for (int clusterY = 0; clusterY < tileCountY; clusterY += CLUSTER_SIZE)
+    {
+        const int maxY = std::min(clusterY + CLUSTER_SIZE, tileCountY);
+        for (int clusterX = 0; clusterX < tileCountX; clusterX += CLUSTER_SIZE)
+        {
+            const int maxX = std::min(clusterX + CLUSTER_SIZE, tileCountX);
+            for (int y = clusterY; y < maxY; ++y)
+            {
+                for (int x = clusterX; x < maxX; ++x)
+                {
+                    const int32_t seed = y * tileCountX + x;
+                    if (UNLABELED != graph.regionOfTile[seed]) continue;
+
+                    graph.regionOfTile[seed] = regionCount;
+                    stack.push_back(seed);
+                    while (!stack.empty())
+                    {
+                        const int32_t tile = stack.back();
+                        stack.pop_back();
+                        const int tx = tile % tileCountX, ty = tile / tileCountX;
+
+                        auto visit = [&](int nx, int ny) {
+                            if (nx < clusterX || nx >= maxX || ny < clusterY || ny >= maxY) return;
+                            const int32_t neighbour = ny * tileCountX + nx;
+                            if (UNLABELED != graph.regionOfTile[neighbour]) return;
+                            graph.regionOfTile[neighbour] = regionCount;
+                            stack.push_back(neighbour);
+                        };
+                        visit(tx - 1, ty);
+                        visit(tx + 1, ty);
+                        visit(tx, ty - 1);
+                        visit(tx, ty + 1);
+                    }
+                    regionCount++;
+                }
+            }
+        }
+    }
+
+    // connect the regions of neighbouring clusters which touch
+    std::vector<int32_t> parent(regionCount);
+    for (int32_t region = 0; region < regionCount; ++region) parent[region] = region;
+    auto find = [&parent](int32_t region) {
+        while (parent[region] != region)
+        {
+            parent[region] = parent[parent[region]];
+            region = parent[region];
+        }
+        return region;
+    };
+    auto join = [&](int32_t first, int32_t second) {
+        if (first < 0 || second < 0) return;
+        first = find(first);
+        second = find(second);
+        if (first != second) parent[std::max(first, second)] = std::min(first, second);
+    };
+    for (int y = 0; y < tileCountY; ++y)
+    {
+        for (int x = 0; x < tileCountX; ++x)
+        {
+            const int32_t tile = y * tileCountX + x;
+            const int32_t region = graph.regionOfTile[tile];
+            if (region < 0) continue;
+            if (x + 1 < tileCountX) join(region, graph.regionOfTile[tile + 1]);
+            if (y + 1 < tileCountY) join(region, graph.regionOfTile[tile + tileCountX]);
+        }
+    }
+
+    graph.componentOfRegion.resize(regionCount);
+    for (int32_t region = 0; region < regionCount; ++region)
+    {
+        graph.componentOfRegion[region] = find(region);
+    }
+}
+
+bool PathService::appendSearch(const PathGrid& grid, uint32_t stoppedBy, int32_t srcTile, int32_t dstTile, std::vector<int32_t>& tiles)
+{
+    if (srcTile == dstTile)
+    {
+        if (tiles.empty()) tiles.push_back(srcTile);
+        return true;
+    }
+
+    if (!_astar.find_path(grid, stoppedBy, srcTile % _tileCountX, srcTile / _tileCountX, dstTile % _tileCountX, dstTile / _tileCountX, true)
+        || !_astar.get_tiles(_searchTiles))
+    {
+        return false;
+    }
+
+    const size_t first = (!tiles.empty() && tiles.back() == _searchTiles.front()) ? 1 : 0;
+    tiles.insert(tiles.end(), _searchTiles.begin() + first, _searchTiles.end());
+    return true;
+}
+
+void PathService::eraseLoops(std::vector<int32_t>& tiles)
+{
+    std::unordered_map<int32_t, size_t> position;
+    size_t count = 0;
+    for (size_t i = 0; i < tiles.size(); ++i)
+    {
+        const int32_t tile = tiles[i];
+        auto visited = position.find(tile);
+        if (visited != position.end())
+        {
+            // back to a tile visited before, drop the loop
+            const size_t first = visited->second;
+            for (size_t j = first + 1; j < count; ++j) position.erase(tiles[j]);
+            count = first + 1;
+            continue;
+        }
+        position[tile] = count;
+        tiles[count++] = tile;
+    }
+    tiles.resize(count);
+}
+
+bool PathService::joinCachedPath(const PathGrid& grid, uint32_t stoppedBy, int32_t srcTile, int32_t dstTile, const std::vector<int32_t>& cached)
+{
+    // only search from our source to the start of the cached path and from its end to our destination
+    _tiles.clear();
+    if (!appendSearch(grid, stoppedBy, srcTile, cached.front(), _tiles))
+    {
+        return false;
+    }
+    _tiles.insert(_tiles.end(), cached.begin() + (_tiles.back() == cached.front() ? 1 : 0), cached.end());
+    if (!appendSearch(grid, stoppedBy, cached.back(), dstTile, _tiles))
+    {
+        return false;
+    }
+
+    // the searches might double back along the cached path
+    eraseLoops(_tiles);
+
+    // a detour beyond that of the cached path itself is not worth it
+    const int srcX = srcTile % _tileCountX, srcY = srcTile / _tileCountX,
+              dstX = dstTile % _tileCountX, dstY = dstTile / _tileCountX;
+    const int startX = cached.front() % _tileCountX, startY = cached.front() / _tileCountX,
+              endX = cached.back() % _tileCountX, endY = cached.back() / _tileCountX;
+    const float cachedDetour = AStar::cost(cached, _tileCountX) - AStar::estimate(startX, startY, endX, endY, true);
+    return AStar::cost(_tiles, _tileCountX) <= AStar::estimate(srcX, srcY, dstX, dstY, true) + cachedDetour + CLUSTER_SIZE;
+}
+
+bool PathService::find_path(const PathGrid& grid, uint32_t stoppedBy, const int src_ix, const int src_iy, const int dst_ix, const int dst_iy,
+                            const int pos_x, const int pos_y, waypoint_list_t& wplst)
+{
+    const int32_t srcTile = grid.getTileIndex(src_ix, src_iy);
+    const int32_t dstTile = grid.getTileIndex(dst_ix, dst_iy);
+    if (srcTile < 0 || dstTile < 0)
+    {
+        return false;
+    }
+
+    validate(grid);
+    const ClusterGraph& graph = getGraph(grid, stoppedBy);
+    const int32_t srcRegion = graph.regionOfTile[srcTile];
+    const int32_t dstRegion = graph.regionOfTile[dstTile];
+
+    // standing in a wall or heading into one, let AStar sort it out
+    if (srcRegion < 0 || dstRegion < 0)
+    {
+        return _astar.find_path(grid, stoppedBy, src_ix, src_iy, dst_ix, dst_iy, true)
+            && _astar.get_path(pos_x, pos_y, wplst);
+    }
+
+    // no need to search if the regions are not connected at all
+    if (graph.componentOfRegion[srcRegion] != graph.componentOfRegion[dstRegion])
+    {
+        return false;
+    }
+
+    const CacheKey key = { srcRegion, dstRegion, stoppedBy };
+    auto it = _cacheIndex.find(key);
+    if (it != _cacheIndex.end())
+    {
+        // mark as most recently used
+        _cache.splice(_cache.begin(), _cache, it->second);
+        if (joinCachedPath(grid, stoppedBy, srcTile, dstTile, it->second->tiles))
+        {
+            _cacheHits++;
+            return AStar::get_path(_tiles, _tileCountX, pos_x, pos_y, wplst);
+        }
+
+        // the cached path is of no use, forget it
+        _cache.erase(it->second);
+        _cacheIndex.erase(it);
+    }
+
+    _cacheMisses++;
+    _tiles.clear();
+    if (!appendSearch(grid, stoppedBy, srcTile, dstTile, _tiles))
+    {
+        return false;
+    }
+
+    // remember the path, dropping the least recently used one if the cache is full
+    _cache.push_front(CacheEntry());
+    _cache.front().key = key;
+    _cache.front().tiles = _tiles;
+    _cacheIndex[key] = _cache.begin();
+    if (_cache.size() > MAX_CACHED_PATHS)
+    {
+        _cacheIndex.erase(_cache.back().key);
+        _cache.pop_back();
+    }
+
+    return AStar::get_path(_tiles, _tileCountX, pos_x, pos_y, wplst);
+}
+
+PathService g_pathService(g_astar);
@@ -0,0 +1,128 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/AI/PathService.hpp
+/// @brief Shared path planning on top of AStar.
+/// @details Groups the tiles of a mesh into clusters and caches recent paths between clusters,
+///          so that many characters heading for the same destination share a single search.
+
+#pragma once
+
+#include "egolib/AI/AStar.hpp"
+
+/**
+ * @brief
+ *  Answers path queries using a coarse cluster graph and an LRU cache of recent paths.
+ * @details
+ *  The mesh is divided into square clusters of CLUSTER_SIZE tiles. Each cluster is divided into
+ *  regions, the 4-connected parts of its walkable tiles. Regions of neighbouring clusters which touch
+ *  are connected, and the connected components of that graph tell whether a path exists at all.
+ *  Found paths are cached under (source region, destination region, stoppedby bits). A later query
+ *  between the same regions only searches the few tiles from its source to the cached start and from
+ *  the cached end to its destination. Loops where these searches double back along the cached path
+ *  are cut out. If the joined path is still longer than the direct distance plus the detour of the
+ *  cached path itself plus CLUSTER_SIZE tiles, a fresh search replaces the cached path.
+ *
+ *  The cluster graphs and the cache are rebuilt whenever the grid changes or its revision changes,
+ *  see PathGrid::getRevision().
+ */
+class PathService {
+
+public:
+    static constexpr int CLUSTER_SIZE = 8;          ///< Edge length of a cluster in tiles
+    static constexpr size_t MAX_CACHED_PATHS = 64;  ///< Capacity of the path cache
+
+public:
+    PathService(AStar& astar);
+
+    /**
+     * @brief
+     *  Find a path between two tiles and fill a waypoint list with it.
+     * @param pos_x, pos_y
+     *  the destination in world coordinates, used for the final waypoint
+     * @return
+     *  @a true if a path was found and at least one waypoint was added, @a false otherwise
+     */
+    bool find_path(const PathGrid& grid, uint32_t stoppedBy, const int src_ix, const int src_iy, const int dst_ix, const int dst_iy,
+                   const int pos_x, const int pos_y, waypoint_list_t& wplst);
+
+    /// @brief Drop the cluster graphs and all cached paths.
+    void clear();
+
+    size_t getCacheHits() const { return _cacheHits; }
+    size_t getCacheMisses() const { return _cacheMisses; }
+
+private:
+    /// The regions of all clusters for one set of stoppedby bits.
+    struct ClusterGraph {
+        uint32_t stoppedBy;
+        std::vector<int32_t> regionOfTile;          ///< Region of each tile, @a -1 if the tile is not walkable
+        std::vector<int32_t> componentOfRegion;     ///< Connected component of each region
+    };
+
+    struct CacheKey {
+        int32_t srcRegion;
+        int32_t dstRegion;
+        uint32_t stoppedBy;
+
+        bool operator==(const CacheKey& other) const {
+            return srcRegion == other.srcRegion && dstRegion == other.dstRegion && stoppedBy == other.stoppedBy;
+        }
+    };
+
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& key) const {
+            return std::hash<uint64_t>()((uint64_t(uint32_t(key.srcRegion)) << 32 | uint32_t(key.dstRegion)) ^ (uint64_t(key.stoppedBy) * 0x9E3779B97F4A7C15ull));
+        }
+    };
+
+    struct CacheEntry {
+        CacheKey key;
+        std::vector<int32_t> tiles;                 ///< The cached path, start tile first
+    };
+
+    typedef std::list<CacheEntry> CacheList;
+
+private:
+    void validate(const PathGrid& grid);
+    const ClusterGraph& getGraph(const PathGrid& grid, uint32_t stoppedBy);
+    void buildGraph(const PathGrid& grid, ClusterGraph& graph) const;
+    /// @brief Search a path with AStar and append its tiles, the first tile is skipped if it is already the last one of @a tiles.
+    bool appendSearch(const PathGrid& grid, uint32_t stoppedBy, int32_t srcTile, int32_t dstTile, std::vector<int32_t>& tiles);
+    /// @brief Join a cached path with the searches from the source to its start and from its end to the destination.
+    bool joinCachedPath(const PathGrid& grid, uint32_t stoppedBy, int32_t srcTile, int32_t dstTile, const std::vector<int32_t>& cached);
+    /// @brief Cut out the loops of a path, a tile visited twice keeps only its first visit.
+    static void eraseLoops(std::vector<int32_t>& tiles);
+
+private:
+    AStar& _astar;
+    std::weak_ptr<const void> _owner;               ///< The owner of the grid the graphs and paths belong to
+    uint32_t _revision;                             ///< The revision of that grid
+    int _tileCountX;
+    std::vector<ClusterGraph> _graphs;              ///< One graph per set of stoppedby bits seen so far
+
+    CacheList _cache;                               ///< Cached paths, most recently used first
+    std::unordered_map<CacheKey, CacheList::iterator, CacheKeyHash> _cacheIndex;
+    std::vector<int32_t> _tiles;                    ///< Scratch tile path
+    std::vector<int32_t> _searchTiles;              ///< Scratch tile path of a single search
+    size_t _cacheHits;
+    size_t _cacheMisses;
+};
+
+extern PathService g_pathService;
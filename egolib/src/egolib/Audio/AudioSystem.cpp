@@ -19,6 +19,7 @@
 /// @author Johan Jansen
 
 #include "egolib/Audio/AudioSystem.hpp"
+#include "egolib/Core/System.hpp"
 
 #include "game/Graphics/CameraSystem.hpp"
 #include "game/game.h"
@@ -61,6 +62,16 @@ static const std::array<const char*, GSND_COUNT> wavenames =
     "stealth_end"
 };
 
+/// @return @a true if sound effects or music are enabled and there is an audio device to play them on
+static bool isAudioOutputEnabled()
+{
+    if (Ego::Core::System::get().isHeadless())
+    {
+        return false;
+    }
+    return egoboo_config_t::get().sound_effects_enable.getValue() || egoboo_config_t::get().sound_music_enable.getValue();
+}
+
 AudioSystem::AudioSystem() :
     _musicLoaded(),
     _musicIDToNameMap(),
@@ -73,7 +84,7 @@ AudioSystem::AudioSystem() :
     _globalSounds.fill(INVALID_SOUND_ID);
 
     // Initialize SDL mixer.
-    if (egoboo_config_t::get().sound_effects_enable.getValue() || egoboo_config_t::get().sound_music_enable.getValue())
+    if (isAudioOutputEnabled())
     {
         const SDL_version* link_version = Mix_Linked_Version();
 		Log::get().info("initializing SDL mixer audio services version %d.%d.%d ... ", link_version->major, link_version->minor, link_version->patch);
@@ -160,7 +171,7 @@ void AudioSystem::download(egoboo_config_t& cfg)
     _loopingSounds.clear();
 
     // Restore audio if needed
-    if (egoboo_config_t::get().sound_effects_enable.getValue() || egoboo_config_t::get().sound_music_enable.getValue())
+    if (isAudioOutputEnabled())
     {
         if (-1 != Mix_OpenAudio(egoboo_config_t::get().sound_highQuality_enable.getValue() ? MIX_HIGH_QUALITY : MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_FORMAT, MIX_DEFAULT_CHANNELS, egoboo_config_t::get().sound_outputBuffer_size.getValue()))
         {
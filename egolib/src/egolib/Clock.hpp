@@ -143,6 +143,18 @@ protected:
 	 */
 	Stopwatch _stopwatch;
 
+	/**
+	 * @brief
+	 *	A sliding window holding the event counts of the measured durations, see count().
+	 */
+	SlidingWindow<double> _countWindow;
+
+	/**
+	 * @brief
+	 *	The number of events counted in the current section.
+	 */
+	size_t _count;
+
 protected:
 
 	/**
@@ -158,7 +170,8 @@ protected:
 	 *	The clock is in its initial state w.r.t. the current point in time.
 	 */
 	AbstractClock(const std::string& name, size_t slidingWindowCapacity)
-		: _name(name), _stopwatch(), _slidingWindow(slidingWindowCapacity) {
+		: _name(name), _slidingWindow(slidingWindowCapacity), _stopwatch(),
+		  _countWindow(slidingWindowCapacity), _count(0) {
 		// Intentionally empty.
 	}
 	virtual ~AbstractClock() {
@@ -215,6 +228,56 @@ public:
 		}
 	}
 
+	/**
+	 * @brief
+	 *	Count events (e.g. draw calls) in the observed section.
+	 * @param amount
+	 *	the number of events
+	 * @remark
+	 *	The count of a section is recorded when the section is left.
+	 */
+	void count(size_t amount) {
+		_count += amount;
+	}
+
+	/**
+	 * @brief
+	 *	Get the average number of events counted in the associated code section(s).
+	 * @return
+	 *	the average number of events counted in the associated code section(s)
+	 * @remark
+	 *	If no duration was measured yet, @a 0 is returned.
+	 */
+	double avgCount() const {
+		if (_countWindow.empty()) {
+			return 0;
+		}
+		else {
+			double totalCount = 0;
+			for (size_t i = 0; i < _countWindow.size(); ++i) {
+				totalCount += _countWindow.get(i);
+			}
+			return totalCount / _countWindow.size();
+		}
+	}
+
+	/**
+	 * @brief
+	 *	Get the number of events counted the last time the associated code section(s) were left.
+	 * @return
+	 *	the number of events counted the last time the associated code section(s) were left
+	 * @remark
+	 *	If no duration was measured yet, @a 0 is returned.
+	 */
+	double lstCount() const {
+		if (_countWindow.empty()) {
+			return 0;
+		}
+		else {
+			return _countWindow.get(_countWindow.size() - 1);
+		}
+	}
+
 	/**
 	 * @brief
 	 *	Enter the observed section.
@@ -222,6 +285,7 @@ public:
 	virtual void enter() {
 		_stopwatch.reset();
 		_stopwatch.start();
+		_count = 0;
 	}
 
 	/**
@@ -235,6 +299,9 @@ public:
 		_slidingWindow.add(_stopwatch.elapsed());
 		// Reset the stopwatch.
 		_stopwatch.reset();
+		// Add the events counted to the sliding window.
+		_countWindow.add(static_cast<double>(_count));
+		_count = 0;
 	}
 
 	/**
@@ -243,6 +310,7 @@ public:
 	 */
 	virtual void reinit() {
 		_slidingWindow.clear();
+		_countWindow.clear();
 	}
 };
 
@@ -0,0 +1,133 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/ChunkedPool.hpp
+/// @brief  A pool handing out elements which are allocated in chunks and never move
+
+#pragma once
+
+#include "IdLib/IdLib.hpp"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   A growable pool of default constructible elements. Elements are allocated in contiguous
+*   chunks, a chunk is only added if no released element is left. Elements never move, hence
+*   references to them stay valid for as long as the element is held.
+* @remark
+*   Released elements are handed out again as they are, resetting them is up to the caller.
+* @remark
+*   Each element shares ownership of its chunk: a chunk is destroyed as soon as the pool and
+*   all holders of its elements dropped them.
+**/
+template <typename T>
+class ChunkedPool : public Id::NonCopyable
+{
+public:
+    /**
+    * @brief
+    *   Construct an empty pool.
+    * @param chunkSize
+    *   the number of elements allocated at once
+    **/
+    ChunkedPool(const size_t chunkSize = 256) :
+        _chunkSize(std::max<size_t>(1, chunkSize)),
+        _capacity(0),
+        _chunks(),
+        _free()
+    {
+        //ctor
+    }
+
+    /**
+    * @brief
+    *   Get an element which is not in use, allocating a new chunk if needed.
+    **/
+    std::shared_ptr<T> acquire()
+    {
+        if (_free.empty()) {
+            grow();
+        }
+        std::shared_ptr<T> element = std::move(_free.back());
+        _free.pop_back();
+        return element;
+    }
+
+    /**
+    * @brief
+    *   Return an element acquired from this pool.
+    **/
+    void release(const std::shared_ptr<T> &element)
+    {
+        _free.push_back(element);
+    }
+
+    /**
+    * @return
+    *   the number of elements allocated by this pool
+    **/
+    size_t getCapacity() const
+    {
+        return _capacity;
+    }
+
+    /**
+    * @return
+    *   the number of elements which can be acquired without allocating
+    **/
+    size_t getFreeCount() const
+    {
+        return _free.size();
+    }
+
+    /**
+    * @brief
+    *   Forget all chunks and released elements.
+    **/
+    void clear()
+    {
+        _free.clear();
+        _chunks.clear();
+        _capacity = 0;
+    }
+
+private:
+    void grow()
+    {
+        std::shared_ptr<T> chunk(new T[_chunkSize], std::default_delete<T[]>());
+        _chunks.push_back(chunk);
+        _capacity += _chunkSize;
+
+        //Hand out the first element of the chunk first
+        _free.reserve(_free.size() + _chunkSize);
+        for (size_t i = _chunkSize; i > 0; --i) {
+            _free.push_back(std::shared_ptr<T>(chunk, chunk.get() + (i - 1)));
+        }
+    }
+
+private:
+    size_t _chunkSize;
+    size_t _capacity;
+    std::vector<std::shared_ptr<T>> _chunks;
+    std::vector<std::shared_ptr<T>> _free;          ///< Elements which are not in use
+};
+
+} //namespace Ego
@@ -0,0 +1,138 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/CommandBuffer.hpp
+/// @brief  Records commands on a worker thread for replay on another thread
+
+#pragma once
+
+#include <IdLib/IdLib.hpp>
+
+namespace Ego {
+namespace Core {
+
+/**
+ * @brief
+ *  A list of commands recorded for later replay. A thread can make a buffer its current buffer,
+ *  all commands submitted by that thread are then recorded into that buffer. Commands submitted
+ *  by a thread without a current buffer are executed immediately.
+ * @remark
+ *  A buffer must only be used by one thread at a time.
+ */
+class CommandBuffer : public Id::NonCopyable
+{
+public:
+    using Command = std::function<void()>;
+
+    /**
+     * @brief
+     *  Makes a buffer the current buffer of the calling thread for the lifetime of this object.
+     */
+    class Scope : public Id::NonCopyable
+    {
+    public:
+        Scope(CommandBuffer& buffer) :
+            _previous(current())
+        {
+            current() = &buffer;
+        }
+
+        ~Scope()
+        {
+            current() = _previous;
+        }
+
+    private:
+        CommandBuffer *_previous;
+    };
+
+    CommandBuffer() :
+        _commands()
+    {
+        //ctor
+    }
+
+    /**
+     * @brief
+     *  Record a command into the current buffer of the calling thread or execute it immediately if
+     *  the calling thread has no current buffer.
+     * @param command
+     *  the command. It must not refer to state which might be gone when the buffer is replayed.
+     */
+    static void submit(Command command)
+    {
+        CommandBuffer *buffer = current();
+        if (buffer) {
+            buffer->_commands.push_back(std::move(command));
+        } else {
+            command();
+        }
+    }
+
+    /**
+     * @brief
+     *  Execute the recorded commands in the order they were recorded and clear this buffer.
+     *  Commands submitted by a replayed command go to the current buffer of the replaying thread.
+     */
+    void replay()
+    {
+        std::vector<Command> commands;
+        commands.swap(_commands);
+        for (Command& command : commands) {
+            command();
+        }
+
+        //Keep the storage for the next recording
+        commands.clear();
+        if (_commands.empty()) {
+            _commands.swap(commands);
+        }
+    }
+
+    /**
+     * @brief
+     *  Drop the recorded commands.
+     */
+    void clear()
+    {
+        _commands.clear();
+    }
+
+    /**
+     * @return
+     *  the number of recorded commands
+     */
+    size_t size() const
+    {
+        return _commands.size();
+    }
+
+private:
+    static CommandBuffer *& current()
+    {
+        static thread_local CommandBuffer *buffer = nullptr;
+        return buffer;
+    }
+
+private:
+    std::vector<Command> _commands;
+};
+
+} // namespace Core
+} // namespace Ego
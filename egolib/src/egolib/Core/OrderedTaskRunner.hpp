@@ -0,0 +1,187 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/OrderedTaskRunner.hpp
+/// @brief  Runs a sequence of tasks on a ThreadPool with the same results as a serial run
+
+#pragma once
+
+#include "egolib/Core/ThreadPool.hpp"
+#include "egolib/Core/CommandBuffer.hpp"
+
+namespace Ego {
+namespace Core {
+
+/**
+ * @brief
+ *  Processes a sequence of items in order. Consecutive items which are @a independent are
+ *  processed concurrently on a ThreadPool, every other item is processed on the calling thread
+ *  and acts as a barrier: all items before it are finished before it starts, no item after it
+ *  starts before it has finished.
+ * @remark
+ *  Independent items defer their effects on shared state through CommandBuffer::submit(). Every
+ *  worker records into its own buffer. Once a run of independent items is finished, the buffers
+ *  are replayed on the calling thread in item order, before the next dependent item starts.
+ *  Dependent items have no buffer, their commands are executed immediately.
+ * @remark
+ *  An item may only be classified as independent if processing it writes no state that any
+ *  other independent item reads, other than through commands, and reads no state that any other
+ *  independent item writes. Under that contract the final state does not depend on the number
+ *  of threads: a run of independent items never sees the commands of its own run.
+ * @remark
+ *  The classification of an item is evaluated before the independent items in front of it
+ *  have been processed, hence it must not depend on state written by independent items.
+ */
+class OrderedTaskRunner : public Id::NonCopyable
+{
+public:
+    /**
+     * @brief
+     *  Construct this runner.
+     * @param threads
+     *  the number of worker threads. If @a 0, all items are processed on the calling thread.
+     * @param minimumBatchSize
+     *  runs of independent items shorter than this are processed on the calling thread
+     */
+    OrderedTaskRunner(size_t threads, size_t minimumBatchSize = 8) :
+        _pool(threads > 0 ? std::make_unique<ThreadPool>(threads) : nullptr),
+        _threads(threads),
+        _minimumBatchSize(std::max<size_t>(1, minimumBatchSize)),
+        _futures(),
+        _buffers()
+    {
+        //ctor
+    }
+
+    /**
+     * @return
+     *  the number of worker threads of this runner
+     */
+    size_t getThreadCount() const
+    {
+        return _threads;
+    }
+
+    /**
+     * @brief
+     *  Process a sequence of items.
+     * @param items
+     *  the items
+     * @param isIndependent
+     *  a callable <tt>bool(const Item&)</tt> classifying an item
+     * @param process
+     *  a callable <tt>void(const Item&)</tt> processing an item
+     */
+    template <typename Item, typename IsIndependent, typename Process>
+    void run(const std::vector<Item>& items, IsIndependent isIndependent, Process process)
+    {
+        size_t batchBegin = 0, batchEnd = 0;
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (isIndependent(items[i])) {
+                //Extend the current run of independent items
+                if (batchBegin == batchEnd) batchBegin = i;
+                batchEnd = i + 1;
+                continue;
+            }
+            runBatch(items, batchBegin, batchEnd, process);
+            batchBegin = batchEnd = 0;
+            process(items[i]);
+        }
+        runBatch(items, batchBegin, batchEnd, process);
+    }
+
+private:
+    template <typename Item, typename Process>
+    void runBatch(const std::vector<Item>& items, const size_t begin, const size_t end, Process& process)
+    {
+        const size_t count = end - begin;
+        if (0 == count) {
+            return;
+        }
+
+        //Not worth the synchronization overhead
+        if (!_pool || count < _minimumBatchSize) {
+            CommandBuffer& buffer = getBuffer(0);
+            try {
+                CommandBuffer::Scope scope(buffer);
+                for (size_t i = begin; i < end; ++i) {
+                    process(items[i]);
+                }
+            } catch (...) {
+                buffer.clear();
+                throw;
+            }
+            buffer.replay();
+            return;
+        }
+
+        //Split the run into one contiguous chunk per worker
+        const size_t chunks = std::min(_threads, count);
+        const size_t chunkSize = (count + chunks - 1) / chunks;
+        _futures.clear();
+        for (size_t chunkBegin = begin, chunk = 0; chunkBegin < end; chunkBegin += chunkSize, ++chunk) {
+            const size_t chunkEnd = std::min(end, chunkBegin + chunkSize);
+            CommandBuffer *buffer = &getBuffer(chunk);
+            _futures.push_back(_pool->submit([&items, &process, buffer, chunkBegin, chunkEnd]() {
+                CommandBuffer::Scope scope(*buffer);
+                for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+                    process(items[i]);
+                }
+            }));
+        }
+
+        //Barrier, rethrows the first exception thrown by a chunk
+        for (std::future<void>& future : _futures) {
+            future.wait();
+        }
+        try {
+            for (std::future<void>& future : _futures) {
+                future.get();
+            }
+        } catch (...) {
+            for (size_t chunk = 0; chunk < _futures.size(); ++chunk) {
+                _buffers[chunk]->clear();
+            }
+            throw;
+        }
+
+        //The chunks are contiguous, hence replaying them in chunk order replays in item order
+        for (size_t chunk = 0; chunk < _futures.size(); ++chunk) {
+            _buffers[chunk]->replay();
+        }
+    }
+
+    CommandBuffer& getBuffer(const size_t index)
+    {
+        while (_buffers.size() <= index) {
+            _buffers.push_back(std::make_unique<CommandBuffer>());
+        }
+        return *_buffers[index];
+    }
+
+private:
+    std::unique_ptr<ThreadPool> _pool;
+    size_t _threads;
+    size_t _minimumBatchSize;
+    std::vector<std::future<void>> _futures;
+    std::vector<std::unique_ptr<CommandBuffer>> _buffers;   //< One per chunk, reused between runs
+};
+
+} // namespace Core
+} // namespace Ego
@@ -0,0 +1,151 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/RadixSort.hpp
+/// @brief  Stable least significant digit radix sort of key/value pairs
+
+#pragma once
+
+#include "IdLib/IdLib.hpp"
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  Sorts elements by an unsigned integer key, one byte of the key per pass starting with the
+ *  least significant byte. The sort is stable. Passes over bytes which are the same in all keys
+ *  are skipped, hence keys with few significant bits are cheap to sort.
+ * @remark
+ *  The element storage is kept between sorts, a sorter used once per frame does not allocate
+ *  once it has grown to the largest number of elements.
+ * @tparam Value
+ *  the type of the values sorted along with the keys
+ * @tparam Key
+ *  an unsigned integer type
+ */
+template <typename Value, typename Key = uint64_t>
+class RadixSort : public Id::NonCopyable
+{
+public:
+    static_assert(std::is_unsigned<Key>::value, "the key type must be an unsigned integer type");
+
+    struct Element
+    {
+        Key key;
+        Value value;
+    };
+
+    RadixSort() :
+        _elements(),
+        _buffer()
+    {
+        //ctor
+    }
+
+    /**
+     * @brief
+     *  Remove all elements.
+     */
+    void clear()
+    {
+        _elements.clear();
+    }
+
+    /**
+     * @brief
+     *  Add an element.
+     */
+    void push(const Key key, const Value& value)
+    {
+        _elements.push_back({key, value});
+    }
+
+    /**
+     * @return
+     *  the number of elements
+     */
+    size_t size() const
+    {
+        return _elements.size();
+    }
+
+    /**
+     * @return
+     *  the elements, in ascending order of their keys after sort()
+     */
+    const std::vector<Element>& getElements() const
+    {
+        return _elements;
+    }
+
+    /**
+     * @brief
+     *  Sort the elements in ascending order of their keys.
+     */
+    void sort()
+    {
+        const size_t count = _elements.size();
+        if (count < 2) return;
+        _buffer.resize(count);
+
+        for (size_t shift = 0; shift < 8 * sizeof(Key); shift += 8)
+        {
+            size_t offsets[256] = {};
+            for (const Element& element : _elements)
+            {
+                offsets[(element.key >> shift) & 0xFF]++;
+            }
+
+            // all keys share this byte
+            if (offsets[(_elements[0].key >> shift) & 0xFF] == count) continue;
+
+            size_t sum = 0;
+            for (size_t &offset : offsets)
+            {
+                const size_t bucketSize = offset;
+                offset = sum;
+                sum += bucketSize;
+            }
+            for (const Element& element : _elements)
+            {
+                _buffer[offsets[(element.key >> shift) & 0xFF]++] = element;
+            }
+            _elements.swap(_buffer);
+        }
+    }
+
+    /**
+     * @return
+     *  a key which orders floating point values like the values themselves, NaNs excluded
+     */
+    static uint32_t getKey(const float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        // negative values have their order reversed, positive values go above them
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+private:
+    std::vector<Element> _elements;
+    std::vector<Element> _buffer;   ///< The target of every other pass
+};
+
+} // namespace Ego
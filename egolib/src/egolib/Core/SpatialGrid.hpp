@@ -0,0 +1,312 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/SpatialGrid.hpp
+/// @brief  Flat uniform grid for fast element lookup based on bounding boxes
+/// @details Unlike Ego::QuadTree, the grid is not rebuilt every update. Elements are kept in a
+///          contiguous array and are only re-bucketed when the range of cells they cover changes.
+
+#pragma once
+
+#include "egolib/Math/Standard.hpp"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   A uniform grid of square cells covering a rectangular area. Each element is registered in every
+*   cell its 2D bounding box overlaps. Elements outside of the area are clamped to the border cells.
+* @tparam T
+*   the element type. It must provide <tt>const AABB2f& getAABB2D() const</tt> and
+*   <tt>bool isTerminated() const</tt>.
+* @remark
+*   An element spanning several cells is only reported from the first of its cells that the query
+*   visits. Queries do not modify the grid and may therefore run concurrently.
+**/
+template<typename T>
+class SpatialGrid
+{
+public:
+    /**
+    * @brief
+    *   Construct an empty grid without any cells. Elements can be inserted before the bounds are
+    *   known, they are bucketed as soon as setBounds() is called.
+    **/
+    SpatialGrid() :
+        _bounds(),
+        _cellSize(1.0f),
+        _inverseCellSize(1.0f),
+        _cellCountX(0),
+        _cellCountY(0),
+        _cells(),
+        _entries()
+    {
+        //ctor
+    }
+
+    /**
+    * @brief
+    *   Set the area covered by this grid and the edge length of its cells.
+    *   All elements are re-bucketed if anything changed.
+    **/
+    void setBounds(const float minX, const float minY, const float maxX, const float maxY, const float cellSize)
+    {
+        const AABB2f bounds(Vector2f(minX, minY), Vector2f(maxX, maxY));
+        if (!_cells.empty() && _cellSize == cellSize && _bounds.getMin() == bounds.getMin() && _bounds.getMax() == bounds.getMax()) {
+            return;
+        }
+
+        _bounds = bounds;
+        _cellSize = std::max(cellSize, 1.0f);
+        _inverseCellSize = 1.0f / _cellSize;
+        _cellCountX = std::max<int>(1, static_cast<int>(std::ceil((maxX - minX) * _inverseCellSize)));
+        _cellCountY = std::max<int>(1, static_cast<int>(std::ceil((maxY - minY) * _inverseCellSize)));
+
+        _cells.clear();
+        _cells.resize(_cellCountX * _cellCountY);
+
+        //Re-bucket everything we already know about
+        for (uint32_t index = 0; index < _entries.size(); ++index) {
+            Entry &entry = _entries[index];
+            entry.range = computeRange(entry.element->getAABB2D());
+            link(index);
+        }
+    }
+
+    /**
+    * @brief
+    *   Add an element to this grid. The grid holds on to the element until it is terminated.
+    **/
+    void insert(const std::shared_ptr<T> &element)
+    {
+        const uint32_t index = static_cast<uint32_t>(_entries.size());
+        _entries.emplace_back(element);
+        if (!_cells.empty()) {
+            _entries[index].range = computeRange(element->getAABB2D());
+            link(index);
+        }
+    }
+
+    /**
+    * @brief
+    *   Bring this grid up to date. Terminated elements are dropped and elements whose bounding
+    *   box moved into a different range of cells are re-bucketed. Elements which stayed within
+    *   their cells cost a single range computation.
+    **/
+    void update()
+    {
+        uint32_t index = 0;
+        while (index < _entries.size()) {
+            Entry &entry = _entries[index];
+
+            //Drop elements that no longer exist
+            if (entry.element->isTerminated()) {
+                removeAt(index);
+                continue;
+            }
+
+            if (!_cells.empty()) {
+                const CellRange range = computeRange(entry.element->getAABB2D());
+                if (range != entry.range) {
+                    unlink(index);
+                    entry.range = range;
+                    link(index);
+                }
+            }
+
+            ++index;
+        }
+    }
+
+    /**
+    * @brief
+    *   Find all elements whose bounding box overlaps the specified search area
+    * @param searchArea
+    *   The bounding box which is used for finding elements
+    * @param result
+    *   Vector of all elements that fit within the search area (elements are appended)
+    **/
+    void find(const AABB2f &searchArea, std::vector<std::shared_ptr<T>> &result) const
+    {
+        find(searchArea, result, [](const T&) { return true; });
+    }
+
+    /**
+    * @brief
+    *   Find all elements whose bounding box overlaps the specified search area and that
+    *   satisfy a predicate
+    * @param predicate
+    *   a callable <tt>bool(const T&)</tt>, only elements for which it returns true are added
+    **/
+    template<typename Predicate>
+    void find(const AABB2f &searchArea, std::vector<std::shared_ptr<T>> &result, Predicate predicate) const
+    {
+        //Search area is not part of our bounds
+        if (_cells.empty() || !_bounds.overlaps(searchArea)) {
+            return;
+        }
+
+        const CellRange range = computeRange(searchArea);
+
+        for (int y = range.minY; y <= range.maxY; ++y) {
+            const std::vector<uint32_t> *row = &_cells[y * _cellCountX];
+            for (int x = range.minX; x <= range.maxX; ++x) {
+                for (uint32_t index : row[x]) {
+                    const Entry &entry = _entries[index];
+
+                    //Only report an element from the first cell of the query it is linked into
+                    if (x != std::max(range.minX, entry.range.minX) || y != std::max(range.minY, entry.range.minY)) {
+                        continue;
+                    }
+
+                    const T &element = *entry.element;
+                    if (element.isTerminated() || !element.getAABB2D().overlaps(searchArea)) {
+                        continue;
+                    }
+                    if (predicate(element)) {
+                        result.push_back(entry.element);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+    * @brief
+    *   Removes all elements from this grid. The bounds and cells are kept.
+    **/
+    void clear()
+    {
+        _entries.clear();
+        for (std::vector<uint32_t> &cell : _cells) {
+            cell.clear();
+        }
+    }
+
+    /**
+    * @return
+    *   the number of elements stored in this grid
+    **/
+    size_t size() const
+    {
+        return _entries.size();
+    }
+
+private:
+    /// Inclusive range of cells covered by a bounding box
+    struct CellRange
+    {
+        int minX, minY, maxX, maxY;
+
+        CellRange() : minX(0), minY(0), maxX(-1), maxY(-1) {}
+
+        bool operator!=(const CellRange &other) const
+        {
+            return minX != other.minX || minY != other.minY || maxX != other.maxX || maxY != other.maxY;
+        }
+    };
+
+    struct Entry
+    {
+        Entry(const std::shared_ptr<T> &element) :
+            element(element),
+            range()
+        {
+            //ctor
+        }
+
+        std::shared_ptr<T> element;
+        CellRange range;            //< Cells this element is currently linked into
+    };
+
+    CellRange computeRange(const AABB2f &aabb) const
+    {
+        CellRange range;
+        range.minX = clampCell((aabb.getMin()[kX] - _bounds.getMin()[kX]) * _inverseCellSize, _cellCountX);
+        range.minY = clampCell((aabb.getMin()[kY] - _bounds.getMin()[kY]) * _inverseCellSize, _cellCountY);
+        range.maxX = clampCell((aabb.getMax()[kX] - _bounds.getMin()[kX]) * _inverseCellSize, _cellCountX);
+        range.maxY = clampCell((aabb.getMax()[kY] - _bounds.getMin()[kY]) * _inverseCellSize, _cellCountY);
+        return range;
+    }
+
+    static int clampCell(const float cell, const int count)
+    {
+        if (!(cell >= 0.0f)) return 0;   //also catches NaN
+        if (cell >= static_cast<float>(count - 1)) return count - 1;
+        return static_cast<int>(cell);
+    }
+
+    void link(const uint32_t index)
+    {
+        const CellRange &range = _entries[index].range;
+        for (int y = range.minY; y <= range.maxY; ++y) {
+            for (int x = range.minX; x <= range.maxX; ++x) {
+                _cells[y * _cellCountX + x].push_back(index);
+            }
+        }
+    }
+
+    void unlink(const uint32_t index)
+    {
+        const CellRange &range = _entries[index].range;
+        for (int y = range.minY; y <= range.maxY; ++y) {
+            for (int x = range.minX; x <= range.maxX; ++x) {
+                std::vector<uint32_t> &cell = _cells[y * _cellCountX + x];
+                for (size_t i = 0; i < cell.size(); ++i) {
+                    if (cell[i] == index) {
+                        cell[i] = cell.back();
+                        cell.pop_back();
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /// Swap-remove an entry, relinking the entry that takes its place
+    void removeAt(const uint32_t index)
+    {
+        const uint32_t last = static_cast<uint32_t>(_entries.size() - 1);
+        if (!_cells.empty()) {
+            unlink(index);
+        }
+        if (index != last) {
+            if (!_cells.empty()) {
+                unlink(last);
+            }
+            _entries[index] = std::move(_entries[last]);
+            if (!_cells.empty()) {
+                link(index);
+            }
+        }
+        _entries.pop_back();
+    }
+
+private:
+    AABB2f _bounds;                                 //< Area covered by the cells
+    float _cellSize;
+    float _inverseCellSize;
+    int _cellCountX;
+    int _cellCountY;
+    std::vector<std::vector<uint32_t>> _cells;      //< Per cell, indices into _entries
+    std::vector<Entry> _entries;                    //< Contiguous element storage
+};
+
+} //namespace Ego
@@ -0,0 +1,209 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/StreamingQueue.hpp
+/// @brief  Decodes requested resources on worker threads and hands them out in time-budgeted slices
+
+#pragma once
+
+#include "egolib/Core/ThreadPool.hpp"
+
+namespace Ego {
+namespace Core {
+
+/**
+ * @brief
+ *  A two stage pipeline for streaming resources. Requested keys are decoded into payloads on a
+ *  ThreadPool, the decoded payloads are then handed to an upload function on the thread calling
+ *  upload(), for at most a given amount of time per call.
+ * @remark
+ *  The decode function must not touch state owned by the uploading thread (e.g. an OpenGL
+ *  context). Exceptions thrown by the decode function are swallowed and yield a default
+ *  constructed payload.
+ * @remark
+ *  request(), isPending(), getPendingCount(), wait() and clear() are thread safe. upload() must
+ *  only be called by one thread at a time.
+ */
+template <typename Key, typename Payload>
+class StreamingQueue : public Id::NonCopyable
+{
+public:
+    using Decode = std::function<Payload(const Key&)>;
+
+    /**
+     * @brief
+     *  Construct this queue.
+     * @param threads
+     *  the number of worker threads. If @a 0, keys are decoded by request() on the calling thread.
+     * @param decode
+     *  a callable <tt>Payload(const Key&)</tt> decoding a key
+     */
+    StreamingQueue(size_t threads, Decode decode) :
+        _decode(decode),
+        _mutex(),
+        _decodedCondition(),
+        _pending(),
+        _decoded(),
+        _decoding(0),
+        _generation(0),
+        _pool(threads > 0 ? std::make_unique<ThreadPool>(threads) : nullptr)
+    {
+        //ctor
+    }
+
+    /**
+     * @brief
+     *  Request a key to be decoded.
+     * @return
+     *  @a true if the key was queued, @a false if it is already pending
+     */
+    bool request(const Key& key)
+    {
+        size_t generation;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_pending.insert(key).second) {
+                return false;
+            }
+            _decoding++;
+            generation = _generation;
+        }
+
+        if (_pool) {
+            _pool->submit([this, key, generation]() { decode(key, generation); });
+        } else {
+            decode(key, generation);
+        }
+        return true;
+    }
+
+    /**
+     * @brief
+     *  Hand decoded payloads to an upload function in the order they finished decoding.
+     * @param upload
+     *  a callable <tt>void(const Key&, Payload&&)</tt>
+     * @param budget
+     *  no further payload is handed out once this much time has passed. At least one payload is
+     *  handed out if any is available, so a budget of zero uploads one payload per call.
+     * @return
+     *  the number of payloads handed out
+     */
+    template <typename Upload>
+    size_t upload(Upload upload, const std::chrono::microseconds& budget)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        size_t count = 0;
+        do {
+            std::pair<Key, Payload> decoded;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_decoded.empty()) {
+                    break;
+                }
+                decoded = std::move(_decoded.front());
+                _decoded.pop_front();
+            }
+
+            upload(decoded.first, std::move(decoded.second));
+            count++;
+
+            //No longer pending once it was uploaded
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pending.erase(decoded.first);
+        } while (std::chrono::steady_clock::now() - begin < budget);
+        return count;
+    }
+
+    /**
+     * @return
+     *  @a true if the key was requested and has not been uploaded yet
+     */
+    bool isPending(const Key& key) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _pending.find(key) != _pending.end();
+    }
+
+    /**
+     * @return
+     *  the number of keys requested and not uploaded yet
+     */
+    size_t getPendingCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _pending.size();
+    }
+
+    /**
+     * @brief
+     *  Block until all requested keys are decoded.
+     */
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _decodedCondition.wait(lock, [this] { return 0 == _decoding; });
+    }
+
+    /**
+     * @brief
+     *  Forget all pending keys. Payloads already decoded are dropped, keys still being decoded
+     *  are dropped as soon as they finish.
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.clear();
+        _decoded.clear();
+        _generation++;
+    }
+
+private:
+    void decode(const Key& key, const size_t generation)
+    {
+        Payload payload;
+        try {
+            payload = _decode(key);
+        } catch (...) {
+            payload = Payload();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            //Requested before the last clear()
+            if (generation == _generation) {
+                _decoded.emplace_back(key, std::move(payload));
+            }
+            _decoding--;
+        }
+        _decodedCondition.notify_all();
+    }
+
+private:
+    Decode _decode;
+    mutable std::mutex _mutex;
+    std::condition_variable _decodedCondition;
+    std::unordered_set<Key> _pending;                //< Requested and not uploaded yet
+    std::deque<std::pair<Key, Payload>> _decoded;    //< Decoded and waiting for upload
+    size_t _decoding;
+    size_t _generation;
+    std::unique_ptr<ThreadPool> _pool;               //< Last, the workers are joined before the rest is destroyed
+};
+
+} // namespace Core
+} // namespace Ego
@@ -0,0 +1,325 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/SweepAndPrune.hpp
+/// @brief  Incremental broadphase keeping overlapping pairs of bounding boxes between updates
+/// @details The endpoints of the boxes are kept sorted along both axes. As elements move only a
+///          little between updates, re-sorting them is close to linear and the pairs are updated
+///          from the endpoints which swapped places.
+
+#pragma once
+
+#include "egolib/Math/Standard.hpp"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   A sweep and prune broadphase over 2D bounding boxes. Elements are identified by a caller
+*   defined 64 bit key. Every update, the caller passes the current box of each element to
+*   update() and then calls commit(). Elements which were not updated since the last commit are
+*   removed.
+* @remark
+*   Two elements are paired if their boxes overlap (touching boxes overlap) and their filters
+*   accept each other: the group of either element must intersect the mask of the other one.
+**/
+class SweepAndPrune
+{
+public:
+    using Key = uint64_t;
+
+    /// A pair of overlapping elements, the first key is smaller than the second key
+    struct Pair
+    {
+        Key first, second;
+
+        Pair(const Key first, const Key second) : first(first), second(second) {}
+
+        bool operator<(const Pair &other) const
+        {
+            return first < other.first || (first == other.first && second < other.second);
+        }
+
+        bool operator==(const Pair &other) const
+        {
+            return first == other.first && second == other.second;
+        }
+    };
+
+    SweepAndPrune() :
+        _proxies(),
+        _freeProxies(),
+        _proxyByKey(),
+        _axes(),
+        _pairSet(),
+        _pairs(),
+        _addedPairs(),
+        _removedPairs(),
+        _mergedPairs(),
+        _stamp(0)
+    {
+        //ctor
+    }
+
+    /**
+    * @brief
+    *   Insert an element or update the box and the filter of an element.
+    * @param group
+    *   the groups this element belongs to
+    * @param mask
+    *   the groups this element pairs with
+    **/
+    void update(const Key key, const AABB2f &box, const uint32_t group = 1, const uint32_t mask = 0xFFFFFFFF)
+    {
+        auto it = _proxyByKey.find(key);
+        if (it == _proxyByKey.end()) {
+            uint32_t index;
+            if (_freeProxies.empty()) {
+                index = static_cast<uint32_t>(_proxies.size());
+                _proxies.emplace_back();
+            } else {
+                index = _freeProxies.back();
+                _freeProxies.pop_back();
+            }
+            _proxyByKey.emplace(key, index);
+
+            //New endpoints start behind all others and are sorted in by commit()
+            Proxy &proxy = _proxies[index];
+            proxy.key = key;
+            proxy.alive = true;
+            for (size_t axis = 0; axis < 2; ++axis) {
+                _axes[axis].push_back(Endpoint(std::numeric_limits<float>::infinity(), index, false));
+                _axes[axis].push_back(Endpoint(std::numeric_limits<float>::infinity(), index, true));
+            }
+            it = _proxyByKey.find(key);
+        }
+
+        Proxy &proxy = _proxies[it->second];
+        proxy.box = box;
+        proxy.group = group;
+        proxy.mask = mask;
+        proxy.stamp = _stamp;
+    }
+
+    /**
+    * @brief
+    *   Remove the elements which were not updated since the last commit, re-sort the endpoints
+    *   and update the pairs.
+    **/
+    void commit()
+    {
+        removeStaleProxies();
+
+        for (size_t axis = 0; axis < 2; ++axis) {
+            std::vector<Endpoint> &endpoints = _axes[axis];
+            for (Endpoint &endpoint : endpoints) {
+                const AABB2f &box = _proxies[endpoint.proxy].box;
+                endpoint.value = endpoint.isMax ? box.getMax()[axis] : box.getMin()[axis];
+            }
+            sortAxis(endpoints);
+        }
+
+        updatePairs();
+        _stamp++;
+    }
+
+    /**
+    * @return
+    *   all pairs of overlapping elements as of the last commit, sorted
+    **/
+    const std::vector<Pair>& getPairs() const
+    {
+        return _pairs;
+    }
+
+    /**
+    * @return
+    *   the number of elements
+    **/
+    size_t size() const
+    {
+        return _proxyByKey.size();
+    }
+
+    /**
+    * @brief
+    *   Remove all elements and pairs.
+    **/
+    void clear()
+    {
+        _proxies.clear();
+        _freeProxies.clear();
+        _proxyByKey.clear();
+        _axes[0].clear();
+        _axes[1].clear();
+        _pairSet.clear();
+        _pairs.clear();
+        _addedPairs.clear();
+        _removedPairs.clear();
+    }
+
+private:
+    struct Proxy
+    {
+        Key key;
+        AABB2f box;
+        uint32_t group;
+        uint32_t mask;
+        uint32_t stamp;
+        bool alive;
+
+        Proxy() : key(0), box(), group(0), mask(0), stamp(0), alive(false) {}
+    };
+
+    struct Endpoint
+    {
+        float value;
+        uint32_t proxy;
+        bool isMax;
+
+        Endpoint(const float value, const uint32_t proxy, const bool isMax) : value(value), proxy(proxy), isMax(isMax) {}
+
+        /// Minima go before maxima of the same value, touching boxes overlap
+        bool operator<(const Endpoint &other) const
+        {
+            return value < other.value || (value == other.value && !isMax && other.isMax);
+        }
+    };
+
+    static uint64_t encode(const uint32_t a, const uint32_t b)
+    {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+    }
+
+    Pair makePair(const uint32_t a, const uint32_t b) const
+    {
+        const Key keyA = _proxies[a].key, keyB = _proxies[b].key;
+        return keyA < keyB ? Pair(keyA, keyB) : Pair(keyB, keyA);
+    }
+
+    /// Insertion sort, close to linear for nearly sorted endpoints. Every swap of a minimum and a
+    /// maximum is a change of the overlap along this axis.
+    void sortAxis(std::vector<Endpoint> &endpoints)
+    {
+        for (size_t i = 1; i < endpoints.size(); ++i) {
+            const Endpoint endpoint = endpoints[i];
+            size_t j = i;
+            while (j > 0 && endpoint < endpoints[j - 1]) {
+                const Endpoint &other = endpoints[j - 1];
+                if (endpoint.proxy != other.proxy && endpoint.isMax != other.isMax) {
+                    if (!endpoint.isMax) {
+                        addPair(endpoint.proxy, other.proxy);
+                    } else {
+                        removePair(endpoint.proxy, other.proxy);
+                    }
+                }
+                endpoints[j] = other;
+                --j;
+            }
+            endpoints[j] = endpoint;
+        }
+    }
+
+    void addPair(const uint32_t a, const uint32_t b)
+    {
+        const Proxy &proxyA = _proxies[a], &proxyB = _proxies[b];
+        if (0 == (proxyA.group & proxyB.mask) || 0 == (proxyB.group & proxyA.mask)) {
+            return;
+        }
+        if (!proxyA.box.overlaps(proxyB.box)) {
+            return;
+        }
+        if (_pairSet.insert(encode(a, b)).second) {
+            _addedPairs.push_back(makePair(a, b));
+        }
+    }
+
+    void removePair(const uint32_t a, const uint32_t b)
+    {
+        if (_pairSet.erase(encode(a, b)) > 0) {
+            _removedPairs.push_back(makePair(a, b));
+        }
+    }
+
+    void removeStaleProxies()
+    {
+        bool removed = false;
+        for (uint32_t index = 0; index < _proxies.size(); ++index) {
+            Proxy &proxy = _proxies[index];
+            if (proxy.alive && proxy.stamp != _stamp) {
+                proxy.alive = false;
+                _proxyByKey.erase(proxy.key);
+                _freeProxies.push_back(index);
+                removed = true;
+            }
+        }
+        if (!removed) {
+            return;
+        }
+
+        for (size_t axis = 0; axis < 2; ++axis) {
+            std::vector<Endpoint> &endpoints = _axes[axis];
+            endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(),
+                                           [this](const Endpoint &endpoint) { return !_proxies[endpoint.proxy].alive; }),
+                            endpoints.end());
+        }
+        for (auto it = _pairSet.begin(); it != _pairSet.end();) {
+            if (!_proxies[*it >> 32].alive || !_proxies[*it & 0xFFFFFFFF].alive) {
+                _removedPairs.push_back(makePair(*it >> 32, *it & 0xFFFFFFFF));
+                it = _pairSet.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    /// Merge the changes of this commit into the sorted pairs, only the changes are sorted. A pair
+    /// changes at most once per commit: it is only added if the boxes overlap after the commit and
+    /// only removed if they are apart after the commit.
+    void updatePairs()
+    {
+        if (_addedPairs.empty() && _removedPairs.empty()) {
+            return;
+        }
+        std::sort(_addedPairs.begin(), _addedPairs.end());
+        std::sort(_removedPairs.begin(), _removedPairs.end());
+
+        _mergedPairs.clear();
+        std::set_difference(_pairs.begin(), _pairs.end(), _removedPairs.begin(), _removedPairs.end(), std::back_inserter(_mergedPairs));
+        _pairs.clear();
+        std::merge(_mergedPairs.begin(), _mergedPairs.end(), _addedPairs.begin(), _addedPairs.end(), std::back_inserter(_pairs));
+        _addedPairs.clear();
+        _removedPairs.clear();
+    }
+
+private:
+    std::vector<Proxy> _proxies;
+    std::vector<uint32_t> _freeProxies;
+    std::unordered_map<Key, uint32_t> _proxyByKey;
+    std::array<std::vector<Endpoint>, 2> _axes;     //< Sorted endpoints along x and y
+    std::unordered_set<uint64_t> _pairSet;          //< Overlapping pairs of proxy indices
+    std::vector<Pair> _pairs;                       //< Overlapping pairs of keys, sorted
+    std::vector<Pair> _addedPairs;                  //< Pairs added during this commit
+    std::vector<Pair> _removedPairs;                //< Pairs removed during this commit
+    std::vector<Pair> _mergedPairs;                 //< Scratch buffer for the next sorted pairs
+    uint32_t _stamp;                                //< Incremented by every commit
+};
+
+} //namespace Ego
@@ -140,7 +140,13 @@ const std::string System::VERSION = "0.1.9";
 
 System *System::_singleton = nullptr;
 
-System::System(const char *binaryPath, const char *egobooPath)
+System::System(const char *binaryPath, const char *egobooPath, bool headless) :
+    timerService(nullptr),
+    eventService(nullptr),
+    videoService(nullptr),
+    audioService(nullptr),
+    inputService(nullptr),
+    headless(headless)
 {
     // Initialize the virtual file system.
     vfs_init(binaryPath, egobooPath);
@@ -195,6 +201,12 @@ System::System(const char *binaryPath, const char *egobooPath)
         Log::uninitialize();
         /*vfs_uninitialize();*/
         std::rethrow_exception(std::current_exception());
+    }
+    // A headless system has no window, no audio output and no input devices.
+    if (headless)
+    {
+        Log::get().info("Running headless, SDL video, audio and input services are not initialized\n");
+        return;
     }
 	try
 	{
@@ -270,13 +282,13 @@ System& System::get()
     return *_singleton;
 }
 
-void System::initialize(const char *binaryPath, const char *egobooPath)
+void System::initialize(const char *binaryPath, const char *egobooPath, bool headless)
 {
     if (_singleton)
     {
         return;
     }
-    _singleton = new System(binaryPath, egobooPath);
+    _singleton = new System(binaryPath, egobooPath, headless);
 }
 
 void System::uninitialize()
@@ -126,7 +126,7 @@ protected:
      * @remark
      *  Intentionally protected.
      */
-    System(const char *binaryPath, const char *egobooPath);
+    System(const char *binaryPath, const char *egobooPath, bool headless);
 
     /**
      * @brief
@@ -157,11 +157,13 @@ public:
     /**
      * @brief
      *  Initialize the system singleton.
+     * @param headless
+     *  if @a true, the video, audio and input services are not initialized
      * @remark
      *  If the system singleton is initialized,
      *  a call to this method is a no-op.
      */
-    static void initialize(const char *binaryPath, const char *egobooPath);
+    static void initialize(const char *binaryPath, const char *egobooPath, bool headless = false);
 
     /**
      * @brief
@@ -178,7 +180,18 @@ private:
     VideoService *videoService;
     AudioService *audioService;
     InputService *inputService;
+    bool headless;
 public:
+    /**
+     * @brief
+     *  Get if this system is headless.
+     * @return
+     *  @a true if this system has no video, audio and input services, @a false otherwise
+     */
+    bool isHeadless() const
+    {
+        return headless;
+    }
     TimerService &getTimerService()
     {
         return *timerService;
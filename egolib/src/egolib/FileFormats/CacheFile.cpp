@@ -0,0 +1,218 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/FileFormats/CacheFile.cpp
+/// @brief  Versioned binary caches of parsed data files
+
+#include "egolib/FileFormats/CacheFile.hpp"
+#include "egolib/vfs.h"
+
+namespace Ego
+{
+
+namespace
+{
+/// "EGOC" as read on a little endian machine, a cache file from a machine of the other byte order is rejected.
+const uint32_t MAGIC = 0x434F4745;
+
+/// Serializes reads and writes of cache files, a cache file is never read while it is written
+std::mutex s_fileMutex;
+
+}
+
+CacheArchive::CacheArchive() :
+    _cursor(nullptr),
+    _end(nullptr),
+    _good(true),
+    _data()
+{
+    //ctor
+}
+
+CacheArchive::CacheArchive(const char *data, size_t length) :
+    _cursor(data),
+    _end(data + length),
+    _good(nullptr != data),
+    _data()
+{
+    //ctor
+}
+
+void CacheArchive::bytes(void *value, size_t size)
+{
+    if (!isReading()) {
+        const char *source = static_cast<const char *>(value);
+        _data.insert(_data.end(), source, source + size);
+        return;
+    }
+    if (!_good || static_cast<size_t>(_end - _cursor) < size) {
+        _good = false;
+        std::memset(value, 0, size);
+        return;
+    }
+    std::memcpy(value, _cursor, size);
+    _cursor += size;
+}
+
+void CacheArchive::operator()(std::string& value)
+{
+    uint32_t length = static_cast<uint32_t>(value.size());
+    (*this)(length);
+    if (!isReading()) {
+        _data.insert(_data.end(), value.begin(), value.end());
+        return;
+    }
+    if (!_good || static_cast<size_t>(_end - _cursor) < length) {
+        _good = false;
+        value.clear();
+        return;
+    }
+    value.assign(_cursor, length);
+    _cursor += length;
+}
+
+void CacheArchive::operator()(IPair& value)
+{
+    (*this)(value.base);
+    (*this)(value.rand);
+}
+
+void CacheArchive::operator()(FRange& value)
+{
+    (*this)(value.from);
+    (*this)(value.to);
+}
+
+void CacheArchive::operator()(IDSZ2& value)
+{
+    uint32_t temporary = value.toUint32();
+    (*this)(temporary);
+    value = IDSZ2(temporary);
+}
+
+void CacheArchive::operator()(LocalParticleProfileRef& value)
+{
+    int temporary = value.get();
+    (*this)(temporary);
+    value = LocalParticleProfileRef(temporary);
+}
+
+CacheFile::CacheFile(const std::string& directory, const std::string& extension, uint32_t version) :
+    _directory(directory),
+    _extension(extension),
+    _version(version)
+{
+    //ctor
+}
+
+uint64_t CacheFile::hashBytes(const char *data, size_t length)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string CacheFile::getCachePathname(const std::string& sourcePathname) const
+{
+    char name[17];
+    snprintf(name, SDL_arraysize(name), "%016llx", static_cast<unsigned long long>(hashBytes(sourcePathname.data(), sourcePathname.size())));
+    return _directory + "/" + name + "." + _extension;
+}
+
+bool CacheFile::load(const std::string& sourcePathname, const Transfer& transfer) const
+{
+    const int64_t modificationTime = vfs_getLastModTime(sourcePathname);
+    if (modificationTime < 0) {
+        return false;
+    }
+
+    char *data = nullptr;
+    size_t length = 0;
+    {
+        std::lock_guard<std::mutex> lock(s_fileMutex);
+        if (!vfs_readEntireFile(getCachePathname(sourcePathname), &data, &length)) {
+            return false;
+        }
+    }
+
+    const bool hit = decode(sourcePathname, modificationTime, data, length, transfer);
+    std::free(data);
+    return hit;
+}
+
+bool CacheFile::store(const std::string& sourcePathname, const Transfer& transfer) const
+{
+    const int64_t modificationTime = vfs_getLastModTime(sourcePathname);
+    if (modificationTime < 0) {
+        return false;
+    }
+
+    const std::vector<char> data = encode(sourcePathname, modificationTime, transfer);
+
+    std::lock_guard<std::mutex> lock(s_fileMutex);
+    return vfs_writeEntireFile(getCachePathname(sourcePathname), data.data(), data.size());
+}
+
+std::vector<char> CacheFile::encode(const std::string& sourcePathname, int64_t modificationTime, const Transfer& transfer) const
+{
+    CacheArchive values;
+    transfer(values);
+
+    CacheArchive archive;
+    uint32_t magic = MAGIC, version = _version;
+    std::string pathname = sourcePathname;
+    uint64_t checksum = hashBytes(values.getData().data(), values.getData().size());
+    archive(magic);
+    archive(version);
+    archive(modificationTime);
+    archive(pathname);
+    archive(checksum);
+
+    std::vector<char> data = archive.getData();
+    data.insert(data.end(), values.getData().begin(), values.getData().end());
+    return data;
+}
+
+bool CacheFile::decode(const std::string& sourcePathname, int64_t modificationTime, const char *data, size_t length, const Transfer& transfer) const
+{
+    CacheArchive archive(data, length);
+    uint32_t magic = 0, version = 0;
+    int64_t cachedModificationTime = -1;
+    std::string cachedSourcePathname;
+    uint64_t checksum = 0;
+    archive(magic);
+    archive(version);
+    archive(cachedModificationTime);
+    archive(cachedSourcePathname);
+    archive(checksum);
+
+    bool hit = archive.isGood() && MAGIC == magic && _version == version
+            && modificationTime == cachedModificationTime && sourcePathname == cachedSourcePathname
+            && checksum == hashBytes(data + length - archive.getRemainingSize(), archive.getRemainingSize());
+    if (hit) {
+        transfer(archive);
+        hit = archive.isGood() && 0 == archive.getRemainingSize();
+    }
+    return hit;
+}
+
+} // namespace Ego
@@ -0,0 +1,276 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/FileFormats/CacheFile.hpp
+/// @brief  Versioned binary caches of parsed data files
+/// @details Parsing the text files of the game data is slow compared to copying the parsed values
+///          back out of a binary file. A cache file holds the result of parsing a single source
+///          file and is only used as long as the source file has not been modified.
+
+#pragma once
+
+#include "egolib/typedef.h"
+#include "egolib/IDSZ.hpp"
+#include "egolib/Profiles/LocalParticleProfileRef.hpp"
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  Transfers values to or from a binary buffer. The same sequence of calls is used for writing
+ *  and for reading, hence a single <tt>transfer(CacheArchive&)</tt> function per type describes
+ *  its cached layout.
+ * @remark
+ *  Values are stored in the byte order of the machine, cache files are not portable.
+ * @remark
+ *  If a read runs past the end of the buffer, all further reads yield zeroes and
+ *  isGood() returns @a false.
+ */
+class CacheArchive : public Id::NonCopyable
+{
+public:
+    /**
+     * @brief
+     *  Construct an archive writing into an internal buffer.
+     */
+    CacheArchive();
+
+    /**
+     * @brief
+     *  Construct an archive reading from a buffer.
+     * @param data, length
+     *  the buffer. It must outlive this archive.
+     */
+    CacheArchive(const char *data, size_t length);
+
+    /**
+     * @return
+     *  @a true if this archive reads, @a false if it writes
+     */
+    bool isReading() const
+    {
+        return nullptr != _cursor;
+    }
+
+    /**
+     * @return
+     *  @a false if a read ran past the end of the buffer
+     */
+    bool isGood() const
+    {
+        return _good;
+    }
+
+    /**
+     * @brief
+     *  Mark the data read as invalid, e.g. because a value is out of range.
+     */
+    void fail()
+    {
+        _good = false;
+    }
+
+    /**
+     * @return
+     *  the number of Bytes not read yet
+     */
+    size_t getRemainingSize() const
+    {
+        return static_cast<size_t>(_end - _cursor);
+    }
+
+    /**
+     * @return
+     *  the Bytes written so far
+     */
+    const std::vector<char>& getData() const
+    {
+        return _data;
+    }
+
+    /**
+     * @brief
+     *  Transfer raw Bytes.
+     */
+    void bytes(void *value, size_t size);
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type operator()(T& value)
+    {
+        bytes(&value, sizeof(T));
+    }
+
+    void operator()(std::string& value);
+    void operator()(IPair& value);
+    void operator()(FRange& value);
+    void operator()(IDSZ2& value);
+    void operator()(LocalParticleProfileRef& value);
+
+    /// Aggregates describe themselves through a <tt>transfer(CacheArchive&)</tt> member function.
+    template <typename T>
+    typename std::enable_if<std::is_class<T>::value>::type operator()(T& value)
+    {
+        value.transfer(*this);
+    }
+
+    template <typename T, size_t N>
+    void operator()(T (&values)[N])
+    {
+        for (T& value : values) (*this)(value);
+    }
+
+    template <typename T, size_t N>
+    void operator()(std::array<T, N>& values)
+    {
+        for (T& value : values) (*this)(value);
+    }
+
+    template <size_t N>
+    void operator()(std::bitset<N>& values)
+    {
+        for (size_t i = 0; i < N; ++i) {
+            bool value = values[i];
+            (*this)(value);
+            values[i] = value;
+        }
+    }
+
+    template <typename K, typename V>
+    void operator()(std::unordered_map<K, V>& values)
+    {
+        uint32_t size = static_cast<uint32_t>(values.size());
+        (*this)(size);
+        if (isReading()) {
+            values.clear();
+            for (uint32_t i = 0; i < size && _good; ++i) {
+                K key = K();
+                (*this)(key);
+                (*this)(values[key]);
+            }
+        } else {
+            for (auto& pair : values) {
+                K key = pair.first;
+                (*this)(key);
+                (*this)(pair.second);
+            }
+        }
+    }
+
+private:
+    const char *_cursor;
+    const char *_end;
+    bool _good;
+    std::vector<char> _data;
+};
+
+/**
+ * @brief
+ *  A directory of cache files. Every source file has at most one cache file, named after a hash of
+ *  the source pathname. A cache file records the format version, the source pathname and the
+ *  modification time of the source file it was created from and is ignored if any of them differ.
+ *  A checksum of the cached values guards against damaged cache files.
+ */
+class CacheFile
+{
+public:
+    typedef std::function<void(CacheArchive&)> Transfer;
+
+    /**
+     * @brief
+     *  Construct this cache.
+     * @param directory
+     *  the VFS pathname of the directory the cache files are stored in, relative to the write directory
+     * @param extension
+     *  the file extension of the cache files
+     * @param version
+     *  the format version. Must be changed whenever the layout of the cached data changes.
+     */
+    CacheFile(const std::string& directory, const std::string& extension, uint32_t version);
+
+    /**
+     * @brief
+     *  Restore the values parsed from a source file.
+     * @param sourcePathname
+     *  the VFS pathname of the source file
+     * @param transfer
+     *  a function transferring the cached values. It is only called for an intact cache file.
+     * @return
+     *  @a true on a cache hit, @a false otherwise
+     */
+    bool load(const std::string& sourcePathname, const Transfer& transfer) const;
+
+    /**
+     * @brief
+     *  Store the values parsed from a source file.
+     * @param sourcePathname
+     *  the VFS pathname of the source file
+     * @param transfer
+     *  a function transferring the values to cache
+     * @return
+     *  @a true on success, @a false on failure
+     */
+    bool store(const std::string& sourcePathname, const Transfer& transfer) const;
+
+    /**
+     * @brief
+     *  Encode the contents of a cache file.
+     * @param sourcePathname, modificationTime
+     *  the VFS pathname and the modification time of the source file
+     * @param transfer
+     *  a function transferring the values to cache
+     * @return
+     *  the contents of the cache file
+     */
+    std::vector<char> encode(const std::string& sourcePathname, int64_t modificationTime, const Transfer& transfer) const;
+
+    /**
+     * @brief
+     *  Decode the contents of a cache file.
+     * @param sourcePathname, modificationTime
+     *  the VFS pathname and the current modification time of the source file
+     * @param data, length
+     *  the contents of the cache file
+     * @param transfer
+     *  a function transferring the cached values. It is only called if the cache file is intact
+     *  and neither the format version, the source pathname nor the modification time differ.
+     * @return
+     *  @a true on a cache hit, @a false otherwise
+     */
+    bool decode(const std::string& sourcePathname, int64_t modificationTime, const char *data, size_t length, const Transfer& transfer) const;
+
+    /**
+     * @return
+     *  the VFS pathname of the cache file of a source file
+     */
+    std::string getCachePathname(const std::string& sourcePathname) const;
+
+    /**
+     * @return
+     *  the 64 bit FNV-1a hash of a sequence of Bytes
+     */
+    static uint64_t hashBytes(const char *data, size_t length);
+
+private:
+    std::string _directory;
+    std::string _extension;
+    uint32_t _version;
+};
+
+} // namespace Ego
@@ -0,0 +1,289 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/FileFormats/Replay.cpp
+/// @brief Recording and playback of the player latches of a module session
+
+#include "egolib/FileFormats/Replay.hpp"
+#include "egolib/Log/_Include.hpp"
+
+namespace Ego
+{
+
+static const char REPLAY_MAGIC[4] = {'E', 'G', 'O', 'R'};
+
+const uint8_t Replay::VERSION;
+const size_t Replay::MAX_PLAYERS;
+
+static void writeUint32(std::vector<uint8_t>& buffer, const uint32_t value)
+{
+    buffer.push_back(static_cast<uint8_t>(value));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+    buffer.push_back(static_cast<uint8_t>(value >> 16));
+    buffer.push_back(static_cast<uint8_t>(value >> 24));
+}
+
+static void writeFloat(std::vector<uint8_t>& buffer, const float value)
+{
+    //Bit exact, a replay must reproduce the very same latches
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeUint32(buffer, bits);
+}
+
+static void writeString(std::vector<uint8_t>& buffer, const std::string& value)
+{
+    const size_t length = std::min<size_t>(value.length(), 0xFFFF);
+    buffer.push_back(static_cast<uint8_t>(length));
+    buffer.push_back(static_cast<uint8_t>(length >> 8));
+    buffer.insert(buffer.end(), value.begin(), value.begin() + length);
+}
+
+Replay::Replay() :
+    _latches()
+{
+    //ctor
+}
+
+bool Replay::equal(const latch_t& a, const latch_t& b)
+{
+    return 0 == std::memcmp(&a.x, &b.x, sizeof(float))
+        && 0 == std::memcmp(&a.y, &b.y, sizeof(float))
+        && a.b == b.b;
+}
+
+ReplayRecorder::ReplayRecorder() :
+    Replay(),
+    _file(nullptr),
+    _buffer(),
+    _current(),
+    _changed(0),
+    _ticks(0)
+{
+    //ctor
+}
+
+ReplayRecorder::ReplayRecorder(const std::string& pathname) :
+    Replay(),
+    _file(nullptr),
+    _buffer(),
+    _current(),
+    _changed(0),
+    _ticks(0)
+{
+    const size_t separator = pathname.find_last_of('/');
+    if (separator != std::string::npos && separator > 0) {
+        vfs_mkdir(pathname.substr(0, separator));
+    }
+    _file = vfs_openWrite(pathname);
+    if (!_file) {
+        throw std::runtime_error("unable to open replay file `" + pathname + "` for writing");
+    }
+}
+
+ReplayRecorder::~ReplayRecorder()
+{
+    if (!_file) {
+        return;
+    }
+    flush();
+    vfs_close(_file);
+    Log::get().info("Recorded %u ticks of player input\n", _ticks);
+}
+
+void ReplayRecorder::begin(const std::string& moduleName, const uint32_t seed, const std::vector<std::string>& importPlayers)
+{
+    _buffer.insert(_buffer.end(), std::begin(REPLAY_MAGIC), std::end(REPLAY_MAGIC));
+    _buffer.push_back(VERSION);
+    writeString(_buffer, moduleName);
+    writeUint32(_buffer, seed);
+    _buffer.push_back(static_cast<uint8_t>(importPlayers.size()));
+    for (const std::string& importPlayer : importPlayers) {
+        writeString(_buffer, importPlayer);
+    }
+}
+
+void ReplayRecorder::recordLatch(const size_t player, const latch_t& latch)
+{
+    if (player >= MAX_PLAYERS) {
+        return;
+    }
+    _current[player] = latch;
+    if (!equal(latch, _latches[player])) {
+        _changed |= (1 << player);
+    }
+}
+
+void ReplayRecorder::endTick()
+{
+    _buffer.push_back(_changed);
+    for (size_t player = 0; player < MAX_PLAYERS; ++player) {
+        if (0 == (_changed & (1 << player))) {
+            continue;
+        }
+        const latch_t& latch = _current[player];
+        writeFloat(_buffer, latch.x);
+        writeFloat(_buffer, latch.y);
+        writeUint32(_buffer, static_cast<uint32_t>(latch.b.to_ulong()));
+        _latches[player] = latch;
+    }
+    _changed = 0;
+    _ticks++;
+
+    //Write in large chunks
+    if (_buffer.size() >= 4096) {
+        flush();
+    }
+}
+
+void ReplayRecorder::flush()
+{
+    //Recording into memory
+    if (!_file || _buffer.empty()) {
+        return;
+    }
+    if (vfs_write(_buffer.data(), 1, _buffer.size(), _file) != _buffer.size()) {
+        Log::get().warn("unable to write replay data\n");
+    }
+    _buffer.clear();
+}
+
+ReplayPlayback::ReplayPlayback(const std::string& pathname) :
+    Replay(),
+    _data(),
+    _position(0),
+    _moduleName(),
+    _seed(0),
+    _importPlayers(),
+    _ticks(0),
+    _truncated(false)
+{
+    vfs_FILE *file = vfs_openRead(pathname);
+    if (!file) {
+        throw std::runtime_error("unable to open replay file `" + pathname + "`");
+    }
+    std::array<uint8_t, 65536> chunk;
+    size_t count;
+    while ((count = vfs_read(chunk.data(), 1, chunk.size(), file)) > 0) {
+        _data.insert(_data.end(), chunk.begin(), chunk.begin() + count);
+    }
+    vfs_close(file);
+
+    readHeader("`" + pathname + "`");
+}
+
+ReplayPlayback::ReplayPlayback(const std::vector<uint8_t>& data) :
+    Replay(),
+    _data(data),
+    _position(0),
+    _moduleName(),
+    _seed(0),
+    _importPlayers(),
+    _ticks(0),
+    _truncated(false)
+{
+    readHeader("replay data");
+}
+
+void ReplayPlayback::readHeader(const std::string& name)
+{
+    if (_data.size() < sizeof(REPLAY_MAGIC) + 1 || 0 != std::memcmp(_data.data(), REPLAY_MAGIC, sizeof(REPLAY_MAGIC))) {
+        throw std::runtime_error(name + " is not a replay file");
+    }
+    _position = sizeof(REPLAY_MAGIC);
+    if (readUint8() != VERSION) {
+        throw std::runtime_error(name + " has an unsupported version");
+    }
+    _moduleName = readString();
+    _seed = readUint32();
+    const uint8_t importCount = readUint8();
+    for (uint8_t i = 0; i < importCount; ++i) {
+        _importPlayers.push_back(readString());
+    }
+}
+
+bool ReplayPlayback::nextTick()
+{
+    if (isFinished()) {
+        return false;
+    }
+    const uint8_t changed = _data[_position];
+    const size_t size = 1 + std::bitset<8>(changed).count() * 3 * sizeof(uint32_t);
+    if (_position + size > _data.size()) {
+        //The recording was interrupted in the middle of this record
+        _position = _data.size();
+        _truncated = true;
+        return false;
+    }
+    _position++;
+    for (size_t player = 0; player < MAX_PLAYERS; ++player) {
+        if (0 == (changed & (1 << player))) {
+            continue;
+        }
+        latch_t& latch = _latches[player];
+        const uint32_t x = readUint32(), y = readUint32();
+        std::memcpy(&latch.x, &x, sizeof(float));
+        std::memcpy(&latch.y, &y, sizeof(float));
+        latch.b = std::bitset<32>(readUint32());
+    }
+    _ticks++;
+    return true;
+}
+
+const latch_t& ReplayPlayback::getLatch(const size_t player) const
+{
+    static const latch_t none;
+    return player < MAX_PLAYERS ? _latches[player] : none;
+}
+
+uint8_t ReplayPlayback::readUint8()
+{
+    if (_position + 1 > _data.size()) {
+        throw std::runtime_error("truncated replay file");
+    }
+    return _data[_position++];
+}
+
+uint32_t ReplayPlayback::readUint32()
+{
+    if (_position + 4 > _data.size()) {
+        throw std::runtime_error("truncated replay file");
+    }
+    const uint32_t value = static_cast<uint32_t>(_data[_position])
+                         | static_cast<uint32_t>(_data[_position + 1]) << 8
+                         | static_cast<uint32_t>(_data[_position + 2]) << 16
+                         | static_cast<uint32_t>(_data[_position + 3]) << 24;
+    _position += 4;
+    return value;
+}
+
+std::string ReplayPlayback::readString()
+{
+    const size_t low = readUint8();
+    const size_t high = readUint8();
+    const size_t length = low | (high << 8);
+    if (_position + length > _data.size()) {
+        throw std::runtime_error("truncated replay file");
+    }
+    std::string value(reinterpret_cast<const char *>(_data.data() + _position), length);
+    _position += length;
+    return value;
+}
+
+} //namespace Ego
@@ -0,0 +1,212 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/FileFormats/Replay.hpp
+/// @brief Recording and playback of the player latches of a module session
+
+#pragma once
+
+#include "IdLib/IdLib.hpp"
+#include "egolib/input_device.h"
+#include "egolib/vfs.h"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   A replay file starts with a header (the module folder name, the random seed the module was
+*   started with and the saved characters imported into it) followed by one record per call of
+*   readPlayerInput(). A record is a byte whose bit @a i is set if the latch of player @a i
+*   changed, followed by the changed latches (raw x and y floats and the button bits, all little
+*   endian). An idle tick hence costs a single byte.
+* @remark
+*   Only the latches of the player objects are recorded. Actions players perform through the
+*   user interface (inventory screen, stealth toggle) are not part of the latch stream, and
+*   imported characters are referenced by their save folder, so they must not change between
+*   recording and playback.
+**/
+class Replay
+{
+public:
+    static const uint8_t VERSION = 1;
+
+    /// Number of players whose latches are recorded
+    static const size_t MAX_PLAYERS = 8;
+
+protected:
+    /// Latches as of the last record, per player
+    std::array<latch_t, MAX_PLAYERS> _latches;
+
+    Replay();
+
+    static bool equal(const latch_t& a, const latch_t& b);
+};
+
+/**
+* @brief
+*   Writes a replay file
+**/
+class ReplayRecorder : public Replay, public Id::NonCopyable
+{
+public:
+    /**
+    * @brief
+    *   Record into memory only, see getData().
+    **/
+    ReplayRecorder();
+
+    /**
+    * @brief
+    *   Open a replay file for writing.
+    * @param pathname
+    *   the VFS pathname of the file, e.g. "/replays/session.egr"
+    * @throw std::runtime_error
+    *   if the file can not be opened
+    **/
+    ReplayRecorder(const std::string& pathname);
+
+    /**
+    * @brief
+    *   Flush all pending records and close the replay file.
+    **/
+    ~ReplayRecorder();
+
+    /**
+    * @brief
+    *   Write the header. Must be called exactly once, before the first record.
+    **/
+    void begin(const std::string& moduleName, const uint32_t seed, const std::vector<std::string>& importPlayers);
+
+    /**
+    * @brief
+    *   Set the latch of a player for the current record
+    **/
+    void recordLatch(const size_t player, const latch_t& latch);
+
+    /**
+    * @brief
+    *   Finish the current record
+    **/
+    void endTick();
+
+    /**
+    * @return
+    *   the number of records written so far
+    **/
+    uint32_t getTickCount() const { return _ticks; }
+
+    /**
+    * @return
+    *   the bytes not written to the replay file yet, i.e. all bytes if recording into memory
+    **/
+    const std::vector<uint8_t>& getData() const { return _buffer; }
+
+private:
+    void flush();
+
+private:
+    vfs_FILE *_file;
+    std::vector<uint8_t> _buffer;           ///< Pending bytes
+    std::array<latch_t, MAX_PLAYERS> _current;
+    uint8_t _changed;                       ///< Bit mask of players whose latch changed in the current record
+    uint32_t _ticks;
+};
+
+/**
+* @brief
+*   Reads a replay file
+**/
+class ReplayPlayback : public Replay, public Id::NonCopyable
+{
+public:
+    /**
+    * @brief
+    *   Load a replay file and read its header.
+    * @param pathname
+    *   the VFS pathname of the file
+    * @throw std::runtime_error
+    *   if the file can not be read or is not a replay file
+    **/
+    ReplayPlayback(const std::string& pathname);
+
+    /**
+    * @brief
+    *   Play back a replay held in memory.
+    * @param data
+    *   the bytes of the replay
+    * @throw std::runtime_error
+    *   if the data is not a replay
+    **/
+    ReplayPlayback(const std::vector<uint8_t>& data);
+
+    const std::string& getModuleName() const { return _moduleName; }
+    uint32_t getSeed() const { return _seed; }
+    const std::vector<std::string>& getImportPlayers() const { return _importPlayers; }
+
+    /**
+    * @brief
+    *   Advance to the next record
+    * @return
+    *   @a false if there are no more records. A truncated last record, e.g. of a replay whose
+    *   recording was interrupted, ends the playback as well.
+    **/
+    bool nextTick();
+
+    /**
+    * @return
+    *   the latch of a player as of the current record
+    **/
+    const latch_t& getLatch(const size_t player) const;
+
+    /**
+    * @return
+    *   @a true if all records have been played back
+    **/
+    bool isFinished() const { return _position >= _data.size(); }
+
+    /**
+    * @return
+    *   the number of records played back so far
+    **/
+    uint32_t getTickCount() const { return _ticks; }
+
+    /**
+    * @return
+    *   @a true if the playback ended at a truncated record
+    **/
+    bool isTruncated() const { return _truncated; }
+
+private:
+    void readHeader(const std::string& name);
+    uint8_t readUint8();
+    uint32_t readUint32();
+    std::string readString();
+
+private:
+    std::vector<uint8_t> _data;
+    size_t _position;
+    std::string _moduleName;
+    uint32_t _seed;
+    std::vector<std::string> _importPlayers;
+    uint32_t _ticks;
+    bool _truncated;
+};
+
+} //namespace Ego
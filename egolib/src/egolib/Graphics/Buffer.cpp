@@ -25,7 +25,9 @@
 
 namespace Ego {
 
-Buffer::Buffer(size_t size) : size(size) {}
+Buffer::Buffer(size_t size) : size(size), invalidRanges(), bufferObject() {
+    invalidate();
+}
 
 Buffer::~Buffer() {}
 
@@ -33,4 +35,54 @@ size_t Buffer::getSize() const {
     return size;
 }
 
+void Buffer::invalidate(size_t offset, size_t size) {
+    if (offset > this->size || size > this->size - offset) {
+        throw std::invalid_argument("out of bounds");
+    }
+    if (0 == size) {
+        return;
+    }
+    size_t end = offset + size;
+    // The first range which ends at or after the beginning of the new range.
+    auto first = std::lower_bound(invalidRanges.begin(), invalidRanges.end(), offset,
+                                  [](const Range& range, size_t offset) { return range.offset + range.size < offset; });
+    // Merge all ranges which begin at or before the end of the new range.
+    auto last = first;
+    while (last != invalidRanges.end() && last->offset <= end) {
+        offset = std::min(offset, last->offset);
+        end = std::max(end, last->offset + last->size);
+        ++last;
+    }
+    first = invalidRanges.erase(first, last);
+    invalidRanges.insert(first, Range{offset, end - offset});
+}
+
+void Buffer::invalidate() {
+    invalidate(0, size);
+}
+
+const std::vector<Buffer::Range>& Buffer::getInvalidRanges() const {
+    return invalidRanges;
+}
+
+size_t Buffer::getInvalidSize() const {
+    size_t invalidSize = 0;
+    for (const auto& range : invalidRanges) {
+        invalidSize += range.size;
+    }
+    return invalidSize;
+}
+
+void Buffer::validate() {
+    invalidRanges.clear();
+}
+
+BufferObject *Buffer::getBufferObject() const {
+    return bufferObject.get();
+}
+
+void Buffer::setBufferObject(std::unique_ptr<BufferObject> bufferObject) {
+    this->bufferObject = std::move(bufferObject);
+}
+
 } // namespace Ego
@@ -21,15 +21,37 @@
 /// @brief Abstract base class of all buffers.
 /// @author Michael Heilmann
 
+#pragma once
+
 #include "egolib/platform.h"
 
 namespace Ego {
 
+/**
+ * @brief
+ *  The GPU-side copy of a buffer.
+ *  It is created by a renderer when the buffer is uploaded for the first time and owned by the buffer.
+ */
+class BufferObject : private Id::NonCopyable {
+public:
+    virtual ~BufferObject() {}
+};
+
 /**
  * @brief
  *  The abstract base class of all vertex- and index buffers.
  */
 class Buffer : private Id::NonCopyable {
+public:
+    /**
+     * @brief
+     *  A range of Bytes of a buffer.
+     */
+    struct Range {
+        size_t offset;
+        size_t size;
+    };
+
 private:
     /**
      * @brief
@@ -37,6 +59,19 @@ private:
      */
     size_t size;
 
+    /**
+     * @brief
+     *  The ranges of this buffer modified since the last upload.
+     *  Sorted by offset, overlapping and adjacent ranges are merged.
+     */
+    std::vector<Range> invalidRanges;
+
+    /**
+     * @brief
+     *  The GPU-side copy of this buffer or a null pointer.
+     */
+    std::unique_ptr<BufferObject> bufferObject;
+
 protected:
     /**
      * @brief
@@ -79,6 +114,65 @@ public:
      */
     virtual void unlock() = 0;
 
+    /**
+     * @brief
+     *  Mark a range of this buffer as modified, i.e. the range has to be uploaded again.
+     * @param offset, size
+     *  the offset and the size, in Bytes, of the range
+     * @throw std::invalid_argument
+     *  if <tt>offset + size</tt> is greater than the size of this buffer
+     * @remark
+     *  The range is merged with overlapping and adjacent invalid ranges,
+     *  hence invalidating neighbouring ranges results in a single upload.
+     */
+    void invalidate(size_t offset, size_t size);
+
+    /**
+     * @brief
+     *  Mark this buffer as modified.
+     */
+    void invalidate();
+
+    /**
+     * @brief
+     *  Get the ranges of this buffer modified since the last upload.
+     * @return
+     *  the ranges of this buffer modified since the last upload, sorted by offset
+     * @remark
+     *  A new buffer is invalid as a whole.
+     */
+    const std::vector<Range>& getInvalidRanges() const;
+
+    /**
+     * @brief
+     *  Get the size, in Bytes, of the ranges of this buffer modified since the last upload.
+     * @return
+     *  the size, in Bytes, of the ranges of this buffer modified since the last upload
+     */
+    size_t getInvalidSize() const;
+
+    /**
+     * @brief
+     *  Mark this buffer as uploaded.
+     */
+    void validate();
+
+    /**
+     * @brief
+     *  Get the GPU-side copy of this buffer.
+     * @return
+     *  the GPU-side copy of this buffer or a null pointer if this buffer was not uploaded yet
+     */
+    BufferObject *getBufferObject() const;
+
+    /**
+     * @brief
+     *  Set the GPU-side copy of this buffer.
+     * @param bufferObject
+     *  the GPU-side copy of this buffer
+     */
+    void setBufferObject(std::unique_ptr<BufferObject> bufferObject);
+
 }; // class Buffer
 
 /**
@@ -84,6 +84,14 @@ public:
     const IndexDescriptor& operator=(const IndexDescriptor& other) noexcept;
 
 public:
+    /**
+     * @brief Get the syntax of an index.
+     * @return the syntax of an index
+     */
+    Syntax getSyntax() const {
+        return syntax;
+    }
+
     /**
      * @brief Get the size, in Bytes, of an index.
      * @return the size, in Bytes, of an index
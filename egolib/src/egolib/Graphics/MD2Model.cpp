@@ -47,27 +47,41 @@ float MD2Model::getMD2Normal(size_t normal, size_t index)
 	return MD2_NORMALS[normal][index];
 }
 
+/// The horizontal environment map coordinate of a normal
+static float getEnvironmentU(size_t normal)
+{
+    return std::atan2(MD2_NORMALS[normal][1], MD2_NORMALS[normal][0]) * Ego::Math::invTwoPi<float>();
+}
+
 void MD2Model::scaleModel(const float scaleX, const float scaleY, const float scaleZ)
 {
     for(MD2_Frame &frame : _frames)
     {
         bool boundingBoxFound = false;
 
-        for(MD2_Vertex& vertex : frame.vertexList)
+        MD2_VertexArrays &vertices = frame.vertices;
+        float *posX = vertices.get(MD2_VertexArrays::PositionX);
+        float *posY = vertices.get(MD2_VertexArrays::PositionY);
+        float *posZ = vertices.get(MD2_VertexArrays::PositionZ);
+        float *nrmX = vertices.get(MD2_VertexArrays::NormalX);
+        float *nrmY = vertices.get(MD2_VertexArrays::NormalY);
+        float *nrmZ = vertices.get(MD2_VertexArrays::NormalZ);
+
+        for(size_t i = 0; i < vertices.size(); ++i)
         {
             oct_vec_v2_t opos;
 
-            vertex.pos[kX] *= scaleX;
-            vertex.pos[kY] *= scaleY;
-            vertex.pos[kZ] *= scaleZ;
-
-            std::copysign(vertex.nrm[kX], scaleX);
-            std::copysign(vertex.nrm[kY], scaleY);
-            std::copysign(vertex.nrm[kZ], scaleZ);
+            posX[i] *= scaleX;
+            posY[i] *= scaleY;
+            posZ[i] *= scaleZ;
 
-			vertex.nrm.normalize();
+            Vector3f nrm(nrmX[i], nrmY[i], nrmZ[i]);
+			nrm.normalize();
+            nrmX[i] = nrm[kX];
+            nrmY[i] = nrm[kY];
+            nrmZ[i] = nrm[kZ];
 
-            opos = oct_vec_v2_t(vertex.pos);
+            opos = oct_vec_v2_t(Vector3f(posX[i], posY[i], posZ[i]));
 
             // Re-calculate the bounding box for this frame
             if (!boundingBoxFound)
@@ -80,6 +94,7 @@ void MD2Model::scaleModel(const float scaleX, const float scaleY, const float sc
                 frame.bb.join(opos);
             }
         }
+        vertices.pad();
 #if 0
         // we don't really want objects that have extent in more than one
         // dimension to be called empty
@@ -104,10 +119,11 @@ void MD2Model::makeEquallyLit()
 {
 	for(MD2_Frame &frame : _frames)
 	{
-	    for(MD2_Vertex &vertex : frame.vertexList)
-	    {
-	        vertex.normal = EGO_NORMAL_COUNT-1;
-	    }
+	    // the "equal light" normal
+	    MD2_VertexArrays &vertices = frame.vertices;
+	    float *envU = vertices.get(MD2_VertexArrays::EnvironmentU);
+	    std::fill(envU, envU + vertices.size(), getEnvironmentU(EGO_NORMAL_COUNT-1));
+	    vertices.pad();
 	}
 }
 
@@ -168,7 +184,7 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
 
     for(MD2_Frame &frame : model->_frames)
     {
-    	frame.vertexList.resize(md2Header.num_vertices);
+    	frame.vertices.resize(md2Header.num_vertices);
     }
 
     // Load the texture coordinates from the file, normalizing them as we go
@@ -226,8 +242,17 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
 #endif
 
         // unpack the md2 vertex_lst from this frame
+        MD2_VertexArrays &vertices = frame.vertices;
+        float *posX = vertices.get(MD2_VertexArrays::PositionX);
+        float *posY = vertices.get(MD2_VertexArrays::PositionY);
+        float *posZ = vertices.get(MD2_VertexArrays::PositionZ);
+        float *nrmX = vertices.get(MD2_VertexArrays::NormalX);
+        float *nrmY = vertices.get(MD2_VertexArrays::NormalY);
+        float *nrmZ = vertices.get(MD2_VertexArrays::NormalZ);
+        float *envU = vertices.get(MD2_VertexArrays::EnvironmentU);
+
         bool boundingBoxFound = false;
-        for(MD2_Vertex &vertex : frame.vertexList)
+        for(size_t i = 0; i < vertices.size(); ++i)
         {
             oct_vec_v2_t ovec;
             id_md2_vertex_t frame_vert;
@@ -236,23 +261,24 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
             vfs_read(&frame_vert, sizeof( id_md2_vertex_t ), 1, f);
 
             // grab the vertex position
-            vertex.pos[kX] = frame_vert.v[0] * frame_header.scale[0] + frame_header.translate[0];
-            vertex.pos[kY] = frame_vert.v[1] * frame_header.scale[1] + frame_header.translate[1];
-            vertex.pos[kZ] = frame_vert.v[2] * frame_header.scale[2] + frame_header.translate[2];
+            posX[i] = frame_vert.v[0] * frame_header.scale[0] + frame_header.translate[0];
+            posY[i] = frame_vert.v[1] * frame_header.scale[1] + frame_header.translate[1];
+            posZ[i] = frame_vert.v[2] * frame_header.scale[2] + frame_header.translate[2];
 
             // grab the normal index
-            vertex.normal = frame_vert.normalIndex;
-            if (vertex.normal > MD2_MAX_NORMALS) {
-            	vertex.normal = MD2_MAX_NORMALS;
+            size_t normal = frame_vert.normalIndex;
+            if (normal > MD2_MAX_NORMALS) {
+            	normal = MD2_MAX_NORMALS;
             }
 
-            // expand the normal index into an actual normal
-            vertex.nrm[kX] = MD2_NORMALS[frame_vert.normalIndex][0];
-            vertex.nrm[kY] = MD2_NORMALS[frame_vert.normalIndex][1];
-            vertex.nrm[kZ] = MD2_NORMALS[frame_vert.normalIndex][2];
+            // expand the normal index into an actual normal and its environment map coordinate
+            nrmX[i] = MD2_NORMALS[normal][0];
+            nrmY[i] = MD2_NORMALS[normal][1];
+            nrmZ[i] = MD2_NORMALS[normal][2];
+            envU[i] = getEnvironmentU(normal);
 
             // Calculate the bounding box for this frame
-            ovec = oct_vec_v2_t(vertex.pos);
+            ovec = oct_vec_v2_t(Vector3f(posX[i], posY[i], posZ[i]));
             if (!boundingBoxFound)
             {
                 frame.bb = oct_bb_t(ovec);
@@ -263,6 +289,7 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
                 frame.bb.join(ovec);
             }
         }
+        vertices.pad();
 
         //make sure to copy the frame name!
         strncpy(frame.name, frame_header.name, 16);
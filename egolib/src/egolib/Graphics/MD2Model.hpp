@@ -23,28 +23,13 @@
 
 #include "egolib/FileFormats/id_md2.h"
 #include "egolib/bbox.h"
+#include "egolib/Graphics/MD2VertexArrays.hpp"
 
 static constexpr size_t EGO_NORMAL_COUNT = MD2_MAX_NORMALS + 1;
 
 typedef id_md2_skin_t MD2_SkinName;
 typedef id_md2_triangle_t MD2_Triangle;
 
-class MD2_Vertex
-{
-public:
-	MD2_Vertex() :
-		pos(0.0f, 0.0f, 0.0f),
-		nrm(0.0f, 0.0f, 0.0f),
-		normal(0)
-	{
-		//ctor
-	}
-
-	Vector3f pos;
-	Vector3f nrm;
-    size_t   normal;  ///< index to id-normal array
-};
-
 class MD2_TexCoord
 {
 public:
@@ -80,7 +65,7 @@ public:
 #if 0
 		name(),
 #endif
-		vertexList(),
+		vertices(),
 		bb(),
 		framelip(0),
 		framefx(EMPTY_BIT_FIELD)
@@ -90,7 +75,7 @@ public:
 
     char name[16];
 
-    std::vector<MD2_Vertex> vertexList;
+    MD2_VertexArrays vertices;  ///< the vertices of this frame, see MD2_VertexArrays::interpolate()
 
     oct_bb_t bb;        ///< axis-aligned octagonal bounding box limits
     int framelip;       ///< the position in the current animation
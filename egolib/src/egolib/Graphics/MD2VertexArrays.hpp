@@ -0,0 +1,276 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/MD2VertexArrays.hpp
+/// @brief  Structure of arrays storage of MD2 frame vertices and the vertex interpolation kernels
+
+#pragma once
+
+#include "IdLib/IdLib.hpp"
+#include <cstddef>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define EGO_MD2_INTERPOLATION_SSE 1
+    #include <xmmintrin.h>
+#endif
+
+/**
+ * @brief
+ *  The vertices of an MD2 frame stored as one array per component.
+ *  Every array is padded to a multiple of BLOCK_SIZE entries with copies of the last vertex,
+ *  hence kernels may always load whole blocks of vertices.
+ */
+class MD2_VertexArrays
+{
+public:
+    enum Component
+    {
+        PositionX,
+        PositionY,
+        PositionZ,
+        NormalX,
+        NormalY,
+        NormalZ,
+        EnvironmentU,   ///< The horizontal environment map coordinate derived from the MD2 normal index
+        ComponentCount,
+    };
+
+    /// The number of vertices the arrays are padded to a multiple of, large enough for 8-wide kernels
+    static constexpr size_t BLOCK_SIZE = 8;
+
+    MD2_VertexArrays() :
+        _size(0),
+        _stride(0),
+        _data()
+    {
+        //ctor
+    }
+
+    /**
+     * @brief
+     *  Resize the arrays to @a size vertices, all components are zero.
+     */
+    void resize(size_t size)
+    {
+        _size = size;
+        _stride = (size + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        _data.assign(_stride * ComponentCount, 0.0f);
+    }
+
+    /**
+     * @brief
+     *  Copy the last vertex into the padding. Call after the vertices were modified.
+     */
+    void pad()
+    {
+        if (0 == _size) return;
+        for (size_t component = 0; component < ComponentCount; ++component)
+        {
+            float *array = &_data[component * _stride];
+            std::fill(array + _size, array + _stride, array[_size - 1]);
+        }
+    }
+
+    /**
+     * @return
+     *  the number of vertices
+     */
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @return
+     *  the array of a component
+     */
+    float *get(Component component)
+    {
+        return _data.data() + component * _stride;
+    }
+
+    const float *get(Component component) const
+    {
+        return _data.data() + component * _stride;
+    }
+
+    /**
+     * @brief
+     *  Interpolate the vertices @a begin (inclusive) to @a end (exclusive) between two frames.
+     * @param destination
+     *  the destination vertices. A vertex type must have the members <tt>float pos[4]</tt>,
+     *  <tt>float nrm[3]</tt> and <tt>float env[2]</tt>.
+     * @remark
+     *  <tt>pos[3]</tt> is set to @a 1, <tt>env[1]</tt> is derived from the interpolated normal.
+     *  Uses the SSE kernel if available and the scalar kernel otherwise.
+     */
+    template <typename Vertex>
+    static void interpolate(Vertex *destination, const MD2_VertexArrays& last, const MD2_VertexArrays& next,
+                            size_t begin, size_t end, float flip)
+    {
+#if defined(EGO_MD2_INTERPOLATION_SSE)
+        interpolateSSE(destination, last, next, begin, end, flip);
+#else
+        interpolateScalar(destination, last, next, begin, end, flip);
+#endif
+    }
+
+    /**
+     * @brief
+     *  The portable kernel of interpolate().
+     */
+    template <typename Vertex>
+    static void interpolateScalar(Vertex *destination, const MD2_VertexArrays& last, const MD2_VertexArrays& next,
+                                  size_t begin, size_t end, float flip)
+    {
+        const float *lastPosX = last.get(PositionX), *nextPosX = next.get(PositionX);
+        const float *lastPosY = last.get(PositionY), *nextPosY = next.get(PositionY);
+        const float *lastPosZ = last.get(PositionZ), *nextPosZ = next.get(PositionZ);
+        const float *lastNrmX = last.get(NormalX), *nextNrmX = next.get(NormalX);
+        const float *lastNrmY = last.get(NormalY), *nextNrmY = next.get(NormalY);
+        const float *lastNrmZ = last.get(NormalZ), *nextNrmZ = next.get(NormalZ);
+        const float *lastEnvU = last.get(EnvironmentU), *nextEnvU = next.get(EnvironmentU);
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            Vertex &vertex = destination[i];
+            vertex.pos[0] = lastPosX[i] + (nextPosX[i] - lastPosX[i]) * flip;
+            vertex.pos[1] = lastPosY[i] + (nextPosY[i] - lastPosY[i]) * flip;
+            vertex.pos[2] = lastPosZ[i] + (nextPosZ[i] - lastPosZ[i]) * flip;
+            vertex.pos[3] = 1.0f;
+
+            vertex.nrm[0] = lastNrmX[i] + (nextNrmX[i] - lastNrmX[i]) * flip;
+            vertex.nrm[1] = lastNrmY[i] + (nextNrmY[i] - lastNrmY[i]) * flip;
+            vertex.nrm[2] = lastNrmZ[i] + (nextNrmZ[i] - lastNrmZ[i]) * flip;
+
+            vertex.env[0] = lastEnvU[i] + (nextEnvU[i] - lastEnvU[i]) * flip;
+            vertex.env[1] = 0.5f * (1.0f + vertex.nrm[2]);
+        }
+    }
+
+#if defined(EGO_MD2_INTERPOLATION_SSE)
+    /**
+     * @brief
+     *  The SSE kernel of interpolate(), processes four vertices at a time.
+     * @remark
+     *  Computes the same values as interpolateScalar(). Blocks start at multiples of four, so
+     *  together with the padding no load goes past the end of the arrays. Vertices of a block
+     *  outside of [begin, end) are not stored.
+     */
+    template <typename Vertex>
+    static void interpolateSSE(Vertex *destination, const MD2_VertexArrays& last, const MD2_VertexArrays& next,
+                               size_t begin, size_t end, float flip)
+    {
+        const __m128 f = _mm_set1_ps(flip);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        const float *lastComponents[ComponentCount], *nextComponents[ComponentCount];
+        for (size_t component = 0; component < ComponentCount; ++component)
+        {
+            lastComponents[component] = last.get(Component(component));
+            nextComponents[component] = next.get(Component(component));
+        }
+
+        for (size_t i = begin & ~size_t(3); i < end; i += 4)
+        {
+            __m128 value[ComponentCount];
+            for (size_t component = 0; component < ComponentCount; ++component)
+            {
+                const __m128 a = _mm_loadu_ps(lastComponents[component] + i);
+                const __m128 b = _mm_loadu_ps(nextComponents[component] + i);
+                value[component] = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), f));
+            }
+            __m128 environmentV = _mm_mul_ps(half, _mm_add_ps(one, value[NormalZ]));
+
+            // turn the components of four vertices into four vertices
+            __m128 position0 = value[PositionX], position1 = value[PositionY], position2 = value[PositionZ], position3 = one;
+            _MM_TRANSPOSE4_PS(position0, position1, position2, position3);
+            __m128 normal0 = value[NormalX], normal1 = value[NormalY], normal2 = value[NormalZ], normal3 = value[EnvironmentU];
+            _MM_TRANSPOSE4_PS(normal0, normal1, normal2, normal3);
+
+            const size_t first = std::max(begin, i) - i;
+            const size_t count = std::min<size_t>(4, end - i);
+            if (0 == first && 4 == count)
+            {
+                // whole vertex positions, the normal and the first environment coordinate if they are adjacent
+                _mm_storeu_ps(destination[i + 0].pos, position0);
+                _mm_storeu_ps(destination[i + 1].pos, position1);
+                _mm_storeu_ps(destination[i + 2].pos, position2);
+                _mm_storeu_ps(destination[i + 3].pos, position3);
+                if (offsetof(Vertex, env) == offsetof(Vertex, nrm) + 3 * sizeof(float))
+                {
+                    storeNormal(destination[i + 0], normal0);
+                    storeNormal(destination[i + 1], normal1);
+                    storeNormal(destination[i + 2], normal2);
+                    storeNormal(destination[i + 3], normal3);
+
+                    alignas(16) float environmentVs[4];
+                    _mm_store_ps(environmentVs, environmentV);
+                    destination[i + 0].env[1] = environmentVs[0];
+                    destination[i + 1].env[1] = environmentVs[1];
+                    destination[i + 2].env[1] = environmentVs[2];
+                    destination[i + 3].env[1] = environmentVs[3];
+                    continue;
+                }
+            }
+
+            alignas(16) float positions[4][4], normals[4][4], environmentVs[4];
+            _mm_store_ps(positions[0], position0);
+            _mm_store_ps(positions[1], position1);
+            _mm_store_ps(positions[2], position2);
+            _mm_store_ps(positions[3], position3);
+            _mm_store_ps(normals[0], normal0);
+            _mm_store_ps(normals[1], normal1);
+            _mm_store_ps(normals[2], normal2);
+            _mm_store_ps(normals[3], normal3);
+            _mm_store_ps(environmentVs, environmentV);
+
+            for (size_t j = first; j < count; ++j)
+            {
+                Vertex &vertex = destination[i + j];
+                vertex.pos[0] = positions[j][0];
+                vertex.pos[1] = positions[j][1];
+                vertex.pos[2] = positions[j][2];
+                vertex.pos[3] = positions[j][3];
+
+                vertex.nrm[0] = normals[j][0];
+                vertex.nrm[1] = normals[j][1];
+                vertex.nrm[2] = normals[j][2];
+
+                vertex.env[0] = normals[j][3];
+                vertex.env[1] = environmentVs[j];
+            }
+        }
+    }
+
+private:
+    /// Store a normal and the first environment coordinate, which follows the normal in the vertex
+    template <typename Vertex>
+    static void storeNormal(Vertex& vertex, __m128 value)
+    {
+        _mm_storeu_ps(reinterpret_cast<float *>(reinterpret_cast<char *>(&vertex) + offsetof(Vertex, nrm)), value);
+    }
+#endif
+
+private:
+    size_t _size;
+    size_t _stride;             ///< The padded number of vertices
+    std::vector<float> _data;   ///< The arrays of all components, one after another
+};
@@ -23,28 +23,49 @@
 #include "egolib/_math.h"
 #include "egolib/fileutil.h"
 #include "egolib/Graphics/TextureManager.hpp"
+#include "egolib/Renderer/Null/Texture.hpp"
+#include "egolib/Core/System.hpp"
+#include "egolib/Extensions/SDL_GL_extensions.h"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
 TextureManager::TextureManager() :
+    _headless(Ego::Core::System::get().isHeadless()),
+    _unload(),
+    _textureCache(),
+    _placeholderTexture(),
     _deferredLoadingMutex(),
-    _requestedLoadDeferredTextures(),
-    _notifyDeferredLoadingComplete()
+    _notifyDeferredLoadingComplete(),
+    // Reading and decoding images is mostly waiting for the disk, a couple of threads are enough.
+    _streamingQueue(_headless ? 0 : 2, &TextureManager::decode)
 {
-    Ego::OpenGL::initializeErrorTextures();
+    if (!_headless) {
+        Ego::OpenGL::initializeErrorTextures();
+        _placeholderTexture = std::make_shared<Ego::OpenGL::Texture>();
+        _placeholderTexture->load("<placeholder texture>", Ego::Graphics::SDL::createSurface(1, 1));
+    }
 }
 
 TextureManager::~TextureManager()
 {
+    _streamingQueue.clear();
+    _streamingQueue.wait();
     _textureCache.clear();
 	_unload.clear();
-    Ego::OpenGL::uninitializeErrorTextures();
+    _placeholderTexture = nullptr;
+    if (!_headless) {
+        Ego::OpenGL::uninitializeErrorTextures();
+    }
 }
 
 void TextureManager::release_all()
 {
-	if (SDL_GL_GetCurrentContext() != nullptr) {
+    // Textures still being streamed in are not needed anymore.
+    _streamingQueue.clear();
+
+    std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
+	if (_headless || SDL_GL_GetCurrentContext() != nullptr) {
 		// We are the main OpenGL context thread so we can destroy textures.
 		_textureCache.clear();
 		_unload.clear();
@@ -63,52 +84,101 @@ void TextureManager::reupload()
     // TODO
 }
 
-void TextureManager::updateDeferredLoading()
+TextureManager::DecodedImage TextureManager::decode(const std::string &filePath)
+{
+    DecodedImage image;
+    image.surface = ego_texture_decode_vfs(filePath, image.fullFilename);
+    return image;
+}
+
+void TextureManager::upload(const std::string &filePath, DecodedImage &&image)
+{
+    //Loaded synchronously in the meantime
+    if (_textureCache.find(filePath) != _textureCache.end()) return;
+
+    //A texture that can not be loaded is the error texture
+    std::shared_ptr<Ego::Texture> loadTexture = std::make_shared<Ego::OpenGL::Texture>();
+    if (!image.surface || !loadTexture->load(image.fullFilename, image.surface)) {
+        Log::get().warn("unable to load texture: %s\n", vfs_resolveReadFilename(filePath.c_str()));
+    }
+
+    std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
+    _textureCache[filePath] = loadTexture;
+    Log::get().debug("Deferred texture load: %s\n", filePath.c_str());
+}
+
+void TextureManager::updateDeferredLoading(const std::chrono::microseconds& budget)
 {
-    //If nothing to do, exit function immeadiately
-    if(_requestedLoadDeferredTextures.empty()) return;
+    //Upload the textures decoded by the worker threads until the time is up
+    const size_t uploaded = _streamingQueue.upload([this](const std::string &filePath, DecodedImage &&image) {
+        upload(filePath, std::move(image));
+    }, budget);
+
+    //Notify all waiting threads that loading progressed
+    if (uploaded > 0) {
+        _notifyDeferredLoadingComplete.notify_all();
+    }
+}
+
+std::shared_ptr<Ego::Texture> TextureManager::requestTexture(const std::string &filePath)
+{
+    //Without an OpenGL context there is nothing to stream
+    if(_headless) {
+        return getTexture(filePath);
+    }
 
-    //Load each texture that is required by another thread
     {
         std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
-        for(const std::string &filePath : _requestedLoadDeferredTextures) {
-            std::shared_ptr<Ego::Texture> loadTexture = std::make_shared<Ego::OpenGL::Texture>();
-            ego_texture_load_vfs(loadTexture, filePath.c_str());
-            _textureCache[filePath] = loadTexture;
-			Log::get().debug("Deferred texture load: %s\n", filePath.c_str());
+        auto result = _textureCache.find(filePath);
+        if(result != _textureCache.end()) {
+            return (*result).second;
         }
-        _requestedLoadDeferredTextures.clear();
     }
 
-    //Notify all waiting threads that loading is complete
-    _notifyDeferredLoadingComplete.notify_all();  
+    _streamingQueue.request(filePath);
+    return nullptr;
 }
 
-const std::shared_ptr<Ego::Texture>& TextureManager::getTexture(const std::string &filePath)
+const std::shared_ptr<Ego::Texture>& TextureManager::getPlaceholderTexture() const
 {
-    //Not loaded yet?
-    auto result = _textureCache.find(filePath);
-    if(result == _textureCache.end()) {
+    return _placeholderTexture;
+}
 
-        if(SDL_GL_GetCurrentContext() != nullptr) {
-            //We are the main OpenGL context thread so we can load textures
-            std::shared_ptr<Ego::Texture> loadTexture = std::make_shared<Ego::OpenGL::Texture>();
-            ego_texture_load_vfs(loadTexture, filePath.c_str());
-            _textureCache[filePath] = loadTexture;
-        }
-        else {
-            //We cannot load textures, wait blocking for main thread to load it for us
-            std::unique_lock<std::mutex> lock(_deferredLoadingMutex);
-            _requestedLoadDeferredTextures.push_front(filePath);
-			Log::get().debug("Wait for deferred texture: %s\n", filePath.c_str());
-            _notifyDeferredLoadingComplete.wait(lock, [this]{return _requestedLoadDeferredTextures.empty();});
+const std::shared_ptr<Ego::Texture>& TextureManager::getTexture(const std::string &filePath)
+{
+    //Without an OpenGL context there is nothing to upload to, do not even read the image
+    if(_headless) {
+        std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
+        std::shared_ptr<Ego::Texture> &texture = _textureCache[filePath];
+        if(!texture) {
+            texture = std::make_shared<Ego::Null::Texture>(filePath);
         }
-
-        return _textureCache[filePath];
+        return texture;
     }
 
+    std::unique_lock<std::mutex> lock(_deferredLoadingMutex);
+
     //Get cached texture
-    else {
+    auto result = _textureCache.find(filePath);
+    if(result != _textureCache.end()) {
         return (*result).second;
     }
+
+    lock.unlock();
+    if(SDL_GL_GetCurrentContext() != nullptr) {
+        //We are the main OpenGL context thread so we can load textures
+        std::shared_ptr<Ego::Texture> loadTexture = std::make_shared<Ego::OpenGL::Texture>();
+        ego_texture_load_vfs(loadTexture, filePath.c_str());
+        lock.lock();
+        std::shared_ptr<Ego::Texture> &texture = _textureCache[filePath];
+        texture = loadTexture;
+        return texture;
+    }
+
+    //We cannot load textures, wait blocking for main thread to stream it in for us
+    _streamingQueue.request(filePath);
+    lock.lock();
+    Log::get().debug("Wait for deferred texture: %s\n", filePath.c_str());
+    _notifyDeferredLoadingComplete.wait(lock, [this, &filePath]{ return _textureCache.find(filePath) != _textureCache.end(); });
+    return _textureCache[filePath];
 }
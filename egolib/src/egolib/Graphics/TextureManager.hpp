@@ -24,6 +24,7 @@
 
 #include "egolib/typedef.h"
 #include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Core/StreamingQueue.hpp"
 
 //--------------------------------------------------------------------------------------------
 
@@ -71,7 +72,7 @@ public:
      * @brief
      *  Request a texture from the TextureHandler. If required, this function will load the texture
      *  first. This method is thread safe, if used by another thread that is not the OpenGL context
-     *  thread, then it will block until the OpenGL context thread can load the texture for us.
+     *  thread, then it will block until the texture was streamed in by updateDeferredLoading().
      *  If the texture has already been loaded (even by other threads), that texture will be cached
      *  and this function will return it immediately.
      * @param filePath
@@ -82,13 +83,57 @@ public:
      */
     const std::shared_ptr<Ego::Texture>& getTexture(const std::string &filePath);
 
-    void updateDeferredLoading();
+    /**
+     * @brief
+     *  Request a texture without waiting for it. If the texture is not loaded yet, it is read and
+     *  decoded on a worker thread and uploaded by a later call to updateDeferredLoading().
+     *  This method is thread safe.
+     * @param filePath
+     *  File path of the texture to load
+     * @return
+     *  The texture if it is loaded, @a nullptr otherwise.
+     */
+    std::shared_ptr<Ego::Texture> requestTexture(const std::string &filePath);
+
+    /**
+     * @brief
+     *  Get the texture to use while a requested texture is streamed in.
+     * @return
+     *  a fully transparent texture
+     */
+    const std::shared_ptr<Ego::Texture>& getPlaceholderTexture() const;
+
+    /**
+     * @brief
+     *  Upload decoded textures. Must be called by the OpenGL context thread.
+     * @param budget
+     *  no further texture is uploaded once this much time has passed, at least one texture
+     *  is uploaded if any was decoded
+     */
+    void updateDeferredLoading(const std::chrono::microseconds& budget = std::chrono::milliseconds(2));
 
 private:
+    /// An image read and decoded by a worker thread, waiting to be uploaded.
+    struct DecodedImage
+    {
+        std::string fullFilename;
+        std::shared_ptr<SDL_Surface> surface;
+    };
+
+    /// Read and decode an image, runs on the worker threads.
+    static DecodedImage decode(const std::string &filePath);
+
+    /// Upload a decoded image, runs on the OpenGL context thread.
+    void upload(const std::string &filePath, DecodedImage &&image);
+
+    /// If true, no texture is loaded and the texture manager hands out null textures.
+    const bool _headless;
+
 	std::forward_list<std::shared_ptr<Ego::Texture>> _unload;
     std::unordered_map<std::string, std::shared_ptr<Ego::Texture>> _textureCache;
+    std::shared_ptr<Ego::Texture> _placeholderTexture;
 
     std::mutex _deferredLoadingMutex;
-    std::forward_list<std::string> _requestedLoadDeferredTextures;
     std::condition_variable _notifyDeferredLoadingComplete;
+    Ego::Core::StreamingQueue<std::string, DecodedImage> _streamingQueue;
 };
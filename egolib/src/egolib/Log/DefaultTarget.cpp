@@ -30,7 +30,7 @@ namespace Log {
 static constexpr size_t MAX_LOG_MESSAGE = 1024; ///< Max length of log messages.
 
 DefaultTarget::DefaultTarget(const std::string& filename, Level level)
-	: Target(level) {
+	: Target(level), _mutex() {
 	_file = vfs_openWrite(filename);
 	if (!_file) {
 		throw std::runtime_error("unable to open log file `" + filename + "`");
@@ -46,6 +46,7 @@ DefaultTarget::~DefaultTarget() {
 
 void DefaultTarget::writev(Level level, const char *format, va_list args) {
 	char logBuffer[MAX_LOG_MESSAGE] = EMPTY_CSTR;
+	std::lock_guard<std::mutex> lock(_mutex);
 
 	// Add prefix
 	const char *prefix;
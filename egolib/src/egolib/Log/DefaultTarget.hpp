@@ -34,6 +34,11 @@ private:
 	*  The log file.
 	*/
 	vfs_FILE *_file;
+	/**
+	* @brief
+	*  Serializes writes, log messages may come from loader threads.
+	*/
+	std::mutex _mutex;
 public:
 	DefaultTarget(const std::string& filename, Level level = Level::Warning);
 	virtual ~DefaultTarget();
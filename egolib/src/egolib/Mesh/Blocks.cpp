@@ -0,0 +1,131 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Mesh/Blocks.cpp
+/// @brief  A hierarchy of bounding boxes over the blocks of a mesh for frustum culling
+
+#include "egolib/Mesh/Blocks.hpp"
+
+namespace Ego {
+
+MeshBlocks::MeshBlocks()
+	: _levels() {
+}
+
+size_t MeshBlocks::getBlockCountX() const {
+	return _levels.empty() ? 0 : _levels.front()._countX;
+}
+
+size_t MeshBlocks::getBlockCountY() const {
+	return _levels.empty() ? 0 : _levels.front()._countY;
+}
+
+void MeshBlocks::build(const MeshInfo& info, const TileBox& tileBox, float headroom) {
+	_levels.clear();
+	if (0 == info.getTileCount()) {
+		return;
+	}
+
+	// The blocks.
+	level_t blocks;
+	blocks._countX = (info.getTileCountX() + getTilesPerBlock() - 1) / getTilesPerBlock();
+	blocks._countY = (info.getTileCountY() + getTilesPerBlock() - 1) / getTilesPerBlock();
+	blocks._boxes.reserve(blocks._countX * blocks._countY);
+	for (size_t y = 0; y < blocks._countY; ++y) {
+		for (size_t x = 0; x < blocks._countX; ++x) {
+			const size_t tileX = x * getTilesPerBlock(), tileY = y * getTilesPerBlock();
+			AABB3f box = tileBox(Index1D(tileX + tileY * info.getTileCountX()));
+			for (size_t ty = tileY; ty < std::min(tileY + getTilesPerBlock(), info.getTileCountY()); ++ty) {
+				for (size_t tx = tileX; tx < std::min(tileX + getTilesPerBlock(), info.getTileCountX()); ++tx) {
+					box.join(tileBox(Index1D(tx + ty * info.getTileCountX())));
+				}
+			}
+			blocks._boxes.push_back(AABB3f(box.getMin(), box.getMax() + Vector3f(0.0f, 0.0f, headroom)));
+		}
+	}
+	_levels.push_back(std::move(blocks));
+
+	// Join 2 x 2 boxes until a single box is left.
+	while (_levels.back()._boxes.size() > 1) {
+		const level_t& below = _levels.back();
+		level_t level;
+		level._countX = (below._countX + 1) / 2;
+		level._countY = (below._countY + 1) / 2;
+		level._boxes.reserve(level._countX * level._countY);
+		for (size_t y = 0; y < level._countY; ++y) {
+			for (size_t x = 0; x < level._countX; ++x) {
+				AABB3f box = below._boxes[2 * y * below._countX + 2 * x];
+				for (size_t by = 2 * y; by < std::min(2 * y + 2, below._countY); ++by) {
+					for (size_t bx = 2 * x; bx < std::min(2 * x + 2, below._countX); ++bx) {
+						box.join(below._boxes[by * below._countX + bx]);
+					}
+				}
+				level._boxes.push_back(box);
+			}
+		}
+		_levels.push_back(std::move(level));
+	}
+}
+
+void MeshBlocks::cull(const MeshInfo& info, const TileBox& tileBox, const Graphics::Frustum& frustum, std::vector<size_t>& blocks, std::vector<Index1D>& tiles) const {
+	if (_levels.empty()) {
+		return;
+	}
+	cull(info, tileBox, &frustum, _levels.size() - 1, 0, 0, blocks, tiles);
+}
+
+void MeshBlocks::cull(const MeshInfo& info, const TileBox& tileBox, const Graphics::Frustum *frustum, size_t level, size_t x, size_t y, std::vector<size_t>& blocks, std::vector<Index1D>& tiles) const {
+	const level_t& current = _levels[level];
+	if (frustum) {
+		const Math::Relation relation = frustum->intersects(current._boxes[y * current._countX + x], true);
+		if (Math::Relation::outside == relation) {
+			return;
+		}
+		// The boxes within a box entirely inside of the frustum are not tested.
+		if (Math::Relation::inside == relation) {
+			frustum = nullptr;
+		}
+	}
+	if (0 == level) {
+		blocks.push_back(y * current._countX + x);
+		addTiles(info, tileBox, frustum, x, y, tiles);
+		return;
+	}
+	const level_t& below = _levels[level - 1];
+	for (size_t by = 2 * y; by < std::min(2 * y + 2, below._countY); ++by) {
+		for (size_t bx = 2 * x; bx < std::min(2 * x + 2, below._countX); ++bx) {
+			cull(info, tileBox, frustum, level - 1, bx, by, blocks, tiles);
+		}
+	}
+}
+
+void MeshBlocks::addTiles(const MeshInfo& info, const TileBox& tileBox, const Graphics::Frustum *frustum, size_t x, size_t y, std::vector<Index1D>& tiles) const {
+	const size_t tileX = x * getTilesPerBlock(), tileY = y * getTilesPerBlock();
+	for (size_t ty = tileY; ty < std::min(tileY + getTilesPerBlock(), info.getTileCountY()); ++ty) {
+		for (size_t tx = tileX; tx < std::min(tileX + getTilesPerBlock(), info.getTileCountX()); ++tx) {
+			const Index1D index(tx + ty * info.getTileCountX());
+			if (frustum && Math::Relation::outside == frustum->intersects(tileBox(index), true)) {
+				continue;
+			}
+			tiles.push_back(index);
+		}
+	}
+}
+
+} // namespace Ego
@@ -0,0 +1,87 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Mesh/Blocks.hpp
+/// @brief  A hierarchy of bounding boxes over the blocks of a mesh for frustum culling
+
+#pragma once
+
+#include "egolib/Mesh/Info.hpp"
+#include "egolib/FileFormats/map_file.h"
+#include "egolib/frustum.h"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  A hierarchy of bounding boxes over the blocks of a mesh for culling the mesh against a view frustum.
+ *  Level 0 has one box per block of 4 x 4 tiles, every level above has one box per 2 x 2 boxes of the
+ *  level below, the last level has a single box.
+ */
+struct MeshBlocks
+{
+	/// A callable <tt>AABB3f(const Index1D&)</tt> returning the bounding box of a tile.
+	using TileBox = std::function<AABB3f(const Index1D&)>;
+
+	MeshBlocks();
+
+	/**
+	 * @brief Build the boxes from the bounding boxes of the tiles.
+	 * @param info the mesh information
+	 * @param tileBox the bounding boxes of the tiles
+	 * @param headroom the height by which the boxes of the blocks are raised above their tiles
+	 */
+	void build(const MeshInfo& info, const TileBox& tileBox, float headroom);
+
+	/**
+	 * @brief Cull the blocks and the tiles against a frustum.
+	 * @param info the mesh information
+	 * @param tileBox the bounding boxes of the tiles
+	 * @param frustum the frustum
+	 * @param blocks receives the indices of the blocks which are not outside of the frustum
+	 * @param tiles receives the indices of the tiles which are not outside of the frustum
+	 * @remark A tile is received if and only if Frustum::intersects(tileBox(tile), true) does
+	 *         not return Ego::Math::Relation::outside.
+	 */
+	void cull(const MeshInfo& info, const TileBox& tileBox, const Graphics::Frustum& frustum, std::vector<size_t>& blocks, std::vector<Index1D>& tiles) const;
+
+	/// @brief Get the number of blocks along the x-axis.
+	size_t getBlockCountX() const;
+	/// @brief Get the number of blocks along the y-axis.
+	size_t getBlockCountY() const;
+	/// @brief Get the number of tiles along each side of a block.
+	static constexpr size_t getTilesPerBlock() {
+		return Info<int>::Block::Size() / Info<int>::Grid::Size();
+	}
+
+private:
+	struct level_t
+	{
+		size_t _countX, _countY;   ///< the number of boxes along the x- and the y-axis
+		std::vector<AABB3f> _boxes;
+	};
+	std::vector<level_t> _levels;
+
+	/// @param frustum the frustum or a null pointer if the box is entirely inside of the frustum
+	void cull(const MeshInfo& info, const TileBox& tileBox, const Graphics::Frustum *frustum, size_t level, size_t x, size_t y, std::vector<size_t>& blocks, std::vector<Index1D>& tiles) const;
+	/// @param frustum the frustum or a null pointer if the block is entirely inside of the frustum
+	void addTiles(const MeshInfo& info, const TileBox& tileBox, const Graphics::Frustum *frustum, size_t x, size_t y, std::vector<Index1D>& tiles) const;
+};
+
+} // namespace Ego
@@ -27,6 +27,7 @@
 #include "egolib/typedef.h"
 #include "egolib/Logic/Damage.hpp"
 #include "egolib/Profiles/LocalParticleProfileRef.hpp"
+#include "egolib/FileFormats/CacheFile.hpp"
 
 /**
  * @brief
@@ -81,6 +82,18 @@ protected:
 
 public:
 
+    /**
+     * @brief
+     *  Get the cache of parsed profile files.
+     * @remark
+     *  Increment the version whenever a <tt>transfer(Ego::CacheArchive&)</tt> function of a profile changes.
+     */
+    static const Ego::CacheFile& getCache()
+    {
+        static const Ego::CacheFile cache("/cache/profiles", "objc", 1);
+        return cache;
+    }
+
     /**
      * @brief
      *  Get the name of this profile.
@@ -112,6 +125,13 @@ struct SpawnDescriptor
         _facingAdd = 0;
         _lpip = LocalParticleProfileRef::Invalid;
     }
+
+    void transfer(Ego::CacheArchive& archive)
+    {
+        archive(_amount);
+        archive(_facingAdd);
+        archive(_lpip);
+    }
 };
 
 /// Enchants as well as particles can continuously spawn other particles.
@@ -129,4 +149,10 @@ struct ContinuousSpawnDescriptor : public SpawnDescriptor
         this->SpawnDescriptor::reset();
         _delay = 0;
     }
+
+    void transfer(Ego::CacheArchive& archive)
+    {
+        this->SpawnDescriptor::transfer(archive);
+        archive(_delay);
+    }
 };
@@ -83,9 +83,47 @@ void EnchantProfile::setEnchantName(const std::string& name)
     _enchantName = name;
 }
 
+void EnchantProfile::transfer(Ego::CacheArchive& archive)
+{
+    archive(_override);
+    archive(remove_overridden);
+    archive(retarget);
+    archive(required_damagetype);
+    archive(require_damagetarget_damagetype);
+    archive(spawn_overlay);
+
+    archive(lifetime);
+    archive(endIfCannotPay);
+    archive(removedByIDSZ);
+
+    archive(_owner);
+    archive(_target);
+
+    archive(_set);
+    archive(_add);
+
+    archive(seeKurses);
+    archive(darkvision);
+
+    archive(contspawn);
+
+    archive(endsound_index);
+    archive(killtargetonend);
+    archive(poofonend);
+    archive(endmessage);
+
+    archive(_enchantName);
+}
+
 std::shared_ptr<EnchantProfile> EnchantProfile::readFromFile(const std::string& pathname)
 {
+    // use the values parsed last time if the file did not change since
     std::shared_ptr<EnchantProfile> profile = std::make_shared<EnchantProfile>();
+    if (getCache().load(pathname, [&profile](Ego::CacheArchive& archive) { profile->transfer(archive); }))
+    {
+        profile->_name = pathname;
+        return profile;
+    }
 
     ReadContext ctxt(pathname);
     if (!ctxt.ensureOpen())
@@ -271,5 +309,7 @@ std::shared_ptr<EnchantProfile> EnchantProfile::readFromFile(const std::string&
     // Limit the endsound_index.
     profile->endsound_index = Ego::Math::constrain<Sint16>(profile->endsound_index, INVALID_SOUND_ID, MAX_WAVE);
 
+    getCache().store(pathname, [&profile](Ego::CacheArchive& archive) { profile->transfer(archive); });
+
     return profile;
 }
@@ -139,6 +139,13 @@ public:
         ObjectRelation(bool stay, SFP8_T manaDrain, SFP8_T lifeDrain) :
             _stay(stay), _manaDrain(manaDrain), _lifeDrain(lifeDrain)
         {}
+
+        void transfer(Ego::CacheArchive& archive)
+        {
+            archive(_stay);
+            archive(_manaDrain);
+            archive(_lifeDrain);
+        }
     };
 
     /**
@@ -196,6 +203,12 @@ public:
             apply = false;
             value = 0.0f;
         }
+
+        void transfer(Ego::CacheArchive& archive)
+        {
+            archive(apply);
+            archive(value);
+        }
     };
 
     // The "set" modifiers of this enchant.
@@ -217,6 +230,13 @@ public:
     bool poofonend;                      ///< Spawn a poof on end?
     int endmessage;                      ///< Message on end (-1 for none)
 
+private:
+    /**
+     * @brief
+     *  Transfer the values read from the profile file to or from the profile cache.
+     */
+    void transfer(Ego::CacheArchive& archive);
+
 private:
     std::string _enchantName;
 };
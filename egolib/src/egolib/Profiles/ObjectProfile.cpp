@@ -42,8 +42,10 @@ ObjectProfile::ObjectProfile() :
     _slotNumber(-1),
 
     _randomName(),
-    _aiScript(),
+    _aiScript(std::make_shared<script_info_t>()),
     _particleProfiles(),
+    _pendingEnchant(nullptr),
+    _pendingParticles(),
 
     _texturesLoaded(),
     _iconsLoaded(),
@@ -412,8 +414,147 @@ void ObjectProfile::setupXPTable()
     }
 }
 
+void ObjectProfile::transferDataFile(Ego::CacheArchive& archive)
+{
+    archive(_className);
+
+    archive(_skinInfo);
+
+    archive(_skinOverride);
+    archive(_levelOverride);
+    archive(_stateOverride);
+    archive(_contentOverride);
+    archive(_idsz);
+
+    archive(_maxAmmo);
+    archive(_ammo);
+    archive(_money);
+
+    archive(_gender);
+
+    archive(_spawnLife);
+    archive(_spawnMana);
+    archive(_baseAttribute);
+    archive(_attributeGain);
+
+    archive(_weight);
+    archive(_bounciness);
+    archive(_bumpDampen);
+    archive(_size);
+    archive(_sizeGainPerLevel);
+    archive(_shadowSize);
+    archive(_bumpSize);
+    archive(_bumpOverrideSize);
+    archive(_bumpSizeBig);
+    archive(_bumpOverrideSizeBig);
+    archive(_bumpHeight);
+    archive(_bumpOverrideHeight);
+    archive(_stoppedBy);
+
+    archive(_jumpPower);
+    archive(_jumpNumber);
+    archive(_animationSpeedSneak);
+    archive(_animationSpeedWalk);
+    archive(_animationSpeedRun);
+    archive(_flyHeight);
+    archive(_waterWalking);
+    archive(_jumpSound);
+    archive(_footFallSound);
+
+    archive(_lifeColor);
+    archive(_manaColor);
+    archive(_drawIcon);
+
+    archive(_flashAND);
+    archive(_alpha);
+    archive(_light);
+    archive(_transferBlending);
+    archive(_sheen);
+    archive(_phongMapping);
+    archive(_textureMovementRateX);
+    archive(_textureMovementRateY);
+    archive(_uniformLit);
+    archive(_hasReflection);
+    archive(_alwaysDraw);
+    archive(_forceShadow);
+    archive(_causesRipples);
+    archive(_dontCullBackfaces);
+
+    archive(iframefacing);
+    archive(iframeangle);
+    archive(nframefacing);
+    archive(nframeangle);
+    archive(_blockRating);
+
+    archive(_resistBumpSpawn);
+
+    archive(_experienceForLevel);
+    archive(_startingExperience);
+    archive(_experienceWorth);
+    archive(_experienceExchange);
+    archive(_experienceRate);
+    archive(_levelUpRandomSeedOverride);
+
+    archive(_isEquipment);
+    archive(_isItem);
+    archive(_isMount);
+    archive(_isStackable);
+    archive(_isInvincible);
+    archive(_isPlatform);
+    archive(_canUsePlatforms);
+    archive(_canGrabMoney);
+    archive(_canOpenStuff);
+    archive(_canBeDazed);
+    archive(_canBeGrogged);
+    archive(_isBigItem);
+    archive(_isRanged);
+    archive(_nameIsKnown);
+    archive(_usageIsKnown);
+    archive(_canCarryToNextModule);
+    archive(_damageTargetDamageType);
+    archive(_slotsValid);
+    archive(_riderCanAttack);
+    archive(_kurseChance);
+    archive(_hideState);
+    archive(_isValuable);
+    archive(_spellEffectType);
+
+    archive(_needSkillIDToUse);
+    archive(_weaponAction);
+    archive(_attachAttackParticleToWeapon);
+    archive(_attackParticle);
+    archive(_attackFast);
+    archive(_strengthBonus);
+    archive(_intelligenceBonus);
+    archive(_dexterityBonus);
+
+    archive(_attachedParticleAmount);
+    archive(_attachedParticleReaffirmDamageType);
+    archive(_attachedParticle);
+    archive(_goPoofParticleAmount);
+    archive(_goPoofParticleFacingAdd);
+    archive(_goPoofParticle);
+
+    archive(_bludValid);
+    archive(_bludParticle);
+
+    archive(_seeInvisibleLevel);
+
+    archive(_stickyButt);
+    archive(_useManaCost);
+
+    archive(_startingPerks);
+    archive(_perkPool);
+}
+
 bool ObjectProfile::loadDataFile(const std::string &filePath)
 {
+    // Use the values parsed last time if the file did not change since
+    if (AbstractProfile::getCache().load(filePath, [this](Ego::CacheArchive& archive) { transferDataFile(archive); }))
+    {
+        return true;
+    }
+
     // Open the file
     ReadContext ctxt(filePath);
     if (!ctxt.ensureOpen())
@@ -917,6 +1058,8 @@ bool ObjectProfile::loadDataFile(const std::string &filePath)
             break;
         }
     }
+
+    AbstractProfile::getCache().store(filePath, [this](Ego::CacheArchive& archive) { transferDataFile(archive); });
     return true;
 }
 
@@ -975,14 +1118,25 @@ std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &fo
         return nullptr;
     }
 
+    std::shared_ptr<ObjectProfile> profile = readFromFile(folderPath, lightWeight);
+    if (!profile)
+    {
+        return nullptr;
+    }
+
+    profile->registerResources(slotNumber, lightWeight);
+    return profile;
+}
+
+std::shared_ptr<ObjectProfile> ObjectProfile::readFromFile(const std::string &folderPath, const bool lightWeight)
+{
     //Allocate memory
     std::shared_ptr<ObjectProfile> profile = std::make_shared<ObjectProfile>();
 
     //Set some data
     profile->_pathname = folderPath;
-    profile->_slotNumber = slotNumber;
 
-    //Don't load 3d model, enchant, messages, sounds or particle effects for lightweight profiles
+    //Don't load 3d model, enchant, messages or particle effects for lightweight profiles
     if(!lightWeight)
     {
         // Load the model for this profile
@@ -994,35 +1148,22 @@ std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &fo
             return nullptr;
         }
 
-        // Load the enchantment for this profile (optional)
+        // Read the enchantment for this profile (optional)
         STRING newloadname;
         make_newloadname( folderPath.c_str(), "/enchant.txt", newloadname );
-        profile->_ieve = ProfileSystem::get().EnchantProfileSystem.load_one( newloadname, static_cast<EVE_REF>(slotNumber) );
+        profile->_pendingEnchant = EnchantProfile::readFromFile( newloadname );
 
         // Load the messages for this profile, do this before loading the AI script
         // to ensure any dynamic loaded messages get loaded last (optional)
         profile->loadAllMessages(folderPath + "/message.txt");
 
-        // Load the particles for this profile (optional)
+        // Read the particles for this profile (optional)
         for (LocalParticleProfileRef cnt(0); cnt.get() < 30; ++cnt) //TODO: find better way of listing files
         {
             const std::string particleName = folderPath + "/part" + std::to_string(cnt.get()) + ".txt";
-            PIP_REF particleProfile = ProfileSystem::get().ParticleProfileSystem.load_one(particleName.c_str(), INVALID_PIP_REF);
-
-            // Make sure it's referenced properly
-            if(particleProfile != INVALID_PIP_REF) {
-                profile->_particleProfiles[cnt] = particleProfile; 
-            }
-        }
-
-        // Load the waves for this iobj
-        for ( size_t cnt = 0; cnt < 30; cnt++ ) //TODO: make better search than just 30 (list files?)
-        {
-            const std::string soundName = folderPath + "/sound" + std::to_string(cnt);
-            SoundID soundID = AudioSystem::get().loadSound(soundName);
-
-            if(soundID != INVALID_SOUND_ID) {
-                profile->_soundMap[cnt] = soundID;
+            std::shared_ptr<ParticleProfile> particleProfile = ParticleProfile::readFromFile(particleName);
+            if(particleProfile) {
+                profile->_pendingParticles.emplace_back(cnt, particleProfile);
             }
         }
     }
@@ -1034,7 +1175,6 @@ std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &fo
     profile->_randomName.loadFromFile(folderPath + "/naming.txt");
 
     // Finally load the character profile
-    // Do after loading particle and sound profiles
     try {
         if(!profile->loadDataFile(folderPath + "/data.txt")) {
 			Log::get().warn("Unable to load data.txt for profile: %s\n", folderPath.c_str());
@@ -1055,6 +1195,41 @@ std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &fo
     return profile;
 }
 
+void ObjectProfile::registerResources(const PRO_REF slotNumber, const bool lightWeight)
+{
+    _slotNumber = slotNumber;
+
+    // The enchantment shares the slot number of this profile
+    _ieve = ProfileSystem::get().EnchantProfileSystem.add_one( _pendingEnchant, static_cast<EVE_REF>(slotNumber) );
+    _pendingEnchant = nullptr;
+
+    // Particles take the next free references in the order of their local numbers
+    for (const auto& element : _pendingParticles)
+    {
+        PIP_REF particleProfile = ProfileSystem::get().ParticleProfileSystem.add_one(element.second, INVALID_PIP_REF);
+
+        // Make sure it's referenced properly
+        if(particleProfile != INVALID_PIP_REF) {
+            _particleProfiles[element.first] = particleProfile;
+        }
+    }
+    _pendingParticles.clear();
+
+    if (!lightWeight)
+    {
+        // Load the waves for this iobj
+        for ( size_t cnt = 0; cnt < 30; cnt++ ) //TODO: make better search than just 30 (list files?)
+        {
+            const std::string soundName = _pathname + "/sound" + std::to_string(cnt);
+            SoundID soundID = AudioSystem::get().loadSound(soundName);
+
+            if(soundID != INVALID_SOUND_ID) {
+                _soundMap[cnt] = soundID;
+            }
+        }
+    }
+}
+
 
 bool ObjectProfile::isSlotValid(slot_t slot) const
 {
@@ -149,6 +149,17 @@ struct SkinInfo
     uint8_t      defence;                          ///< Damage reduction
     uint8_t      damageModifier[DAMAGE_COUNT];     ///< Invictus, inverse, mana burn etc.
     float        damageResistance[DAMAGE_COUNT];   ///< Damage Resistance (can be negative)
+
+    void transfer(Ego::CacheArchive& archive)
+    {
+        archive(name);
+        archive(cost);
+        archive(maxAccel);
+        archive(dressy);
+        archive(defence);
+        archive(damageModifier);
+        archive(damageResistance);
+    }
 };
 
 //--------------------------------------------------------------------------------------------
@@ -233,7 +244,8 @@ public:
     /**
     * Write access getter
     **/
-    inline script_info_t& getAIScript() {return _aiScript;}
+    inline script_info_t& getAIScript() {return *_aiScript;}
+    inline void setAIScript(const std::shared_ptr<script_info_t>& script) {_aiScript = script;}
     inline RandomName& getRandomNameData() {return _randomName;}
 
     /**
@@ -582,6 +594,22 @@ public:
     **/
     static std::shared_ptr<ObjectProfile> loadFromFile(const std::string &folderPath, const PRO_REF slotOverride, const bool lightWeight = false);
 
+    /**
+    * @brief Reads all files in the folder path without touching any shared state, see registerResources().
+    *        Any number of profiles can be read concurrently.
+    * @param lightWeight If true, then no 3D model, particle or enchant will be read (for menu)
+    * @return the profile or a null pointer if it could not be read
+    **/
+    static std::shared_ptr<ObjectProfile> readFromFile(const std::string &folderPath, const bool lightWeight = false);
+
+    /**
+    * @brief Puts a profile read by readFromFile() into a slot. Its enchant and particle profiles are registered with
+    *        the ProfileSystem and its sounds are loaded. Must be called on the loading thread, in loading order.
+    * @param slotNumber Which slot number to load this profile in
+    * @param lightWeight If true, then no sounds will be loaded (for menu)
+    **/
+    void registerResources(const PRO_REF slotNumber, const bool lightWeight = false);
+
     /**
     * @brief Writes the contents of this character instance to a profile data.txt file
     **/
@@ -614,6 +642,11 @@ private:
     **/
     bool loadDataFile(const std::string &filePath);
 
+    /**
+    * @brief Transfers the values read from a datafile (data.txt) to or from the profile cache
+    **/
+    void transferDataFile(Ego::CacheArchive& archive);
+
     /**
     * @author ZF
     * @details This calculates the xp needed to reach next level and stores it in an array for later use
@@ -631,11 +664,15 @@ private:
     /// the random naming info
     RandomName _randomName;
     
-    script_info_t _aiScript;                    ///< the AI script for this profile
+    std::shared_ptr<script_info_t> _aiScript;   ///< the AI script for this profile, may be shared with other profiles
 
     //Particles
     std::unordered_map<LocalParticleProfileRef, PIP_REF> _particleProfiles;
 
+    // read by readFromFile(), handed over to the ProfileSystem by registerResources()
+    std::shared_ptr<EnchantProfile> _pendingEnchant;
+    std::vector<std::pair<LocalParticleProfileRef, std::shared_ptr<ParticleProfile>>> _pendingParticles;
+
     // the profile skins
     std::unordered_map<size_t, Ego::DeferredTexture> _texturesLoaded;
     std::unordered_map<size_t, Ego::DeferredTexture> _iconsLoaded;
@@ -60,6 +60,16 @@ void dynalight_info_t::reset()
     falloff_add = 0.0f;
 }
 
+void dynalight_info_t::transfer(Ego::CacheArchive& archive)
+{
+    archive(mode);
+    archive(on);
+    archive(level);
+    archive(level_add);
+    archive(falloff);
+    archive(falloff_add);
+}
+
 ParticleProfile::ParticleProfile() :
 
     // Spawning.
@@ -159,17 +169,99 @@ ParticleProfile::~ParticleProfile()
     //dtor
 }
 
+void ParticleProfile::transfer(Ego::CacheArchive& archive)
+{
+    archive(soundspawn);
+    archive(force);
+    archive(newtargetonspawn);
+    archive(needtarget);
+    archive(startontarget);
+
+    archive(end_time);
+    archive(end_water);
+    archive(end_bump);
+    archive(end_ground);
+    archive(end_wall);
+    archive(end_lastframe);
+    archive(end_sound);
+    archive(end_sound_floor);
+    archive(end_sound_wall);
+
+    archive(contspawn);
+    archive(endspawn);
+    archive(bumpspawn);
+
+    archive(bump_money);
+    archive(bump_size);
+    archive(bump_height);
+
+    archive(damage);
+    archive(damageType);
+    archive(dazeTime);
+    archive(grogTime);
+    archive(_intellectDamageBonus);
+    archive(spawnenchant);
+    archive(onlydamagefriendly);
+    archive(friendlyfire);
+    archive(hateonly);
+    archive(cause_roll);
+    archive(cause_pancake);
+
+    archive(lifeDrain);
+    archive(manaDrain);
+
+    archive(homing);
+    archive(targetangle);
+    archive(homingaccel);
+    archive(homingfriction);
+    archive(zaimspd);
+    archive(rotatetoface);
+    archive(targetcaster);
+
+    archive(spdlimit);
+    archive(dampen);
+    archive(allowpush);
+    archive(ignore_gravity);
+
+    archive(dynalight);
+    archive(type);
+    archive(image_max);
+    archive(image_stt);
+    archive(image_add);
+    archive(rotate_pair);
+    archive(rotate_add);
+    archive(size_base);
+    archive(size_add);
+    archive(facingadd);
+    archive(orientation);
+
+    archive(_comment);
+    archive(_particleEffectBits);
+    archive(_gravityPull);
+
+    archive(_spawnFacing);
+    archive(_spawnPositionOffsetXY);
+    archive(_spawnPositionOffsetZ);
+    archive(_spawnVelocityOffsetXY);
+    archive(_spawnVelocityOffsetZ);
+}
+
 std::shared_ptr<ParticleProfile> ParticleProfile::readFromFile(const std::string& pathname)
 {
     char cTmp;
 
+    // use the values parsed last time if the file did not change since
+    std::shared_ptr<ParticleProfile> profile = std::make_shared<ParticleProfile>();
+    if (getCache().load(pathname, [&profile](Ego::CacheArchive& archive) { profile->transfer(archive); })) {
+        profile->_name = pathname;
+        return profile;
+    }
+
     ReadContext ctxt(pathname);
     if (!ctxt.ensureOpen()) {
         return nullptr;
     }
 
-    std::shared_ptr<ParticleProfile> profile = std::make_shared<ParticleProfile>();
-
     // set up the EGO_PROFILE_STUFF
     profile->_name = pathname;
 
@@ -418,6 +510,8 @@ std::shared_ptr<ParticleProfile> ParticleProfile::readFromFile(const std::string
     // Limit the soundspawn index.
     profile->soundspawn = Ego::Math::constrain<int8_t>(profile->soundspawn, INVALID_SOUND_ID, MAX_WAVE);
 
+    getCache().store(pathname, [&profile](Ego::CacheArchive& archive) { profile->transfer(archive); });
+
     return profile;
 }
 
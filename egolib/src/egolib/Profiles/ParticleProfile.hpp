@@ -114,6 +114,8 @@ struct dynalight_info_t
     dynalight_info_t();
 
     void reset();
+
+    void transfer(Ego::CacheArchive& archive);
 };
 
 /// The definition of a particle profile
@@ -261,6 +263,13 @@ public:
     uint16_t facingadd;           ///< Facing
     prt_ori_t orientation;      ///< The way the particle orientation is calculated for display
 
+private:
+    /**
+     * @brief
+     *  Transfer the values read from the profile file to or from the profile cache.
+     */
+    void transfer(Ego::CacheArchive& archive);
+
 private:
     std::string _comment;
     std::bitset<NR_OF_DAMFX_BITS> _particleEffectBits;
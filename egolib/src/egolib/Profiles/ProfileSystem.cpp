@@ -30,6 +30,7 @@
 #include "game/Entities/_Include.hpp"
 #include "game/game.h"
 #include "game/script_compile.h"
+#include "egolib/Core/ThreadPool.hpp"
 
 AbstractProfileSystem<EnchantProfile, EVE_REF, INVALID_EVE_REF, ENCHANTPROFILES_MAX> EnchantProfileSystem("enchant", "/debug/enchant_profile_usage.txt");
 AbstractProfileSystem<ParticleProfile, PIP_REF, INVALID_PIP_REF, MAX_PIP> ParticleProfileSystem("particle", "/debug/particle_profile_usage.txt");
@@ -74,6 +75,9 @@ void ProfileSystem::reset()
     // Reset particle, enchant and models.
     ParticleProfileSystem.reset();
     EnchantProfileSystem.reset();
+
+    // Release the compiled AI scripts.
+    parser_state_t::get().clearCompiledScripts();
 }
 
 const std::shared_ptr<ObjectProfile>& ProfileSystem::getProfile(const std::string& name) const
@@ -190,12 +194,71 @@ PRO_REF ProfileSystem::loadOneProfile(const std::string &pathName, int slot_over
     }
 
     //Success! Store object into the loaded profile map
+    addLoadedProfile(iobj, profile);
+
+    return iobj;
+}
+
+void ProfileSystem::addLoadedProfile(PRO_REF iobj, const std::shared_ptr<ObjectProfile> &profile)
+{
     _profilesLoaded[iobj] = profile;
     _profilesLoadedByName[profile->getPathname().substr(profile->getPathname().find_last_of('/') + 1)] = profile;
-    Log::get().debug("ProfileSystem::loadOneProfile() - Loaded (%s) into %s\n", pathName.c_str(), profile->getPathname().substr(profile->getPathname().find_last_of('/') + 1).c_str());
+    Log::get().debug("ProfileSystem::loadOneProfile() - Loaded (%s) into %s\n", profile->getPathname().c_str(), profile->getPathname().substr(profile->getPathname().find_last_of('/') + 1).c_str());
+}
 
+void ProfileSystem::loadProfiles(const std::vector<std::string> &folderPaths)
+{
+    struct Candidate
+    {
+        std::string folderPath;
+        PRO_REF slotNumber;
+        std::future<std::shared_ptr<ObjectProfile>> profile;    ///< Invalid if an earlier folder claimed the same slot
+    };
+
+    const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    ThreadPool pool(threads);
+
+    // Assign the slots in order, the first folder asking for a free slot gets it
+    std::vector<Candidate> candidates;
+    std::unordered_set<PRO_REF> claimedSlots;
+    for (const std::string &folderPath : folderPaths)
+    {
+        int islot = getProfileSlotNumber(folderPath);
+        if (islot < 0 || islot >= INVALID_PRO_REF) continue;
 
-    return iobj;
+        Candidate candidate;
+        candidate.folderPath = folderPath;
+        candidate.slotNumber = static_cast<PRO_REF>(islot);
+        if (_profilesLoaded.find(candidate.slotNumber) != _profilesLoaded.end()) continue;
+
+        // Read the files on the worker threads
+        if (claimedSlots.insert(candidate.slotNumber).second)
+        {
+            candidate.profile = pool.submit([folderPath]() { return ObjectProfile::readFromFile(folderPath); });
+        }
+        candidates.push_back(std::move(candidate));
+    }
+
+    // Register the profiles in order
+    for (Candidate &candidate : candidates)
+    {
+        // The slot was claimed by an earlier folder. It is still free if that folder failed to load.
+        if (!candidate.profile.valid())
+        {
+            loadOneProfile(candidate.folderPath);
+            continue;
+        }
+
+        std::shared_ptr<ObjectProfile> profile = candidate.profile.get();
+        if (!profile)
+        {
+            Log::get().warn("ProfileSystem::loadOneProfile() - Failed to load (%s) into slot number %d\n", candidate.folderPath.c_str(), candidate.slotNumber);
+            continue;
+        }
+
+        profile->registerResources(candidate.slotNumber);
+        addLoadedProfile(candidate.slotNumber, profile);
+    }
 }
 
 const Ego::DeferredTexture& ProfileSystem::getSpellBookIcon(size_t index) const
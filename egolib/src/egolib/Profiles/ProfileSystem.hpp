@@ -102,6 +102,17 @@ public:
      */
     PRO_REF loadOneProfile(const std::string &folderPath, int slot_override = -1);
 
+    /**
+     * @brief
+     *  Load the profiles in a list of folders. The result is the same as calling loadOneProfile() for each
+     *  folder in order: slots, particle and enchant references and sounds are assigned in that order.
+     * @remark
+     *  The files of the profiles are read concurrently on a pool of worker threads. Everything touching
+     *  shared state, including the registration into this profile system, happens on the calling thread.
+     *  Textures are deferred and uploaded on the main thread when they are first used.
+     */
+    void loadProfiles(const std::vector<std::string> &folderPaths);
+
     /**
      * @brief Loads only the slot number from data.txt
      *        If slot_override is valid, then that is used indead
@@ -154,6 +165,10 @@ public:
      */
     void loadGlobalParticleProfiles();
 
+private:
+    /// Store a loaded profile into the loaded profile maps
+    void addLoadedProfile(PRO_REF slotNumber, const std::shared_ptr<ObjectProfile> &profile);
+
 private:
     std::unordered_map<PRO_REF, std::shared_ptr<ObjectProfile>> _profilesLoaded; //Maps slot numbers to ObjectProfiles
     std::unordered_map<std::string, std::shared_ptr<ObjectProfile>> _profilesLoadedByName; //Maps names to ObjectProfiles
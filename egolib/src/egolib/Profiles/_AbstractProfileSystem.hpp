@@ -136,6 +136,17 @@ public:
     /// @return a reference to the profile on sucess, INVALIDREF on failure
     REFTYPE load_one(const std::string& pathname, const REFTYPE _override)
     {
+        return add_one(TYPE::readFromFile(pathname), _override);
+    }
+
+    /// @brief Add a profile which was read already into the profile stack.
+    /// @return a reference to the profile on sucess, INVALIDREF on failure or if @a profile is a null pointer
+    REFTYPE add_one(const std::shared_ptr<TYPE>& profile, const REFTYPE _override)
+    {
+        if (!profile) {
+            return INVALIDREF;
+        }
+
         if(isLoaded(_override)) {
 			Log::get().warn("%s:%d:%s: loaded over existing profile\n", __FILE__, __LINE__, __FUNCTION__);
         }
@@ -157,13 +168,6 @@ public:
             }
         }
 
-        //Allocate memory for new profile
-        std::shared_ptr<TYPE> profile = TYPE::readFromFile(pathname);
-
-        if (!profile) {
-            return INVALIDREF;
-        }
-
         _map[ref] = profile;
         return ref;
     }
@@ -25,6 +25,22 @@ std::shared_ptr<const Texture> DeferredTexture::get() {
             throw std::logic_error("DeferredTexture::get() on nullptr texture");
         }
 
+        _texture = TextureManager::get().requestTexture(_filePath);
+        if (!_texture) {
+            return TextureManager::get().getPlaceholderTexture();
+        }
+        _loaded = true;
+    }
+
+    return _texture;
+}
+
+std::shared_ptr<const Texture> DeferredTexture::getLoaded() {
+    if (!_loaded) {
+        if (_filePath.empty()) {
+            throw std::logic_error("DeferredTexture::getLoaded() on nullptr texture");
+        }
+
         _texture = TextureManager::get().getTexture(_filePath);
         _loaded = true;
     }
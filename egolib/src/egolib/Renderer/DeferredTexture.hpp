@@ -7,6 +7,8 @@ namespace Ego {
  * @brief
  *  A texture with lazy loading. This means the texture will not
  *  be loaded into memory before it is required for rendering.
+ *  The texture is streamed in by the TextureManager, until it arrives
+ *  a placeholder texture is returned.
  */
 class DeferredTexture {
 public:
@@ -18,6 +20,13 @@ public:
 
     std::shared_ptr<const Texture> get();
 
+    /**
+     * @brief
+     *  Like get(), but waits for the texture to be loaded instead of returning the placeholder.
+     *  Use this if the size of the texture is required.
+     */
+    std::shared_ptr<const Texture> getLoaded();
+
     void release();
 
     void setTextureSource(const std::string &filePath);
@@ -0,0 +1,206 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Renderer.cpp
+/// @brief  Implementation of a renderer which renders nothing
+
+#include "egolib/Renderer/Null/Renderer.hpp"
+
+namespace Ego {
+namespace Null {
+
+AccumulationBuffer::AccumulationBuffer() :
+    Ego::AccumulationBuffer(), colourDepth(32, 8, 8, 8, 8)
+{}
+
+AccumulationBuffer::~AccumulationBuffer() {}
+
+void AccumulationBuffer::clear() {}
+
+void AccumulationBuffer::setClearValue(const Colour4f& value) {}
+
+const ColourDepth& AccumulationBuffer::getColourDepth() {
+    return colourDepth;
+}
+
+ColourBuffer::ColourBuffer() :
+    Ego::ColourBuffer(), colourDepth(32, 8, 8, 8, 8)
+{}
+
+ColourBuffer::~ColourBuffer() {}
+
+void ColourBuffer::clear() {}
+
+void ColourBuffer::setClearValue(const Colour4f& value) {}
+
+const ColourDepth& ColourBuffer::getColourDepth() {
+    return colourDepth;
+}
+
+DepthBuffer::DepthBuffer() :
+    Ego::DepthBuffer()
+{}
+
+DepthBuffer::~DepthBuffer() {}
+
+void DepthBuffer::clear() {}
+
+void DepthBuffer::setClearValue(const float& value) {}
+
+uint8_t DepthBuffer::getDepth() {
+    return 24;
+}
+
+StencilBuffer::StencilBuffer() :
+    Ego::StencilBuffer()
+{}
+
+StencilBuffer::~StencilBuffer() {}
+
+void StencilBuffer::clear() {}
+
+void StencilBuffer::setClearValue(const float& value) {}
+
+uint8_t StencilBuffer::getDepth() {
+    return 8;
+}
+
+TextureUnit::TextureUnit() :
+    Ego::TextureUnit()
+{}
+
+TextureUnit::~TextureUnit() {}
+
+void TextureUnit::setActivated(const Ego::Texture *texture) {}
+
+Renderer::Renderer() :
+    _accumulationBuffer(),
+    _colourBuffer(),
+    _depthBuffer(),
+    _stencilBuffer(),
+    _textureUnit(),
+    _info("null renderer", "Egoboo", "1.0")
+{}
+
+Renderer::~Renderer() {}
+
+const Ego::RendererInfo& Renderer::getInfo() {
+    return _info;
+}
+
+Ego::AccumulationBuffer& Renderer::getAccumulationBuffer() {
+    return _accumulationBuffer;
+}
+
+Ego::ColourBuffer& Renderer::getColourBuffer() {
+    return _colourBuffer;
+}
+
+Ego::DepthBuffer& Renderer::getDepthBuffer() {
+    return _depthBuffer;
+}
+
+Ego::StencilBuffer& Renderer::getStencilBuffer() {
+    return _stencilBuffer;
+}
+
+Ego::TextureUnit& Renderer::getTextureUnit() {
+    return _textureUnit;
+}
+
+void Renderer::setAlphaTestEnabled(bool enabled) {}
+
+void Renderer::setAlphaFunction(CompareFunction function, float value) {}
+
+void Renderer::setBlendingEnabled(bool enabled) {}
+
+void Renderer::setBlendFunction(BlendFunction sourceColour, BlendFunction sourceAlpha,
+                                BlendFunction destinationColour, BlendFunction destinationAlpha) {}
+
+void Renderer::setColour(const Colour4f& colour) {}
+
+void Renderer::setCullingMode(CullingMode mode) {}
+
+void Renderer::setDepthFunction(CompareFunction function) {}
+
+void Renderer::setDepthTestEnabled(bool enabled) {}
+
+void Renderer::setDepthWriteEnabled(bool enabled) {}
+
+void Renderer::setScissorTestEnabled(bool enabled) {}
+
+void Renderer::setScissorRectangle(float left, float bottom, float width, float height) {}
+
+void Renderer::setStencilMaskBack(uint32_t mask) {}
+
+void Renderer::setStencilMaskFront(uint32_t mask) {}
+
+void Renderer::setStencilTestEnabled(bool enabled) {}
+
+void Renderer::setViewportRectangle(float left, float bottom, float width, float height) {}
+
+void Renderer::setWindingMode(WindingMode mode) {}
+
+void Renderer::loadMatrix(const Matrix4f4f& matrix) {}
+
+void Renderer::multiplyMatrix(const Matrix4f4f& matrix) {}
+
+void Renderer::setPerspectiveCorrectionEnabled(bool enabled) {}
+
+void Renderer::setDitheringEnabled(bool enabled) {}
+
+void Renderer::setPointSmoothEnabled(bool enabled) {}
+
+void Renderer::setLineSmoothEnabled(bool enabled) {}
+
+void Renderer::setLineWidth(float width) {}
+
+void Renderer::setPointSize(float size) {}
+
+void Renderer::setPolygonSmoothEnabled(bool enabled) {}
+
+void Renderer::setMultisamplesEnabled(bool enabled) {}
+
+void Renderer::setLightingEnabled(bool enabled) {}
+
+void Renderer::setRasterizationMode(RasterizationMode mode) {}
+
+void Renderer::setGouraudShadingEnabled(bool enabled) {}
+
+void Renderer::render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) {}
+
+void Renderer::render(const std::vector<VertexBuffer *>& vertexBuffers, IndexBuffer& indexBuffer,
+                      PrimitiveType primitiveType, const std::vector<std::pair<size_t, size_t>>& ranges) {}
+
+size_t Renderer::upload(Ego::Buffer& buffer) {
+    size_t uploaded = buffer.getInvalidSize();
+    if (!buffer.getBufferObject()) {
+        buffer.setBufferObject(std::make_unique<BufferObject>());
+        uploaded = buffer.getSize();
+    }
+    buffer.validate();
+    return uploaded;
+}
+
+std::shared_ptr<Ego::Texture> Renderer::createTexture() {
+    return std::make_shared<Texture>();
+}
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,187 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Renderer.hpp
+/// @brief  Implementation of a renderer which renders nothing
+
+#pragma once
+
+#include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Renderer/Null/Texture.hpp"
+
+/**
+ * @brief
+ *  The Egoboo null back-end. It accepts every call of the renderer interface and does nothing,
+ *  hence it neither requires a window nor an OpenGL context. Used by the headless mode.
+ */
+namespace Ego {
+namespace Null {
+
+/// An accumulation buffer facade which does nothing.
+class AccumulationBuffer : public Ego::AccumulationBuffer {
+private:
+    ColourDepth colourDepth;
+public:
+    AccumulationBuffer();
+    virtual ~AccumulationBuffer();
+    /** @copydoc Ego::Buffer<Colour4f>::clear */
+    virtual void clear() override;
+    /** @copydoc Ego::Buffer<Colour4f>::setClearValue */
+    virtual void setClearValue(const Colour4f& value) override;
+    /** @copydoc Ego::AccumulationBuffer::getColourDepth */
+    virtual const ColourDepth& getColourDepth() override;
+};
+
+/// A colour buffer facade which does nothing.
+class ColourBuffer : public Ego::ColourBuffer {
+private:
+    ColourDepth colourDepth;
+public:
+    ColourBuffer();
+    virtual ~ColourBuffer();
+    /** @copydoc Ego::Buffer<Colour4f>::clear */
+    virtual void clear() override;
+    /** @copydoc Ego::Buffer<Colour4f>::setClearValue */
+    virtual void setClearValue(const Colour4f& value) override;
+    /** @copydoc Ego::ColourBuffer::getColourDepth */
+    virtual const ColourDepth& getColourDepth() override;
+};
+
+/// A depth buffer facade which does nothing.
+class DepthBuffer : public Ego::DepthBuffer {
+public:
+    DepthBuffer();
+    virtual ~DepthBuffer();
+    /** @copydoc Ego::Buffer<float>::clear */
+    virtual void clear() override;
+    /** @copydoc Ego::Buffer<float>::setClearValue */
+    virtual void setClearValue(const float& value) override;
+    /** @copydoc Ego::DepthBuffer::getDepth */
+    virtual uint8_t getDepth() override;
+};
+
+/// A stencil buffer facade which does nothing.
+class StencilBuffer : public Ego::StencilBuffer {
+public:
+    StencilBuffer();
+    virtual ~StencilBuffer();
+    /** @copydoc Ego::Buffer<float>::clear */
+    virtual void clear() override;
+    /** @copydoc Ego::Buffer<float>::setClearValue */
+    virtual void setClearValue(const float& value) override;
+    /** @copydoc Ego::StencilBuffer::getDepth */
+    virtual uint8_t getDepth() override;
+};
+
+/// A texture unit facade which does nothing.
+class TextureUnit : public Ego::TextureUnit {
+public:
+    TextureUnit();
+    virtual ~TextureUnit();
+    /** @copydoc Ego::TextureUnit::setActivated */
+    virtual void setActivated(const Ego::Texture *texture) override;
+};
+
+class Renderer : public Ego::Renderer
+{
+protected:
+    AccumulationBuffer _accumulationBuffer;
+    ColourBuffer _colourBuffer;
+    DepthBuffer _depthBuffer;
+    StencilBuffer _stencilBuffer;
+    TextureUnit _textureUnit;
+    RendererInfo _info;
+
+public:
+    /**
+     * @brief
+     *  Construct this null renderer.
+     */
+    Renderer();
+    /**
+     * @brief
+     *  Destruct this null renderer.
+     */
+    virtual ~Renderer();
+
+public:
+    /** @copydoc Ego::Renderer::getInfo() */
+    virtual const Ego::RendererInfo& getInfo() override;
+
+    /** @copydoc Ego::Renderer::getAccumulationBuffer() */
+    virtual Ego::AccumulationBuffer& getAccumulationBuffer() override;
+
+    /** @copydoc Ego::Renderer::getColourBuffer */
+    virtual Ego::ColourBuffer& getColourBuffer() override;
+
+    /** @copydoc Ego::Renderer::getDepthBuffer() */
+    virtual Ego::DepthBuffer& getDepthBuffer() override;
+
+    /** @copydoc Ego::Renderer::getStencilBuffer() */
+    virtual Ego::StencilBuffer& getStencilBuffer() override;
+
+    /** @copydoc Ego::Renderer::getTextureUnit() */
+    virtual Ego::TextureUnit& getTextureUnit() override;
+
+    virtual void setAlphaTestEnabled(bool enabled) override;
+    virtual void setAlphaFunction(CompareFunction function, float value) override;
+    virtual void setBlendingEnabled(bool enabled) override;
+    virtual void setBlendFunction(BlendFunction sourceColour, BlendFunction sourceAlpha,
+                                  BlendFunction destinationColour, BlendFunction destinationAlpha) override;
+    virtual void setColour(const Colour4f& colour) override;
+    virtual void setCullingMode(CullingMode mode) override;
+    virtual void setDepthFunction(CompareFunction function) override;
+    virtual void setDepthTestEnabled(bool enabled) override;
+    virtual void setDepthWriteEnabled(bool enabled) override;
+    virtual void setScissorTestEnabled(bool enabled) override;
+    virtual void setScissorRectangle(float left, float bottom, float width, float height) override;
+    virtual void setStencilMaskBack(uint32_t mask) override;
+    virtual void setStencilMaskFront(uint32_t mask) override;
+    virtual void setStencilTestEnabled(bool enabled) override;
+    virtual void setViewportRectangle(float left, float bottom, float width, float height) override;
+    virtual void setWindingMode(WindingMode mode) override;
+    virtual void loadMatrix(const Matrix4f4f& matrix) override;
+    virtual void multiplyMatrix(const Matrix4f4f& matrix) override;
+    virtual void setPerspectiveCorrectionEnabled(bool enabled) override;
+    virtual void setDitheringEnabled(bool enabled) override;
+    virtual void setPointSmoothEnabled(bool enabled) override;
+    virtual void setLineSmoothEnabled(bool enabled) override;
+    virtual void setLineWidth(float width) override;
+    virtual void setPointSize(float size) override;
+    virtual void setPolygonSmoothEnabled(bool enabled) override;
+    virtual void setMultisamplesEnabled(bool enabled) override;
+    virtual void setLightingEnabled(bool enabled) override;
+    virtual void setRasterizationMode(RasterizationMode mode) override;
+    virtual void setGouraudShadingEnabled(bool enabled) override;
+    virtual void render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) override;
+
+    /** @copydoc Ego::Renderer::render */
+    virtual void render(const std::vector<VertexBuffer *>& vertexBuffers, IndexBuffer& indexBuffer,
+                        PrimitiveType primitiveType, const std::vector<std::pair<size_t, size_t>>& ranges) override;
+
+    /** @copydoc Ego::Renderer::upload */
+    virtual size_t upload(Ego::Buffer& buffer) override;
+
+    /** @copydoc Ego::Renderer::createTexture */
+    virtual std::shared_ptr<Ego::Texture> createTexture() override;
+
+}; // class Renderer
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,84 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Texture.cpp
+/// @brief  Implementation of textures for the null renderer.
+
+#include "egolib/Renderer/Null/Texture.hpp"
+
+namespace Ego {
+namespace Null {
+
+Texture::Texture() :
+    Texture("<null texture>")
+{
+    //ctor
+}
+
+Texture::Texture(const String& name) :
+    Ego::Texture(name, TextureType::_2D, TextureAddressMode::Repeat, TextureAddressMode::Repeat,
+                 1, 1, 1, 1, nullptr, false),
+    _isDefault(true)
+{
+    //ctor
+}
+
+Texture::~Texture()
+{
+    //dtor
+}
+
+bool Texture::load(const String& name, const SharedPtr<SDL_Surface>& surface)
+{
+    if (!surface) {
+        throw Id::InvalidArgumentException(__FILE__, __LINE__, "nullptr == surface");
+    }
+    _type = ((1 == surface->h) && (surface->w > 1)) ? TextureType::_1D : TextureType::_2D;
+    _width = _sourceWidth = surface->w;
+    _height = _sourceHeight = surface->h;
+    _hasAlpha = false;
+    _name = name;
+    _isDefault = false;
+    return true;
+}
+
+bool Texture::load(const SharedPtr<SDL_Surface>& surface)
+{
+    std::ostringstream stream;
+    stream << "<source " << static_cast<void *>(surface.get()) << ">";
+    return load(stream.str(), surface);
+}
+
+void Texture::release()
+{
+    _type = TextureType::_2D;
+    _width = _sourceWidth = 1;
+    _height = _sourceHeight = 1;
+    _hasAlpha = false;
+    _source = nullptr;
+    _isDefault = true;
+}
+
+bool Texture::isDefault() const
+{
+    return _isDefault;
+}
+
+} // namespace Null
+} // namespace Ego
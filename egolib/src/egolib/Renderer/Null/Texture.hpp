@@ -0,0 +1,85 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Texture.hpp
+/// @brief  Implementation of textures for the null renderer.
+
+#pragma once
+
+#include "egolib/Renderer/Texture.hpp"
+
+namespace Ego {
+namespace Null {
+
+/**
+ * @brief
+ *  A texture of the null renderer. It keeps track of the size of its source but never
+ *  holds on to any pixel data nor does it upload anything anywhere.
+ */
+class Texture : public Ego::Texture
+{
+public:
+    /**
+     * @brief
+     *  Construct this texture.
+     * @post
+     *  This texture is a default texture of size 1 x 1.
+     */
+    Texture();
+
+    /**
+     * @brief
+     *  Construct this texture.
+     * @param name
+     *  the name of this texture
+     * @post
+     *  This texture is a default texture of size 1 x 1 with the specified name.
+     */
+    Texture(const String& name);
+
+    /**
+     * @brief
+     *  Destruct this texture.
+     */
+    virtual ~Texture();
+
+public:
+    /** @override Ego::Texture::load(const String&, const SharedPtr<SDL_Surface>&) */
+    bool load(const String& name, const SharedPtr<SDL_Surface>& surface) override;
+
+    /** @override Ego::Texture::load(const SharedPtr<SDL_Surface>&) */
+    bool load(const SharedPtr<SDL_Surface>& surface) override;
+
+    /** @override Ego::Texture::release */
+    void release() override;
+
+    /** @override Ego::Texture::isDefault */
+    bool isDefault() const override;
+
+private:
+    /**
+     * @brief
+     *  @a true if no source was loaded into this texture, @a false otherwise.
+     */
+    bool _isDefault;
+
+}; // class Texture
+
+} // namespace Null
+} // namespace Ego
@@ -2,4 +2,10 @@
 #if defined(__WIN32__) || defined(__LINUX__)
 GLPROC(glStencilMaskSeparate, PFNGLSTENCILMASKSEPARATEPROC, "glStencilMaskSeparate")
 GLPROC(glBlendFuncSeparate, PFNGLBLENDFUNCSEPARATEPROC, "glBlendFuncSeparate")
+GLPROC(glMultiDrawElements, PFNGLMULTIDRAWELEMENTSPROC, "glMultiDrawElements")
+GLPROC(glGenBuffers, PFNGLGENBUFFERSPROC, "glGenBuffers")
+GLPROC(glDeleteBuffers, PFNGLDELETEBUFFERSPROC, "glDeleteBuffers")
+GLPROC(glBindBuffer, PFNGLBINDBUFFERPROC, "glBindBuffer")
+GLPROC(glBufferData, PFNGLBUFFERDATAPROC, "glBufferData")
+GLPROC(glBufferSubData, PFNGLBUFFERSUBDATAPROC, "glBufferSubData")
 #endif
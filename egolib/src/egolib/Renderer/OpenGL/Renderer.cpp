@@ -52,6 +52,26 @@ static bool link() {
     return true;
 }
 
+/**
+ * @brief
+ *  An OpenGL buffer object holding the GPU-side copy of a buffer.
+ */
+class BufferObject : public Ego::BufferObject {
+private:
+    GLuint id;
+public:
+    BufferObject() : id(0) {
+        glGenBuffers(1, &id);
+        Utilities::isError();
+    }
+    virtual ~BufferObject() {
+        glDeleteBuffers(1, &id);
+    }
+    GLuint getId() const {
+        return id;
+    }
+};
+
 } // namespace OpenGL
 } // namespace Ego
 
@@ -434,7 +454,102 @@ void Renderer::render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, s
     glDisableClientState(GL_TEXTURE_COORD_ARRAY);
     glDisableClientState(GL_NORMAL_ARRAY);
     const char *vertices = static_cast<char *>(vertexBuffer.lock());
-    const auto& vertexDescriptor = vertexBuffer.getVertexDescriptor();
+    bindVertexElements(vertexBuffer.getVertexDescriptor(), vertices);
+    const GLenum primitiveType_gl = Utilities::toOpenGL(primitiveType);
+    if (index + length > vertexBuffer.getNumberOfVertices()) {
+        throw std::invalid_argument("out of bounds");
+    }
+    // Disable the enabled client-side capabilities again. 
+    glDrawArrays(primitiveType_gl, index, length);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+}
+
+void Renderer::render(const std::vector<VertexBuffer *>& vertexBuffers, IndexBuffer& indexBuffer,
+                      PrimitiveType primitiveType, const std::vector<std::pair<size_t, size_t>>& ranges) {
+    if (ranges.empty()) {
+        return;
+    }
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    // The array pointers are relative to the buffer object bound when they are set.
+    // Buffers which were never uploaded are drawn from client memory, locked until the draw is done.
+    std::vector<std::unique_ptr<VertexBufferScopedLock>> vertexBufferLocks;
+    for (auto vertexBuffer : vertexBuffers) {
+        auto bufferObject = static_cast<BufferObject *>(vertexBuffer->getBufferObject());
+        if (bufferObject) {
+            glBindBuffer(GL_ARRAY_BUFFER, bufferObject->getId());
+            bindVertexElements(vertexBuffer->getVertexDescriptor(), nullptr);
+        } else {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            vertexBufferLocks.push_back(std::make_unique<VertexBufferScopedLock>(*vertexBuffer));
+            bindVertexElements(vertexBuffer->getVertexDescriptor(), vertexBufferLocks.back()->get<char>());
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    const char *indices;
+    std::unique_ptr<BufferScopedLock> indexBufferLock;
+    auto bufferObject = static_cast<BufferObject *>(indexBuffer.getBufferObject());
+    if (bufferObject) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferObject->getId());
+        indices = nullptr;
+    } else {
+        indexBufferLock = std::make_unique<BufferScopedLock>(indexBuffer);
+        indices = indexBufferLock->get<char>();
+    }
+    const size_t indexSize = indexBuffer.getIndexDescriptor().getIndexSize();
+    _multiDrawCounts.clear();
+    _multiDrawOffsets.clear();
+    for (const auto& range : ranges) {
+        if (range.first + range.second > indexBuffer.getNumberOfIndices()) {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            throw std::invalid_argument("out of bounds");
+        }
+        _multiDrawCounts.push_back(range.second);
+        _multiDrawOffsets.push_back(indices + range.first * indexSize);
+    }
+    const GLenum type = (IndexDescriptor::Syntax::U16 == indexBuffer.getIndexDescriptor().getSyntax())
+                      ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    glMultiDrawElements(Utilities::toOpenGL(primitiveType), _multiDrawCounts.data(), type,
+                        _multiDrawOffsets.data(), _multiDrawCounts.size());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    Utilities::isError();
+}
+
+size_t Renderer::upload(Ego::Buffer& buffer) {
+    size_t uploaded = 0;
+    const char *data = static_cast<char *>(buffer.lock());
+    auto bufferObject = static_cast<BufferObject *>(buffer.getBufferObject());
+    if (!bufferObject) {
+        auto newBufferObject = std::make_unique<BufferObject>();
+        bufferObject = newBufferObject.get();
+        buffer.setBufferObject(std::move(newBufferObject));
+        glBindBuffer(GL_ARRAY_BUFFER, bufferObject->getId());
+        glBufferData(GL_ARRAY_BUFFER, buffer.getSize(), data, GL_STATIC_DRAW);
+        uploaded = buffer.getSize();
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, bufferObject->getId());
+        for (const auto& range : buffer.getInvalidRanges()) {
+            glBufferSubData(GL_ARRAY_BUFFER, range.offset, range.size, data + range.offset);
+            uploaded += range.size;
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    buffer.unlock();
+    buffer.validate();
+    Utilities::isError();
+    return uploaded;
+}
+
+void Renderer::bindVertexElements(const VertexDescriptor& vertexDescriptor, const char *vertices) {
     for (auto it = vertexDescriptor.begin(); it != vertexDescriptor.end(); ++it) {
         const auto& vertexElementDescriptor = (*it);
         switch (vertexElementDescriptor.getSemantics()) {
@@ -552,16 +667,6 @@ void Renderer::render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, s
                 throw Core::UnhandledSwitchCaseException(__FILE__, __LINE__);
         };
     }
-    const GLenum primitiveType_gl = Utilities::toOpenGL(primitiveType);
-    if (index + length > vertexBuffer.getNumberOfVertices()) {
-        throw std::invalid_argument("out of bounds");
-    }
-    // Disable the enabled client-side capabilities again. 
-    glDrawArrays(primitiveType_gl, index, length);
-    glDisableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_COLOR_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-    glDisableClientState(GL_NORMAL_ARRAY);
 }
 
 GLenum Renderer::toOpenGL(BlendFunction source) {
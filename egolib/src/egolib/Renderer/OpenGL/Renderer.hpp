@@ -93,6 +93,16 @@ protected:
      *  The set of OpenGL extensions supported by this OpenGL implementation.
      */
     UnorderedSet<String> _extensions;
+    /**
+     * @brief
+     *  The numbers of indices of the ranges of the current multi-draw call.
+     */
+    std::vector<GLsizei> _multiDrawCounts;
+    /**
+     * @brief
+     *  The offsets of the ranges of the current multi-draw call.
+     */
+    std::vector<const GLvoid *> _multiDrawOffsets;
 
 public:
     /**
@@ -218,6 +228,13 @@ public:
     /** @copydoc Ego::Renderer::render */
     virtual void render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) override;
 
+    /** @copydoc Ego::Renderer::render */
+    virtual void render(const std::vector<VertexBuffer *>& vertexBuffers, IndexBuffer& indexBuffer,
+                        PrimitiveType primitiveType, const std::vector<std::pair<size_t, size_t>>& ranges) override;
+
+    /** @copydoc Ego::Renderer::upload */
+    virtual size_t upload(Ego::Buffer& buffer) override;
+
     /** @copydoc Ego::Renderer::createTexture */
     virtual SharedPtr<Ego::Texture> createTexture() override;
 
@@ -234,6 +251,16 @@ public:
 private:
     GLenum toOpenGL(BlendFunction source);
 
+    /**
+     * @brief
+     *  Set the client-side vertex array pointers for the elements of a vertex descriptor.
+     * @param vertexDescriptor
+     *  the vertex descriptor
+     * @param vertices
+     *  the address of the first vertex, an offset into the bound buffer object if any
+     */
+    void bindVertexElements(const VertexDescriptor& vertexDescriptor, const char *vertices);
+
 }; // class Renderer
 
 } // namespace OpenGL
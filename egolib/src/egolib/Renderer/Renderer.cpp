@@ -23,6 +23,8 @@
 
 #include "egolib/Renderer/Renderer.hpp"
 #include "egolib/Renderer/OpenGL/Renderer.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
+#include "egolib/Core/System.hpp"
 
 namespace Ego
 {
@@ -30,6 +32,10 @@ namespace Ego
 namespace Core {
 
 Renderer *CreateFunctor<Renderer>::operator()() const {
+    // A headless system has no OpenGL context.
+    if (System::get().isHeadless()) {
+        return new Ego::Null::Renderer();
+    }
     return new Ego::OpenGL::Renderer();
 }
 
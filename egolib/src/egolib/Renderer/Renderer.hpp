@@ -34,6 +34,7 @@
 #include "egolib/Renderer/TextureSampler.hpp"
 #include "egolib/Renderer/RendererInfo.hpp"
 #include "egolib/Graphics/VertexBuffer.hpp"
+#include "egolib/Graphics/IndexBuffer.hpp"
 #include "egolib/Renderer/Texture.hpp"
 #include "egolib/Extensions/ogl_debug.h"
 #include "egolib/Extensions/ogl_extensions.h"
@@ -791,6 +792,37 @@ public:
      */
     virtual void render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) = 0;
 
+    /**
+     * @brief
+     *  Render ranges of an index buffer.
+     * @param vertexBuffers
+     *  the vertex buffers, vertex @a i consists of the elements of vertex @a i of all vertex buffers
+     * @param indexBuffer
+     *  the index buffer
+     * @param primitiveType
+     *  the primitive type
+     * @param ranges
+     *  the ranges of the index buffer as pairs of the index of the first index and the number of indices
+     * @throw std::invalid_argument
+     *  if a range exceeds the number of indices in the index buffer
+     * @remark
+     *  Buffers which were uploaded are rendered from their GPU-side copies.
+     */
+    virtual void render(const std::vector<VertexBuffer *>& vertexBuffers, IndexBuffer& indexBuffer,
+                        PrimitiveType primitiveType, const std::vector<std::pair<size_t, size_t>>& ranges) = 0;
+
+    /**
+     * @brief
+     *  Upload the invalid ranges of a buffer to its GPU-side copy and validate the buffer.
+     * @param buffer
+     *  the buffer
+     * @return
+     *  the number of Bytes uploaded
+     * @remark
+     *  The first upload creates the GPU-side copy of the buffer and uploads the buffer as a whole.
+     */
+    virtual size_t upload(Ego::Buffer& buffer) = 0;
+
     /**
      * @brief
      *  Create a texture.
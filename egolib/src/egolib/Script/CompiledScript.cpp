@@ -0,0 +1,104 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Script/CompiledScript.cpp
+/// @brief  Compiled AI scripts shared between object profiles
+
+#include "egolib/Script/CompiledScript.hpp"
+
+void script_constant_t::transfer(Ego::CacheArchive& archive)
+{
+    archive(_index);
+    archive(_highbits);
+    archive(_kind);
+    archive(_text);
+}
+
+void compiled_script_t::transfer(Ego::CacheArchive& archive)
+{
+    script_info_t& script = *_script;
+
+    archive(script._parallelSafe);
+    archive(script._writesState);
+
+    // the instructions with resolved jumps
+    archive(script._instructions._length);
+    if (archive.isReading() && script._instructions._length > MAXAICOMPILESIZE)
+    {
+        archive.fail();
+        return;
+    }
+    for (size_t i = 0; i < script._instructions._length; ++i)
+    {
+        uint32_t bits = script._instructions[i].getBits();
+        archive(bits);
+        script._instructions[i].setBits(bits);
+    }
+
+    // the string constants
+    uint32_t count = static_cast<uint32_t>(_constants.size());
+    archive(count);
+    if (archive.isReading())
+    {
+        if (count > script._instructions._length)
+        {
+            archive.fail();
+            return;
+        }
+        _constants.resize(count);
+    }
+    for (script_constant_t& constant : _constants)
+    {
+        archive(constant);
+        if (archive.isReading() && constant._index >= script._instructions._length)
+        {
+            archive.fail();
+            return;
+        }
+    }
+}
+
+std::shared_ptr<script_info_t> compiled_script_t::bind(const Resolve& resolve, const std::string& name) const
+{
+    std::vector<uint32_t> values;
+    values.reserve(_constants.size());
+
+    bool same = true;
+    for (const script_constant_t& constant : _constants)
+    {
+        const uint32_t value = resolve(constant) | constant._highbits;
+        values.push_back(value);
+        same = same && value == _script->_instructions[constant._index].getBits();
+    }
+
+    // share the script
+    if (same)
+    {
+        return _script;
+    }
+
+    // patch a copy of the script
+    std::shared_ptr<script_info_t> script = std::make_shared<script_info_t>(*_script);
+    script->_name = name;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        script->_instructions[_constants[i]._index].setBits(values[i]);
+    }
+    return script;
+}
@@ -0,0 +1,76 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Script/CompiledScript.hpp
+/// @brief  Compiled AI scripts shared between object profiles
+
+#pragma once
+
+#include "egolib/Script/script.h"
+#include "egolib/FileFormats/CacheFile.hpp"
+
+/// A string constant of a compiled script. String constants are bound to a value per object profile:
+/// a message is added to the messages of the profile, an object reference "#name" is resolved to
+/// the slot number of the referenced profile which is loaded if necessary.
+struct script_constant_t
+{
+    enum class Kind : uint8_t
+    {
+        Message,
+        Object,
+    };
+
+    uint32_t _index;        ///< The index of the instruction holding the constant
+    uint32_t _highbits;     ///< The bits of that instruction besides the value of the constant
+    Kind _kind;
+    std::string _text;      ///< The message or the name of the referenced object
+
+    void transfer(Ego::CacheArchive& archive);
+};
+
+/// A compiled script with resolved jumps whose string constants are not bound yet.
+/// Profiles which bind the constants to the same values share the script.
+struct compiled_script_t
+{
+    /// A callable <tt>uint32_t(const script_constant_t&)</tt> returning the value of a constant for a profile
+    using Resolve = std::function<uint32_t(const script_constant_t&)>;
+
+    std::shared_ptr<script_info_t> _script;
+    std::vector<script_constant_t> _constants;
+
+    /**
+     * @brief
+     *  Transfer the compiled script, its classification and its string constants to or from a
+     *  cache file. Fails the archive if the cached data is out of range.
+     */
+    void transfer(Ego::CacheArchive& archive);
+
+    /**
+     * @brief
+     *  Bind the string constants to the values of a profile.
+     * @param resolve
+     *  returns the value of a constant for the profile
+     * @param name
+     *  the name of the script file of the profile
+     * @return
+     *  the shared script if all constants are bound to the values it was compiled with, otherwise
+     *  a copy of the script with the constants patched. The copy is not decoded yet.
+     */
+    std::shared_ptr<script_info_t> bind(const Resolve& resolve, const std::string& name) const;
+};
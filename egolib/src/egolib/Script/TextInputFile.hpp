@@ -33,6 +33,9 @@ namespace Script
 /**
  * @brief
  *  A text input file supports reading single characters from a file.
+ * @remark
+ *  The whole file is read into memory when the text input file is constructed,
+ *  advancing the input cursor afterwards only scans that in-memory buffer.
  * @author
  *  Michael Heilmann
  */
@@ -44,9 +47,22 @@ private:
 
     /**
      * @brief
-     *  The backing VFS file.
+     *  The contents of the file or @a nullptr if the file could not be read.
+     *  Allocated by vfs_readEntireFile or by the constructor and freed using std::free.
      */
-    vfs_FILE *_file;
+    char *_data;
+
+    /**
+     * @brief
+     *  The size, in Bytes, of the contents of the file.
+     */
+    size_t _length;
+
+    /**
+     * @brief
+     *  The index of the Byte the next call to advance() reads.
+     */
+    size_t _position;
     
     typedef typename TextFile<_Traits>::Traits Traits;
 
@@ -71,10 +87,44 @@ public:
      */
     TextInputFile(const string& fileName) :
         TextFile<_Traits>(fileName, TextFile<_Traits>::Mode::Read),
-        _file(nullptr),
+        _data(nullptr),
+        _length(0),
+        _position(0),
+        _current(Traits::startOfInput())
+    {
+        if (!vfs_readEntireFile(fileName, &_data, &_length))
+        {
+            _data = nullptr;
+            _length = 0;
+        }
+    }
+
+    /**
+     * @brief
+     *  Construct this text input file with the given file name and contents.
+     *  The VFS is not accessed.
+     * @param fileName
+     *  the file name, used for diagnostics only
+     * @param data
+     *  a pointer to the contents
+     * @param length
+     *  the size, in Bytes, of the contents
+     */
+    TextInputFile(const string& fileName, const char *data, size_t length) :
+        TextFile<_Traits>(fileName, TextFile<_Traits>::Mode::Read),
+        _data(static_cast<char *>(std::malloc(length > 0 ? length : 1))),
+        _length(length),
+        _position(0),
         _current(Traits::startOfInput())
     {
-        _file = vfs_openRead(fileName);
+        if (!_data)
+        {
+            throw bad_alloc();
+        }
+        if (length > 0)
+        {
+            std::memcpy(_data, data, length);
+        }
     }
 
     /**
@@ -83,10 +133,10 @@ public:
      */
     virtual ~TextInputFile()
     {
-        if (_file)
+        if (_data)
         {
-            vfs_close(_file);
-            _file = nullptr;
+            std::free(_data);
+            _data = nullptr;
         }
     }
 
@@ -98,7 +148,7 @@ public:
      */
     bool isOpen() const
     {
-        return nullptr != _file;
+        return nullptr != _data;
     }
 
     /**
@@ -107,9 +157,9 @@ public:
      * @remark
      *  If the file is was not opened, end of the input was reached or an error was encountered,
      *  before a call to this method, the call immediatly returns, not observably modifying the
-     *  state of this object or the file.
+     *  state of this object.
      */
-    virtual void advance()
+    void advance()
     {
         // (1) If an error or the end of the input was encountered ...
         if (_current == Traits::error() || _current == Traits::endOfInput())
@@ -117,49 +167,35 @@ public:
             // ... do nothing.
             return;
         }
-        // (2) If the backing VFS file is not opened ...
-        if (!_file)
+        // (2) If the file could not be read ...
+        if (!_data)
         {
             // ... raise an error.
             _current = Traits::error();
             return;
         }
-        // (3) Otherwise: Read a single Byte.
-        uint8_t byte;
-        size_t size = vfs_read(&byte, 1, 1, _file);
-        if (1 != size)
+        // (3) If all Bytes were consumed ...
+        if (_position == _length)
         {
-            if (vfs_error(_file))
-            {
-                _current = Traits::error();
-                return;
-            }
-            else if (vfs_eof(_file))
-            {
-                _current = Traits::endOfInput();
-                return;
-            }
-            else
-            {
-                ostringstream message;
-                message << __FILE__ << ":" << __LINE__ << ": "
-                        << "inconsistent state of file object  of file `" << this->getFileName() << "`";
-                throw runtime_error(message.str());
-            }
+            // ... the end of the input was reached.
+            _current = Traits::endOfInput();
+            return;
         }
-        // (4) Verify that it is a Byte the represents the starting Byte of a UTF-8 character sequence of length 1.
+        // (4) Otherwise: Take a single Byte.
+        const uint8_t byte = static_cast<uint8_t>(_data[_position++]);
+        // (5) Verify that it is a Byte the represents the starting Byte of a UTF-8 character sequence of length 1.
         if (byte > 0x7F)
         {
             _current = Traits::error();
             return;
         }
-        // (5) Verify that it is not the zero terminator.
+        // (6) Verify that it is not the zero terminator.
         if ('\0' == byte)
         {
             _current = Traits::error();
             return;
         }
-        // (6) Propage the Byte to an extended character and store it.
+        // (7) Propage the Byte to an extended character and store it.
         _current = (typename Traits::ExtendedType)byte;
     }
 
@@ -169,7 +205,7 @@ public:
      * @return
      *  the current extended character
      */
-    typename Traits::ExtendedType get()
+    typename Traits::ExtendedType get() const
     {
         return _current;
     }
@@ -440,8 +440,14 @@ Runtime::Runtime()
 			Define(IfStealthed)
 			Define(SetTargetToDistantFriend)
 			Define(DisplayCharge)
-		}
+		},
+		_functionTable(Ego::ScriptFunctions::SCRIPT_FUNCTIONS_COUNT, nullptr)
 {
+	for (const auto& entry : _functionValueCodeToFunctionPointer) {
+		if (entry.first < _functionTable.size()) {
+			_functionTable[entry.first] = entry.second;
+		}
+	}
 }
 
 #undef DefineAlias
@@ -464,10 +470,15 @@ static std::shared_ptr<Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive>> g
 static int    _script_function_calls[Ego::ScriptFunctions::SCRIPT_FUNCTIONS_COUNT];
 static double _script_function_times[Ego::ScriptFunctions::SCRIPT_FUNCTIONS_COUNT];
 
-static PRO_REF script_error_model = INVALID_PRO_REF;
-static const char * script_error_classname = "UNKNOWN";
+/// Scripts may run on worker threads (see let_all_characters_think), hence the per-thread error context.
+static thread_local PRO_REF script_error_model = INVALID_PRO_REF;
+static thread_local const char * script_error_classname = "UNKNOWN";
+/// The pathname of the profile running the script. The script itself might be shared with other profiles.
+static thread_local const char * script_error_pathname = "UNKNOWN";
 
 static bool _scripting_system_initialized = false;
+/// The thread which initialized the scripting system. Only invocations on this thread are timed.
+static std::thread::id _scripting_system_thread;
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -476,6 +487,7 @@ void scripting_system_begin()
 	if (!_scripting_system_initialized) {
 		Ego::Script::Runtime::initialize();
 		g_scriptFunctionClock = std::make_shared<Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive>>("script function clock", 1);
+		_scripting_system_thread = std::this_thread::get_id();
 		for (size_t i = 0; i < Ego::ScriptFunctions::SCRIPT_FUNCTIONS_COUNT; ++i) {
 			_script_function_calls[i] = 0;
 			_script_function_times[i] = 0.0F;
@@ -528,7 +540,13 @@ void scr_run_chr_script(Object *pchr) {
 		aiState.changed = false;
 	}
 
-	Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(*aiState._clock);
+	// Profiling is switchable at runtime. The timing histogram is not shared with worker threads.
+	const bool profile = egoboo_config_t::get().debug_scriptProfiling_enable.getValue()
+		              && std::this_thread::get_id() == _scripting_system_thread;
+	std::unique_ptr<Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive>> scope;
+	if (profile) {
+		scope = std::make_unique<Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive>>(*aiState._clock);
+	}
 
 	// debug a certain script
 	// debug_scripts = ( 385 == pself->index && 76 == pchr->profile_ref );
@@ -538,16 +556,19 @@ void scr_run_chr_script(Object *pchr) {
 
 	// Make life easier
 	script_error_classname = "UNKNOWN";
+	script_error_pathname = "UNKNOWN";
 	script_error_model = pchr->getProfileID();
 	if (script_error_model < INVALID_PRO_REF)
 	{
-		script_error_classname = ProfileSystem::get().getProfile(script_error_model)->getClassName().c_str();
+		const std::shared_ptr<ObjectProfile> &profile = ProfileSystem::get().getProfile(script_error_model);
+		script_error_classname = profile->getClassName().c_str();
+		script_error_pathname = profile->getPathname().c_str();
 	}
 
 	if (debug_scripts && debug_script_file) {
 		vfs_FILE * scr_file = debug_script_file;
 
-		vfs_printf(scr_file, "\n\n--------\n%s\n", script._name.c_str());
+		vfs_printf(scr_file, "\n\n--------\n%s\n", script_error_pathname);
 		vfs_printf(scr_file, "%d - %s\n", REF_TO_INT(script_error_model), script_error_classname);
 
 		// who are we related to?
@@ -596,29 +617,28 @@ void scr_run_chr_script(Object *pchr) {
 
 	// Reset the script state.
 	script_state_t my_state;
+	my_state._profile = profile;
+	my_state._self = pchr;
 
 	// Reset the ai.
 	aiState.terminate = false;
-	script.indent = 0;
+	my_state.indent = 0;
 
 	// Run the AI Script.
-	script.set_pos(0);
-	while (!aiState.terminate && script.get_pos() < script._instructions.getLength()) {
+	const std::vector<DecodedInstruction>& code = script._decoded;
+	my_state._position = 0;
+	while (!aiState.terminate && my_state._position < code.size()) {
 		// This is used by the Else function
 		// it only keeps track of functions.
-		script.indent_last = script.indent;
-		script.indent = script._instructions[script.get_pos()].getDataBits();
+		my_state.indent_last = my_state.indent;
+		my_state.indent = code[my_state._position].indent;
 
 		// Was it a function.
-		if (script._instructions[script.get_pos()].isInv()) {
-			if (!script_state_t::run_function_call(my_state, aiState, script)) {
-				break;
-			}
+		if (code[my_state._position].isFunction) {
+			script_state_t::run_function_call(my_state, aiState, script);
 		}
 		else {
-			if (!script_state_t::run_operation(my_state, aiState, script)) {
-				break;
-			}
+			script_state_t::run_operation(my_state, aiState, script);
 		}
 	}
 
@@ -671,61 +691,36 @@ void scr_run_chr_script( const ObjectRef character )
 }
 
 //--------------------------------------------------------------------------------------------
-bool script_state_t::run_function_call( script_state_t& state, ai_state_t& aiState, script_info_t& script )
+void script_state_t::run_function_call( script_state_t& state, ai_state_t& aiState, const script_info_t& script )
 {
-    Uint8  functionreturn;
-
-    // check for valid execution pointer
-    if ( script.get_pos() >= script._instructions.getLength() ) return false;
+    const DecodedInstruction& instruction = script._decoded[state._position];
 
-    // Run the function
-	functionreturn = script_state_t::run_function(state, aiState, script);
-
-    // move the execution pointer to the jump code
-    script.increment_pos();
-    if ( functionreturn )
+    // Run the function and continue with the next instruction or jump on a failure
+    if ( script_state_t::run_function( state, aiState, script ) )
     {
-        // move the execution pointer to the next opcode
-		script.increment_pos();
+        state._position++;
     }
     else
     {
-        // use the jump code to jump to the right location
-        size_t new_index = script._instructions[script.get_pos()]._value;
-
-        // make sure the value is valid
-        EGOBOO_ASSERT( new_index <= script._instructions.getLength() );
-
-        // actually do the jump
-		script.set_pos(new_index);
+        state._position = instruction.jump;
     }
-
-    return true;
 }
 
 //--------------------------------------------------------------------------------------------
-/// @todo Merge with caller.
-bool script_state_t::run_operation( script_state_t& state, ai_state_t& aiState, script_info_t& script )
+void script_state_t::run_operation( script_state_t& state, ai_state_t& aiState, const script_info_t& script )
 {
-    const char * variable;
-    Uint32 var_value, operand_count, i;
-
-
-    // check for valid execution pointer
-    if ( script.get_pos() >= script._instructions.getLength() ) return false;
-
-    var_value = script._instructions[script.get_pos()] & Instruction::VALUEBITS;
+    const DecodedInstruction& instruction = script._decoded[state._position];
 
     // debug stuff
-    variable = "UNKNOWN";
     if ( debug_scripts && debug_script_file )
     {
+        const char *variable = "UNKNOWN";
 
-        for ( i = 0; i < script.indent; i++ ) { vfs_printf( debug_script_file, "  " ); }
+        for ( uint32_t i = 0; i < state.indent; i++ ) { vfs_printf( debug_script_file, "  " ); }
 
-        for ( i = 0; i < MAX_OPCODE; i++ )
+        for ( uint32_t i = 0; i < MAX_OPCODE; i++ )
         {
-            if ( Token::Type::Variable == OpList.ary[i]._type && var_value == OpList.ary[i].iValue )
+            if ( Token::Type::Variable == OpList.ary[i]._type && instruction.value == OpList.ary[i].iValue )
             {
                 variable = OpList.ary[i].cName;
                 break;
@@ -735,16 +730,12 @@ bool script_state_t::run_operation( script_state_t& state, ai_state_t& aiState,
         vfs_printf( debug_script_file, "%s = ", variable );
     }
 
-    // Get the number of operands
-	script.increment_pos();
-    operand_count = script._instructions[script.get_pos()]._value;
-
     // Now run the operation
     state.operationsum = 0;
-    for ( i = 0; i < operand_count && script.get_pos() < script._instructions.getLength(); ++i )
+    const DecodedOperand *operand = script._operands.data() + instruction.operandBegin;
+    for ( uint32_t i = 0; i < instruction.operandCount; ++i )
     {
-		script.increment_pos();
-		script_state_t::run_operand(state, aiState, script);
+        script_state_t::run_operand( state, aiState, operand[i] );
     }
     if ( debug_scripts && debug_script_file )
     {
@@ -752,25 +743,27 @@ bool script_state_t::run_operation( script_state_t& state, ai_state_t& aiState,
     }
 
     // Save the results in the register that called the arithmetic
-    script_state_t::set_operand( state, var_value );
+    script_state_t::set_operand( state, instruction.value );
 
     // go to the next opcode
-	script.increment_pos();
-
-    return true;
+    state._position++;
 }
 
 //--------------------------------------------------------------------------------------------
-Uint8 script_state_t::run_function(script_state_t& self, ai_state_t& aiState, script_info_t& script)
+Uint8 script_state_t::run_function(script_state_t& self, ai_state_t& aiState, const script_info_t& script)
 {
     /// @author BB
     /// @details This is about half-way to what is needed for Lua integration
 
-    // Mask out the indentation
-    uint32_t valuecode = script._instructions[script.get_pos()] & Instruction::VALUEBITS;
+    const DecodedInstruction& instruction = script._decoded[self._position];
 
-    // Assume that the function will pass, as most do
-    Uint8 returncode = true;
+    // The fast path
+    if ( nullptr != instruction.function && !self._profile && !debug_scripts )
+    {
+        return instruction.function(self, aiState);
+    }
+
+    uint32_t valuecode = instruction.value;
     if ( MAX_OPCODE == valuecode )
     {
 		Log::get().message("%s:%d:%s: model == %d, class name == \"%s\" - Unknown opcode found!\n", \
@@ -781,7 +774,7 @@ Uint8 script_state_t::run_function(script_state_t& self, ai_state_t& aiState, sc
     // debug stuff
     if ( debug_scripts && debug_script_file )
     {
-        for (uint32_t i = 0; i < script.indent; i++ ) { vfs_printf( debug_script_file,  "  " ); }
+        for (uint32_t i = 0; i < self.indent; i++ ) { vfs_printf( debug_script_file,  "  " ); }
 
         for (uint32_t i = 0; i < MAX_OPCODE; i++ )
         {
@@ -793,26 +786,30 @@ Uint8 script_state_t::run_function(script_state_t& self, ai_state_t& aiState, sc
         }
     }
 
+    // Assume that the function will pass, as most do
+    Uint8 returncode = true;
     if ( valuecode > Ego::ScriptFunctions::SCRIPT_FUNCTIONS_COUNT )
     {
     	//TODO: empty block? why?
     }
+    else if ( nullptr == instruction.function )
+    {
+		Log::get().message("%s:%d:%s: script error - ai script of \"%s\" - unhandled script function %d\n", \
+			               __FILE__, __LINE__, __FUNCTION__, script_error_pathname, valuecode);
+		returncode = false;
+    }
+    else if ( !self._profile )
+    {
+        returncode = instruction.function(self, aiState);
+    }
     else
     {
-		{ 
+		{
 			Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(*g_scriptFunctionClock);
-			const auto& result = Ego::Script::Runtime::get()._functionValueCodeToFunctionPointer.find(valuecode);
-			if (Ego::Script::Runtime::get()._functionValueCodeToFunctionPointer.cend() == result) {
-				Log::get().message("%s:%d:%s: script error - ai script \"%s\" - unhandled script function %d\n", \
-					               __FILE__, __LINE__, __FUNCTION__, script._name.c_str(), valuecode);
-				returncode = false;
-			} else {
-				returncode = result->second(self, aiState);
-			}
-        }
-
-        _script_function_calls[valuecode] += 1;
-        _script_function_times[valuecode] += g_scriptFunctionClock->lst();
+			returncode = instruction.function(self, aiState);
+		}
+		_script_function_calls[valuecode] += 1;
+		_script_function_times[valuecode] += g_scriptFunctionClock->lst();
     }
 
     return returncode;
@@ -852,7 +849,7 @@ void script_state_t::set_operand( script_state_t& state, Uint8 variable )
 }
 
 //--------------------------------------------------------------------------------------------
-void script_state_t::run_operand( script_state_t& state, ai_state_t& aiState, script_info_t& script )
+void script_state_t::run_operand( script_state_t& state, ai_state_t& aiState, const DecodedOperand& operand )
 {
     /// @author ZZ
     /// @details This function does the scripted arithmetic in OPERATOR, OPERAND pscriptrs
@@ -865,35 +862,26 @@ void script_state_t::run_operand( script_state_t& state, ai_state_t& aiState, sc
 
     int32_t iTmp;
 
-    Object * pchr = NULL, * ptarget = NULL, * powner = NULL;
-
-	if (!_currentModule->getObjectHandler().exists(aiState.getSelf())) return;
-	pchr = _currentModule->getObjectHandler().get(aiState.getSelf());
-
-	if (_currentModule->getObjectHandler().exists(aiState.getTarget()))
-    {
-		ptarget = _currentModule->getObjectHandler().get(aiState.getTarget());
-    }
-
-	if (_currentModule->getObjectHandler().exists(aiState.owner))
-    {
-		powner = _currentModule->getObjectHandler().get(aiState.owner);
-    }
+    // The objects are resolved once per run, see script_state_t::getTarget() and script_state_t::getOwner()
+    Object * pchr = state._self, * ptarget = NULL, * powner = NULL;
+    if ( pchr->isTerminated() ) return;
 
     // get the operator
     iTmp      = 0;
     varname   = buffer;
-    operation = script._instructions[script.get_pos()].getDataBits();
-    if ( script._instructions[script.get_pos()].isLdc() )
+    operation = operand.operation;
+    if ( operand.isConstant )
     {
         // Get the working opcode from a constant, constants are all but high 5 bits
-        iTmp = script._instructions[script.get_pos()] & Instruction::VALUEBITS;
+        iTmp = operand.value;
         if ( debug_scripts ) snprintf( buffer, SDL_arraysize( buffer ), "%d", iTmp );
     }
     else
     {
         // Get the variable opcode from a register
-        variable = script._instructions[script.get_pos()] & Instruction::VALUEBITS;
+        variable = operand.value;
+        ptarget = state.getTarget( aiState );
+        powner = state.getOwner( aiState );
 
         switch ( variable )
         {
@@ -1500,24 +1488,83 @@ void script_state_t::run_operand( script_state_t& state, ai_state_t& aiState, sc
 
 //--------------------------------------------------------------------------------------------
 
-bool script_info_t::increment_pos() {
-	if (_position >= _instructions.getLength()) {
-		return false;
+void script_info_t::decode() {
+	// Make sure that the function table is available.
+	scripting_system_begin();
+	const std::vector<Ego::Script::NativeInterface::Function*>& functionTable = Ego::Script::Runtime::get()._functionTable;
+
+	_decoded.clear();
+	_operands.clear();
+
+	// Map the indices of the instruction list to the indices of the decoded instructions.
+	const uint32_t length = _instructions.getLength();
+	std::vector<uint32_t> decodedIndex(length + 1, std::numeric_limits<uint32_t>::max());
+	std::vector<uint32_t> jumpIndex;
+
+	uint32_t index = 0;
+	while (index < length) {
+		const Instruction& instruction = _instructions[index];
+		DecodedInstruction decoded;
+		decoded.isFunction = instruction.isInv();
+		decoded.value = instruction.getBits() & Instruction::VALUEBITS;
+		decoded.indent = instruction.getDataBits();
+		decoded.function = nullptr;
+		decoded.jump = 0;
+		decoded.operandBegin = static_cast<uint32_t>(_operands.size());
+		decoded.operandCount = 0;
+		decodedIndex[index] = static_cast<uint32_t>(_decoded.size());
+
+		if (decoded.isFunction) {
+			if (decoded.value < functionTable.size()) {
+				decoded.function = functionTable[decoded.value];
+			}
+			// The jump code follows the function.
+			jumpIndex.push_back(index + 1 < length ? _instructions[index + 1].getBits() : length);
+			index += 2;
+		} else {
+			// The operand count follows the operation, then the operands.
+			uint32_t count = index + 1 < length ? _instructions[index + 1].getBits() : 0;
+			index += 2;
+			for (uint32_t i = 0; i < count && index < length; ++i, ++index) {
+				const Instruction& operand = _instructions[index];
+				DecodedOperand decodedOperand;
+				decodedOperand.operation = operand.getDataBits();
+				decodedOperand.isConstant = operand.isLdc();
+				decodedOperand.value = operand.getBits() & Instruction::VALUEBITS;
+				_operands.push_back(decodedOperand);
+				decoded.operandCount++;
+			}
+			jumpIndex.push_back(0);
+		}
+		_decoded.push_back(decoded);
+	}
+	decodedIndex[length] = static_cast<uint32_t>(_decoded.size());
+
+	// Resolve the jumps. A jump to the end of the script or to the middle of an instruction ends the script.
+	for (size_t i = 0; i < _decoded.size(); ++i) {
+		if (_decoded[i].isFunction) {
+			const uint32_t target = std::min(jumpIndex[i], length);
+			_decoded[i].jump = decodedIndex[target] != std::numeric_limits<uint32_t>::max()
+				             ? decodedIndex[target] : static_cast<uint32_t>(_decoded.size());
+		}
 	}
-	_position++;
-    return true;
 }
 
-size_t script_info_t::get_pos() const {
-	return _position;
+Object *script_state_t::getTarget(const ai_state_t& aiState) {
+	if (aiState.getTarget() != _targetRef) {
+		_targetRef = aiState.getTarget();
+		_target = _currentModule->getObjectHandler()[_targetRef];
+	}
+	// Removed objects are terminated, hence this is equivalent to ObjectHandler::exists().
+	return (_target && !_target->isTerminated()) ? _target.get() : nullptr;
 }
 
-bool script_info_t::set_pos(size_t position) {
-	if (position >= _instructions.getLength()) {
-		return false;
+Object *script_state_t::getOwner(const ai_state_t& aiState) {
+	if (aiState.owner != _ownerRef) {
+		_ownerRef = aiState.owner;
+		_owner = _currentModule->getObjectHandler()[_ownerRef];
 	}
-	_position = position;
-    return true;
+	return (_owner && !_owner->isTerminated()) ? _owner.get() : nullptr;
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1833,12 +1880,16 @@ void ai_state_t::spawn(ai_state_t& self, const ObjectRef index, const PRO_REF io
 //--------------------------------------------------------------------------------------------
 script_state_t::script_state_t()
 	: x(0), y(0), turn(0), distance(0),
-	  argument(0), operationsum()
+	  argument(0), operationsum(),
+	  indent(0), indent_last(0), _position(0), _profile(false),
+	  _self(nullptr), _targetRef(ObjectRef::Invalid), _target(), _ownerRef(ObjectRef::Invalid), _owner()
 {
 }
 
 script_state_t::script_state_t(const script_state_t& other)
 	: x(other.x), y(other.y), turn(other.turn), distance(other.distance),
-	  argument(other.argument), operationsum(other.operationsum)
+	  argument(other.argument), operationsum(other.operationsum),
+	  indent(other.indent), indent_last(other.indent_last), _position(other._position), _profile(other._profile),
+	  _self(other._self), _targetRef(other._targetRef), _target(other._target), _ownerRef(other._ownerRef), _owner(other._owner)
 {
 }
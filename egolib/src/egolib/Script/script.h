@@ -108,6 +108,31 @@ enum chr_alert_bits
 #define STOR_COUNT          (1 << STOR_BITS)        ///< Storage data (Used in SetXY)
 #define STOR_AND            (STOR_COUNT - 1)        ///< Storage data bitmask
 
+struct script_state_t;
+struct ai_state_t;
+
+namespace Ego {
+namespace Script {
+namespace NativeInterface {
+	/**
+	 * @brief
+	 *  The type of a C/C++ native interface (NI) function.
+	 */
+	typedef uint8_t Function(script_state_t&, ai_state_t&);
+	/**
+	 * @brief
+	 *  Combination of a pointer to a C/C++ NI function with its name in the DSL.
+	 */
+	struct FunctionInfo {
+		/// The name of the function in the DSL.
+		std::string _functionName;
+		/// A pointer to the C/C++ NI function.
+		Function *_functionPointer;
+	};
+}
+} // namespace Script
+} // namespace Ego
+
 //--------------------------------------------------------------------------------------------
 // struct script_info_t
 //--------------------------------------------------------------------------------------------
@@ -289,15 +314,46 @@ struct InstructionList
 	}
 };
 
+/**
+ * @brief
+ *	An operand of an operation, decoded from the instruction list when the script is loaded.
+ */
+struct DecodedOperand
+{
+	uint8_t operation;  ///< The operator (OPADD, OPSUB, ...)
+	bool isConstant;    ///< @a true if @a value is a constant, @a false if it is a variable (VARTMPX, ...)
+	uint32_t value;     ///< The constant or the variable
+};
+
+/**
+ * @brief
+ *	A function call or an operation, decoded from the instruction list when the script is loaded.
+ * @remark
+ *	Function calls store the pointer to the native function and the resolved index of the
+ *	instruction to continue with if the function fails. Operations store the variable they
+ *	assign to and the range of their operands in script_info_t::_operands.
+ */
+struct DecodedInstruction
+{
+	bool isFunction;                                  ///< @a true for function calls, @a false for operations
+	Ego::Script::NativeInterface::Function *function; ///< The native function or @a nullptr if there is none
+	uint32_t value;                                   ///< The function value code or the variable assigned to
+	uint32_t indent;                                  ///< The indentation
+	uint32_t jump;                                    ///< Index of the next instruction if the function fails
+	uint32_t operandBegin;                            ///< Index of the first operand of an operation
+	uint32_t operandCount;                            ///< Number of operands of an operation
+};
+
 struct script_info_t
 {
 public:
     script_info_t() :
         _name(),
-        indent(0),
-        indent_last(0),
-        _position(0),
-        _instructions()
+        _instructions(),
+        _parallelSafe(false),
+        _writesState(true),
+        _decoded(),
+        _operands()
     {
         //ctor
     }
@@ -306,6 +362,9 @@ public:
 	/**
 	 * @brief
 	 *	The name of the script file.
+	 * @remark
+	 *	Profiles with the same script source text share the script, it then has the name of the
+	 *	first of them. Only compile errors are reported with this name.
 	 */
 	std::string _name;
 
@@ -319,25 +378,44 @@ public:
 		return _name;
 	}
 
-    uint32_t        indent;
-    uint32_t        indent_last;
+	/**
+	 * @brief
+	 *	The instruction list.
+	 */
+	InstructionList _instructions;
 
+	/**
+	 * @brief
+	 *	@a true if this script only calls functions and reads variables which write nothing but the
+	 *	state of the running object and do not read the A.I. state of other objects. Such scripts may
+	 *	run concurrently with each other (see let_all_characters_think()).
+	 */
+	bool _parallelSafe;
 
 	/**
 	 * @brief
-	 *	The instruction index.
+	 *	@a true if this script may change the A.I. state value (ai_state_t::state) of the running object.
+	 *	The state value is read by other objects if the profile of the object can hide (Object::isHidden()).
 	 */
-    size_t _position;
+	bool _writesState;
 
 	/**
 	 * @brief
-	 *	The instruction list.
+	 *	The decoded instructions the interpreter runs, see decode().
 	 */
-	InstructionList _instructions;
+	std::vector<DecodedInstruction> _decoded;
 
-	bool increment_pos();
-	size_t get_pos() const;
-	bool set_pos(size_t position);
+	/**
+	 * @brief
+	 *	The decoded operands of all operations.
+	 */
+	std::vector<DecodedOperand> _operands;
+
+	/**
+	 * @brief
+	 *	Decode the instruction list. Must be called after the jumps were resolved.
+	 */
+	void decode();
 
 };
 
@@ -423,15 +501,53 @@ struct script_state_t
     using TaggedValue = Ego::Script::Interpreter::TaggedValue;
     TaggedValue operationsum; /// The result of an arithmetic operation
 
+    uint32_t indent;          ///< The indentation of the current instruction
+    uint32_t indent_last;     ///< The indentation of the last function, used by the Else function
+
 	// public
 	script_state_t();
 	script_state_t(const script_state_t& self);
+
+	/**
+	 * @brief
+	 *	The index of the current instruction in script_info_t::_decoded.
+	 * @remark
+	 *	The index is part of the script state and not of script_info_t because
+	 *	several objects sharing the same script may run their scripts at the same time.
+	 */
+	size_t _position;
+
+	/**
+	 * @brief
+	 *	@a true if the invocations of script functions are timed during this run.
+	 */
+	bool _profile;
+
+	/**
+	 * @brief
+	 *	The object running the script, resolved once per run.
+	 */
+	Object *_self;
+
+	/**
+	 * @brief
+	 *	The target and the owner of the object running the script. They are only
+	 *	resolved again if a script function changes the respective reference.
+	 */
+	ObjectRef _targetRef;
+	std::shared_ptr<Object> _target;
+	ObjectRef _ownerRef;
+	std::shared_ptr<Object> _owner;
+
+	Object *getTarget(const ai_state_t& aiState);
+	Object *getOwner(const ai_state_t& aiState);
+
 	// protected
-	static Uint8 run_function(script_state_t& self, ai_state_t& aiState, script_info_t& script);
+	static Uint8 run_function(script_state_t& self, ai_state_t& aiState, const script_info_t& script);
 	static void set_operand(script_state_t& self, Uint8 variable);
-	static void run_operand(script_state_t& self, ai_state_t& aiState, script_info_t& script);
-	static bool run_operation(script_state_t& self, ai_state_t& aiState, script_info_t& script);
-	static bool run_function_call(script_state_t& self, ai_state_t& aiState, script_info_t& script);
+	static void run_operand(script_state_t& self, ai_state_t& aiState, const DecodedOperand& operand);
+	static void run_operation(script_state_t& self, ai_state_t& aiState, const script_info_t& script);
+	static void run_function_call(script_state_t& self, ai_state_t& aiState, const script_info_t& script);
 };
 
 //--------------------------------------------------------------------------------------------
@@ -447,23 +563,6 @@ void set_alerts( const ObjectRef character );
 
 namespace Ego {
 namespace Script {
-namespace NativeInterface {
-	/**
-	 * @brief
-	 *  The type of a C/C++ native interface (NI) function.
-	 */
-	typedef uint8_t Function(script_state_t&, ai_state_t&);
-	/**
-	 * @brief
-	 *  Combination of a pointer to a C/C++ NI function with its name in the DSL.
-	 */
-	struct FunctionInfo {
-		/// The name of the function in the DSL.
-		std::string _functionName;
-		/// A pointer to the C/C++ NI function.
-		Function *_functionPointer;
-	};
-}
 /**
  * @brief
  *	The runtime (environment) for the scripts.
@@ -496,6 +595,12 @@ public:
 	 *	A map from function value codes to function pointers.
 	 */
 	std::unordered_map<uint32_t, NativeInterface::Function*> _functionValueCodeToFunctionPointer;
+	/**
+	 * @brief
+	 *	The same mapping as a table indexed by function value codes.
+	 *	Entries of unhandled function value codes are @a nullptr.
+	 */
+	std::vector<NativeInterface::Function*> _functionTable;
 };
 
 } // namespace Script
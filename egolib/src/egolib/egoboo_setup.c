@@ -83,6 +83,7 @@ egoboo_config_t::egoboo_config_t() :
     graphic_simultaneousDynamicLights_max(32, "graphic.simultaneousDynamicLights.max", "inclusive upper bound of simultaneous dynamic lights"),
     graphic_framesPerSecond_max(30, "graphic.framesPerSecond.max", "inclusive upper bound of frames per second"),
     graphic_simultaneousParticles_max(768, "graphic.simultaneousParticles.max", "inclusive upper bound of simultaneous particles"),
+    graphic_parallelInstanceUpdate_enable(true, "graphic.parallelInstanceUpdate.enable", "enable/disable updating the character instances on several threads"),
     // Sound configuration section.
     sound_effects_enable(true, "sound.effects.enable", "enable/disable effects"),
     sound_effects_volume(90, "sound.effects.volume", "effects volume"),
@@ -100,13 +101,6 @@ egoboo_config_t::egoboo_config_t() :
     network_lagTolerance(10,"network.lagTolerance","tolerance of lag in seconds"),
     network_hostName("Egoboo host","network.hostName", "name of host to join"),
     network_playerName("Egoboo player", "network.playerName", "player name in network games"),
-    // Game configuration section.
-    game_difficulty(Ego::GameDifficulty::Normal, "game.difficulty", "game difficulty",
-    {
-        { "Easy", Ego::GameDifficulty::Easy },
-        { "Normal", Ego::GameDifficulty::Normal },
-        { "Hard", Ego::GameDifficulty::Hard },
-    }),
     // Camera configuration section.
     camera_control(CameraTurnMode::Auto, "camera.control", "type of camera control",
     {
@@ -114,6 +108,15 @@ egoboo_config_t::egoboo_config_t() :
         { "Auto", CameraTurnMode::Auto },
         { "None", CameraTurnMode::None },
     }),
+    // Game configuration section.
+    game_difficulty(Ego::GameDifficulty::Normal, "game.difficulty", "game difficulty",
+    {
+        { "Easy", Ego::GameDifficulty::Easy },
+        { "Normal", Ego::GameDifficulty::Normal },
+        { "Hard", Ego::GameDifficulty::Hard },
+    }),
+    game_parallelAIScripts_enable(false, "game.parallelAIScripts.enable", "enable/disable running AI scripts on several threads"),
+    game_simultaneousObjects_max(OBJECTS_MAX, "game.simultaneousObjects.max", "inclusive upper bound of simultaneous objects"),
     // HUD configuration section.
     hud_feedback(Ego::FeedbackType::Text, "hud.feedback", "feed back given to the player",
     {
@@ -133,7 +136,8 @@ egoboo_config_t::egoboo_config_t() :
     debug_hideMouse(true,"debug.hideMouse","show/hide mouse"),
     debug_grabMouse(true,"debug.grabMouse","grab/don't grab mouse"),
     debug_developerMode_enable(false,"debug.developerMode.enable","enable/disable developer mode"),
-    debug_sdlImage_enable(true,"debug.SDL_Image.enable","enable/disable advanced SDL_image function")
+    debug_sdlImage_enable(true,"debug.SDL_Image.enable","enable/disable advanced SDL_image function"),
+    debug_scriptProfiling_enable(false,"debug.scriptProfiling.enable","enable/disable timing of script functions")
 {}
 
 egoboo_config_t::~egoboo_config_t()
@@ -168,6 +172,7 @@ egoboo_config_t& egoboo_config_t::operator=(const egoboo_config_t& other)
     graphic_simultaneousDynamicLights_max = other.graphic_simultaneousDynamicLights_max;
     graphic_framesPerSecond_max = other.graphic_framesPerSecond_max;
     graphic_simultaneousParticles_max = other.graphic_simultaneousParticles_max;
+    graphic_parallelInstanceUpdate_enable = other.graphic_parallelInstanceUpdate_enable;
 
     // Sound configuration section.
     sound_effects_enable = other.sound_effects_enable;
@@ -191,6 +196,8 @@ egoboo_config_t& egoboo_config_t::operator=(const egoboo_config_t& other)
 
     // Game configuration section.
     game_difficulty = other.game_difficulty;
+    game_parallelAIScripts_enable = other.game_parallelAIScripts_enable;
+    game_simultaneousObjects_max = other.game_simultaneousObjects_max;
     
     // HUD configuration section.
     hud_displayGameTime = other.hud_displayGameTime;
@@ -208,6 +215,7 @@ egoboo_config_t& egoboo_config_t::operator=(const egoboo_config_t& other)
     debug_grabMouse = other.debug_grabMouse;
     debug_developerMode_enable = other.debug_developerMode_enable;
     debug_sdlImage_enable = other.debug_sdlImage_enable;
+    debug_scriptProfiling_enable = other.debug_scriptProfiling_enable;
 
     return *this;
 }
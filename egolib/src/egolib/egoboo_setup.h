@@ -533,6 +533,7 @@ public:
             graphic_simultaneousDynamicLights_max,
             graphic_framesPerSecond_max,
             graphic_simultaneousParticles_max,
+            graphic_parallelInstanceUpdate_enable,
             //
             sound_effects_enable,
             sound_effects_volume,
@@ -549,6 +550,8 @@ public:
             network_playerName,
             //
             game_difficulty,
+            game_parallelAIScripts_enable,
+            game_simultaneousObjects_max,
             //
             camera_control,
             //
@@ -565,7 +568,8 @@ public:
             debug_hideMouse,
             debug_grabMouse,
             debug_developerMode_enable,
-            debug_sdlImage_enable
+            debug_sdlImage_enable,
+            debug_scriptProfiling_enable
             );
         for_each(variables, f);
     }
@@ -792,10 +796,19 @@ public:
      * @brief
      *  Inclusive upper bound of the number of simultaneous particles.
      * @remark
-     *  Default value is @a 768.
+     *  Default value is @a 768, smaller values than @a 256 are raised to it and larger values than
+     *  @a PARTICLES_LIMIT are lowered to it.
      */
     StandardVariable<uint16_t> graphic_simultaneousParticles_max;
 
+    /**
+     * @brief
+     *  Enable/disable updating the instances of independent characters on several threads.
+     * @remark
+     *  Default value is @a true.
+     */
+    StandardVariable<bool> graphic_parallelInstanceUpdate_enable;
+
     // Sound configuration section.
 
     /**
@@ -936,6 +949,23 @@ public:
      */
     EnumVariable<Ego::GameDifficulty> game_difficulty;
 
+    /**
+     * @brief
+     *  Enable/disable running the AI scripts of independent objects on several threads.
+     * @remark
+     *  Default value is @a false.
+     */
+    StandardVariable<bool> game_parallelAIScripts_enable;
+
+    /**
+     * @brief
+     *  Inclusive upper bound of the number of simultaneous objects.
+     * @remark
+     *  Default value is @a OBJECTS_MAX, @a 0 is raised to @a 1 and larger values than @a OBJECTS_LIMIT
+     *  are lowered to it.
+     */
+    StandardVariable<uint16_t> game_simultaneousObjects_max;
+
     // HUD configuration section.
 
     /**
@@ -1049,6 +1079,15 @@ public:
      */
     StandardVariable<bool> debug_sdlImage_enable;
 
+    /**
+     * @brief
+     *  Enable/disable timing of script function invocations.
+     *  The timings are written to "/debug/script_function_timing.txt".
+     * @remark
+     *  Default value is @a false.
+     */
+    StandardVariable<bool> debug_scriptProfiling_enable;
+
 public:
 
     /**
@@ -72,6 +72,7 @@
 //--------------------------------------------------------------------------------------------
 
 #include "egolib/AI/AStar.hpp"
+#include "egolib/AI/PathService.hpp"
 #include "egolib/AI/LineOfSight.hpp"
 
 //--------------------------------------------------------------------------------------------
@@ -56,12 +56,21 @@
 
 /**
  * @brief
- *  The maximum number of objects.
+ *  The default maximum number of objects.
+ *  The actual maximum is configured by <tt>game.simultaneousObjects.max</tt>.
  * @ingroup
  *  compile-time
  */
 #define OBJECTS_MAX 512
 
+/**
+ * @brief
+ *  The largest maximum number of objects, 16 times the default. Larger configured maxima are lowered to it.
+ * @ingroup
+ *  compile-time
+ */
+#define OBJECTS_LIMIT (16 * OBJECTS_MAX)
+
 /**
  * @brief
  *  The maximum number of enchants.
@@ -80,12 +89,21 @@
 
 /**
  * @brief
- *  The maximum number of particles.
+ *  A reference number of particles.
+ *  The actual maximum is configured by <tt>graphic.simultaneousParticles.max</tt>.
  * @ingroup
  *  compile-time
  */
 #define PARTICLES_MAX 2048
 
+/**
+ * @brief
+ *  The largest maximum number of particles, 16 times the reference number. Larger configured maxima are lowered to it.
+ * @ingroup
+ *  compile-time
+ */
+#define PARTICLES_LIMIT (16 * PARTICLES_MAX)
+
 /**
  * @brief
  *  Maximum number of particle profiles (i.e. <tt>part*.text</tt> files) per object profile.
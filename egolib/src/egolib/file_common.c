@@ -161,7 +161,7 @@ int fs_fileExists(const char *filename)
 #if 0
 const char *fs_createBinaryDirectoryFilename(const char *relative_pathname)
 {
-    static char path[1024]; ///< @todo Not mt-safe.
+    static thread_local char path[1024];
     const char *dir_name_ptr;
 
     path[0] = CSTR_END;
@@ -184,7 +184,7 @@ const char *fs_createBinaryDirectoryFilename(const char *relative_pathname)
 //--------------------------------------------------------------------------------------------
 const char *fs_createDataDirectoryFilename(const char *relative_pathname)
 {
-    static char path[1024]; ///< @todo Not mt-safe.
+    static thread_local char path[1024];
     const char *dir_name_ptr;
 
     path[0] = CSTR_END;
@@ -207,7 +207,7 @@ const char *fs_createDataDirectoryFilename(const char *relative_pathname)
 //--------------------------------------------------------------------------------------------
 const char * fs_createUserDirectoryFilename(const char *relative_pathname)
 {
-    static char path[1024]; ///< @todo Not mt-safe.
+    static thread_local char path[1024];
     const char *dir_name_ptr;
 
     path[0] = CSTR_END;
@@ -230,7 +230,7 @@ const char * fs_createUserDirectoryFilename(const char *relative_pathname)
 //--------------------------------------------------------------------------------------------
 const char *fs_createConfigDirectoryFilename(const char *relative_pathname)
 {
-    static char path[1024];
+    static thread_local char path[1024];
     const char * dir_name_ptr;
 
     path[0] = CSTR_END;
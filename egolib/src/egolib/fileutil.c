@@ -1631,20 +1631,13 @@ bool ego_texture_exists_vfs(const std::string &filename)
     return false;
 }
 
-bool  ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *filename)
+std::shared_ptr<SDL_Surface> ego_texture_decode_vfs(const std::string& filename, std::string& fullFilename)
 {
-    // Get rid of any old data.
-    texture->release();
-
-    // Load the image.
-    bool retval = false;
-
     // Try all different formats.
     for (const auto& loader : ImageManager::get())
     {
-        texture->release();
         // Build the full file name.
-        std::string fullFilename = filename + loader.getExtension();
+        fullFilename = filename + loader.getExtension();
         // Open the file.
         vfs_FILE *file = vfs_openRead(fullFilename);
         if (!file)
@@ -1663,16 +1656,28 @@ bool  ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *fi
             continue;
         }
         vfs_close(file);
-        if (!surface)
+        if (surface)
         {
-            continue;
+            return surface;
         }
+    }
+    return nullptr;
+}
+
+bool  ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *filename)
+{
+    // Get rid of any old data.
+    texture->release();
+
+    // Load the image.
+    bool retval = false;
+
+    std::string fullFilename;
+    std::shared_ptr<SDL_Surface> surface = ego_texture_decode_vfs(filename, fullFilename);
+    if (surface)
+    {
         // Create the texture from the surface.
         retval = texture->load(fullFilename.c_str(), surface);
-        if (retval)
-        {
-            break;
-        }
     }
 
     if(!retval) {
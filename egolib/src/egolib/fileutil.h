@@ -467,6 +467,19 @@ bool copy_to_delimiter_vfs(vfs_FILE * fileread, vfs_FILE * filewrite, int delim,
  */
 bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *filename);
 
+/**
+ * @brief
+ *  Read and decode an image without uploading it. This does not require an OpenGL context.
+ * @param filename
+ *  the filename of the image <em>without</em> extension
+ * @param [out] fullFilename
+ *  the filename including the extension of the image that was decoded
+ * @return
+ *  the decoded image, @a nullptr if no combination of the filename with a supported
+ *  file extension could be decoded
+ */
+std::shared_ptr<SDL_Surface> ego_texture_decode_vfs(const std::string& filename, std::string& fullFilename);
+
 bool ego_texture_exists_vfs(const std::string &filename);
 
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
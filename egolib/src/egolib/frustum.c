@@ -24,6 +24,11 @@
 
 #include "egolib/frustum.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define EGO_FRUSTUM_SSE 1
+    #include <xmmintrin.h>
+#endif
+
 namespace Ego {
 namespace Graphics {
 
@@ -409,6 +414,84 @@ bool Frustum::intersects(const oct_bb_t& oct, const bool doEnds) const {
 	return result > Math::Relation::outside;
 }
 
+void Frustum::intersects_spheres(const float *x, const float *y, const float *z, const float *radius, size_t count, bool doEnds, uint32_t *visible) const {
+    // Handle optional parameters.
+    const int end = doEnds ? Planes::END : Planes::SIDES_END;
+
+    std::fill(visible, visible + (count + 31) / 32, 0);
+
+    size_t i = 0;
+#if defined(EGO_FRUSTUM_SSE)
+    // Test four spheres against one plane at a time. The distances are computed in the same order
+    // as by Plane3f::distance such that the results are the same as the ones of the scalar test.
+    for (; i + 4 <= count; i += 4) {
+        const __m128 cx = _mm_loadu_ps(x + i),
+                     cy = _mm_loadu_ps(y + i),
+                     cz = _mm_loadu_ps(z + i),
+                     nr = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+        __m128 outside = _mm_setzero_ps();
+        for (int j = 0; j <= end; ++j) {
+            const Vector3f& n = _planes[j].getNormal();
+            __m128 dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(n[kX]), cx), _mm_mul_ps(_mm_set1_ps(n[kY]), cy));
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(n[kZ]), cz));
+            dist = _mm_add_ps(dist, _mm_set1_ps(_planes[j].getDistance()));
+            // If the sphere is completely behind the plane, it is outside the frustum.
+            outside = _mm_or_ps(outside, _mm_cmple_ps(dist, nr));
+        }
+        visible[i / 32] |= static_cast<uint32_t>(~_mm_movemask_ps(outside) & 0xf) << (i % 32);
+    }
+#endif
+    for (; i < count; ++i) {
+        const Vector3f center(x[i], y[i], z[i]);
+        bool outside = false;
+        for (int j = 0; j <= end && !outside; ++j) {
+            outside = _planes[j].distance(center) <= -radius[i];
+        }
+        if (!outside) {
+            visible[i / 32] |= 1u << (i % 32);
+        }
+    }
+}
+
+void Frustum::intersects_aabbs(const float *minX, const float *minY, const float *minZ,
+                               const float *maxX, const float *maxY, const float *maxZ,
+                               size_t count, bool doEnds, uint32_t *visible) const {
+    // Handle optional parameters.
+    const int end = doEnds ? Planes::END : Planes::SIDES_END;
+
+    std::fill(visible, visible + (count + 31) / 32, 0);
+
+    size_t i = 0;
+#if defined(EGO_FRUSTUM_SSE)
+    // Test four AABBs against one plane at a time. As for plane_intersects_aabb_max, an AABB is
+    // outside of a plane if its most-positive corner with respect to the plane normal is behind it.
+    for (; i + 4 <= count; i += 4) {
+        const __m128 mins[3] = { _mm_loadu_ps(minX + i), _mm_loadu_ps(minY + i), _mm_loadu_ps(minZ + i) },
+                     maxs[3] = { _mm_loadu_ps(maxX + i), _mm_loadu_ps(maxY + i), _mm_loadu_ps(maxZ + i) };
+        __m128 outside = _mm_setzero_ps();
+        for (int j = 0; j <= end; ++j) {
+            const Vector3f& n = _planes[j].getNormal();
+            __m128 dist = _mm_mul_ps(_mm_set1_ps(n[kX]), n[kX] > 0.0f ? maxs[kX] : mins[kX]);
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(n[kY]), n[kY] > 0.0f ? maxs[kY] : mins[kY]));
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(n[kZ]), n[kZ] > 0.0f ? maxs[kZ] : mins[kZ]));
+            dist = _mm_add_ps(dist, _mm_set1_ps(_planes[j].getDistance()));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_setzero_ps()));
+        }
+        visible[i / 32] |= static_cast<uint32_t>(~_mm_movemask_ps(outside) & 0xf) << (i % 32);
+    }
+#endif
+    for (; i < count; ++i) {
+        const Vector3f mins(minX[i], minY[i], minZ[i]), maxs(maxX[i], maxY[i], maxZ[i]);
+        bool outside = false;
+        for (int j = 0; j <= end && !outside; ++j) {
+            outside = Math::Relation::outside == plane_intersects_aabb_max(_planes[j], mins, maxs);
+        }
+        if (!outside) {
+            visible[i / 32] |= 1u << (i % 32);
+        }
+    }
+}
+
 #pragma pop_macro("NEAR")
 #pragma pop_macro("near")
 #pragma pop_macro("FAR")
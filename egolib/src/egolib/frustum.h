@@ -162,6 +162,44 @@ public:
 	/// @todo Should return geometry_rv.
 	bool intersects(const oct_bb_t& oct, const bool doEnds) const;
 
+    /**
+     * @brief
+     *  Get which spheres of a batch of spheres are not outside this frustum.
+     * @param x, y, z, radius
+     *  arrays of @a count entries each, the sphere @a i has the center <tt>(x[i], y[i], z[i])</tt> and the radius <tt>radius[i]</tt>
+     * @param count
+     *  the number of spheres
+     * @param doEnds
+     *  if @a false, the far and the near plane are ignored
+     * @param [out] visible
+     *  an array of <tt>(count + 31) / 32</tt> words. Bit <tt>i % 32</tt> of word <tt>i / 32</tt> is set
+     *  if the sphere @a i is not outside this frustum, all other bits are cleared.
+     * @remark
+     *  A sphere is outside this frustum under the same condition as for intersects(const Sphere3f&, const bool).
+     *  Four spheres are tested at a time if SSE is available.
+     */
+    void intersects_spheres(const float *x, const float *y, const float *z, const float *radius, size_t count, bool doEnds, uint32_t *visible) const;
+
+    /**
+     * @brief
+     *  Get which AABBs of a batch of AABBs are not outside this frustum.
+     * @param minX, minY, minZ, maxX, maxY, maxZ
+     *  arrays of @a count entries each, the AABB @a i has the corners <tt>(minX[i], minY[i], minZ[i])</tt> and <tt>(maxX[i], maxY[i], maxZ[i])</tt>
+     * @param count
+     *  the number of AABBs
+     * @param doEnds
+     *  if @a false, the far and the near plane are ignored
+     * @param [out] visible
+     *  an array of <tt>(count + 31) / 32</tt> words. Bit <tt>i % 32</tt> of word <tt>i / 32</tt> is set
+     *  if the AABB @a i is not outside this frustum, all other bits are cleared.
+     * @remark
+     *  An AABB is outside this frustum under the same condition as for intersects(const AABB3f&, bool).
+     *  Four AABBs are tested at a time if SSE is available.
+     */
+    void intersects_aabbs(const float *minX, const float *minY, const float *minZ,
+                          const float *maxX, const float *maxY, const float *maxZ,
+                          size_t count, bool doEnds, uint32_t *visible) const;
+
     /**
     * @brief
     *	Call this every time the camera moves or the projection matrix changes to update the frustum
@@ -119,6 +119,9 @@ struct s_vfs_search_context
     BIT_FIELD  bits;
 
     VFS_PATH found;
+
+    std::vector<std::string> names;     ///< The names listed by the manifest
+    std::vector<char *>      name_ptrs; ///< Null terminated list of pointers into @a names, see @a file_list
 };
 
 struct s_vfs_path_data
@@ -162,6 +165,12 @@ static void _vfs_findClose(vfs_search_context_t *ctxt);
 
 static int fake_physfs_vprintf(PHYSFS_File *file, const char *format, va_list args);
 
+static void _vfs_manifest_invalidate();
+static void _vfs_manifest_update(const std::string& path, bool removed);
+static bool _vfs_manifest_exists(const std::string& path, bool *is_directory);
+static bool _vfs_manifest_get_real_dir(const std::string& path, std::string& real_dir);
+static void _vfs_manifest_list(const std::string& path, std::vector<std::string>& names);
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 int vfs_init(const char *argv0, const char *root_dir)
@@ -241,6 +250,7 @@ int vfs_init(const char *argv0, const char *root_dir)
 //--------------------------------------------------------------------------------------------
 void _vfs_exit()
 {
+    _vfs_manifest_invalidate();
     PHYSFS_deinit();
 }
 
@@ -273,6 +283,251 @@ bool validate(const std::string& source, std::string& target) {
     }
 }
 
+//--------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------
+
+/// An entry of a directory in the manifest.
+struct vfs_manifest_entry_t
+{
+    bool        is_directory;
+    bool        has_real_dir;   ///< @a true if @a real_dir was looked up already
+    std::string real_dir;       ///< The directory or archive providing this entry, see PHYSFS_getRealDir()
+};
+
+/// A directory in the manifest.
+struct vfs_manifest_directory_t
+{
+    std::vector<std::string> names;                                 ///< The names of the entries in PhysFS order
+    std::unordered_map<std::string, vfs_manifest_entry_t> entries;  ///< The entries by key, see _vfs_manifest_key()
+};
+
+/// @brief The manifest of the virtual file system.
+/// @details Every directory is listed through PhysFS once, the first time a path inside it is
+///          queried. All further queries, hits and misses alike, are answered by a hash lookup.
+///          Writing to the write directory updates the affected entries only, the manifest is
+///          dropped as a whole whenever the search path changes.
+static std::unordered_map<std::string, vfs_manifest_directory_t> _vfs_manifest;
+static std::mutex _vfs_manifest_mutex;
+
+/// Convert a path to the canonical form used by the manifest: forward slashes, no leading,
+/// trailing or repeated slashes. The root directory is the empty string.
+static std::string _vfs_manifest_canonical(const std::string& path)
+{
+    std::string canonical;
+    canonical.reserve(path.size());
+    for (char c : path)
+    {
+        if (WIN32_SLASH_CHR == c) c = NET_SLASH_CHR;
+        if (NET_SLASH_CHR == c && (canonical.empty() || NET_SLASH_CHR == canonical.back())) continue;
+        canonical.push_back(c);
+    }
+    if (!canonical.empty() && NET_SLASH_CHR == canonical.back()) canonical.pop_back();
+    return canonical;
+}
+
+/// Convert a canonical path or a name to a key in the manifest. Native directories are
+/// case-insensitive on Windows and Mac OS X, so are the keys. PhysFS is always queried with
+/// the canonical path itself.
+static std::string _vfs_manifest_key(const std::string& canonical)
+{
+#if defined(ID_WINDOWS) || defined(ID_OSX)
+    std::string key = canonical;
+    std::transform(key.begin(), key.end(), key.begin(), [](char c) { return static_cast<char>(::tolower(static_cast<unsigned char>(c))); });
+    return key;
+#else
+    return canonical;
+#endif
+}
+
+/// Split a canonical path into its parent directory and its name.
+static void _vfs_manifest_split(const std::string& canonical, std::string& parent, std::string& name)
+{
+    const size_t slash = canonical.rfind(NET_SLASH_CHR);
+    parent = (std::string::npos == slash) ? std::string() : canonical.substr(0, slash);
+    name = (std::string::npos == slash) ? canonical : canonical.substr(slash + 1);
+}
+
+static const vfs_manifest_directory_t& _vfs_manifest_get_directory(const std::string& canonical)
+{
+    const std::string key = _vfs_manifest_key(canonical);
+    auto it = _vfs_manifest.find(key);
+    if (it != _vfs_manifest.end()) return it->second;
+
+    vfs_manifest_directory_t& directory = _vfs_manifest[key];
+    const std::string prefix = canonical.empty() ? std::string() : canonical + NET_SLASH_STR;
+
+    char **list = PHYSFS_enumerateFiles(canonical.empty() ? NET_SLASH_STR : canonical.c_str());
+    if (NULL != list)
+    {
+        for (char **name = list; NULL != *name; ++name)
+        {
+            vfs_manifest_entry_t entry;
+            entry.is_directory = 0 != PHYSFS_isDirectory((prefix + *name).c_str());
+            entry.has_real_dir = false;
+            if (directory.entries.emplace(_vfs_manifest_key(*name), entry).second)
+            {
+                directory.names.push_back(*name);
+            }
+        }
+        PHYSFS_freeList(list);
+    }
+
+    return directory;
+}
+
+/// @return the entry of a canonical path, @a nullptr if there is no such file or directory or if the path is the root directory
+/// @remark The entry is only valid as long as the manifest mutex is held.
+static vfs_manifest_entry_t *_vfs_manifest_find(const std::string& canonical)
+{
+    if (canonical.empty()) return nullptr;
+
+    std::string parent, name;
+    _vfs_manifest_split(canonical, parent, name);
+
+    // do not list directories that do not exist
+    if (!parent.empty())
+    {
+        const vfs_manifest_entry_t *parent_entry = _vfs_manifest_find(parent);
+        if (nullptr == parent_entry || !parent_entry->is_directory) return nullptr;
+    }
+
+    const vfs_manifest_directory_t& directory = _vfs_manifest_get_directory(parent);
+    auto it = directory.entries.find(_vfs_manifest_key(name));
+    if (it == directory.entries.end()) return nullptr;
+
+    return const_cast<vfs_manifest_entry_t *>(&it->second);
+}
+
+/// Query the entry of a canonical path from PhysFS again, if its directory is listed already.
+static void _vfs_manifest_refresh_entry(const std::string& canonical)
+{
+    std::string parent, name;
+    _vfs_manifest_split(canonical, parent, name);
+
+    // directories not listed yet are read from PhysFS when they are first queried
+    auto directory = _vfs_manifest.find(_vfs_manifest_key(parent));
+    if (directory == _vfs_manifest.end()) return;
+
+    const std::string key = _vfs_manifest_key(name);
+    auto entry = directory->second.entries.find(key);
+    if (0 != PHYSFS_exists(canonical.c_str()))
+    {
+        if (entry == directory->second.entries.end())
+        {
+            entry = directory->second.entries.emplace(key, vfs_manifest_entry_t()).first;
+            directory->second.names.push_back(name);
+        }
+        entry->second.is_directory = 0 != PHYSFS_isDirectory(canonical.c_str());
+        // the write directory might provide this entry now
+        entry->second.has_real_dir = false;
+    }
+    else if (entry != directory->second.entries.end())
+    {
+        std::vector<std::string>& names = directory->second.names;
+        names.erase(std::remove_if(names.begin(), names.end(),
+                                   [&key](const std::string& other) { return _vfs_manifest_key(other) == key; }),
+                    names.end());
+        directory->second.entries.erase(entry);
+    }
+}
+
+/// Update the manifest after a file or directory was created or removed in the write directory.
+/// @param path the created or removed file or directory
+/// @param removed @a true if @a path or its contents were removed. The listings of @a path and
+///                of all directories below it are dropped.
+static void _vfs_manifest_update(const std::string& path, bool removed)
+{
+    std::lock_guard<std::mutex> lock(_vfs_manifest_mutex);
+
+    const std::string canonical = _vfs_manifest_canonical(path);
+    if (canonical.empty())
+    {
+        // the root directory itself never changes
+        if (removed) _vfs_manifest.clear();
+        return;
+    }
+
+    // PHYSFS_mkdir() creates all missing parent directories, so every component may be new
+    for (size_t slash = canonical.find(NET_SLASH_CHR); std::string::npos != slash; slash = canonical.find(NET_SLASH_CHR, slash + 1))
+    {
+        _vfs_manifest_refresh_entry(canonical.substr(0, slash));
+    }
+    _vfs_manifest_refresh_entry(canonical);
+
+    if (removed)
+    {
+        const std::string key = _vfs_manifest_key(canonical);
+        const std::string prefix = key + NET_SLASH_STR;
+        for (auto it = _vfs_manifest.begin(); it != _vfs_manifest.end();)
+        {
+            if (it->first == key || 0 == it->first.compare(0, prefix.size(), prefix))
+            {
+                it = _vfs_manifest.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+void _vfs_manifest_invalidate()
+{
+    std::lock_guard<std::mutex> lock(_vfs_manifest_mutex);
+    _vfs_manifest.clear();
+}
+
+bool _vfs_manifest_exists(const std::string& path, bool *is_directory)
+{
+    std::lock_guard<std::mutex> lock(_vfs_manifest_mutex);
+
+    const std::string canonical = _vfs_manifest_canonical(path);
+    if (canonical.empty())
+    {
+        if (NULL != is_directory) *is_directory = true;
+        return true;
+    }
+
+    const vfs_manifest_entry_t *entry = _vfs_manifest_find(canonical);
+    if (NULL != is_directory) *is_directory = (nullptr != entry) && entry->is_directory;
+    return nullptr != entry;
+}
+
+bool _vfs_manifest_get_real_dir(const std::string& path, std::string& real_dir)
+{
+    std::lock_guard<std::mutex> lock(_vfs_manifest_mutex);
+
+    const std::string canonical = _vfs_manifest_canonical(path);
+    vfs_manifest_entry_t *entry = _vfs_manifest_find(canonical);
+    if (nullptr == entry) return false;
+
+    if (!entry->has_real_dir)
+    {
+        const char *tmp = PHYSFS_getRealDir(canonical.c_str());
+        entry->real_dir = (NULL == tmp) ? std::string() : std::string(tmp);
+        entry->has_real_dir = true;
+    }
+    real_dir = entry->real_dir;
+    return !real_dir.empty();
+}
+
+void _vfs_manifest_list(const std::string& path, std::vector<std::string>& names)
+{
+    std::lock_guard<std::mutex> lock(_vfs_manifest_mutex);
+
+    names.clear();
+    const std::string canonical = _vfs_manifest_canonical(path);
+    if (!canonical.empty())
+    {
+        const vfs_manifest_entry_t *entry = _vfs_manifest_find(canonical);
+        if (nullptr == entry || !entry->is_directory) return;
+    }
+    names = _vfs_manifest_get_directory(canonical).names;
+}
+
+//--------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------
 vfs_FILE *vfs_openRead(const std::string& pathname)
 {
     BAIL_IF_NOT_INIT();
@@ -282,6 +537,11 @@ vfs_FILE *vfs_openRead(const std::string& pathname)
         return nullptr;
     }
 
+    // misses are answered by the manifest
+    if (!_vfs_manifest_exists(temporary, nullptr)) {
+        return nullptr;
+    }
+
     PHYSFS_File *ftmp = PHYSFS_openRead(temporary.c_str());
     if (!ftmp)
     {
@@ -330,6 +590,7 @@ vfs_FILE *vfs_openWrite(const std::string& pathname)
     #endif
         return NULL;
     }
+    _vfs_manifest_update(temporary, false);
 
     // Open the VFS file.
 	vfs_FILE *vfs_file;
@@ -363,6 +624,7 @@ vfs_FILE *vfs_openAppend(const std::string& pathname)
     #endif
         return NULL;
     }
+    _vfs_manifest_update(temporary, false);
 
 	vfs_FILE *vfs_file;
 	try {
@@ -394,7 +656,7 @@ const char * vfs_convert_fname_sys( const char * fname )
     // a tile that needs to be created. The optimal solution might be to check to see if
     // the path belongs to a registered virtual mount point?
 
-    static VFS_PATH local_fname = EMPTY_CSTR;
+    static thread_local VFS_PATH local_fname = EMPTY_CSTR;
 
     size_t   offset;
     VFS_PATH copy_fname  = EMPTY_CSTR;
@@ -471,7 +733,7 @@ const char * vfs_convert_fname_sys( const char * fname )
 const char * vfs_convert_fname( const char * fname )
 {
     VFS_PATH        copy_fname  = EMPTY_CSTR;
-    static VFS_PATH local_fname = EMPTY_CSTR;
+    static thread_local VFS_PATH local_fname = EMPTY_CSTR;
 
     BAIL_IF_NOT_INIT();
 
@@ -519,7 +781,7 @@ const char * vfs_convert_fname( const char * fname )
     //    path returned by PHYSFS_getRealDir()
 
     const char * ptmp, *path_begin, *path_end;
-    static VFS_PATH found_path;
+    static thread_local VFS_PATH found_path;
 
     found_path[0] = CSTR_END;
 
@@ -583,7 +845,7 @@ void vfs_listSearchPaths( void )
 //--------------------------------------------------------------------------------------------
 const char * vfs_resolveReadFilename( const char * src_filename )
 {
-    static STRING read_name_str = EMPTY_CSTR;
+    static thread_local STRING read_name_str = EMPTY_CSTR;
     VFS_PATH      loc_fname = EMPTY_CSTR, szTemp = EMPTY_CSTR;
     int           retval_len = 0;
     const char   *retval = NULL;
@@ -614,12 +876,14 @@ const char * vfs_resolveReadFilename( const char * src_filename )
 
     retval = NULL;
     retval_len = 0;
-    if ( PHYSFS_isDirectory( loc_fname ) )
+    bool is_directory = false;
+    std::string real_dir;
+    if ( _vfs_manifest_exists( loc_fname, &is_directory ) && is_directory )
     {
-        retval = PHYSFS_getRealDir( loc_fname );
-
-        if ( VALID_CSTR( retval ) )
+        if ( _vfs_manifest_get_real_dir( loc_fname, real_dir ) )
         {
+            retval = real_dir.c_str();
+
             const char * ptmp = vfs_mount_info_strip_path( loc_fname );
 
             if ( VALID_CSTR( ptmp ) )
@@ -637,13 +901,10 @@ const char * vfs_resolveReadFilename( const char * src_filename )
     }
     else
     {
-        const char * tmp_dirname;
         const char * ptmp = loc_fname;
 
         // make PHYSFS grab the actual directory
-        tmp_dirname = PHYSFS_getRealDir( loc_fname );
-
-        if ( INVALID_CSTR( tmp_dirname ) )
+        if ( !_vfs_manifest_get_real_dir( loc_fname, real_dir ) )
         {
             // not found... just punt
             strncpy( read_name_str, loc_fname, SDL_arraysize( read_name_str ) );
@@ -654,7 +915,7 @@ const char * vfs_resolveReadFilename( const char * src_filename )
         {
             ptmp = vfs_mount_info_strip_path( loc_fname );
 
-            snprintf( read_name_str, SDL_arraysize( read_name_str ), "%s/%s", tmp_dirname, ptmp );
+            snprintf( read_name_str, SDL_arraysize( read_name_str ), "%s/%s", real_dir.c_str(), ptmp );
             retval     = read_name_str;
             retval_len = SDL_arraysize( read_name_str );
         }
@@ -671,7 +932,7 @@ const char * vfs_resolveReadFilename( const char * src_filename )
 //--------------------------------------------------------------------------------------------
 const char * vfs_resolveWriteFilename( const char * src_filename )
 {
-    static VFS_PATH  szFname = EMPTY_CSTR;
+    static thread_local VFS_PATH  szFname = EMPTY_CSTR;
     VFS_PATH szTemp;
     const  char    * write_dir;
 
@@ -1003,6 +1264,7 @@ bool vfs_mkdir(const std::string& pathname) {
         Log::get().debug("PHYSF_mkdir(%s) failed: %s\n", pathname.c_str(), vfs_getError());
         return false;
     }
+    _vfs_manifest_update(temporary, false);
 
     return true;
 }
@@ -1020,6 +1282,7 @@ bool vfs_delete_file(const std::string& pathname)
         Log::get().debug("PHYSF_delete(%s) failed: %s\n", pathname.c_str(), vfs_getError());
         return false;
     }
+    _vfs_manifest_update(temporary, true);
     return true;
 }
 
@@ -1029,7 +1292,7 @@ bool vfs_exists(const std::string& pathname) {
     if (!validate(pathname, temporary)) {
         return false;
     }
-    return (0 != PHYSFS_exists(temporary.c_str()));
+    return _vfs_manifest_exists(temporary, nullptr);
 }
 
 bool vfs_isDirectory(const std::string& pathname) {
@@ -1038,7 +1301,21 @@ bool vfs_isDirectory(const std::string& pathname) {
     if (!validate(pathname, temporary)) {
         return false;
     }
-    return 0 != PHYSFS_isDirectory(temporary.c_str());
+    bool is_directory;
+    return _vfs_manifest_exists(temporary, &is_directory) && is_directory;
+}
+
+int64_t vfs_getLastModTime(const std::string& pathname) {
+    BAIL_IF_NOT_INIT();
+    std::string temporary;
+    if (!validate(pathname, temporary)) {
+        return -1;
+    }
+    // answer misses from the manifest, e.g. if a cache file is probed for a source that does not exist
+    if (!_vfs_manifest_exists(temporary, nullptr)) {
+        return -1;
+    }
+    return PHYSFS_getLastModTime(temporary.c_str());
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1967,19 +2244,17 @@ void _vfs_findClose( vfs_search_context_t * ctxt )
 
     if ( NULL == ctxt ) return;
 
-    if ( NULL != ctxt->file_list )
-    {
-        PHYSFS_freeList( ctxt->file_list );
-        ctxt->file_list = NULL;
-    }
+    ctxt->file_list = NULL;
     ctxt->ptr       = NULL;
+    ctxt->name_ptrs.clear();
+    ctxt->names.clear();
 }
 
 //--------------------------------------------------------------------------------------------
 vfs_search_context_t * _vfs_search( vfs_search_context_t ** pctxt )
 {
     const char * retval = NULL;
-    static VFS_PATH  path_buffer = EMPTY_CSTR;
+    static thread_local VFS_PATH  path_buffer = EMPTY_CSTR;
 
     BAIL_IF_NOT_INIT();
 
@@ -2193,14 +2468,14 @@ vfs_search_context_t * vfs_findFirst( const char * search_path, const char * sea
 	vfs_search_context_t *ctxt = new vfs_search_context_t();
 
     // grab all the files
-    ctxt->file_list = vfs_enumerateFiles( vfs_convert_fname( search_path ) );
-    ctxt->ptr       = NULL;
-
-    // no search list generated
-    if ( NULL == ctxt->file_list )
+    _vfs_manifest_list( vfs_convert_fname( search_path ), ctxt->names );
+    for ( std::string& name : ctxt->names )
     {
-        return NULL;
+        ctxt->name_ptrs.push_back( &name[0] );
     }
+    ctxt->name_ptrs.push_back( NULL );
+    ctxt->file_list = ctxt->name_ptrs.data();
+    ctxt->ptr       = NULL;
 
     // empty search list
     if ( NULL == *( ctxt->file_list ) )
@@ -2283,6 +2558,7 @@ int vfs_removeDirectoryAndContents( const char * dirname, int recursive )
     if ( !fs_fileIsDirectory( write_dir ) ) return VFS_FALSE;
 
     fs_removeDirectoryAndContents( write_dir, recursive );
+    _vfs_manifest_update( dirname, true );
 
     return VFS_TRUE;
 }
@@ -2619,7 +2895,7 @@ const char * vfs_getError( void )
     /// @author ZF
     /// @details Returns the last error the PHYSFS system reported.
 
-    static char errors[1024];
+    static thread_local char errors[1024];
     const char * physfs_error, * file_error;
 	//bool is_error;
 
@@ -2688,6 +2964,8 @@ int vfs_add_mount_point( const char * root_path, const char * relative_path, con
 
     if ( _vfs_mount_info_add( mount_point, root_path, relative_path ) )
     {
+        _vfs_manifest_invalidate();
+
         retval = PHYSFS_mount( loc_dirname, mount_point, append );
         if ( 0 == retval )
         {
@@ -2724,6 +3002,8 @@ int vfs_remove_mount_point( const char * mount_point )
     // does it exist in the list?
     if ( cnt < 0 ) return false;
 
+    _vfs_manifest_invalidate();
+
     while ( cnt >= 0 )
     {
         // we have to use the path name to remove the search path, not the mount point name
@@ -2991,6 +3271,8 @@ void vfs_set_base_search_paths( void )
 {
     BAIL_IF_NOT_INIT();
 
+    _vfs_manifest_invalidate();
+
     // Put write dir first in search path...
     PHYSFS_addToSearchPath( fs_getUserDirectory(), 0 );
 
@@ -3051,7 +3333,8 @@ bool vfs_readEntireFile(const std::string& pathname, char **data, size_t *length
     else
     {
         size_t pos = 0;
-        char *buffer = (char *) malloc(fileLen);
+        // Allocate at least one Byte so that empty files can be read, too.
+        char *buffer = (char *) malloc(fileLen > 0 ? fileLen : 1);
         if (buffer == nullptr)
         {
             vfs_close(file);
@@ -222,10 +222,20 @@ int vfs_seek(vfs_FILE *file , long offset);
 bool vfs_mkdir(const std::string& pathname);
 /** @return @a true on success, @a false on failure */
 bool vfs_delete_file(const std::string& pathname);
-/** @return @a true if the path refers to a file that exists, @a false otherwise */
+/**
+ * @return @a true if the path refers to a file that exists, @a false otherwise
+ * @remark Answered from the manifest of the virtual file system, which lists each directory only once.
+ *         The manifest is dropped when mount points are added or removed. Writing, creating or deleting
+ *         files and directories only updates the affected entries in directory listings already cached.
+ */
 bool vfs_exists(const std::string& pathname);
 /** @return @a true if the pathname refers to an existing directory file, @a false otherwise */
 bool vfs_isDirectory(const std::string& pathname);
+/**
+ * @return the last modification time of the file in seconds since the epoch,
+ *         @a -1 if the file does not exist or its modification time can not be determined
+ */
+int64_t vfs_getLastModTime(const std::string& pathname);
 
 // binary reading and writing
 size_t vfs_read(void *buffer, size_t size, size_t count, vfs_FILE *file);
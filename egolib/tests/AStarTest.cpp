@@ -0,0 +1,145 @@
+#include <string>
+#include <vector>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/AI/AStar.hpp"
+#include "egolib/Math/_Include.hpp"
+
+EgoTest_TestCase(AStarTest)
+{
+
+/// A grid from rows of characters, '#' is a wall and ' ' is a pit
+struct Grid : public PathGrid
+{
+    static constexpr uint32_t WALL = 1;
+
+    std::vector<std::string> rows;
+    std::shared_ptr<int> owner;
+
+    Grid(const std::vector<std::string>& rows) :
+        rows(rows), owner(std::make_shared<int>(0))
+    {}
+
+    int getTileCountX() const override { return static_cast<int>(rows.front().size()); }
+    int getTileCountY() const override { return static_cast<int>(rows.size()); }
+    bool isStopped(int x, int y, uint32_t stoppedBy) const override
+    {
+        const int32_t tile = getTileIndex(x, y);
+        return (tile < 0 || '#' == at(tile)) && (0 != (stoppedBy & WALL));
+    }
+    bool isWalkable(int32_t tile, uint32_t stoppedBy) const override
+    {
+        return ' ' != at(tile) && !('#' == at(tile) && 0 != (stoppedBy & WALL));
+    }
+    std::shared_ptr<const void> getOwner() const override { return owner; }
+    uint32_t getRevision() const override { return 0; }
+
+    char at(int32_t tile) const { return rows[tile / getTileCountX()][tile % getTileCountX()]; }
+};
+
+static std::vector<int32_t> search(AStar& astar, const Grid& grid, int srcX, int srcY, int dstX, int dstY)
+{
+    std::vector<int32_t> tiles;
+    if (astar.find_path(grid, Grid::WALL, srcX, srcY, dstX, dstY, true))
+    {
+        astar.get_tiles(tiles);
+    }
+    return tiles;
+}
+
+EgoTest_Test(openGridTakesTheDiagonal)
+{
+    const Grid grid({
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+    });
+    AStar astar;
+    const std::vector<int32_t> tiles = search(astar, grid, 0, 0, 4, 4);
+    EgoTest_Assert(tiles == std::vector<int32_t>({0, 6, 12, 18, 24}));
+    EgoTest_Assert(AStar::cost(tiles, grid.getTileCountX()) == AStar::estimate(0, 0, 4, 4, true));
+}
+
+EgoTest_Test(diagonalMovesDoNotCutCorners)
+{
+    const Grid grid({
+        "......",
+        ".####.",
+        ".#..#.",
+        ".#..#.",
+        "...##.",
+        "......",
+    });
+    AStar astar;
+    const std::vector<int32_t> tiles = search(astar, grid, 0, 0, 3, 3);
+    EgoTest_Assert(!tiles.empty());
+    EgoTest_Assert(tiles.front() == grid.getTileIndex(0, 0) && tiles.back() == grid.getTileIndex(3, 3));
+    for (size_t i = 1; i < tiles.size(); ++i)
+    {
+        const int x0 = tiles[i - 1] % grid.getTileCountX(), y0 = tiles[i - 1] / grid.getTileCountX(),
+                  x1 = tiles[i] % grid.getTileCountX(), y1 = tiles[i] / grid.getTileCountX();
+        EgoTest_Assert(std::abs(x1 - x0) <= 1 && std::abs(y1 - y0) <= 1);
+        EgoTest_Assert(grid.isWalkable(tiles[i], Grid::WALL));
+        EgoTest_Assert(grid.isWalkable(grid.getTileIndex(x0, y1), Grid::WALL));
+        EgoTest_Assert(grid.isWalkable(grid.getTileIndex(x1, y0), Grid::WALL));
+    }
+}
+
+EgoTest_Test(unreachableDestinationFails)
+{
+    const Grid grid({
+        ".......",
+        "..###..",
+        "..#.#..",
+        "..###..",
+        ".......",
+    });
+    AStar astar;
+    EgoTest_Assert(search(astar, grid, 0, 0, 3, 2).empty());
+    // a pit does not let the search through either
+    const Grid pits({
+        "... ...",
+        "... ...",
+    });
+    EgoTest_Assert(search(astar, pits, 0, 0, 6, 1).empty());
+    // the search state is reused, a later search still succeeds
+    EgoTest_Assert(!search(astar, grid, 0, 0, 6, 4).empty());
+}
+
+EgoTest_Test(destinationInAWallMovesNextToIt)
+{
+    const Grid grid({
+        "......",
+        "......",
+        "......",
+        "...###",
+        "...###",
+    });
+    AStar astar;
+    const std::vector<int32_t> tiles = search(astar, grid, 0, 0, 5, 3);
+    EgoTest_Assert(!tiles.empty());
+    EgoTest_Assert(grid.isWalkable(tiles.back(), Grid::WALL));
+    const int x = tiles.back() % grid.getTileCountX(), y = tiles.back() / grid.getTileCountX();
+    EgoTest_Assert(std::abs(x - 5) <= 1 && std::abs(y - 3) <= 1);
+    // no free tile next to the destination
+    EgoTest_Assert(search(astar, grid, 0, 0, 5, 4).empty());
+}
+
+EgoTest_Test(finalWaypointIsTheDestination)
+{
+    const Grid grid({
+        "......",
+        "####..",
+        "......",
+    });
+    AStar astar;
+    EgoTest_Assert(astar.find_path(grid, Grid::WALL, 0, 0, 0, 2, true));
+    waypoint_list_t wplst;
+    waypoint_list_t::clear(wplst);
+    EgoTest_Assert(astar.get_path(50, 300, wplst));
+    EgoTest_Assert(wplst._head > 1);
+    EgoTest_Assert(wplst._pos[wplst._head - 1][kX] == 50.0f && wplst._pos[wplst._head - 1][kY] == 300.0f);
+}
+
+};
@@ -0,0 +1,73 @@
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
+
+EgoTest_TestCase(BufferTest)
+{
+
+static const Ego::VertexDescriptor &aColourDescriptor()
+{
+    static const Ego::VertexDescriptor descriptor({
+        Ego::VertexElementDescriptor(0, Ego::VertexElementDescriptor::Syntax::F3, Ego::VertexElementDescriptor::Semantics::Colour)
+    });
+    return descriptor;
+}
+
+EgoTest_Test(invalidRangesAreMerged)
+{
+    Ego::VertexBuffer buffer(100, aColourDescriptor());
+
+    //A new buffer is invalid as a whole
+    EgoTest_Assert(buffer.getInvalidRanges().size() == 1);
+    EgoTest_Assert(buffer.getInvalidSize() == 1200);
+    buffer.validate();
+    EgoTest_Assert(buffer.getInvalidRanges().empty());
+
+    buffer.invalidate(120, 48);
+    buffer.invalidate(0, 12);
+    buffer.invalidate(600, 12);
+    EgoTest_Assert(buffer.getInvalidRanges().size() == 3);
+    EgoTest_Assert(buffer.getInvalidRanges()[0].offset == 0);
+    EgoTest_Assert(buffer.getInvalidRanges()[1].offset == 120);
+    EgoTest_Assert(buffer.getInvalidRanges()[2].offset == 600);
+
+    //Adjacent ranges are merged
+    buffer.invalidate(168, 12);
+    EgoTest_Assert(buffer.getInvalidRanges().size() == 3);
+    EgoTest_Assert(buffer.getInvalidRanges()[1].size == 60);
+
+    //A range overlapping several ranges swallows them
+    buffer.invalidate(6, 300);
+    EgoTest_Assert(buffer.getInvalidRanges().size() == 2);
+    EgoTest_Assert(buffer.getInvalidRanges()[0].offset == 0);
+    EgoTest_Assert(buffer.getInvalidRanges()[0].size == 306);
+    EgoTest_Assert(buffer.getInvalidSize() == 318);
+
+    bool thrown = false;
+    try {
+        buffer.invalidate(1190, 12);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    EgoTest_Assert(thrown);
+}
+
+EgoTest_Test(onlyInvalidRangesAreUploaded)
+{
+    Ego::Null::Renderer renderer;
+    Ego::VertexBuffer buffer(1000, aColourDescriptor());
+
+    //The first upload transfers the whole buffer
+    EgoTest_Assert(renderer.upload(buffer) == 12000);
+    EgoTest_Assert(nullptr != buffer.getBufferObject());
+    EgoTest_Assert(renderer.upload(buffer) == 0);
+
+    //A few tiles with four vertices each changed their lighting
+    for (size_t tile : { 10, 11, 12, 200 }) {
+        buffer.invalidate(tile * 4 * 12, 4 * 12);
+    }
+    EgoTest_Assert(buffer.getInvalidRanges().size() == 2);
+    EgoTest_Assert(renderer.upload(buffer) == 4 * 4 * 12);
+    EgoTest_Assert(buffer.getInvalidRanges().empty());
+}
+
+};
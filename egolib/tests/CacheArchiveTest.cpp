@@ -0,0 +1,154 @@
+#include <string>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/FileFormats/CacheFile.hpp"
+
+EgoTest_TestCase(CacheArchiveTest)
+{
+
+enum class Colour : uint8_t { Red, Green, Blue };
+
+struct Values
+{
+    int32_t integer;
+    float real;
+    bool flag;
+    Colour colour;
+    std::string text;
+    IPair pair;
+    FRange range;
+    IDSZ2 idsz;
+    LocalParticleProfileRef particle;
+    std::array<uint16_t, 3> array;
+    std::bitset<70> bits;
+    std::unordered_map<size_t, std::string> map;
+
+    Values() : integer(0), real(0.0f), flag(false), colour(Colour::Red), text(), pair(), range(), idsz(IDSZ2::None),
+               particle(), array(), bits(), map() {}
+
+    void transfer(Ego::CacheArchive& archive)
+    {
+        archive(integer);
+        archive(real);
+        archive(flag);
+        archive(colour);
+        archive(text);
+        archive(pair);
+        archive(range);
+        archive(idsz);
+        archive(particle);
+        archive(array);
+        archive(bits);
+        archive(map);
+    }
+};
+
+EgoTest_Test(valuesSurviveARoundTrip)
+{
+    Values source;
+    source.integer = -42;
+    source.real = 1.5f;
+    source.flag = true;
+    source.colour = Colour::Blue;
+    source.text = "Sword of Cheese";
+    source.pair = IPair(3, 4);
+    source.range = FRange(0.25f, 8.0f);
+    source.idsz = IDSZ2('S', 'W', 'O', 'R');
+    source.particle = LocalParticleProfileRef(7);
+    source.array = {{ 1, 2, 65535 }};
+    source.bits[0] = source.bits[69] = true;
+    source.map[1] = "one";
+    source.map[3] = "three";
+
+    Ego::CacheArchive writer;
+    EgoTest_Assert(!writer.isReading());
+    writer(source);
+
+    Values target;
+    Ego::CacheArchive reader(writer.getData().data(), writer.getData().size());
+    EgoTest_Assert(reader.isReading());
+    reader(target);
+    EgoTest_Assert(reader.isGood());
+    EgoTest_Assert(0 == reader.getRemainingSize());
+
+    EgoTest_Assert(target.integer == source.integer);
+    EgoTest_Assert(target.real == source.real);
+    EgoTest_Assert(target.flag == source.flag);
+    EgoTest_Assert(target.colour == source.colour);
+    EgoTest_Assert(target.text == source.text);
+    EgoTest_Assert(target.pair.base == 3 && target.pair.rand == 4);
+    EgoTest_Assert(target.range.from == 0.25f && target.range.to == 8.0f);
+    EgoTest_Assert(target.idsz == source.idsz);
+    EgoTest_Assert(target.particle == source.particle);
+    EgoTest_Assert(target.array == source.array);
+    EgoTest_Assert(target.bits == source.bits);
+    EgoTest_Assert(target.map == source.map);
+}
+
+EgoTest_Test(truncatedDataIsDetected)
+{
+    Values source;
+    source.text = "a string which does not fit";
+
+    Ego::CacheArchive writer;
+    writer(source);
+
+    Values target;
+    Ego::CacheArchive reader(writer.getData().data(), writer.getData().size() - 4);
+    reader(target);
+    EgoTest_Assert(!reader.isGood());
+}
+
+/// Encode a cache file for a source file with the given modification time
+static std::vector<char> encodeText(const Ego::CacheFile& cache, const std::string& sourcePathname, int64_t modificationTime)
+{
+    Values source;
+    source.text = "cached";
+    return cache.encode(sourcePathname, modificationTime, [&source](Ego::CacheArchive& archive) { archive(source); });
+}
+
+/// Decode a cache file, @a true on a cache hit with the values intact
+static bool decodeText(const Ego::CacheFile& cache, const std::string& sourcePathname, int64_t modificationTime, const std::vector<char>& data)
+{
+    Values target;
+    const bool hit = cache.decode(sourcePathname, modificationTime, data.data(), data.size(), [&target](Ego::CacheArchive& archive) { archive(target); });
+    return hit && "cached" == target.text;
+}
+
+EgoTest_Test(intactCacheFilesAreHits)
+{
+    const Ego::CacheFile cache("cache/test", "tst", 1);
+    EgoTest_Assert(decodeText(cache, "objects/sword.obj/data.txt", 1000, encodeText(cache, "objects/sword.obj/data.txt", 1000)));
+}
+
+EgoTest_Test(modifiedSourcesAreMisses)
+{
+    const Ego::CacheFile cache("cache/test", "tst", 1);
+    const std::vector<char> data = encodeText(cache, "objects/sword.obj/data.txt", 1000);
+    EgoTest_Assert(!decodeText(cache, "objects/sword.obj/data.txt", 1001, data));
+    EgoTest_Assert(!decodeText(cache, "objects/sword.obj/data.txt", 999, data));
+}
+
+EgoTest_Test(otherFormatVersionsAreMisses)
+{
+    const Ego::CacheFile oldCache("cache/test", "tst", 1), newCache("cache/test", "tst", 2);
+    EgoTest_Assert(!decodeText(newCache, "objects/sword.obj/data.txt", 1000, encodeText(oldCache, "objects/sword.obj/data.txt", 1000)));
+}
+
+EgoTest_Test(otherSourcePathnamesAreMisses)
+{
+    const Ego::CacheFile cache("cache/test", "tst", 1);
+    const std::vector<char> data = encodeText(cache, "objects/sword.obj/data.txt", 1000);
+    EgoTest_Assert(!decodeText(cache, "objects/shield.obj/data.txt", 1000, data));
+}
+
+EgoTest_Test(damagedCacheFilesAreMisses)
+{
+    const Ego::CacheFile cache("cache/test", "tst", 1);
+    std::vector<char> data = encodeText(cache, "objects/sword.obj/data.txt", 1000);
+    data.back() ^= 0x1;
+    EgoTest_Assert(!decodeText(cache, "objects/sword.obj/data.txt", 1000, data));
+    data.pop_back();
+    EgoTest_Assert(!decodeText(cache, "objects/sword.obj/data.txt", 1000, data));
+}
+
+};
@@ -0,0 +1,82 @@
+#include <vector>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Core/ChunkedPool.hpp"
+#include "egolib/egolib_config.h"
+
+EgoTest_TestCase(ChunkedPoolTest)
+{
+
+/// About the size of the hot part of a particle
+struct Element
+{
+    float data[64];
+    uint32_t id;
+
+    Element() : data(), id(0) {}
+};
+
+EgoTest_Test(elementsAreStable)
+{
+    Ego::ChunkedPool<Element> pool(16);
+    std::vector<std::shared_ptr<Element>> elements;
+    std::vector<Element*> addresses;
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        elements.push_back(pool.acquire());
+        elements.back()->id = i;
+        addresses.push_back(elements.back().get());
+    }
+    EgoTest_Assert(pool.getCapacity() == 112);
+    EgoTest_Assert(pool.getFreeCount() == 12);
+
+    //Growing the pool does not move the elements handed out
+    for (uint32_t i = 0; i < 100; ++i) {
+        pool.acquire();
+    }
+    for (uint32_t i = 0; i < 100; ++i) {
+        EgoTest_Assert(elements[i].get() == addresses[i]);
+        EgoTest_Assert(elements[i]->id == i);
+    }
+
+    //Released elements are reused before the pool grows
+    const size_t capacity = pool.getCapacity();
+    pool.release(elements[42]);
+    std::shared_ptr<Element> element = pool.acquire();
+    EgoTest_Assert(element.get() == addresses[42]);
+    EgoTest_Assert(pool.getCapacity() == capacity);
+
+    //Elements outlive the pool
+    pool.clear();
+    EgoTest_Assert(pool.getCapacity() == 0);
+    EgoTest_Assert(element->id == 42);
+}
+
+EgoTest_Test(scalesToLargerLimits)
+{
+    //Today's particle limit, four times and sixteen times that
+    for (size_t factor : { 1, 4, 16 }) {
+        const size_t count = factor * PARTICLES_MAX;
+        Ego::ChunkedPool<Element> pool;
+        std::vector<std::shared_ptr<Element>> elements;
+        elements.reserve(count);
+
+        for (int round = 0; round < 2; ++round) {
+            for (size_t i = 0; i < count; ++i) {
+                elements.push_back(pool.acquire());
+                elements.back()->id = static_cast<uint32_t>(i);
+            }
+            //Grows by whole chunks only, and not at all in the second round
+            EgoTest_Assert(pool.getCapacity() >= count);
+            EgoTest_Assert(pool.getCapacity() < count + 256);
+            EgoTest_Assert(pool.getFreeCount() == pool.getCapacity() - count);
+
+            for (const std::shared_ptr<Element> &element : elements) {
+                pool.release(element);
+            }
+            elements.clear();
+            EgoTest_Assert(pool.getFreeCount() == pool.getCapacity());
+        }
+    }
+}
+
+};
@@ -0,0 +1,149 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include <vector>
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Script/CompiledScript.hpp"
+
+EgoTest_TestCase(CompiledScriptTest)
+{
+
+static const uint32_t MESSAGE_HIGHBITS = 0x80000000;
+
+/// A script of six instructions with a message in instruction 1 and an object reference in
+/// instruction 4, compiled with the message bound to 0 and the object bound to 7
+static compiled_script_t makeCompiledScript()
+{
+    compiled_script_t compiled;
+    compiled._script = std::make_shared<script_info_t>();
+    compiled._script->_name = "mp_objects/first.obj/script.txt";
+    compiled._script->_parallelSafe = true;
+    compiled._script->_writesState = false;
+    compiled._script->_instructions._length = 6;
+    for (uint32_t i = 0; i < 6; ++i) {
+        compiled._script->_instructions[i].setBits(100 + i);
+    }
+    compiled._script->_instructions[1].setBits(MESSAGE_HIGHBITS | 0);
+    compiled._script->_instructions[4].setBits(7);
+
+    script_constant_t message;
+    message._index = 1;
+    message._highbits = MESSAGE_HIGHBITS;
+    message._kind = script_constant_t::Kind::Message;
+    message._text = "Hello";
+    compiled._constants.push_back(message);
+
+    script_constant_t object;
+    object._index = 4;
+    object._highbits = 0;
+    object._kind = script_constant_t::Kind::Object;
+    object._text = "sword.obj";
+    compiled._constants.push_back(object);
+
+    return compiled;
+}
+
+/// Resolves messages and object references to the given values
+static compiled_script_t::Resolve resolveTo(uint32_t message, uint32_t object)
+{
+    return [message, object](const script_constant_t& constant) {
+        return script_constant_t::Kind::Message == constant._kind ? message : object;
+    };
+}
+
+EgoTest_Test(profilesBindingTheSameValuesShareTheScript)
+{
+    const compiled_script_t compiled = makeCompiledScript();
+    std::shared_ptr<script_info_t> script = compiled.bind(resolveTo(0, 7), "mp_objects/second.obj/script.txt");
+    EgoTest_Assert(script == compiled._script);
+}
+
+EgoTest_Test(profilesBindingOtherValuesGetAPatchedCopy)
+{
+    const compiled_script_t compiled = makeCompiledScript();
+    std::shared_ptr<script_info_t> script = compiled.bind(resolveTo(3, 9), "mp_objects/second.obj/script.txt");
+    EgoTest_Assert(script != compiled._script);
+
+    //The copy has its own name and the constants patched, the shared script is unchanged
+    EgoTest_Assert("mp_objects/second.obj/script.txt" == script->getName());
+    EgoTest_Assert("mp_objects/first.obj/script.txt" == compiled._script->getName());
+    EgoTest_Assert((MESSAGE_HIGHBITS | 3) == script->_instructions[1].getBits());
+    EgoTest_Assert(9 == script->_instructions[4].getBits());
+    EgoTest_Assert((MESSAGE_HIGHBITS | 0) == compiled._script->_instructions[1].getBits());
+    EgoTest_Assert(7 == compiled._script->_instructions[4].getBits());
+    for (uint32_t i : { 0, 2, 3, 5 }) {
+        EgoTest_Assert(script->_instructions[i].getBits() == compiled._script->_instructions[i].getBits());
+    }
+    EgoTest_Assert(script->_parallelSafe == compiled._script->_parallelSafe);
+}
+
+EgoTest_Test(compiledScriptsAreRestoredFromTheCache)
+{
+    const Ego::CacheFile cache("/cache/scripts", "scrc", 1);
+    compiled_script_t source = makeCompiledScript();
+    const std::vector<char> data = cache.encode("mp_objects/first.obj/script.txt", 1000, [&source](Ego::CacheArchive& archive) { source.transfer(archive); });
+
+    compiled_script_t target;
+    target._script = std::make_shared<script_info_t>();
+    EgoTest_Assert(cache.decode("mp_objects/first.obj/script.txt", 1000, data.data(), data.size(), [&target](Ego::CacheArchive& archive) { target.transfer(archive); }));
+
+    EgoTest_Assert(target._script->_parallelSafe == source._script->_parallelSafe);
+    EgoTest_Assert(target._script->_writesState == source._script->_writesState);
+    EgoTest_Assert(target._script->_instructions.getLength() == source._script->_instructions.getLength());
+    for (uint32_t i = 0; i < source._script->_instructions.getLength(); ++i) {
+        EgoTest_Assert(target._script->_instructions[i].getBits() == source._script->_instructions[i].getBits());
+    }
+    EgoTest_Assert(target._constants.size() == source._constants.size());
+    for (size_t i = 0; i < source._constants.size(); ++i) {
+        EgoTest_Assert(target._constants[i]._index == source._constants[i]._index);
+        EgoTest_Assert(target._constants[i]._highbits == source._constants[i]._highbits);
+        EgoTest_Assert(target._constants[i]._kind == source._constants[i]._kind);
+        EgoTest_Assert(target._constants[i]._text == source._constants[i]._text);
+    }
+
+    //The restored script binds like the compiled one
+    EgoTest_Assert(target.bind(resolveTo(0, 7), "mp_objects/second.obj/script.txt") == target._script);
+}
+
+EgoTest_Test(scriptsCachedByAnotherCompilerAreMisses)
+{
+    //The parser folds the hash of its opcode table and classification into the version
+    const Ego::CacheFile oldCompiler("/cache/scripts", "scrc", 3 ^ 0x1234), newCompiler("/cache/scripts", "scrc", 3 ^ 0x4321);
+    compiled_script_t source = makeCompiledScript();
+    const std::vector<char> data = oldCompiler.encode("mp_objects/first.obj/script.txt", 1000, [&source](Ego::CacheArchive& archive) { source.transfer(archive); });
+
+    compiled_script_t target;
+    target._script = std::make_shared<script_info_t>();
+    EgoTest_Assert(!newCompiler.decode("mp_objects/first.obj/script.txt", 1000, data.data(), data.size(), [&target](Ego::CacheArchive& archive) { target.transfer(archive); }));
+}
+
+EgoTest_Test(constantsOutsideOfTheScriptAreRejected)
+{
+    const Ego::CacheFile cache("/cache/scripts", "scrc", 1);
+    compiled_script_t source = makeCompiledScript();
+    source._constants[1]._index = 6;
+    const std::vector<char> data = cache.encode("mp_objects/first.obj/script.txt", 1000, [&source](Ego::CacheArchive& archive) { source.transfer(archive); });
+
+    compiled_script_t target;
+    target._script = std::make_shared<script_info_t>();
+    EgoTest_Assert(!cache.decode("mp_objects/first.obj/script.txt", 1000, data.data(), data.size(), [&target](Ego::CacheArchive& archive) { target.transfer(archive); }));
+}
+
+};
@@ -0,0 +1,91 @@
+#include <vector>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/frustum.h"
+#include "egolib/Math/Transform.hpp"
+
+EgoTest_TestCase(FrustumTest)
+{
+
+/// A camera looking down at the origin like the game camera does
+static Ego::Graphics::Frustum aFrustum()
+{
+    Ego::Graphics::Frustum frustum;
+    frustum.calculate(Ego::Math::Transform::perspective(60.0f, 4.0f / 3.0f, 1.0f, 5000.0f),
+                      Ego::Math::Transform::lookAt(Vector3f(0.0f, -1000.0f, 1000.0f), Vector3f::zero(), Vector3f(0.0f, 0.0f, 1.0f)));
+    return frustum;
+}
+
+/// Random primitives stored as one array per component
+struct Primitives
+{
+    std::vector<float> x, y, z, radius;
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+
+    Primitives(size_t count)
+    {
+        uint32_t seed = 12345;
+        auto random = [&seed](float range) {
+            seed = seed * 1664525u + 1013904223u;
+            return (seed >> 8) / float(1 << 24) * range;
+        };
+        for (size_t i = 0; i < count; ++i) {
+            x.push_back(random(6000.0f) - 3000.0f);
+            y.push_back(random(6000.0f) - 3000.0f);
+            z.push_back(random(1000.0f) - 500.0f);
+            //Some points among the spheres
+            radius.push_back(i % 7 == 0 ? 0.0f : random(200.0f));
+            minX.push_back(x.back() - radius.back());
+            minY.push_back(y.back() - random(200.0f));
+            minZ.push_back(z.back() - random(200.0f));
+            maxX.push_back(x.back() + random(200.0f));
+            maxY.push_back(y.back() + radius.back());
+            maxZ.push_back(z.back() + random(200.0f));
+        }
+    }
+
+    size_t size() const
+    {
+        return x.size();
+    }
+};
+
+static bool isSet(const std::vector<uint32_t>& visible, size_t i)
+{
+    return 0 != (visible[i / 32] & (1u << (i % 32)));
+}
+
+EgoTest_Test(batchesMatchSingleTests)
+{
+    const Ego::Graphics::Frustum frustum = aFrustum();
+    //Not a multiple of the batch size
+    const Primitives primitives(10003);
+    std::vector<uint32_t> visible((primitives.size() + 31) / 32);
+
+    for (bool doEnds : { false, true }) {
+        size_t visibleCount = 0;
+        frustum.intersects_spheres(primitives.x.data(), primitives.y.data(), primitives.z.data(), primitives.radius.data(),
+                                   primitives.size(), doEnds, visible.data());
+        for (size_t i = 0; i < primitives.size(); ++i) {
+            const Sphere3f sphere(Vector3f(primitives.x[i], primitives.y[i], primitives.z[i]), primitives.radius[i]);
+            const bool expected = Ego::Math::Relation::outside != frustum.intersects(sphere, doEnds);
+            EgoTest_Assert(isSet(visible, i) == expected);
+            if (expected) visibleCount++;
+        }
+        //Neither trivially all nor trivially none
+        EgoTest_Assert(visibleCount > 0 && visibleCount < primitives.size());
+
+        frustum.intersects_aabbs(primitives.minX.data(), primitives.minY.data(), primitives.minZ.data(),
+                                 primitives.maxX.data(), primitives.maxY.data(), primitives.maxZ.data(),
+                                 primitives.size(), doEnds, visible.data());
+        for (size_t i = 0; i < primitives.size(); ++i) {
+            const AABB3f aabb(Vector3f(primitives.minX[i], primitives.minY[i], primitives.minZ[i]),
+                              Vector3f(primitives.maxX[i], primitives.maxY[i], primitives.maxZ[i]));
+            EgoTest_Assert(isSet(visible, i) == (Ego::Math::Relation::outside != frustum.intersects(aabb, doEnds)));
+        }
+    }
+
+    //Unused bits of the last word are cleared
+    EgoTest_Assert(0 == (visible.back() >> (primitives.size() % 32)));
+}
+
+};
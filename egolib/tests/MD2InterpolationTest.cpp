@@ -0,0 +1,166 @@
+#include <cmath>
+#include <vector>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Graphics/MD2VertexArrays.hpp"
+
+EgoTest_TestCase(MD2InterpolationTest)
+{
+
+/// The layout of GLvertex
+struct Vertex
+{
+    float pos[4];
+    float nrm[3];
+    float env[2];
+    float tex[2];
+    float col[4];
+    int color_dir;
+};
+
+/// A vertex as MD2 frames stored it before they were split into arrays
+struct LegacyVertex
+{
+    float pos[3];
+    float nrm[3];
+    size_t normal;
+};
+
+static const size_t NORMAL_COUNT = 163;
+
+/// Two frames of random vertices in both layouts
+struct Frames
+{
+    std::vector<LegacyVertex> legacyLast, legacyNext;
+    MD2_VertexArrays last, next;
+    float environmentU[NORMAL_COUNT];
+
+    Frames(size_t count)
+    {
+        uint32_t seed = 12345;
+        auto random = [&seed](float range) {
+            seed = seed * 1664525u + 1013904223u;
+            return (seed >> 8) / float(1 << 24) * range;
+        };
+        for (size_t i = 0; i < NORMAL_COUNT; ++i) {
+            environmentU[i] = random(1.0f);
+        }
+
+        legacyLast.resize(count);
+        legacyNext.resize(count);
+        last.resize(count);
+        next.resize(count);
+        fill(legacyLast, last, random);
+        fill(legacyNext, next, random);
+    }
+
+    template <typename Random>
+    void fill(std::vector<LegacyVertex>& legacy, MD2_VertexArrays& arrays, Random& random)
+    {
+        for (size_t i = 0; i < legacy.size(); ++i) {
+            LegacyVertex &vertex = legacy[i];
+            for (size_t j = 0; j < 3; ++j) {
+                vertex.pos[j] = random(200.0f) - 100.0f;
+                vertex.nrm[j] = random(2.0f) - 1.0f;
+            }
+            vertex.normal = static_cast<size_t>(random(NORMAL_COUNT - 1));
+
+            arrays.get(MD2_VertexArrays::PositionX)[i] = vertex.pos[0];
+            arrays.get(MD2_VertexArrays::PositionY)[i] = vertex.pos[1];
+            arrays.get(MD2_VertexArrays::PositionZ)[i] = vertex.pos[2];
+            arrays.get(MD2_VertexArrays::NormalX)[i] = vertex.nrm[0];
+            arrays.get(MD2_VertexArrays::NormalY)[i] = vertex.nrm[1];
+            arrays.get(MD2_VertexArrays::NormalZ)[i] = vertex.nrm[2];
+            arrays.get(MD2_VertexArrays::EnvironmentU)[i] = environmentU[vertex.normal];
+        }
+        arrays.pad();
+    }
+
+    /// The loop of chr_instance_t::interpolate_vertices_raw() before the frames were split into arrays
+    void interpolateLegacy(Vertex *destination, size_t begin, size_t end, float flip) const
+    {
+        for (size_t i = begin; i < end; ++i) {
+            Vertex &dst = destination[i];
+            const LegacyVertex &srcLast = legacyLast[i], &srcNext = legacyNext[i];
+            for (size_t j = 0; j < 3; ++j) {
+                dst.pos[j] = srcLast.pos[j] + (srcNext.pos[j] - srcLast.pos[j]) * flip;
+                dst.nrm[j] = srcLast.nrm[j] + (srcNext.nrm[j] - srcLast.nrm[j]) * flip;
+            }
+            dst.pos[3] = 1.0f;
+            dst.env[0] = environmentU[srcLast.normal] + (environmentU[srcNext.normal] - environmentU[srcLast.normal]) * flip;
+            dst.env[1] = 0.5f * (1.0f + dst.nrm[2]);
+        }
+    }
+};
+
+static bool equal(const Vertex& a, const Vertex& b)
+{
+    const float tolerance = 1e-4f;
+    for (size_t j = 0; j < 4; ++j) {
+        if (std::abs(a.pos[j] - b.pos[j]) > tolerance) return false;
+    }
+    for (size_t j = 0; j < 3; ++j) {
+        if (std::abs(a.nrm[j] - b.nrm[j]) > tolerance) return false;
+    }
+    for (size_t j = 0; j < 2; ++j) {
+        if (std::abs(a.env[j] - b.env[j]) > tolerance) return false;
+    }
+    return true;
+}
+
+EgoTest_Test(kernelsMatchTheLegacyLoop)
+{
+    Frames frames(203);
+    std::vector<Vertex> expected(203), scalar(203), vectorized(203);
+
+    //Ranges which do not start or end on a block boundary
+    for (size_t begin : { 0, 1, 5, 198 }) {
+        for (size_t end : { 199, 202, 203 }) {
+            for (float flip : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+                frames.interpolateLegacy(expected.data(), begin, end, flip);
+                MD2_VertexArrays::interpolateScalar(scalar.data(), frames.last, frames.next, begin, end, flip);
+                MD2_VertexArrays::interpolate(vectorized.data(), frames.last, frames.next, begin, end, flip);
+                for (size_t i = begin; i < end; ++i) {
+                    EgoTest_Assert(equal(scalar[i], expected[i]));
+                    EgoTest_Assert(equal(vectorized[i], expected[i]));
+                }
+            }
+        }
+    }
+}
+
+EgoTest_Test(verticesOutsideTheRangeAreNotWritten)
+{
+    Frames frames(16);
+    std::vector<Vertex> vertices(16);
+    vertices[2].pos[0] = 42.0f;
+    vertices[7].pos[0] = 42.0f;
+
+    MD2_VertexArrays::interpolate(vertices.data(), frames.last, frames.next, 3, 7, 0.5f);
+    EgoTest_Assert(vertices[2].pos[0] == 42.0f);
+    EgoTest_Assert(vertices[7].pos[0] == 42.0f);
+}
+
+EgoTest_Test(unalignedRangesStayWithinTheArrays)
+{
+    //No padding beyond the last block, the kernel must not load past the end of the arrays
+    Frames frames(8);
+    std::vector<Vertex> expected(8), vertices(8);
+
+    for (size_t begin : { 1, 5, 6, 7 }) {
+        for (size_t end : { 7, 8 }) {
+            if (begin >= end) continue;
+            for (Vertex &vertex : vertices) vertex.pos[0] = 42.0f;
+            frames.interpolateLegacy(expected.data(), begin, end, 0.5f);
+            MD2_VertexArrays::interpolate(vertices.data(), frames.last, frames.next, begin, end, 0.5f);
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                if (i < begin || i >= end) {
+                    EgoTest_Assert(vertices[i].pos[0] == 42.0f);
+                } else {
+                    EgoTest_Assert(equal(vertices[i], expected[i]));
+                }
+            }
+        }
+    }
+}
+
+};
@@ -0,0 +1,116 @@
+#include <vector>
+#include <algorithm>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Mesh/Blocks.hpp"
+#include "egolib/Math/Transform.hpp"
+
+EgoTest_TestCase(MeshBlocksTest)
+{
+
+/// A mesh whose size is not a multiple of the block size with random tile heights
+struct Terrain
+{
+    Ego::MeshInfo info;
+    std::vector<AABB3f> boxes;
+
+    Terrain(size_t tileCountX, size_t tileCountY) :
+        info(tileCountX, tileCountY), boxes()
+    {
+        uint32_t seed = 4711;
+        auto random = [&seed](float range) {
+            seed = seed * 1664525u + 1013904223u;
+            return (seed >> 8) / float(1 << 24) * range;
+        };
+        for (size_t y = 0; y < tileCountY; ++y) {
+            for (size_t x = 0; x < tileCountX; ++x) {
+                const float z = random(400.0f) - 200.0f;
+                const Vector3f min(x * Info<float>::Grid::Size(), y * Info<float>::Grid::Size(), z);
+                boxes.push_back(AABB3f(min, min + Vector3f(Info<float>::Grid::Size(), Info<float>::Grid::Size(), random(300.0f))));
+            }
+        }
+    }
+
+    Ego::MeshBlocks::TileBox tileBox() const
+    {
+        return [this](const Index1D& index) { return boxes[index.getI()]; };
+    }
+};
+
+static Ego::Graphics::Frustum aFrustum(const Vector3f& eye, const Vector3f& target)
+{
+    Ego::Graphics::Frustum frustum;
+    frustum.calculate(Ego::Math::Transform::perspective(60.0f, 4.0f / 3.0f, 32.0f, 20000.0f),
+                      Ego::Math::Transform::lookAt(eye, target, Vector3f(0.0f, 0.0f, 1.0f)));
+    return frustum;
+}
+
+static std::vector<int> indices(const std::vector<Index1D>& tiles)
+{
+    std::vector<int> result;
+    for (const Index1D& tile : tiles) {
+        result.push_back(tile.getI());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+EgoTest_Test(cullMatchesPerTileFrustumTests)
+{
+    const Terrain terrain(37, 23);
+    Ego::MeshBlocks blocks;
+    blocks.build(terrain.info, terrain.tileBox(), 512.0f);
+    EgoTest_Assert(blocks.getBlockCountX() == 10);
+    EgoTest_Assert(blocks.getBlockCountY() == 6);
+
+    const float sizeX = terrain.info.getTileCountX() * Info<float>::Grid::Size(),
+                sizeY = terrain.info.getTileCountY() * Info<float>::Grid::Size();
+    const std::vector<std::pair<Vector3f, Vector3f>> views = {
+        //Above the middle of the mesh like the game camera
+        {Vector3f(sizeX * 0.5f, sizeY * 0.5f - 1000.0f, 1000.0f), Vector3f(sizeX * 0.5f, sizeY * 0.5f, 0.0f)},
+        //From a corner across the mesh
+        {Vector3f(-200.0f, -200.0f, 600.0f), Vector3f(sizeX, sizeY, 0.0f)},
+        //Close to the ground along the x-axis, the far side of the mesh is beyond the near tiles
+        {Vector3f(100.0f, sizeY * 0.5f, 50.0f), Vector3f(sizeX, sizeY * 0.5f, 50.0f)},
+        //Away from the mesh
+        {Vector3f(sizeX * 0.5f, -1000.0f, 500.0f), Vector3f(sizeX * 0.5f, -5000.0f, 0.0f)},
+    };
+    for (const auto& view : views) {
+        const Ego::Graphics::Frustum frustum = aFrustum(view.first, view.second);
+
+        std::vector<size_t> culledBlocks;
+        std::vector<Index1D> culledTiles;
+        blocks.cull(terrain.info, terrain.tileBox(), frustum, culledBlocks, culledTiles);
+
+        std::vector<Index1D> expectedTiles;
+        for (size_t i = 0; i < terrain.info.getTileCount(); ++i) {
+            if (Ego::Math::Relation::outside != frustum.intersects(terrain.boxes[i], true)) {
+                expectedTiles.push_back(Index1D(i));
+            }
+        }
+        EgoTest_Assert(indices(culledTiles) == indices(expectedTiles));
+
+        //Every tile in view lies in a block in view, and no block is reported twice
+        std::sort(culledBlocks.begin(), culledBlocks.end());
+        EgoTest_Assert(std::adjacent_find(culledBlocks.begin(), culledBlocks.end()) == culledBlocks.end());
+        for (const Index1D& tile : culledTiles) {
+            const size_t x = (tile.getI() % terrain.info.getTileCountX()) / Ego::MeshBlocks::getTilesPerBlock(),
+                         y = (tile.getI() / terrain.info.getTileCountX()) / Ego::MeshBlocks::getTilesPerBlock();
+            EgoTest_Assert(std::binary_search(culledBlocks.begin(), culledBlocks.end(), y * blocks.getBlockCountX() + x));
+        }
+    }
+}
+
+EgoTest_Test(emptyMeshHasNoBlocks)
+{
+    const Terrain terrain(0, 0);
+    Ego::MeshBlocks blocks;
+    blocks.build(terrain.info, terrain.tileBox(), 512.0f);
+    EgoTest_Assert(blocks.getBlockCountX() == 0);
+
+    std::vector<size_t> culledBlocks;
+    std::vector<Index1D> culledTiles;
+    blocks.cull(terrain.info, terrain.tileBox(), aFrustum(Vector3f(0.0f, -1000.0f, 1000.0f), Vector3f::zero()), culledBlocks, culledTiles);
+    EgoTest_Assert(culledBlocks.empty() && culledTiles.empty());
+}
+
+};
@@ -0,0 +1,232 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include <vector>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Core/OrderedTaskRunner.hpp"
+
+EgoTest_TestCase(OrderedTaskRunnerTest)
+{
+
+/// A tiny deterministic "world": every actor owns a private value, dependent actors
+/// additionally read and write a shared value. Independent actors only read shared state
+/// written by dependent actors, which is exactly the contract of OrderedTaskRunner.
+struct World
+{
+    struct Actor
+    {
+        bool independent;
+        uint32_t value;
+    };
+
+    std::vector<Actor> actors;
+    uint32_t shared;
+
+    World(size_t count) : actors(count), shared(1)
+    {
+        uint32_t seed = 12345;
+        for (size_t i = 0; i < count; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            actors[i].independent = (seed >> 16) % 5 != 0;
+            actors[i].value = seed;
+        }
+    }
+
+    void step(size_t index)
+    {
+        Actor &actor = actors[index];
+        if (actor.independent) {
+            for (int i = 0; i < 64; ++i) {
+                actor.value = actor.value * 31u + shared + static_cast<uint32_t>(i);
+            }
+        } else {
+            shared = shared * 7u + actor.value;
+            actor.value ^= shared;
+        }
+    }
+};
+
+static void runWorld(World& world, Ego::Core::OrderedTaskRunner& runner, int ticks)
+{
+    std::vector<size_t> indices(world.actors.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = i;
+    }
+    for (int tick = 0; tick < ticks; ++tick) {
+        runner.run(indices,
+                   [&world](size_t index) { return world.actors[index].independent; },
+                   [&world](size_t index) { world.step(index); });
+    }
+}
+
+EgoTest_Test(parallelRunMatchesSerialRun)
+{
+    World serialWorld(1000), parallelWorld(1000);
+
+    Ego::Core::OrderedTaskRunner serialRunner(0);
+    Ego::Core::OrderedTaskRunner parallelRunner(4, 2);
+    EgoTest_Assert(parallelRunner.getThreadCount() == 4);
+
+    runWorld(serialWorld, serialRunner, 50);
+    runWorld(parallelWorld, parallelRunner, 50);
+
+    EgoTest_Assert(serialWorld.shared == parallelWorld.shared);
+    for (size_t i = 0; i < serialWorld.actors.size(); ++i) {
+        EgoTest_Assert(serialWorld.actors[i].value == parallelWorld.actors[i].value);
+    }
+}
+
+/// Like World, but independent actors also damage other actors and append to a shared log.
+/// Those effects are deferred through command buffers, as the A.I. scripts do.
+struct CommandWorld
+{
+    struct Actor
+    {
+        bool independent;
+        uint32_t value;
+        int32_t health;
+    };
+
+    std::vector<Actor> actors;
+    uint32_t shared;
+    std::vector<size_t> log;
+    int tick;
+
+    CommandWorld(size_t count) : actors(count), shared(1), log(), tick(0)
+    {
+        uint32_t seed = 54321;
+        for (size_t i = 0; i < count; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            actors[i].independent = (seed >> 16) % 7 != 0;
+            actors[i].value = seed;
+            actors[i].health = 1000;
+        }
+    }
+
+    void step(size_t index)
+    {
+        Actor &actor = actors[index];
+        const size_t target = (index * 7 + static_cast<size_t>(tick)) % actors.size();
+        if (actor.independent) {
+            //Reading the health of others is fine, it is only written by commands and dependent actors
+            actor.value = actor.value * 31u + shared + static_cast<uint32_t>(actors[target].health);
+            const int32_t damage = static_cast<int32_t>(actor.value % 5);
+            Ego::Core::CommandBuffer::submit([this, index, target, damage]() {
+                actors[target].health -= damage;
+                log.push_back(index);
+            });
+        } else {
+            shared = shared * 7u + actor.value + static_cast<uint32_t>(actors[target].health);
+            actors[target].health += 3;
+            //Dependent actors have no buffer, this is executed right away
+            Ego::Core::CommandBuffer::submit([this, index]() { log.push_back(index); });
+        }
+    }
+};
+
+static void runCommandWorld(CommandWorld& world, Ego::Core::OrderedTaskRunner& runner, int ticks)
+{
+    std::vector<size_t> indices(world.actors.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = i;
+    }
+    for (world.tick = 0; world.tick < ticks; ++world.tick) {
+        runner.run(indices,
+                   [&world](size_t index) { return world.actors[index].independent; },
+                   [&world](size_t index) { world.step(index); });
+    }
+}
+
+EgoTest_Test(parallelRunWithCommandsMatchesSerialRun)
+{
+    CommandWorld serialWorld(1000), parallelWorld(1000);
+
+    Ego::Core::OrderedTaskRunner serialRunner(0);
+    Ego::Core::OrderedTaskRunner parallelRunner(4, 2);
+
+    runCommandWorld(serialWorld, serialRunner, 50);
+    runCommandWorld(parallelWorld, parallelRunner, 50);
+
+    EgoTest_Assert(serialWorld.shared == parallelWorld.shared);
+    for (size_t i = 0; i < serialWorld.actors.size(); ++i) {
+        EgoTest_Assert(serialWorld.actors[i].value == parallelWorld.actors[i].value);
+        EgoTest_Assert(serialWorld.actors[i].health == parallelWorld.actors[i].health);
+    }
+
+    //Every actor logged once per tick, in item order
+    EgoTest_Assert(serialWorld.log.size() == 50 * serialWorld.actors.size());
+    EgoTest_Assert(serialWorld.log == parallelWorld.log);
+    for (size_t i = 0; i < serialWorld.log.size(); ++i) {
+        EgoTest_Assert(serialWorld.log[i] == i % serialWorld.actors.size());
+    }
+}
+
+EgoTest_Test(commandsAreDeferredUntilTheRunOfIndependentItemsEnds)
+{
+    //Without workers, commands are deferred exactly as with them
+    Ego::Core::OrderedTaskRunner serialRunner(0);
+    Ego::Core::OrderedTaskRunner parallelRunner(3, 1);
+    for (Ego::Core::OrderedTaskRunner *runner : { &serialRunner, &parallelRunner }) {
+        std::vector<int> items = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        std::vector<int> executed;
+        std::vector<size_t> executedWhenProcessed(items.size());
+
+        runner->run(items,
+                    [](int item) { return item != 5; },
+                    [&](int item) {
+                        executedWhenProcessed[item] = executed.size();
+                        Ego::Core::CommandBuffer::submit([&executed, item]() { executed.push_back(item); });
+                    });
+
+        EgoTest_Assert(executed == items);
+        //Items 0 to 4 saw none of their commands, the barrier saw all of them and its own came right away
+        for (int item = 0; item < 5; ++item) {
+            EgoTest_Assert(0 == executedWhenProcessed[item]);
+        }
+        EgoTest_Assert(5 == executedWhenProcessed[5]);
+        for (int item = 6; item < 10; ++item) {
+            EgoTest_Assert(6 == executedWhenProcessed[item]);
+        }
+
+        //Outside of a run, commands are executed immediately
+        Ego::Core::CommandBuffer::submit([&executed]() { executed.push_back(10); });
+        EgoTest_Assert(11 == executed.size());
+    }
+}
+
+EgoTest_Test(itemsAreProcessedExactlyOnce)
+{
+    std::vector<int> items(257);
+    std::vector<std::atomic<int>> counts(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i] = static_cast<int>(i);
+        counts[i] = 0;
+    }
+
+    Ego::Core::OrderedTaskRunner runner(3, 1);
+    runner.run(items,
+               [](int item) { return item % 17 != 0; },
+               [&counts](int item) { counts[item]++; });
+
+    for (size_t i = 0; i < counts.size(); ++i) {
+        EgoTest_Assert(counts[i] == 1);
+    }
+}
+
+};
@@ -0,0 +1,145 @@
+#include <string>
+#include <vector>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/AI/PathService.hpp"
+#include "egolib/Math/_Include.hpp"
+#include "egolib/FileFormats/map_file.h"
+
+EgoTest_TestCase(PathServiceTest)
+{
+
+/// A grid from rows of characters, '#' is a wall
+struct Grid : public PathGrid
+{
+    static constexpr uint32_t WALL = 1;
+
+    std::vector<std::string> rows;
+    std::shared_ptr<int> owner;
+    uint32_t revision;
+
+    Grid(const std::vector<std::string>& rows) :
+        rows(rows), owner(std::make_shared<int>(0)), revision(0)
+    {}
+
+    int getTileCountX() const override { return static_cast<int>(rows.front().size()); }
+    int getTileCountY() const override { return static_cast<int>(rows.size()); }
+    bool isStopped(int x, int y, uint32_t stoppedBy) const override
+    {
+        const int32_t tile = getTileIndex(x, y);
+        return (tile < 0 || '#' == at(tile)) && (0 != (stoppedBy & WALL));
+    }
+    bool isWalkable(int32_t tile, uint32_t stoppedBy) const override
+    {
+        return !('#' == at(tile) && 0 != (stoppedBy & WALL));
+    }
+    std::shared_ptr<const void> getOwner() const override { return owner; }
+    uint32_t getRevision() const override { return revision; }
+
+    char at(int32_t tile) const { return rows[tile / getTileCountX()][tile % getTileCountX()]; }
+};
+
+/// Find a path to the centre of a tile and get its waypoints.
+static bool findPath(PathService& service, const Grid& grid, int srcX, int srcY, int dstX, int dstY, waypoint_list_t& wplst)
+{
+    waypoint_list_t::clear(wplst);
+    return service.find_path(grid, Grid::WALL, srcX, srcY, dstX, dstY,
+                             dstX * Info<int>::Grid::Size() + Info<int>::Grid::Size() / 2,
+                             dstY * Info<int>::Grid::Size() + Info<int>::Grid::Size() / 2, wplst);
+}
+
+EgoTest_Test(unreachableComponentFailsWithoutSearching)
+{
+    const Grid grid({
+        "................",
+        "..........####..",
+        "..........#..#..",
+        "..........####..",
+    });
+    AStar astar;
+    PathService service(astar);
+    waypoint_list_t wplst;
+    EgoTest_Assert(!findPath(service, grid, 0, 0, 11, 2, wplst));
+    EgoTest_Assert(0 == service.getCacheHits() && 0 == service.getCacheMisses());
+}
+
+EgoTest_Test(cacheHitsAndMisses)
+{
+    const Grid grid({
+        "........................",
+        "#######################.",
+        "........................",
+    });
+    AStar astar;
+    PathService service(astar);
+    waypoint_list_t wplst;
+    EgoTest_Assert(findPath(service, grid, 0, 0, 0, 2, wplst));
+    EgoTest_Assert(0 == service.getCacheHits() && 1 == service.getCacheMisses());
+    // the same regions share the cached path
+    EgoTest_Assert(findPath(service, grid, 1, 0, 2, 2, wplst));
+    EgoTest_Assert(1 == service.getCacheHits() && 1 == service.getCacheMisses());
+    // the way back is another path
+    EgoTest_Assert(findPath(service, grid, 0, 2, 0, 0, wplst));
+    EgoTest_Assert(1 == service.getCacheHits() && 2 == service.getCacheMisses());
+}
+
+EgoTest_Test(cacheHitDoesNotDoubleBack)
+{
+    const Grid grid({
+        "########################",
+        "........................",
+        "########################",
+    });
+    AStar astar;
+    PathService service(astar);
+    waypoint_list_t wplst;
+    EgoTest_Assert(findPath(service, grid, 0, 1, 23, 1, wplst));
+    EgoTest_Assert(findPath(service, grid, 2, 1, 21, 1, wplst));
+    EgoTest_Assert(1 == service.getCacheHits());
+    // a straight line has no waypoint but the destination, going to the ends of the cached path and back has more
+    EgoTest_Assert(1 == wplst._head);
+    EgoTest_Assert(wplst._pos[0][kX] == 21 * Info<int>::Grid::Size() + Info<int>::Grid::Size() / 2);
+}
+
+EgoTest_Test(longDetourSearchesAgain)
+{
+    const Grid grid({
+        "........................",
+        "........................",
+        "........................",
+        "........................",
+        "........................",
+        "........................",
+        "........................",
+        "........................",
+    });
+    AStar astar;
+    PathService service(astar);
+    waypoint_list_t wplst;
+    EgoTest_Assert(findPath(service, grid, 0, 0, 23, 0, wplst));
+    // the cached path is along the top row, this one is along the bottom row
+    EgoTest_Assert(findPath(service, grid, 7, 7, 16, 7, wplst));
+    EgoTest_Assert(0 == service.getCacheHits() && 2 == service.getCacheMisses());
+    EgoTest_Assert(1 == wplst._head);
+    // the fresh path replaced the cached one
+    EgoTest_Assert(findPath(service, grid, 6, 7, 17, 7, wplst));
+    EgoTest_Assert(1 == service.getCacheHits() && 2 == service.getCacheMisses());
+}
+
+EgoTest_Test(revisionChangeDropsTheCache)
+{
+    Grid grid({
+        "................",
+        "................",
+    });
+    AStar astar;
+    PathService service(astar);
+    waypoint_list_t wplst;
+    EgoTest_Assert(findPath(service, grid, 0, 0, 15, 1, wplst));
+    grid.rows[0][8] = '#';
+    grid.rows[1][8] = '#';
+    grid.revision++;
+    EgoTest_Assert(!findPath(service, grid, 0, 0, 15, 1, wplst));
+    EgoTest_Assert(0 == service.getCacheHits() && 1 == service.getCacheMisses());
+}
+
+};
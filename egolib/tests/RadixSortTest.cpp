@@ -0,0 +1,47 @@
+#include <algorithm>
+#include <vector>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Core/RadixSort.hpp"
+
+EgoTest_TestCase(RadixSortTest)
+{
+
+EgoTest_Test(sortIsStable)
+{
+    Ego::RadixSort<uint32_t> sorter;
+    std::vector<std::pair<uint64_t, uint32_t>> expected;
+
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < 5000; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        //Few distinct keys spread over all bytes of the key
+        const uint64_t key = (uint64_t(seed >> 28) << 52) | (uint64_t(seed >> 24 & 0xF) << 8);
+        sorter.push(key, i);
+        expected.emplace_back(key, i);
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const std::pair<uint64_t, uint32_t>& x, const std::pair<uint64_t, uint32_t>& y) { return x.first < y.first; });
+
+    sorter.sort();
+    EgoTest_Assert(sorter.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EgoTest_Assert(sorter.getElements()[i].key == expected[i].first);
+        EgoTest_Assert(sorter.getElements()[i].value == expected[i].second);
+    }
+
+    //Sorting again reuses the storage
+    sorter.clear();
+    EgoTest_Assert(sorter.size() == 0);
+    sorter.sort();
+}
+
+EgoTest_Test(floatKeysKeepTheOrder)
+{
+    const std::vector<float> values = { -1000.0f, -2.5f, -0.0f, 0.0f, 1e-6f, 1.0f, 2.5f, 1e9f };
+    for (size_t i = 1; i < values.size(); ++i) {
+        EgoTest_Assert(Ego::RadixSort<int>::getKey(values[i - 1]) <= Ego::RadixSort<int>::getKey(values[i]));
+    }
+    EgoTest_Assert(Ego::RadixSort<int>::getKey(-2.5f) < Ego::RadixSort<int>::getKey(-1.0f));
+}
+
+};
@@ -0,0 +1,92 @@
+#include <vector>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/FileFormats/Replay.hpp"
+
+EgoTest_TestCase(ReplayTest)
+{
+
+static latch_t aLatch(float x, float y, unsigned long buttons)
+{
+    latch_t latch;
+    latch.x = x;
+    latch.y = y;
+    latch.b = std::bitset<32>(buttons);
+    return latch;
+}
+
+static bool equal(const latch_t& a, const latch_t& b)
+{
+    return a.x == b.x && a.y == b.y && a.b == b.b;
+}
+
+/// The latches of two players over a few ticks, some ticks are idle
+static std::vector<std::array<latch_t, 2>> someTicks()
+{
+    std::vector<std::array<latch_t, 2>> ticks;
+    for (int tick = 0; tick < 50; ++tick) {
+        const float x = (tick / 5) * 0.1f - 0.5f;
+        ticks.push_back({{ aLatch(x, -x, tick % 7 == 0 ? 3 : 0), aLatch(0.0f, tick < 25 ? 1.0f : -1.0f, 1u << 31) }});
+    }
+    return ticks;
+}
+
+static std::vector<uint8_t> record(const std::vector<std::array<latch_t, 2>>& ticks)
+{
+    Ego::ReplayRecorder recorder;
+    recorder.begin("adventurer.mod", 0xDEADBEEF, { "mage", "söldner" });
+    for (const auto& latches : ticks) {
+        recorder.recordLatch(0, latches[0]);
+        recorder.recordLatch(1, latches[1]);
+        recorder.endTick();
+    }
+    EgoTest_Assert(recorder.getTickCount() == ticks.size());
+    return recorder.getData();
+}
+
+EgoTest_Test(playbackReproducesTheRecording)
+{
+    const std::vector<std::array<latch_t, 2>> ticks = someTicks();
+    const std::vector<uint8_t> data = record(ticks);
+
+    Ego::ReplayPlayback playback(data);
+    EgoTest_Assert(playback.getModuleName() == "adventurer.mod");
+    EgoTest_Assert(playback.getSeed() == 0xDEADBEEF);
+    EgoTest_Assert(playback.getImportPlayers().size() == 2);
+    EgoTest_Assert(playback.getImportPlayers()[1] == "söldner");
+
+    for (const auto& latches : ticks) {
+        EgoTest_Assert(playback.nextTick());
+        EgoTest_Assert(equal(playback.getLatch(0), latches[0]));
+        EgoTest_Assert(equal(playback.getLatch(1), latches[1]));
+        EgoTest_Assert(equal(playback.getLatch(2), latch_t()));
+    }
+    EgoTest_Assert(playback.isFinished());
+    EgoTest_Assert(!playback.nextTick());
+    EgoTest_Assert(playback.getTickCount() == ticks.size());
+}
+
+EgoTest_Test(idleTicksCostOneByte)
+{
+    std::vector<std::array<latch_t, 2>> ticks(100);
+    const std::vector<uint8_t> idle = record(ticks);
+    ticks.resize(200);
+    EgoTest_Assert(record(ticks).size() == idle.size() + 100);
+}
+
+EgoTest_Test(truncatedRecordsEndThePlayback)
+{
+    const std::vector<std::array<latch_t, 2>> ticks = someTicks();
+    const std::vector<uint8_t> data = record(ticks);
+
+    //Cut into the last record, which holds the latch of the second player
+    const std::vector<uint8_t> truncated(data.begin(), data.end() - 5);
+    Ego::ReplayPlayback playback(truncated);
+    size_t played = 0;
+    while (playback.nextTick()) {
+        played++;
+    }
+    EgoTest_Assert(played == ticks.size() - 1);
+    EgoTest_Assert(playback.isFinished());
+}
+
+};
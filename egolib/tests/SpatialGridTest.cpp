@@ -0,0 +1,230 @@
+#include <vector>
+#include <thread>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Core/SpatialGrid.hpp"
+#include "egolib/Math/Standard.hpp"
+
+EgoTest_TestCase(SpatialGridTest)
+{
+
+class SpatialGridElement
+{
+public:
+    SpatialGridElement(float x, float y, float size) : _bounds(Vector2f(x-size, y-size), Vector2f(x+size, y+size)), _terminated(false)
+    {
+        //ctor
+    }
+
+    AABB2f& getAABB2D() { return _bounds; }
+    const AABB2f& getAABB2D() const { return _bounds; }
+
+    bool isTerminated() const { return _terminated; }
+    void terminate() { _terminated = true; }
+
+private:
+    AABB2f _bounds;
+    bool _terminated;
+};
+
+static AABB2f anAABBFromARect(float centerX, float centerY, float size) {
+    return AABB2f(Vector2f(centerX - size, centerY - size), Vector2f(centerX + size, centerY + size));
+}
+
+/// All elements overlapping the search area, in the order of the element list
+static std::vector<SpatialGridElement *> bruteForceFind(const std::vector<std::shared_ptr<SpatialGridElement>> &elements, const AABB2f &searchArea)
+{
+    std::vector<SpatialGridElement *> result;
+    for(const std::shared_ptr<SpatialGridElement> &element : elements) {
+        if(!element->isTerminated() && element->getAABB2D().overlaps(searchArea)) {
+            result.push_back(element.get());
+        }
+    }
+    return result;
+}
+
+static std::vector<SpatialGridElement *> sorted(const std::vector<std::shared_ptr<SpatialGridElement>> &elements)
+{
+    std::vector<SpatialGridElement *> result;
+    for(const std::shared_ptr<SpatialGridElement> &element : elements) {
+        result.push_back(element.get());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+EgoTest_Test(elementsSpanningSeveralCellsAreFoundOnce)
+{
+    Ego::SpatialGrid<SpatialGridElement> grid;
+    std::vector<std::shared_ptr<SpatialGridElement>> elements;
+    grid.setBounds(0, 0, 512, 512, 32);
+
+    //Elements from a fraction of a cell up to several cells wide, some reaching over the bounds
+    uint32_t seed = 4711;
+    auto next = [&seed](uint32_t range) { seed = seed * 1664525u + 1013904223u; return static_cast<float>((seed >> 8) % range); };
+    for(int i = 0; i < 300; ++i) {
+        elements.push_back(std::make_shared<SpatialGridElement>(next(600) - 40.0f, next(600) - 40.0f, 1.0f + next(80)));
+        grid.insert(elements.back());
+    }
+
+    for(int round = 0; round < 20; ++round) {
+        for(int i = 0; i < 50; ++i) {
+            AABB2f searchArea = anAABBFromARect(next(512), next(512), 1.0f + next(150));
+            std::vector<std::shared_ptr<SpatialGridElement>> result;
+            grid.find(searchArea, result);
+
+            std::vector<SpatialGridElement *> expected = bruteForceFind(elements, searchArea);
+            std::sort(expected.begin(), expected.end());
+            EgoTest_Assert(sorted(result) == expected);
+        }
+
+        //Move some elements across cells before the next round
+        for(const std::shared_ptr<SpatialGridElement> &element : elements) {
+            if(next(3) == 0) {
+                element->getAABB2D() = anAABBFromARect(next(600) - 40.0f, next(600) - 40.0f, 1.0f + next(80));
+            }
+        }
+        grid.update();
+    }
+}
+
+EgoTest_Test(runSpatialGridTestStatic)
+{
+    Ego::SpatialGrid<SpatialGridElement> grid;
+    std::vector<std::shared_ptr<SpatialGridElement>> elements;
+
+    //Put a fat element in the middle of the grid
+    elements.push_back(std::make_shared<SpatialGridElement>(128, 128, 20));
+
+    //Put one element in each corner
+    elements.push_back(std::make_shared<SpatialGridElement>(0, 0, 5));
+    elements.push_back(std::make_shared<SpatialGridElement>(256, 0, 5));
+    elements.push_back(std::make_shared<SpatialGridElement>(0, 256, 5));
+    elements.push_back(std::make_shared<SpatialGridElement>(256, 256, 5));
+
+    grid.setBounds(0, 0, 256, 256, 32);
+    for(const std::shared_ptr<SpatialGridElement> &element : elements) {
+        grid.insert(element);
+    }
+
+    std::vector<std::shared_ptr<SpatialGridElement>> findResults;
+
+    //Searching outside the grid should produce no results
+    grid.find(anAABBFromARect(-50, -50, 20), findResults);
+    EgoTest_Assert(findResults.empty());
+    findResults.clear();
+
+    //Searching around each corner should find one element
+    grid.find(anAABBFromARect(0, 0, 50), findResults);
+    EgoTest_Assert(findResults.size() == 1);
+    findResults.clear();
+
+    grid.find(anAABBFromARect(256, 256, 50), findResults);
+    EgoTest_Assert(findResults.size() == 1);
+    findResults.clear();
+
+    //Searching in the middle should find exactly one element, even though it spans several cells
+    grid.find(anAABBFromARect(128, 128, 50), findResults);
+    EgoTest_Assert(findResults.size() == 1);
+    findResults.clear();
+
+    //Searching whole grid should find all elements exactly once
+    grid.find(anAABBFromARect(128, 128, 128), findResults);
+    EgoTest_Assert(findResults.size() == elements.size());
+    findResults.clear();
+
+    //A predicate filters results
+    grid.find(anAABBFromARect(128, 128, 128), findResults, [&elements](const SpatialGridElement& element) { return &element != elements[0].get(); });
+    EgoTest_Assert(findResults.size() == elements.size() - 1);
+    findResults.clear();
+}
+
+EgoTest_Test(runSpatialGridTestIncremental)
+{
+    Ego::SpatialGrid<SpatialGridElement> grid;
+    std::vector<std::shared_ptr<SpatialGridElement>> elements;
+
+    //Elements inserted before the bounds are known must be bucketed later
+    for(int i = 0; i < 16; ++i) {
+        elements.push_back(std::make_shared<SpatialGridElement>(16.0f * i, 16.0f * i, 4));
+        grid.insert(elements.back());
+    }
+    grid.setBounds(0, 0, 256, 256, 32);
+
+    std::vector<std::shared_ptr<SpatialGridElement>> result;
+    grid.find(anAABBFromARect(128, 128, 128), result);
+    EgoTest_Assert(result.size() == elements.size());
+
+    //Move all elements into the bottom right corner
+    for(size_t i = 0; i < elements.size(); ++i) {
+        float x = 130.0f + i * 7.0f;
+        float y = 130.0f + i * 7.0f;
+        elements[i]->getAABB2D() = AABB2f(Vector2f(x, y), Vector2f(x+10, y+10));
+    }
+    grid.update();
+
+    //All elements should be found in bottom right now
+    result.clear();
+    grid.find(AABB2f(Vector2f(128, 128), Vector2f(256, 256)), result);
+    EgoTest_Assert(result.size() == elements.size());
+
+    //If we look top half, we should find nothing now
+    result.clear();
+    grid.find(AABB2f(Vector2f(0, 0), Vector2f(256, 127)), result);
+    EgoTest_Assert(result.empty());
+
+    //Terminated elements are not found and are dropped on update
+    elements[0]->terminate();
+    elements[5]->terminate();
+    result.clear();
+    grid.find(AABB2f(Vector2f(128, 128), Vector2f(256, 256)), result);
+    EgoTest_Assert(result.size() == elements.size() - 2);
+    grid.update();
+    EgoTest_Assert(grid.size() == elements.size() - 2);
+    result.clear();
+    grid.find(AABB2f(Vector2f(128, 128), Vector2f(256, 256)), result);
+    EgoTest_Assert(result.size() == elements.size() - 2);
+}
+
+EgoTest_Test(concurrentQueriesMatchSerialQueries)
+{
+    Ego::SpatialGrid<SpatialGridElement> grid;
+    std::vector<std::shared_ptr<SpatialGridElement>> elements;
+    grid.setBounds(0, 0, 512, 512, 32);
+    for(int i = 0; i < 400; ++i) {
+        elements.push_back(std::make_shared<SpatialGridElement>((i * 37) % 512, (i * 91) % 512, 4.0f + (i % 9) * 10.0f));
+        grid.insert(elements.back());
+    }
+
+    std::vector<AABB2f> searchAreas;
+    for(int i = 0; i < 64; ++i) {
+        searchAreas.push_back(anAABBFromARect((i * 53) % 512, (i * 29) % 512, 20.0f + (i % 5) * 30.0f));
+    }
+
+    std::vector<std::vector<SpatialGridElement *>> expected;
+    for(const AABB2f &searchArea : searchAreas) {
+        std::vector<std::shared_ptr<SpatialGridElement>> result;
+        grid.find(searchArea, result);
+        expected.push_back(sorted(result));
+    }
+
+    //Queries do not modify the grid, hence the same results on every thread
+    std::vector<std::thread> threads;
+    std::atomic<int> mismatches(0);
+    for(int t = 0; t < 4; ++t) {
+        threads.emplace_back([&grid, &searchAreas, &expected, &mismatches]() {
+            for(int repeat = 0; repeat < 50; ++repeat) {
+                for(size_t i = 0; i < searchAreas.size(); ++i) {
+                    std::vector<std::shared_ptr<SpatialGridElement>> result;
+                    grid.find(searchAreas[i], result);
+                    if(sorted(result) != expected[i]) mismatches++;
+                }
+            }
+        });
+    }
+    for(std::thread &thread : threads) {
+        thread.join();
+    }
+    EgoTest_Assert(0 == mismatches);
+}
+
+};
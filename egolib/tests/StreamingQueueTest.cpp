@@ -0,0 +1,84 @@
+#include <vector>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Core/StreamingQueue.hpp"
+
+EgoTest_TestCase(StreamingQueueTest)
+{
+
+/// Stands in for reading and decoding an image
+static std::string decodeName(const std::string& name)
+{
+    if (name.empty()) {
+        throw std::invalid_argument("empty name");
+    }
+    return "decoded " + name;
+}
+
+EgoTest_Test(everyRequestIsUploadedOnce)
+{
+    Ego::Core::StreamingQueue<std::string, std::string> queue(4, decodeName);
+    std::vector<std::string> uploaded;
+
+    for (int i = 0; i < 100; ++i) {
+        EgoTest_Assert(queue.request("texture" + std::to_string(i)));
+    }
+    //Requests for pending keys are ignored
+    EgoTest_Assert(!queue.request("texture42"));
+    EgoTest_Assert(queue.getPendingCount() == 100);
+
+    queue.wait();
+    queue.upload([&uploaded](const std::string& key, std::string&& payload) {
+        EgoTest_Assert(payload == "decoded " + key);
+        uploaded.push_back(key);
+    }, std::chrono::seconds(10));
+
+    EgoTest_Assert(uploaded.size() == 100);
+    EgoTest_Assert(queue.getPendingCount() == 0);
+    EgoTest_Assert(!queue.isPending("texture42"));
+
+    //Once uploaded, a key can be requested again
+    EgoTest_Assert(queue.request("texture42"));
+}
+
+EgoTest_Test(uploadsStayWithinTheBudget)
+{
+    Ego::Core::StreamingQueue<std::string, std::string> queue(2, decodeName);
+    for (int i = 0; i < 10; ++i) {
+        queue.request("texture" + std::to_string(i));
+    }
+    queue.wait();
+
+    //A budget of zero uploads one payload per call
+    size_t calls = 0;
+    while (queue.upload([](const std::string&, std::string&&) {}, std::chrono::microseconds(0)) > 0) {
+        calls++;
+        EgoTest_Assert(queue.getPendingCount() == 10 - calls);
+    }
+    EgoTest_Assert(calls == 10);
+}
+
+EgoTest_Test(failedDecodesYieldEmptyPayloads)
+{
+    Ego::Core::StreamingQueue<std::string, std::string> queue(0, decodeName);
+    queue.request("");
+
+    std::string uploaded = "not uploaded";
+    EgoTest_Assert(queue.upload([&uploaded](const std::string&, std::string&& payload) { uploaded = payload; },
+                                std::chrono::milliseconds(1)) == 1);
+    EgoTest_Assert(uploaded.empty());
+}
+
+EgoTest_Test(clearDropsPendingKeys)
+{
+    Ego::Core::StreamingQueue<std::string, std::string> queue(2, decodeName);
+    for (int i = 0; i < 10; ++i) {
+        queue.request("texture" + std::to_string(i));
+    }
+    queue.clear();
+    queue.wait();
+
+    EgoTest_Assert(queue.getPendingCount() == 0);
+    EgoTest_Assert(queue.upload([](const std::string&, std::string&&) {}, std::chrono::seconds(10)) == 0);
+}
+
+};
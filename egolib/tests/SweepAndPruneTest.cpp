@@ -0,0 +1,138 @@
+#include <vector>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Core/SweepAndPrune.hpp"
+#include "egolib/Math/Standard.hpp"
+
+EgoTest_TestCase(SweepAndPruneTest)
+{
+
+static AABB2f anAABBFromARect(float centerX, float centerY, float size) {
+    return AABB2f(Vector2f(centerX - size, centerY - size), Vector2f(centerX + size, centerY + size));
+}
+
+/// All pairs of overlapping boxes, the slow way
+static std::vector<Ego::SweepAndPrune::Pair> bruteForcePairs(const std::vector<AABB2f>& boxes)
+{
+    std::vector<Ego::SweepAndPrune::Pair> pairs;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        for (size_t j = i + 1; j < boxes.size(); ++j) {
+            if (boxes[i].overlaps(boxes[j])) {
+                pairs.emplace_back(i, j);
+            }
+        }
+    }
+    return pairs;
+}
+
+EgoTest_Test(pairsFollowTheElements)
+{
+    Ego::SweepAndPrune broadphase;
+
+    broadphase.update(1, anAABBFromARect(0, 0, 10));
+    broadphase.update(2, anAABBFromARect(15, 0, 10));
+    broadphase.update(3, anAABBFromARect(100, 100, 10));
+    broadphase.commit();
+    EgoTest_Assert(broadphase.getPairs().size() == 1);
+    EgoTest_Assert(broadphase.getPairs()[0] == Ego::SweepAndPrune::Pair(1, 2));
+
+    //Nothing moved, nothing changed
+    broadphase.update(1, anAABBFromARect(0, 0, 10));
+    broadphase.update(2, anAABBFromARect(15, 0, 10));
+    broadphase.update(3, anAABBFromARect(100, 100, 10));
+    broadphase.commit();
+    EgoTest_Assert(broadphase.getPairs().size() == 1);
+    EgoTest_Assert(broadphase.getPairs()[0] == Ego::SweepAndPrune::Pair(1, 2));
+
+    //Element 3 moves onto element 2, element 1 moves away
+    broadphase.update(1, anAABBFromARect(-50, 0, 10));
+    broadphase.update(2, anAABBFromARect(15, 0, 10));
+    broadphase.update(3, anAABBFromARect(20, 5, 10));
+    broadphase.commit();
+    EgoTest_Assert(broadphase.getPairs().size() == 1);
+    EgoTest_Assert(broadphase.getPairs()[0] == Ego::SweepAndPrune::Pair(2, 3));
+
+    //Elements that are not updated are removed together with their pairs
+    broadphase.update(1, anAABBFromARect(-50, 0, 10));
+    broadphase.update(2, anAABBFromARect(15, 0, 10));
+    broadphase.commit();
+    EgoTest_Assert(broadphase.size() == 2);
+    EgoTest_Assert(broadphase.getPairs().empty());
+}
+
+EgoTest_Test(filtersRejectPairs)
+{
+    Ego::SweepAndPrune broadphase;
+
+    //Group 2 only pairs with group 1, never with itself
+    broadphase.update(1, anAABBFromARect(0, 0, 10), 1, 1 | 2);
+    broadphase.update(2, anAABBFromARect(1, 1, 10), 2, 1);
+    broadphase.update(3, anAABBFromARect(2, 2, 10), 2, 1);
+    broadphase.commit();
+    EgoTest_Assert(broadphase.getPairs().size() == 2);
+    EgoTest_Assert(broadphase.getPairs()[0] == Ego::SweepAndPrune::Pair(1, 2));
+    EgoTest_Assert(broadphase.getPairs()[1] == Ego::SweepAndPrune::Pair(1, 3));
+}
+
+EgoTest_Test(pairsMatchBruteForce)
+{
+    Ego::SweepAndPrune broadphase;
+    std::vector<AABB2f> boxes;
+    std::vector<Vector2f> velocities;
+
+    uint32_t seed = 12345;
+    auto random = [&seed](float range) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) / float(1 << 24) * range;
+    };
+
+    for (size_t i = 0; i < 200; ++i) {
+        boxes.push_back(anAABBFromARect(random(512), random(512), 1 + random(16)));
+        velocities.push_back(Vector2f(random(8) - 4, random(8) - 4));
+    }
+
+    for (int tick = 0; tick < 100; ++tick) {
+        //Only some of the elements move each tick
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            if ((i + tick) % 3 == 0) {
+                boxes[i] = AABB2f(boxes[i].getMin() + velocities[i], boxes[i].getMax() + velocities[i]);
+            }
+            broadphase.update(i, boxes[i]);
+        }
+        broadphase.commit();
+
+        const std::vector<Ego::SweepAndPrune::Pair> expected = bruteForcePairs(boxes);
+        EgoTest_Assert(broadphase.getPairs() == expected);
+    }
+}
+
+EgoTest_Test(pairsMatchBruteForceAfterJumps)
+{
+    Ego::SweepAndPrune broadphase;
+    std::vector<AABB2f> boxes;
+
+    uint32_t seed = 4711;
+    auto random = [&seed](float range) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) / float(1 << 24) * range;
+    };
+
+    for (size_t i = 0; i < 100; ++i) {
+        boxes.push_back(anAABBFromARect(random(256), random(256), 1 + random(16)));
+    }
+
+    for (int tick = 0; tick < 50; ++tick) {
+        //Elements jumping across many others start and stop many pairs in a single commit
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            if ((i + tick) % 5 == 0) {
+                boxes[i] = anAABBFromARect(random(256), random(256), 1 + random(16));
+            }
+            broadphase.update(i, boxes[i]);
+        }
+        broadphase.commit();
+
+        const std::vector<Ego::SweepAndPrune::Pair> expected = bruteForcePairs(boxes);
+        EgoTest_Assert(broadphase.getPairs() == expected);
+    }
+}
+
+};
@@ -0,0 +1,57 @@
+#include <string>
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/Script/TextInputFile.hpp"
+
+EgoTest_TestCase(TextInputFileTest)
+{
+
+typedef Ego::Script::Traits<char> Traits;
+typedef Ego::Script::TextInputFile<Traits> TextInputFile;
+
+EgoTest_Test(scansInMemoryBuffer)
+{
+    const std::string contents = "[NAME] \"Sword\"\n: 1.5";
+    TextInputFile file("test.txt", contents.data(), contents.size());
+    EgoTest_Assert(file.isOpen());
+    EgoTest_Assert(file.get() == Traits::startOfInput());
+
+    std::string scanned;
+    for (file.advance(); file.get() != Traits::endOfInput(); file.advance()) {
+        EgoTest_Assert(file.get() != Traits::error());
+        scanned += static_cast<char>(file.get());
+    }
+    EgoTest_Assert(scanned == contents);
+
+    //The end of the input is sticky
+    file.advance();
+    EgoTest_Assert(file.get() == Traits::endOfInput());
+}
+
+EgoTest_Test(rejectsInvalidBytes)
+{
+    const char contents[] = { 'a', '\0', 'b' };
+    TextInputFile file("test.txt", contents, sizeof(contents));
+    file.advance();
+    EgoTest_Assert(file.get() == 'a');
+    file.advance();
+    EgoTest_Assert(file.get() == Traits::error());
+
+    //Errors are sticky
+    file.advance();
+    EgoTest_Assert(file.get() == Traits::error());
+
+    const char nonAscii[] = { '\xC3', '\xA4' };
+    TextInputFile other("test.txt", nonAscii, sizeof(nonAscii));
+    other.advance();
+    EgoTest_Assert(other.get() == Traits::error());
+}
+
+EgoTest_Test(emptyFileEndsImmediately)
+{
+    TextInputFile file("empty.txt", nullptr, 0);
+    EgoTest_Assert(file.isOpen());
+    file.advance();
+    EgoTest_Assert(file.get() == Traits::endOfInput());
+}
+
+};
@@ -0,0 +1,317 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+/// @author Zefz aka Johan Jansen
+
+/// @file game/Core/Benchmarks.cpp
+/// @brief Micro-benchmarks of engine kernels
+
+#include "game/Core/Benchmarks.hpp"
+#include "egolib/Log/_Include.hpp"
+#include "egolib/frustum.h"
+#include "egolib/Math/Transform.hpp"
+#include "egolib/Graphics/MD2VertexArrays.hpp"
+#include "game/Graphics/Vertex.hpp"
+#include "egolib/Script/TextInputFile.hpp"
+#include "egolib/vfs.h"
+
+/// Run a function a number of rounds and return the time taken, in nanoseconds per item.
+template <typename Function>
+static double measure(const size_t rounds, const size_t items, Function function)
+{
+    const auto begin = std::chrono::high_resolution_clock::now();
+    for (size_t round = 0; round < rounds; ++round) {
+        function();
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / (rounds * items);
+}
+
+/// The same sequence of pseudo-random numbers in <tt>[0, range)</tt> on every run.
+class BenchmarkRandom
+{
+public:
+    BenchmarkRandom() : _seed(12345) {}
+
+    float operator()(const float range)
+    {
+        _seed = _seed * 1664525u + 1013904223u;
+        return (_seed >> 8) / float(1 << 24) * range;
+    }
+
+private:
+    uint32_t _seed;
+};
+
+static size_t countBits(const std::vector<uint32_t>& words)
+{
+    size_t count = 0;
+    for (uint32_t word : words) {
+        for (; 0 != word; word &= word - 1) count++;
+    }
+    return count;
+}
+
+/// Collect the VFS pathnames of all .txt files below a directory.
+static void findTextFiles(const std::string& directory, std::vector<std::string>& pathnames)
+{
+    // Finish the search before descending, the search contexts share their path buffer.
+    std::vector<std::string> entries;
+    vfs_search_context_t *context = vfs_findFirst(directory.c_str(), nullptr, VFS_SEARCH_ALL);
+    for (const char *entry = vfs_search_context_get_current(context); nullptr != context && nullptr != entry && '\0' != entry[0]; entry = vfs_search_context_get_current(context)) {
+        entries.push_back(entry);
+        context = vfs_findNext(&context);
+    }
+    vfs_findClose(&context);
+
+    for (const std::string& entry : entries) {
+        if (vfs_isDirectory(entry)) {
+            findTextFiles(entry, pathnames);
+        } else if (entry.size() >= 4 && 0 == entry.compare(entry.size() - 4, 4, ".txt")) {
+            pathnames.push_back(entry);
+        }
+    }
+}
+
+/// Scan a file the way the readers do and return the number of tokens.
+template <typename TextInputFile>
+static size_t countTokens(TextInputFile& file)
+{
+    typedef Ego::Script::Traits<char> Traits;
+    size_t tokens = 0;
+    bool inToken = false;
+    for (file.advance(); file.get() != Traits::endOfInput() && file.get() != Traits::error(); file.advance()) {
+        const bool whiteSpace = Traits::isWhiteSpace(file.get()) || Traits::isNewLine(file.get());
+        if (!whiteSpace && !inToken) {
+            tokens++;
+        }
+        inToken = !whiteSpace;
+    }
+    return tokens;
+}
+
+bool Benchmarks::run(const std::string& name)
+{
+    if (name == "frustum") {
+        frustum();
+        return true;
+    }
+    if (name == "md2") {
+        md2Interpolation();
+        return true;
+    }
+    if (name == "parse") {
+        parse();
+        return true;
+    }
+    Log::get().warn("%s:%d: unknown benchmark \"%s\"\n", __FILE__, __LINE__, name.c_str());
+    return false;
+}
+
+void Benchmarks::frustum()
+{
+    // A camera looking down at the origin like the game camera does.
+    Ego::Graphics::Frustum frustum;
+    frustum.calculate(Ego::Math::Transform::perspective(60.0f, 4.0f / 3.0f, 1.0f, 5000.0f),
+                      Ego::Math::Transform::lookAt(Vector3f(0.0f, -1000.0f, 1000.0f), Vector3f::zero(), Vector3f(0.0f, 0.0f, 1.0f)));
+
+    // Primitives around the camera target, stored once per primitive and once as one array per component.
+    static const size_t count = 10000;
+    static const size_t rounds = 100;
+    BenchmarkRandom random;
+    std::vector<Sphere3f> spheres;
+    std::vector<AABB3f> aabbs;
+    std::vector<float> x, y, z, radius, minX, minY, minZ, maxX, maxY, maxZ;
+    for (size_t i = 0; i < count; ++i) {
+        x.push_back(random(6000.0f) - 3000.0f);
+        y.push_back(random(6000.0f) - 3000.0f);
+        z.push_back(random(1000.0f) - 500.0f);
+        radius.push_back(random(200.0f));
+        minX.push_back(x.back() - random(200.0f));
+        minY.push_back(y.back() - random(200.0f));
+        minZ.push_back(z.back() - random(200.0f));
+        maxX.push_back(x.back() + random(200.0f));
+        maxY.push_back(y.back() + random(200.0f));
+        maxZ.push_back(z.back() + random(200.0f));
+        spheres.emplace_back(Vector3f(x.back(), y.back(), z.back()), radius.back());
+        aabbs.emplace_back(Vector3f(minX.back(), minY.back(), minZ.back()), Vector3f(maxX.back(), maxY.back(), maxZ.back()));
+    }
+    std::vector<uint32_t> visible((count + 31) / 32);
+
+    // The counts keep the compiler from dropping the loops.
+    size_t scalarCount = 0, batchCount = 0;
+    const double scalarSpheres = measure(rounds, count, [&]() {
+        for (const Sphere3f& sphere : spheres) {
+            if (Ego::Math::Relation::outside != frustum.intersects(sphere, false)) scalarCount++;
+        }
+    });
+    const double batchSpheres = measure(rounds, count, [&]() {
+        frustum.intersects_spheres(x.data(), y.data(), z.data(), radius.data(), count, false, visible.data());
+        batchCount += countBits(visible);
+    });
+    Log::get().message("Frustum benchmark, %u spheres: %.2f ns scalar, %.2f ns batched per sphere, %u and %u visible\n",
+                       static_cast<unsigned>(count), scalarSpheres, batchSpheres,
+                       static_cast<unsigned>(scalarCount / rounds), static_cast<unsigned>(batchCount / rounds));
+
+    scalarCount = 0, batchCount = 0;
+    const double scalarAABBs = measure(rounds, count, [&]() {
+        for (const AABB3f& aabb : aabbs) {
+            if (Ego::Math::Relation::outside != frustum.intersects(aabb, false)) scalarCount++;
+        }
+    });
+    const double batchAABBs = measure(rounds, count, [&]() {
+        frustum.intersects_aabbs(minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data(),
+                                 count, false, visible.data());
+        batchCount += countBits(visible);
+    });
+    Log::get().message("Frustum benchmark, %u AABBs: %.2f ns scalar, %.2f ns batched per AABB, %u and %u visible\n",
+                       static_cast<unsigned>(count), scalarAABBs, batchAABBs,
+                       static_cast<unsigned>(scalarCount / rounds), static_cast<unsigned>(batchCount / rounds));
+}
+
+void Benchmarks::md2Interpolation()
+{
+    // About the vertex count of a detailed character model.
+    static const size_t count = 512;
+    static const size_t rounds = 20000;
+    static const size_t normalCount = 163;
+
+    // A vertex as MD2 frames stored it before they were split into arrays.
+    struct LegacyVertex
+    {
+        float pos[3];
+        float nrm[3];
+        size_t normal;
+    };
+
+    BenchmarkRandom random;
+    float environmentU[normalCount];
+    for (size_t i = 0; i < normalCount; ++i) {
+        environmentU[i] = random(1.0f);
+    }
+    std::array<std::vector<LegacyVertex>, 2> legacyFrames;
+    std::array<MD2_VertexArrays, 2> frames;
+    for (size_t frame = 0; frame < 2; ++frame) {
+        legacyFrames[frame].resize(count);
+        frames[frame].resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            LegacyVertex &vertex = legacyFrames[frame][i];
+            for (size_t j = 0; j < 3; ++j) {
+                vertex.pos[j] = random(200.0f) - 100.0f;
+                vertex.nrm[j] = random(2.0f) - 1.0f;
+            }
+            vertex.normal = static_cast<size_t>(random(normalCount - 1));
+            frames[frame].get(MD2_VertexArrays::PositionX)[i] = vertex.pos[0];
+            frames[frame].get(MD2_VertexArrays::PositionY)[i] = vertex.pos[1];
+            frames[frame].get(MD2_VertexArrays::PositionZ)[i] = vertex.pos[2];
+            frames[frame].get(MD2_VertexArrays::NormalX)[i] = vertex.nrm[0];
+            frames[frame].get(MD2_VertexArrays::NormalY)[i] = vertex.nrm[1];
+            frames[frame].get(MD2_VertexArrays::NormalZ)[i] = vertex.nrm[2];
+            frames[frame].get(MD2_VertexArrays::EnvironmentU)[i] = environmentU[vertex.normal];
+        }
+        frames[frame].pad();
+    }
+    std::vector<GLvertex> vertices(count);
+
+    // The interpolation factor changes every round like it does while an animation plays.
+    // The checksum keeps the compiler from dropping the loops.
+    float checksum = 0.0f;
+    size_t round = 0;
+    const double legacy = measure(rounds, count, [&]() {
+        const float flip = (round++ % 100) * 0.01f;
+        for (size_t i = 0; i < count; ++i) {
+            GLvertex &dst = vertices[i];
+            const LegacyVertex &srcLast = legacyFrames[0][i], &srcNext = legacyFrames[1][i];
+            for (size_t j = 0; j < 3; ++j) {
+                dst.pos[j] = srcLast.pos[j] + (srcNext.pos[j] - srcLast.pos[j]) * flip;
+                dst.nrm[j] = srcLast.nrm[j] + (srcNext.nrm[j] - srcLast.nrm[j]) * flip;
+            }
+            dst.pos[3] = 1.0f;
+            dst.env[0] = environmentU[srcLast.normal] + (environmentU[srcNext.normal] - environmentU[srcLast.normal]) * flip;
+            dst.env[1] = 0.5f * (1.0f + dst.nrm[2]);
+        }
+        checksum += vertices[count / 2].pos[0];
+    });
+    const double scalar = measure(rounds, count, [&]() {
+        const float flip = (round++ % 100) * 0.01f;
+        MD2_VertexArrays::interpolateScalar(vertices.data(), frames[0], frames[1], 0, count, flip);
+        checksum += vertices[count / 2].pos[0];
+    });
+    const double current = measure(rounds, count, [&]() {
+        const float flip = (round++ % 100) * 0.01f;
+        MD2_VertexArrays::interpolate(vertices.data(), frames[0], frames[1], 0, count, flip);
+        checksum += vertices[count / 2].pos[0];
+    });
+#if defined(EGO_MD2_INTERPOLATION_SSE)
+    static const char *kernel = "SSE";
+#else
+    static const char *kernel = "scalar";
+#endif
+    Log::get().message("MD2 interpolation benchmark, %u vertices: %.2f ns per vertex legacy loop, %.2f ns scalar kernel, "
+                       "%.2f ns interpolate() (%s kernel), checksum %g\n",
+                       static_cast<unsigned>(count), legacy, scalar, current, kernel, checksum);
+}
+
+void Benchmarks::parse()
+{
+    typedef Ego::Script::TextInputFile<Ego::Script::Traits<char>> TextInputFile;
+
+    std::vector<std::string> pathnames;
+    findTextFiles("mp_data", pathnames);
+    findTextFiles("mp_modules", pathnames);
+    if (pathnames.empty()) {
+        Log::get().warn("%s:%d: parse benchmark found no text files in mp_data and mp_modules\n", __FILE__, __LINE__);
+        return;
+    }
+
+    // Read through the VFS and scan, as the readers do.
+    size_t tokens = 0;
+    const double readAndScan = measure(1, 1, [&]() {
+        for (const std::string& pathname : pathnames) {
+            TextInputFile file(pathname);
+            tokens += countTokens(file);
+        }
+    });
+
+    // Scan the same contents from memory, i.e. without the VFS.
+    std::vector<std::string> contents;
+    size_t bytes = 0;
+    for (const std::string& pathname : pathnames) {
+        char *data = nullptr;
+        size_t length = 0;
+        if (vfs_readEntireFile(pathname, &data, &length)) {
+            contents.emplace_back(data, length);
+            bytes += length;
+            free(data);
+        } else {
+            contents.emplace_back();
+        }
+    }
+    size_t scannedTokens = 0;
+    const double scan = measure(1, 1, [&]() {
+        for (size_t i = 0; i < contents.size(); ++i) {
+            TextInputFile file(pathnames[i], contents[i].data(), contents[i].size());
+            scannedTokens += countTokens(file);
+        }
+    });
+
+    const double mebibytes = bytes / (1024.0 * 1024.0);
+    Log::get().message("Parse benchmark, %u files (%u bytes, %u tokens): %.1f ms read and scanned, %.1f ms scanned from memory (%.1f MiB/s), %u tokens\n",
+                       static_cast<unsigned>(pathnames.size()), static_cast<unsigned>(bytes), static_cast<unsigned>(tokens),
+                       readAndScan / 1e6, scan / 1e6, scan > 0.0 ? mebibytes / (scan / 1e9) : 0.0, static_cast<unsigned>(scannedTokens));
+}
@@ -0,0 +1,56 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+/// @author Zefz aka Johan Jansen
+
+/// @file game/Core/Benchmarks.hpp
+/// @brief Micro-benchmarks of engine kernels
+
+#pragma once
+
+#include "egolib/platform.h"
+
+/**
+ * @brief
+ *  Micro-benchmarks of engine kernels. Each compares a kernel with the code it replaced on synthetic
+ *  data and reports the timings through the log. Unlike the unit tests, they assert nothing.
+ *  Run one with <tt>--benchmark &lt;name&gt;</tt>.
+ */
+class Benchmarks
+{
+public:
+    /**
+     * @brief
+     *  Run a benchmark.
+     * @param name
+     *  the name of the benchmark, one of "frustum", "md2" and "parse"
+     * @return
+     *  @a true if the benchmark was run, @a false if there is no benchmark of that name
+     */
+    static bool run(const std::string& name);
+
+private:
+    /// Test 10000 spheres and 10000 AABBs against a frustum one at a time and in batches.
+    static void frustum();
+
+    /// Interpolate 512 MD2 vertices with the per-vertex loop MD2 frames used before and with the kernels of MD2_VertexArrays.
+    static void md2Interpolation();
+
+    /// Scan every text file of the game data (mp_data and mp_modules) with Ego::Script::TextInputFile.
+    static void parse();
+};
@@ -19,6 +19,7 @@
 /// @author Johan Jansen
 
 #include "game/Core/GameEngine.hpp"
+#include "game/Core/Benchmarks.hpp"
 #include "egolib/egolib.h"
 #include "game/Graphics/CameraSystem.hpp"
 #include "game/GameStates/MainMenuState.hpp"
@@ -30,6 +31,11 @@
 #include "game/game.h"
 #include "game/Entities/_Include.hpp"
 #include "game/Physics/CollisionSystem.hpp"
+#include "game/graphic_billboard.h"
+#include "game/link.h"
+#include "egolib/FileFormats/Replay.hpp"
+#include "egolib/FileFormats/CacheFile.hpp"
+#include "game/CharacterMatrix.h"
 
 //Global singelton
 std::unique_ptr<GameEngine> _gameEngine;
@@ -82,10 +88,23 @@ uint64_t GameEngine::getMicros() const
     return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - _startupTimestamp).count();
 }
 
-void GameEngine::start()
+void GameEngine::start(const std::string& replayPathname)
 {    
     initialize();
 
+    //Record the player input of the first module played
+    if (!replayPathname.empty())
+    {
+        try
+        {
+            game_set_replay_recorder(std::make_unique<Ego::ReplayRecorder>(replayPathname));
+        }
+        catch (const std::runtime_error& ex)
+        {
+            Log::get().warn("Replay: %s\n", ex.what());
+        }
+    }
+
     //Initialize clock timeout	
     _startupTimestamp = std::chrono::high_resolution_clock::now();
     _updateTimeout = getMicros() + DELAY_PER_UPDATE_FRAME;
@@ -149,6 +168,326 @@ void GameEngine::start()
     uninitialize();
 }
 
+bool GameEngine::startHeadless(const std::string& moduleName, const uint32_t ticks, const uint32_t scale)
+{
+    initialize();
+    _startupTimestamp = std::chrono::high_resolution_clock::now();
+
+    // Raise the limits before the module creates its object handler, they are restored
+    // before uninitialize() writes the configuration.
+    egoboo_config_t& cfg = egoboo_config_t::get();
+    const uint16_t objectsMax = cfg.game_simultaneousObjects_max.getValue();
+    const uint16_t particlesMax = cfg.graphic_simultaneousParticles_max.getValue();
+    if (scale > 1)
+    {
+        cfg.game_simultaneousObjects_max.setValue(static_cast<uint16_t>(std::min<uint32_t>(OBJECTS_MAX * scale, std::numeric_limits<uint16_t>::max())));
+        cfg.graphic_simultaneousParticles_max.setValue(static_cast<uint16_t>(std::min<uint32_t>(PARTICLES_MAX * scale, std::numeric_limits<uint16_t>::max())));
+        ParticleHandler::get().setDisplayLimit(cfg.graphic_simultaneousParticles_max.getValue());
+    }
+
+    const bool success = beginHeadlessModule(moduleName, time(NULL), std::list<std::string>());
+    if (success)
+    {
+        if (scale > 1)
+        {
+            populateHeadlessModule(scale);
+        }
+        runHeadless(moduleName, ticks, nullptr);
+    }
+
+    cfg.game_simultaneousObjects_max.setValue(objectsMax);
+    cfg.graphic_simultaneousParticles_max.setValue(particlesMax);
+    ParticleHandler::get().setDisplayLimit(particlesMax);
+
+    uninitialize();
+    return success;
+}
+
+void GameEngine::populateHeadlessModule(const uint32_t scale)
+{
+    // Only characters standing on their own, held items and inventories come with their owners
+    std::vector<std::shared_ptr<Object>> originals;
+    for (const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
+    {
+        if (object->isTerminated() || !object->isAlive() || object->isItem()) continue;
+        if (object->isBeingHeld() || object->isInsideInventory()) continue;
+        originals.push_back(object);
+    }
+
+    for (uint32_t copy = 1; copy < scale; ++copy)
+    {
+        for (const std::shared_ptr<Object> &original : originals)
+        {
+            std::shared_ptr<Object> clone = _currentModule->spawnObject(original->getPosition(), original->getProfileID(), original->team,
+                                                                        original->skin, original->ori.facing_z, "", ObjectRef::Invalid);
+            if (!clone) return;
+            clone->ai.content = original->ai.content;
+            clone->ai.passage = original->ai.passage;
+            make_one_character_matrix(clone->getObjRef());
+        }
+    }
+}
+
+bool GameEngine::startReplay(const std::string& pathname)
+{
+    initialize();
+    _startupTimestamp = std::chrono::high_resolution_clock::now();
+
+    std::shared_ptr<Ego::ReplayPlayback> playback;
+    try
+    {
+        playback = std::make_shared<Ego::ReplayPlayback>(pathname);
+    }
+    catch (const std::runtime_error& ex)
+    {
+        Log::get().warn("Replay: %s\n", ex.what());
+        uninitialize();
+        return false;
+    }
+
+    const std::vector<std::string>& importPlayers = playback->getImportPlayers();
+    game_set_replay_playback(playback);
+    if (!beginHeadlessModule(playback->getModuleName(), playback->getSeed(), std::list<std::string>(importPlayers.begin(), importPlayers.end())))
+    {
+        game_set_replay_playback(nullptr);
+        uninitialize();
+        return false;
+    }
+
+    runHeadless(pathname, std::numeric_limits<uint32_t>::max(), playback);
+
+    uninitialize();
+    return true;
+}
+
+bool GameEngine::startReplayCheck(const std::string& moduleName, const uint32_t ticks)
+{
+    static const std::string pathname = "/debug/replay_check.egr";
+
+    initialize();
+    _startupTimestamp = std::chrono::high_resolution_clock::now();
+
+    try
+    {
+        game_set_replay_recorder(std::make_unique<Ego::ReplayRecorder>(pathname));
+    }
+    catch (const std::runtime_error& ex)
+    {
+        Log::get().warn("Replay: %s\n", ex.what());
+        uninitialize();
+        return false;
+    }
+    if (!beginHeadlessModule(moduleName, time(NULL), std::list<std::string>()))
+    {
+        game_set_replay_recorder(nullptr);
+        uninitialize();
+        return false;
+    }
+    runHeadless(moduleName + " (recording)", ticks, nullptr);
+    const uint32_t recordedTicks = update_wld;
+    const uint64_t recordedState = getModuleStateHash();
+
+    // Closes the recorder, which writes the replay file.
+    game_quit_module();
+
+    bool success = false;
+    try
+    {
+        std::shared_ptr<Ego::ReplayPlayback> playback = std::make_shared<Ego::ReplayPlayback>(pathname);
+        game_set_replay_playback(playback);
+        if (beginHeadlessModule(playback->getModuleName(), playback->getSeed(), std::list<std::string>()))
+        {
+            runHeadless(moduleName + " (playback)", ticks, playback);
+            success = recordedTicks == update_wld && recordedState == getModuleStateHash();
+        }
+        else
+        {
+            game_set_replay_playback(nullptr);
+        }
+    }
+    catch (const std::runtime_error& ex)
+    {
+        Log::get().warn("Replay: %s\n", ex.what());
+    }
+
+    if (success)
+    {
+        Log::get().message("Replay check of \"%s\": the playback of %u updates ended in the recorded state\n",
+                           moduleName.c_str(), recordedTicks);
+    }
+    else
+    {
+        Log::get().warn("Replay check of \"%s\": the playback of %u updates did not end in the recorded state\n",
+                        moduleName.c_str(), recordedTicks);
+    }
+
+    uninitialize();
+    return success;
+}
+
+bool GameEngine::startParallelCheck(const std::string& moduleName, const uint32_t ticks)
+{
+    initialize();
+    _startupTimestamp = std::chrono::high_resolution_clock::now();
+
+    // The setting is restored before uninitialize() writes the configuration.
+    egoboo_config_t& cfg = egoboo_config_t::get();
+    const bool parallel = cfg.game_parallelAIScripts_enable.getValue();
+
+    const uint32_t seed = time(NULL);
+    std::array<uint32_t, 2> ticksRun;
+    std::array<uint64_t, 2> states;
+    bool success = true;
+    for (size_t run = 0; run < 2 && success; ++run)
+    {
+        cfg.game_parallelAIScripts_enable.setValue(run == 1);
+        success = beginHeadlessModule(moduleName, seed, std::list<std::string>());
+        if (success)
+        {
+            runHeadless(moduleName + (run == 1 ? " (parallel A.I.)" : " (serial A.I.)"), ticks, nullptr);
+            ticksRun[run] = update_wld;
+            states[run] = getModuleStateHash();
+        }
+    }
+    cfg.game_parallelAIScripts_enable.setValue(parallel);
+
+    if (success)
+    {
+        success = ticksRun[0] == ticksRun[1] && states[0] == states[1];
+        if (success)
+        {
+            Log::get().message("Parallel A.I. check of \"%s\": the serial and the parallel run of %u updates ended in the same state\n",
+                               moduleName.c_str(), ticksRun[0]);
+        }
+        else
+        {
+            Log::get().warn("Parallel A.I. check of \"%s\": the serial and the parallel run of %u updates ended in different states\n",
+                            moduleName.c_str(), ticksRun[0]);
+        }
+    }
+
+    uninitialize();
+    return success;
+}
+
+template <typename Type>
+static void appendStateBytes(std::vector<char>& bytes, const Type& value)
+{
+    const char *begin = reinterpret_cast<const char *>(&value);
+    bytes.insert(bytes.end(), begin, begin + sizeof(Type));
+}
+
+static void appendStateBytes(std::vector<char>& bytes, const Vector3f& value)
+{
+    appendStateBytes(bytes, value.x());
+    appendStateBytes(bytes, value.y());
+    appendStateBytes(bytes, value.z());
+}
+
+uint64_t GameEngine::getModuleStateHash() const
+{
+    // Particle references depend on the order particles were freed in earlier modules, hence
+    // the entities are hashed one by one and their hashes are summed up.
+    uint64_t hash = Ego::CacheFile::hashBytes(reinterpret_cast<const char *>(&update_wld), sizeof(update_wld));
+    std::vector<char> bytes;
+    for (const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
+    {
+        if (object->isTerminated()) continue;
+        bytes.clear();
+        appendStateBytes(bytes, object->getProfileID());
+        appendStateBytes(bytes, object->team);
+        appendStateBytes(bytes, object->getPosition());
+        appendStateBytes(bytes, object->vel);
+        appendStateBytes(bytes, object->getLife());
+        appendStateBytes(bytes, object->getMana());
+        appendStateBytes(bytes, object->getMoney());
+        appendStateBytes(bytes, object->experience);
+        appendStateBytes(bytes, object->ai.state);
+        appendStateBytes(bytes, object->ai.content);
+        appendStateBytes(bytes, object->ai.alert);
+        hash += Ego::CacheFile::hashBytes(bytes.data(), bytes.size());
+    }
+    for (const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
+    {
+        if (particle->isTerminated()) continue;
+        bytes.clear();
+        appendStateBytes(bytes, particle->getProfileID());
+        appendStateBytes(bytes, particle->getPosition());
+        appendStateBytes(bytes, particle->vel);
+        appendStateBytes(bytes, particle->lifetime_remaining);
+        hash += Ego::CacheFile::hashBytes(bytes.data(), bytes.size());
+    }
+    return hash;
+}
+
+void GameEngine::runHeadless(const std::string& name, const uint32_t ticks, const std::shared_ptr<Ego::ReplayPlayback>& playback)
+{
+    // Run the game logic as fast as possible
+    const uint32_t firstTick = update_wld;
+    const uint64_t begin = getMicros();
+    while (!_terminateRequested && update_wld - firstTick < ticks && !_currentGameState->isEnded())
+    {
+        if (playback && playback->isFinished())
+        {
+            break;
+        }
+        updateOneFrame();
+    }
+    const uint64_t elapsed = std::max<uint64_t>(1, getMicros() - begin);
+    const uint32_t ticksRun = update_wld - firstTick;
+
+    const double ticksPerSecond = ticksRun * 1e6 / elapsed;
+    const size_t objects = _currentModule->getObjectHandler().getObjectCount();
+    const size_t particles = ParticleHandler::get().getCount();
+    Log::get().message("Headless run of \"%s\": %u ticks in %.3f seconds, %.1f ticks per second (%.1fx real time), %u objects, %u particles\n",
+                       name.c_str(), ticksRun, elapsed / 1e6, ticksPerSecond, ticksPerSecond / GAME_TARGET_UPS,
+                       static_cast<unsigned>(objects), static_cast<unsigned>(particles));
+}
+
+bool GameEngine::beginHeadlessModule(const std::string& moduleName, const uint32_t seed, const std::list<std::string>& players)
+{
+    std::shared_ptr<ModuleProfile> module;
+    for (const std::shared_ptr<ModuleProfile>& profile : ProfileSystem::get().getModuleProfiles())
+    {
+        if (profile->getFolderName() == moduleName || profile->getFolderName() == moduleName + ".mod")
+        {
+            module = profile;
+            break;
+        }
+    }
+    if (!module)
+    {
+        Log::get().warn("Headless: unknown module \"%s\"\n", moduleName.c_str());
+        return false;
+    }
+
+    // Same steps as LoadingState::loadModuleData()
+    game_quit_module();
+    BillboardSystem::get().reset();
+    make_turntosin();
+    if (!link_build_vfs("mp_data/link.txt", LinkList)) Log::get().warn("Failed to initialize module linking\n");
+    ProfileSystem::get().reset();
+    if (players.empty())
+    {
+        import_list_t::init(g_importList);
+    }
+    else if (!game_load_players(players))
+    {
+        Log::get().warn("Headless: failed to load players\n");
+        return false;
+    }
+    if (!game_begin_module(module, seed))
+    {
+        Log::get().warn("Headless: failed to load module \"%s\"\n", moduleName.c_str());
+        return false;
+    }
+    _currentModule->setImportPlayers(players);
+    std::shared_ptr<CameraSystem> cameraSystem = CameraSystem::request(local_stats.player_count);
+
+    setGameState(std::make_shared<PlayingState>(cameraSystem));
+    return true;
+}
+
 void GameEngine::estimateFrameRate()
 {
     const uint64_t now = getMicros();
@@ -258,6 +597,11 @@ void GameEngine::renderPreloadText(const std::string &text)
 {
     static std::string preloadText("");
 
+    // Nobody is watching
+    if (Ego::Core::System::get().isHeadless()) {
+        return;
+    }
+
     preloadText += text + "\n";
     
     gfx_request_clear_screen();
@@ -273,6 +617,8 @@ void GameEngine::renderPreloadText(const std::string &text)
 
 bool GameEngine::initialize()
 {
+    const bool headless = Ego::Core::System::get().isHeadless();
+
     /* ********************************************************************************** */
     // >>> This must be done as the crappy old systems do not "pull" their configuration.
     //      More recent systems like video or audio system pull their configuraiton data
@@ -300,8 +646,10 @@ bool GameEngine::initialize()
     GFX::initialize();
 
 	// TODO: REMOVE THIS.
-	gfx_system_init_all_graphics();
-	gfx_do_clear_screen();
+    if (!headless) {
+        gfx_system_init_all_graphics();
+        gfx_do_clear_screen();
+    }
 
 	// Initialize the audio system.
 	AudioSystem::initialize();
@@ -314,7 +662,9 @@ bool GameEngine::initialize()
 
 
     // load the bitmapped font (must be done after gfx_system_init_all_graphics())
-    font_bmp_load_vfs("mp_data/font_new_shadow", "mp_data/font.txt");
+    if (!headless) {
+        font_bmp_load_vfs("mp_data/font_new_shadow", "mp_data/font.txt");
+    }
 
     // setup the system gui
     _uiManager = std::unique_ptr<UIManager>(new UIManager());
@@ -328,11 +678,13 @@ bool GameEngine::initialize()
 #endif
 
     // Initialize the sound system.
-    renderPreloadText("Loading audio...");
-    auto& audioSystem = AudioSystem::get();
-    audioSystem.loadAllMusic();
-    playMainMenuSong();
-    audioSystem.loadGlobalSounds();
+    if (!headless) {
+        renderPreloadText("Loading audio...");
+        auto& audioSystem = AudioSystem::get();
+        audioSystem.loadAllMusic();
+        playMainMenuSong();
+        audioSystem.loadGlobalSounds();
+    }
 
     // synchronize the config values with the various game subsystems
     // do this after the ego_init_SDL() and gfx_system_init_OpenGL() in case the config values are clamped
@@ -365,7 +717,9 @@ bool GameEngine::initialize()
     vfs_empty_temp_directories();
 
     //Start the main menu
-    pushGameState(std::make_shared<MainMenuState>());
+    if (!headless) {
+        pushGameState(std::make_shared<MainMenuState>());
+    }
 
     return true;
 }
@@ -543,6 +897,25 @@ std::shared_ptr<PlayingState> GameEngine::getActivePlayingState() const
 /**
  * @brief
  *  The entry point of the program.
+ * @remark
+ *  <tt>--headless &lt;module&gt; [--ticks &lt;n&gt;] [--scale &lt;k&gt;]</tt> runs @a n (default 3000) game
+ *  logic updates of the specified module without window, OpenGL and audio as fast as possible and
+ *  reports the number of updates per second. With @a k greater than 1, the object and particle
+ *  limits are @a k times OBJECTS_MAX and PARTICLES_MAX and every character is cloned @a k - 1 times,
+ *  e.g. run with 1, 4 and 16 to see how a module scales with the limits.
+ * @remark
+ *  <tt>--record &lt;file&gt;</tt> records the player input of the first module played to a replay file,
+ *  <tt>--replay &lt;file&gt;</tt> plays such a file back headless as fast as possible. File names are
+ *  relative to the user data directory.
+ * @remark
+ *  <tt>--check-replay &lt;module&gt; [--ticks &lt;n&gt;]</tt> records @a n game logic updates of the specified
+ *  module headless, plays the recording back and fails unless both runs end in the same state.
+ * @remark
+ *  <tt>--check-parallel &lt;module&gt; [--ticks &lt;n&gt;]</tt> runs @a n game logic updates of the specified module
+ *  headless twice from the same seed, with serial and with parallel A.I. scripts, and fails unless both runs
+ *  end in the same state.
+ * @remark
+ *  <tt>--benchmark &lt;name&gt;</tt> runs one of the micro-benchmarks of Benchmarks and reports the timings to the log.
  * @param argc
  *  the number of command-line arguments (number of elements in the array pointed by @a argv)
  * @param argv
@@ -552,14 +925,82 @@ std::shared_ptr<PlayingState> GameEngine::getActivePlayingState() const
  */
 int SDL_main(int argc, char **argv)
 {
+    // Parse the command-line arguments.
+    std::string headlessModule;
+    uint32_t headlessTicks = 60 * GameEngine::GAME_TARGET_UPS;
+    uint32_t headlessScale = 1;
+    std::string recordPathname, replayPathname, replayCheckModule, parallelCheckModule, benchmarkName;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--headless" && i + 1 < argc)
+        {
+            headlessModule = argv[++i];
+        }
+        else if (argument == "--ticks" && i + 1 < argc)
+        {
+            headlessTicks = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--scale" && i + 1 < argc)
+        {
+            headlessScale = std::max<uint32_t>(1, static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+        }
+        else if (argument == "--record" && i + 1 < argc)
+        {
+            recordPathname = argv[++i];
+        }
+        else if (argument == "--replay" && i + 1 < argc)
+        {
+            replayPathname = argv[++i];
+        }
+        else if (argument == "--check-replay" && i + 1 < argc)
+        {
+            replayCheckModule = argv[++i];
+        }
+        else if (argument == "--check-parallel" && i + 1 < argc)
+        {
+            parallelCheckModule = argv[++i];
+        }
+        else if (argument == "--benchmark" && i + 1 < argc)
+        {
+            benchmarkName = argv[++i];
+        }
+    }
+    const bool headless = !headlessModule.empty() || !replayPathname.empty() || !replayCheckModule.empty()
+                       || !parallelCheckModule.empty() || !benchmarkName.empty();
+
+    bool success = true;
     try
     {
-        Ego::Core::System::initialize(argv[0],nullptr);
+        Ego::Core::System::initialize(argv[0], nullptr, headless);
         try
         {
             _gameEngine = std::unique_ptr<GameEngine>(new GameEngine());
 
-            _gameEngine->start();
+            if (!benchmarkName.empty())
+            {
+                success = Benchmarks::run(benchmarkName);
+            }
+            else if (!replayPathname.empty())
+            {
+                success = _gameEngine->startReplay(replayPathname);
+            }
+            else if (!replayCheckModule.empty())
+            {
+                success = _gameEngine->startReplayCheck(replayCheckModule, headlessTicks);
+            }
+            else if (!parallelCheckModule.empty())
+            {
+                success = _gameEngine->startParallelCheck(parallelCheckModule, headlessTicks);
+            }
+            else if (headless)
+            {
+                success = _gameEngine->startHeadless(headlessModule, headlessTicks, headlessScale);
+            }
+            else
+            {
+                _gameEngine->start(recordPathname);
+            }
         }
         catch (...)
         {
@@ -585,7 +1026,7 @@ int SDL_main(int argc, char **argv)
         std::cerr << "unhandled exception" << std::endl;
         return EXIT_FAILURE;
     }
-    return EXIT_SUCCESS;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
 uint32_t GameEngine::getCurrentUpdateFrame() const
@@ -32,6 +32,7 @@ class ego_mesh_t;
 struct status_list_t;
 class UIManager;
 class PlayingState;
+namespace Ego { class ReplayPlayback; }
 
 class GameEngine
 {
@@ -58,8 +59,72 @@ public:
     *	A blocking function that initializes the GameEngine and enders the MainLoop until
     *	shutdown() is called, at which point it will deinitialize and terminate the program.
     *	This function should only be called by the main function that creates the GameEngine.
+    * @param replayPathname
+    *	if not empty, the player input of the first module played is recorded to this replay file
     **/
-    void start();
+    void start(const std::string& replayPathname = std::string());
+
+    /**
+    * @brief
+    *	A blocking function that initializes the GameEngine without a window, OpenGL and audio,
+    *	loads the specified module and runs a fixed number of game logic updates back to back,
+    *	without waiting between updates and without rendering anything. Reports the achieved
+    *	number of updates per second and terminates the program.
+    *	This function should only be called by the main function that creates the GameEngine
+    *	and requires a headless Ego::Core::System.
+    * @param moduleName
+    *	the folder name of the module e.g. "adventurer.mod" or "adventurer"
+    * @param ticks
+    *	the number of game logic updates to run
+    * @param scale
+    *	if greater than @a 1, the object and particle limits are raised to this multiple of
+    *	OBJECTS_MAX and PARTICLES_MAX and every character of the module is cloned until there
+    *	are @a scale times as many. Used to measure how the game scales with larger limits.
+    * @return
+    *	@a true if the module was loaded and run, @a false otherwise
+    **/
+    bool startHeadless(const std::string& moduleName, const uint32_t ticks, const uint32_t scale = 1);
+
+    /**
+    * @brief
+    *	A blocking function that initializes the GameEngine like startHeadless() and plays back a
+    *	replay file: the recorded module is started with the recorded seed and imported players and
+    *	is updated with the recorded player input, without any frame pacing, until the recording ends.
+    * @param pathname
+    *	the pathname of the replay file
+    * @return
+    *	@a true if the replay was loaded and run, @a false otherwise
+    **/
+    bool startReplay(const std::string& pathname);
+
+    /**
+    * @brief
+    *	A blocking function that initializes the GameEngine like startHeadless(), records a number
+    *	of game logic updates of the specified module to a replay file, plays that file back and
+    *	compares the state of the module at the end of both runs.
+    * @param moduleName
+    *	the folder name of the module e.g. "adventurer.mod" or "adventurer"
+    * @param ticks
+    *	the number of game logic updates to record
+    * @return
+    *	@a true if both runs ended in the same state, @a false otherwise
+    **/
+    bool startReplayCheck(const std::string& moduleName, const uint32_t ticks);
+
+    /**
+    * @brief
+    *	A blocking function that initializes the GameEngine like startHeadless() and runs a number
+    *	of game logic updates of the specified module twice with the same seed, first with the A.I.
+    *	scripts run serially and then with the A.I. scripts run in parallel, and compares the state
+    *	of the module at the end of both runs.
+    * @param moduleName
+    *	the folder name of the module e.g. "adventurer.mod" or "adventurer"
+    * @param ticks
+    *	the number of game logic updates of each run
+    * @return
+    *	@a true if both runs ended in the same state, @a false otherwise
+    **/
+    bool startParallelCheck(const std::string& moduleName, const uint32_t ticks);
 
     /**
     * @return
@@ -221,6 +286,46 @@ private:
     **/
     void renderPreloadText(const std::string &text);
 
+    /**
+    * @brief
+    *	Load a module the way the LoadingState does, but without any user interface or audio,
+    *	and make a PlayingState for it the current GameState.
+    * @param seed
+    *	the random seed of the module
+    * @param players
+    *	the saved characters to import into the module, may be empty
+    * @return
+    *	@a true on success, @a false otherwise
+    **/
+    bool beginHeadlessModule(const std::string& moduleName, const uint32_t seed, const std::list<std::string>& players);
+
+    /**
+    * @brief
+    *	Run game logic updates of the current module back to back and report the updates per second.
+    * @param ticks
+    *	the maximum number of updates
+    * @param playback
+    *	if not @a nullptr, the run stops as soon as this replay is finished
+    **/
+    void runHeadless(const std::string& name, const uint32_t ticks, const std::shared_ptr<Ego::ReplayPlayback>& playback);
+
+    /**
+    * @brief
+    *	Clone every free standing character of the current module until there are @a scale
+    *	times as many of them.
+    **/
+    void populateHeadlessModule(const uint32_t scale);
+
+    /**
+    * @brief
+    *	Hash the game logic state of the current module: the number of updates run and the
+    *	profile, team, position, velocity, life, mana, money, experience and A.I. memory of every
+    *	object and the profile, position, velocity and remaining lifetime of every particle.
+    * @return
+    *	the hash. It does not depend on the order of the objects and particles in their handlers.
+    **/
+    uint64_t getModuleStateHash() const;
+
 private:
     std::chrono::high_resolution_clock::time_point _startupTimestamp;
     bool _isInitialized;
@@ -21,6 +21,10 @@
 #include "game/Entities/ObjectHandler.hpp"
 #include "egolib/Profiles/_Include.hpp"
 #include "game/Entities/Object.hpp"
+#include "game/mesh.h"
+
+//Edge length of a spatial grid cell in world units (a cell covers 2x2 mesh tiles)
+static const float SPATIAL_GRID_CELL_SIZE = 2.0f * Info<float>::Grid::Size();
 
 ObjectRef GET_INDEX_PCHR(const Object *pobj) {
     return (nullptr == pobj) ? ObjectRef::Invalid : pobj->getObjRef();
@@ -34,6 +38,7 @@ bool INGAME_PCHR(const Object *pobj)
 }
 
 ObjectHandler::ObjectHandler() :
+    _spatialGrid(),
 	_internalCharacterList(),
     _iteratorList(),
     _allocateList(),
@@ -41,11 +46,15 @@ ObjectHandler::ObjectHandler() :
     _semaphore(0),
     _deletedCharacters(0),
     _totalCharactersSpawned(0),
-    _dynamicObjects(),
-    _staticObjects(),
-    _updateStaticTreeClock(0)
+    _maxObjects(0)
 {
-    _iteratorList.reserve(OBJECTS_MAX);
+    setCapacity(egoboo_config_t::get().game_simultaneousObjects_max.getValue());
+}
+
+void ObjectHandler::setCapacity(size_t capacity)
+{
+    _maxObjects = Ego::Math::constrain<size_t>(capacity, 1, OBJECTS_LIMIT);
+    _iteratorList.reserve(_maxObjects);
 }
 
 bool ObjectHandler::remove(ObjectRef ref) {
@@ -94,7 +103,7 @@ std::shared_ptr<Object> ObjectHandler::insert(const PRO_REF profileRef, ObjectRe
 	}
 
 	// Limit total number of characters active at the same time.
-	if (getObjectCount() > OBJECTS_MAX) {
+	if (getObjectCount() > _maxObjects) {
 		Log::get().warn("%s:%d: no free object slots available\n", __FILE__, __LINE__);
 		return nullptr;
 	}
@@ -168,7 +177,7 @@ void ObjectHandler::clear()
 {
 	_internalCharacterList.clear();
 	_iteratorList.clear();
-    _dynamicObjects.clear(0, 0, 0, 0);
+    _spatialGrid.clear();
     _deletedCharacters = 0;
     _totalCharactersSpawned = 0;
 }
@@ -224,6 +233,7 @@ void ObjectHandler::maybeRunDeferred()
         {
             EGOBOO_ASSERT(nullptr != object);
             _iteratorList.push_back(object);
+            _spatialGrid.insert(object);
         }
         _allocateList.clear();        
     }
@@ -299,48 +309,26 @@ size_t ObjectHandler::getObjectCount() const
     return _iteratorList.size() + _allocateList.size() - _deletedCharacters;
 }
 
-void ObjectHandler::updateQuadTree(float minX, float minY, float maxX, float maxY)
+void ObjectHandler::updateSpatialGrid(float minX, float minY, float maxX, float maxY)
 {
-    //Reset quad-tree
-    _dynamicObjects.clear(minX, minY, maxX, maxY);
-
-    //Rebuild the static quad tree only once per second
-    bool updateStaticQuadTree = false;
-    if(_updateStaticTreeClock <= 0) {
-        _updateStaticTreeClock = ONESECOND;
-        updateStaticQuadTree = true;
-        _staticObjects.clear(minX, minY, maxX, maxY);
-    }
-    else {
-        _updateStaticTreeClock--;
-    }
-
-    //Rebuild quad-tree
-    for(const std::shared_ptr<Object> &object : _iteratorList) {
-        //Do not add objects that cannot interact with the rest of the world
-        if(object->isTerminated() || object->isHidden()) continue;
+    //Only re-buckets everything if the level size changed
+    _spatialGrid.setBounds(minX, minY, maxX, maxY, SPATIAL_GRID_CELL_SIZE);
 
-        if(object->isScenery()) {
-            if(updateStaticQuadTree) {
-                _staticObjects.insert(object);
-            }
-        }
-        else {
-            _dynamicObjects.insert(object);
-        }
-    }
+    //Drop terminated objects and move objects that changed cells
+    _spatialGrid.update();
 }
 
 std::vector<std::shared_ptr<Object>> ObjectHandler::findObjects(const float x, const float y, const float distance, bool includeSceneryObjects) const { 
     std::vector<std::shared_ptr<Object>> result;
 	AABB2f searchArea = AABB2f(Vector2f(x-distance, y-distance), Vector2f(x+distance, y+distance));
-    _dynamicObjects.find(searchArea, result);
-    if(includeSceneryObjects) _staticObjects.find(searchArea, result);
+    findObjects(searchArea, result, includeSceneryObjects);
     return result;
 }
 
 void ObjectHandler::findObjects(const AABB2f &searchArea, std::vector<std::shared_ptr<Object>> &result, bool includeSceneryObjects) const
 {
-    if(includeSceneryObjects) _staticObjects.find(searchArea, result);
-    return _dynamicObjects.find(searchArea, result);
+    //Do not find objects that cannot interact with the rest of the world
+    _spatialGrid.find(searchArea, result, [includeSceneryObjects](const Object &object) {
+        return !object.isHidden() && (includeSceneryObjects || !object.isScenery());
+    });
 }
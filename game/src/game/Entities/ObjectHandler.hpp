@@ -27,7 +27,7 @@
 #endif
 
 #include "game/egoboo.h"
-#include "egolib/Core/QuadTree.hpp"
+#include "egolib/Core/SpatialGrid.hpp"
 
 //Forward declarations
 class Object;
@@ -139,6 +139,18 @@ public:
 	 */
 	size_t getObjectCount() const;
 
+	/**
+	 * @brief Get the maximum number of objects which may be alive at the same time.
+	 */
+	size_t getCapacity() const { return _maxObjects; }
+
+	/**
+	 * @brief Set the maximum number of objects which may be alive at the same time.
+	 * @param capacity the maximum, it is constrained to [1, OBJECTS_LIMIT]
+	 * @remark Objects alive beyond a lowered maximum stay alive, only new objects are refused.
+	 */
+	void setCapacity(size_t capacity);
+
 	/**
 	 * @brief Removes and de-allocates all game objects contained in this ObjectHandler.
 	 */
@@ -153,8 +165,7 @@ public:
 
 	/**
 	* @brief
-	*	Find all elements that are within range of a specified point in this QuadTree's
-	*	bounding box
+	*	Find all elements that are within range of a specified point
 	* @param x
 	*	x position of point to search from
 	* @param y
@@ -182,12 +193,13 @@ public:
 
 	/**
 	* @brief
-	* 	Clear and rebuild the quad tree for this update frame
+	* 	Bring the spatial grid up to date for this update frame. Only objects that moved
+	*	into different grid cells are re-bucketed, the grid is never rebuilt from scratch.
 	*	This function is NOT thread-safe
 	* @param minX, minY, maxX, maxY
-	*	Sets the bounds of this quad tree (size of the entire current level)
+	*	Sets the bounds of the grid (size of the entire current level)
 	**/
-	void updateQuadTree(float minX, float minY, float maxX, float maxY);
+	void updateSpatialGrid(float minX, float minY, float maxX, float maxY);
 
 	/**
 	* @return
@@ -223,9 +235,7 @@ private:
 #endif
 
 private:
-	Ego::QuadTree<Object> _dynamicObjects;			//Objects that can move (Creatures, moving platforms, etc.)
-	Ego::QuadTree<Object> _staticObjects;			//Objects that rarely move - if ever (Trees, pillars, chairs)
-	int _updateStaticTreeClock;
+	Ego::SpatialGrid<Object> _spatialGrid;			//All active objects, bucketed by the mesh tiles they cover
 
 	std::unordered_map<ObjectRef, std::shared_ptr<Object>> _internalCharacterList; ///< Maps object references to shared pointers to objects
 	std::vector<std::shared_ptr<Object>> _iteratorList;					///< For iterating, contains only valid objects (unsorted)
@@ -236,6 +246,7 @@ private:
 	size_t _deletedCharacters;
 
 	size_t _totalCharactersSpawned;										///< Total count of characters spawned (includes removed)
+	size_t _maxObjects;													///< Maximum allowed objects to be alive at the same time
 
 	friend class ObjectIterator;
 };
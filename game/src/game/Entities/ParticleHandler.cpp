@@ -103,7 +103,7 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnParticle(const Vector3f& sp
         }
         else {
             //If we failed to spawn somehow, put it back to the unused pool
-            _unusedPool.push_back(particle);
+            _particlePool.release(particle);
         }        
     }
 
@@ -168,17 +168,10 @@ std::shared_ptr<Ego::Particle> ParticleHandler::getFreeParticle(bool force)
         }
     }
 
-    //If we have no free particles in the memory pool but we are allowed to allocate new memory
-    if(_unusedPool.empty() && getCount() < _maxParticles) {
-        return std::make_shared<Ego::Particle>();
-    }
-
-    //Get a free, unused particle from the particle pool
-    if (!_unusedPool.empty())
-    {
-        //Retrieve particle from the pool
-        particle = _unusedPool.back();
-        _unusedPool.pop_back();
+    //Get a free, unused particle from the particle pool. If there is none left but we are allowed
+    //to allocate new memory, the pool grows by a whole chunk of particles
+    if(_particlePool.getFreeCount() > 0 || getCount() < _maxParticles) {
+        particle = _particlePool.acquire();
     }
 
     return particle;
@@ -199,7 +192,7 @@ size_t ParticleHandler::getDisplayLimit() const
 
 void ParticleHandler::setDisplayLimit(size_t displayLimit)
 {
-    _maxParticles = Ego::Math::constrain<size_t>(displayLimit, 256, PARTICLES_MAX);
+    _maxParticles = Ego::Math::constrain<size_t>(displayLimit, 256, PARTICLES_LIMIT);
 }
 
 void ParticleHandler::lock()
@@ -226,7 +219,7 @@ void ParticleHandler::unlock()
             particle->destroy();
 
             //Free to be used by another instance again
-            _unusedPool.push_back(particle);
+            _particlePool.release(particle);
             _particleMap.erase(particle->getParticleID());
 
             return true;
@@ -262,7 +255,7 @@ void ParticleHandler::clear()
 
     _pendingParticles.clear();
     _activeParticles.clear();
-    _unusedPool.clear();
+    _particlePool.clear();
     _particleMap.clear();
     _totalParticlesSpawned = 0;
 }
@@ -27,6 +27,7 @@
 
 #include "game/egoboo.h"
 #include "game/Entities/Particle.hpp"
+#include "egolib/Core/ChunkedPool.hpp"
 
 class ParticleHandler : public Ego::Core::Singleton<ParticleHandler>
 {
@@ -89,7 +90,7 @@ public:
         _maxParticles(0),
         _semaphoreLock(0),
         _totalParticlesSpawned(0),
-        _unusedPool(),
+        _particlePool(),
         _activeParticles(),
         _particleMap(),
         
@@ -130,7 +131,7 @@ public:
      * @brief
      *  Set the display limit for particles.
      * @param displayLimit
-     *  the display limit for particles
+     *  the display limit for particles, it is constrained to [256, PARTICLES_LIMIT]
      */
     void setDisplayLimit(size_t displayLimit);
 
@@ -232,7 +233,7 @@ private:
     std::atomic<size_t> _semaphoreLock;
     std::atomic<size_t> _totalParticlesSpawned;
 
-    std::vector<std::shared_ptr<Ego::Particle>> _unusedPool;         //Particles currently unused
+    Ego::ChunkedPool<Ego::Particle> _particlePool;                   //Particles currently unused, allocated in chunks
     std::vector<std::shared_ptr<Ego::Particle>> _activeParticles;    //List of all particles that are active ingame
     std::vector<std::shared_ptr<Ego::Particle>> _pendingParticles;   //Particles that will be added to the active list as soon as it is unlocked
 
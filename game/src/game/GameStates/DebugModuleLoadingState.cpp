@@ -263,7 +263,6 @@ void DebugModuleLoadingState::loadModuleData()
 
         // do some graphics initialization
         //make_lightdirectionlookup();
-        gfx_system_make_enviro();
 
         //Load players if needed
         if(!_playersToLoad.empty())
@@ -115,44 +115,6 @@ void LoadingState::beginState()
 }
 
 
-bool LoadingState::loadPlayers()
-{
-    // blank out any existing data
-    import_list_t::init(g_importList);
-
-    // loop through the selected players and store all the valid data in the list of imported players
-    for(const std::string &loadPath : _playersToLoad)
-    {
-        // get a new import data pointer
-        import_element_t *import_ptr = g_importList.lst + g_importList.count;
-        g_importList.count++;
-
-        //figure out which player we are (1, 2, 3 or 4)
-        import_ptr->local_player_num = g_importList.count-1;
-
-        // set the import info
-        import_ptr->slot            = (import_ptr->local_player_num) * MAX_IMPORT_PER_PLAYER;
-        import_ptr->player          = (import_ptr->local_player_num);
-
-        strncpy( import_ptr->srcDir, loadPath.c_str(), SDL_arraysize( import_ptr->srcDir ) );
-        import_ptr->dstDir[0] = CSTR_END;
-    }
-
-    if(g_importList.count > 0) {
-
-        if(game_copy_imports(&g_importList) == rv_success) {
-            return true;
-        }
-        else {
-            // erase the data in the import folder
-            vfs_removeDirectoryAndContents( "import", VFS_TRUE );
-            return false;
-        }
-    }
-
-    return false;
-}
-
 void LoadingState::loadModuleData()
 {
     const int SCREEN_WIDTH = _gameEngine->getUIManager()->getScreenWidth();
@@ -179,13 +141,10 @@ void LoadingState::loadModuleData()
     // Reset all loaded "profiles" in the "profile system".
     ProfileSystem::get().reset();
 
-    // do some graphics initialization
-    gfx_system_make_enviro();
-
     //Load players if needed
     if(!_playersToLoad.empty()) {
         setProgressText("Loading players...", 50);
-        if(!loadPlayers()) {
+        if(!game_load_players(_playersToLoad)) {
 			Log::get().warn("Failed to load players!\n");
             endState();
             return;
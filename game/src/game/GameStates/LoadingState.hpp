@@ -50,12 +50,6 @@ protected:
 
     void loadModuleData();
 
-    /**
-     * @brief
-     *    Actually loads all data for the Characters that players have picked.
-     */
-    bool loadPlayers();
-
     const std::string getRandomHint() const;
 
     /// @author ZF
@@ -87,9 +87,9 @@ void MapEditorState::update()
     InputSystem::read_keyboard();
     InputSystem::read_mouse();
 
-    //Rebuild the quadtree for fast object lookup
-    _currentModule->getObjectHandler().updateQuadTree(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
-		                                                          _currentModule->getMeshPointer()->_info.getTileCountY()*Info<float>::Grid::Size());
+    //Update the spatial grid for fast object lookup
+    _currentModule->getObjectHandler().updateSpatialGrid(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
+		                                                             _currentModule->getMeshPointer()->_info.getTileCountY()*Info<float>::Grid::Size());
 
     //Always reveal all invisible monsters and objects in Map Editor mode
     local_stats.seeinvis_level = 100;
@@ -142,9 +142,6 @@ void MapEditorState::loadModuleData(std::shared_ptr<ModuleProfile> module)
     // Reset all loaded "profiles" in the "profile system".
     ProfileSystem::get().reset();
 
-    // do some graphics initialization
-    gfx_system_make_enviro();
-
     // try to start a new module
     game_begin_module(module);
 
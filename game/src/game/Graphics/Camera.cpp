@@ -37,6 +37,8 @@ const uint8_t Camera::DEFAULT_TURN_TIME = 16;
 const float Camera::CAM_ZADD_AVG = (0.5f * (CAM_ZADD_MIN + CAM_ZADD_MAX));
 const float Camera::CAM_ZOOM_AVG = (0.5f * (CAM_ZOOM_MIN + CAM_ZOOM_MAX));
 
+std::atomic<uint32_t> Camera::s_nextID(0);
+
 Camera::Camera(const CameraOptions &options) :
     _options(options),
     _viewMatrix(),
@@ -80,6 +82,7 @@ Camera::Camera(const CameraOptions &options) :
     _trackList(),
     _screen(),
     _lastFrame(-1),
+    _id(s_nextID++),
     _tileList(std::make_shared<Ego::Graphics::TileList>()),
     _entityList(std::make_shared<Ego::Graphics::EntityList>())
 {
@@ -213,6 +213,14 @@ public:
     inline int getSwing() const { return _swing; }
 
     inline int getLastFrame() const {return _lastFrame;}
+
+    /**
+     * @brief
+     *  Get the ID of this camera.
+     * @return
+     *  the ID of this camera, no two cameras constructed during a run of the program share an ID
+     */
+    inline uint32_t getID() const { return _id; }
     inline std::shared_ptr<Ego::Graphics::TileList> getTileList() const {return _tileList;}
     inline std::shared_ptr<Ego::Graphics::EntityList> getEntityList() const {return _entityList;}
 
@@ -332,6 +340,8 @@ protected:
 private:
     static constexpr float TURN_Z_SUSTAIN = 0.60f;    ///< Turning rate falloff.
 
+    static std::atomic<uint32_t> s_nextID;            ///< The ID of the next camera.
+
 	const CameraOptions _options;
 
     // The view frustum.
@@ -384,6 +394,7 @@ private:
     ego_frect_t                  _screen;
 
     int _lastFrame;         ///< Number of last update frame.
+    const uint32_t _id;     ///< The ID of this camera.
     std::shared_ptr<Ego::Graphics::TileList> _tileList;     ///< A pointer to a tile list or a null pointer.
     std::shared_ptr<Ego::Graphics::EntityList> _entityList; ///< A pointer to an entity list or a null pointer.
 };
@@ -115,9 +115,10 @@ void CameraSystem::resetAllTargets( const ego_mesh_t * mesh )
     }
 }
 
-egolib_rv CameraSystem::renderAll(std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> renderFunction)
+egolib_rv CameraSystem::renderAll(std::function<void(const std::vector<std::shared_ptr<Camera>>&)> prepareFunction,
+	                                std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> renderFunction)
 {
-    if ( NULL == renderFunction ) {
+    if ( NULL == prepareFunction || NULL == renderFunction ) {
         return rv_error;
     }
 
@@ -128,15 +129,24 @@ egolib_rv CameraSystem::renderAll(std::function<void(std::shared_ptr<Camera>, st
     //Store main camera to restore
     std::shared_ptr<Camera> storeMainCam = _mainCamera;
 
-    for(const std::shared_ptr<Camera> &camera : _cameraList) 
+    // the cameras which have not rendered this frame yet
+    static std::vector<std::shared_ptr<Camera>> cameras;
+    cameras.clear();
+    for(const std::shared_ptr<Camera> &camera : _cameraList)
     {
-        // set the "global" camera pointer to this camera
-        _mainCamera = camera;
-
-	    // has this camera already rendered this frame?
         if ( camera->getLastFrame() >= 0 && static_cast<uint32_t>(camera->getLastFrame()) >= game_frame_all ) {
             continue;
         }
+        cameras.push_back(camera);
+    }
+
+    // everything the cameras have in common is done once
+    prepareFunction(cameras);
+
+    for(const std::shared_ptr<Camera> &camera : cameras)
+    {
+        // set the "global" camera pointer to this camera
+        _mainCamera = camera;
 
         // set up everything for this camera
         beginCameraMode(camera);
@@ -153,6 +163,7 @@ egolib_rv CameraSystem::renderAll(std::function<void(std::shared_ptr<Camera>, st
 
     // reset the "global" camera pointer to whatever it was
     _mainCamera = storeMainCam;
+    cameras.clear();
 
     return rv_success;
 }
@@ -50,7 +50,16 @@ public:
 	void updateAll( const ego_mesh_t * mesh );
 	void resetAllTargets( const ego_mesh_t * mesh );
 
-	egolib_rv renderAll(std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> renderFunction);
+	/**
+	 * @brief
+	 *  Render all cameras which did not render in this frame yet.
+	 * @param prepareFunction
+	 *  called once with all cameras to render before any camera renders
+	 * @param renderFunction
+	 *  called for each camera to render
+	 */
+	egolib_rv renderAll(std::function<void(const std::vector<std::shared_ptr<Camera>>&)> prepareFunction,
+		                std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> renderFunction);
 
 	/**
 	 * @brief
@@ -2,12 +2,13 @@
 #include "game/graphic.h"
 #include "game/graphic_prt.h"
 #include "game/Entities/_Include.hpp"
+#include "egolib/Core/RadixSort.hpp"
 
 namespace Ego {
 namespace Graphics {
 
 EntityList::EntityList()
-    : _lst()
+    : _lst(), _order(), _gathered(false)
 { }
 
 void EntityList::init()
@@ -39,13 +40,20 @@ gfx_rv EntityList::reset()
     }
 
     _lst.clear();
+    _order.clear();
+    _gathered = false;
     return gfx_success;
 }
 
+size_t EntityList::getCapacity()
+{
+    return _currentModule->getObjectHandler().getCapacity() + ParticleHandler::get().getDisplayLimit();
+}
+
 gfx_rv EntityList::test_obj(const Object& obj)
 {
     // The entity is not a candidate if the list is full.
-    if (_lst.size() == CAPACITY)
+    if (_lst.size() == getCapacity())
     {
         return gfx_fail;
     }
@@ -77,6 +85,8 @@ gfx_rv EntityList::add_obj_raw(Object& obj)
 
     // Add!
     _lst.emplace_back(obj.getObjRef(), ParticleRef::Invalid);
+    _order.push_back(static_cast<uint32_t>(_lst.size() - 1));
+    _gathered = false;
 
     // Notify it that it is in a do list.
     obj.inst.indolist = true;
@@ -84,12 +94,12 @@ gfx_rv EntityList::add_obj_raw(Object& obj)
     // Add any weapons it is holding.
     Object *holding;
     holding = _currentModule->getObjectHandler().get(obj.holdingwhich[SLOT_LEFT]);
-    if (holding && _lst.size() < CAPACITY)
+    if (holding && _lst.size() < getCapacity())
     {
         add_obj_raw(*holding);
     }
     holding = _currentModule->getObjectHandler().get(obj.holdingwhich[SLOT_RIGHT]);
-    if (holding && _lst.size() < CAPACITY)
+    if (holding && _lst.size() < getCapacity())
     {
         add_obj_raw(*holding);
     }
@@ -99,7 +109,7 @@ gfx_rv EntityList::add_obj_raw(Object& obj)
 gfx_rv EntityList::test_prt(const std::shared_ptr<Ego::Particle>& prt)
 {
     // The entity is not a candidate if the list is full.
-    if (_lst.size() == CAPACITY)
+    if (_lst.size() == getCapacity())
     {
         return gfx_fail;
     }
@@ -125,80 +135,81 @@ gfx_rv EntityList::add_prt_raw(const std::shared_ptr<Ego::Particle>& prt)
     /// @details This function puts an entity in the list
 
     _lst.emplace_back(ObjectRef::Invalid, prt->getParticleID());
+    _order.push_back(static_cast<uint32_t>(_lst.size() - 1));
+    _gathered = false;
     prt->inst.indolist = true;
 
     return gfx_success;
 }
 
+void EntityList::gather()
+{
+    for (element_t& element : _lst)
+    {
+        if (ParticleRef::Invalid == element.iprt && ObjectRef::Invalid != element.iobj)
+        {
+            const Object *pobj = _currentModule->getObjectHandler().get(element.iobj);
+            if (!pobj) continue;
+
+            element.pos = mat_getTranslate(pobj->inst.matrix);
+            element.ref_pos = mat_getTranslate(pobj->inst.ref.matrix);
+        }
+        else if (ObjectRef::Invalid == element.iobj && ParticleRef::Invalid != element.iprt)
+        {
+            const std::shared_ptr<Ego::Particle> &pprt = ParticleHandler::get()[element.iprt];
+            if (!pprt) continue;
+
+            element.pos = pprt->inst.pos;
+            element.ref_pos = pprt->inst.ref_pos;
+        }
+    }
+    _gathered = true;
+}
+
 gfx_rv EntityList::sort(Camera& cam, const bool do_reflect)
 {
     /// @author ZZ
     /// @details This function orders the entity list based on distance from camera,
     ///    which is needed for reflections to properly clip themselves.
     ///    Order from closest to farthest
-    if (_lst.size() >= CAPACITY)
+    if (_lst.size() >= getCapacity())
     {
         throw std::logic_error("invalid entity list size");
     }
 
+    if (!_gathered)
+    {
+        gather();
+    }
+
 	Vector3f vcam;
     mat_getCamForward(cam.getViewMatrix(), vcam);
 
     // Figure the distance of each.
-    size_t count = 0;
-    for (size_t i = 0; i < _lst.size(); ++i)
+    static Ego::RadixSort<uint32_t, uint32_t> sorter;
+    sorter.clear();
+    for (uint32_t i = 0; i < _lst.size(); ++i)
     {
-		Vector3f vtmp;
-
-        if (ParticleRef::Invalid == _lst[i].iprt && ObjectRef::Invalid != _lst[i].iobj)
-        {
-			Vector3f pos_tmp;
-
-            ObjectRef iobj = _lst[i].iobj;
-
-            if (do_reflect)
-            {
-                pos_tmp = mat_getTranslate(_currentModule->getObjectHandler().get(iobj)->inst.ref.matrix);
-            }
-            else
-            {
-                pos_tmp = mat_getTranslate(_currentModule->getObjectHandler().get(iobj)->inst.matrix);
-            }
-
-            vtmp = pos_tmp - cam.getPosition();
-        }
-        else if (ObjectRef::Invalid == _lst[i].iobj && _lst[i].iprt != ParticleRef::Invalid)
-        {
-            ParticleRef iprt = _lst[i].iprt;
-
-            if (do_reflect)
-            {
-                vtmp = ParticleHandler::get()[iprt]->inst.pos - cam.getPosition();
-            }
-            else
-            {
-                vtmp = ParticleHandler::get()[iprt]->inst.ref_pos - cam.getPosition();
-            }
-        }
-        else
+        element_t& element = _lst[i];
+        if (ObjectRef::Invalid == element.iobj && ParticleRef::Invalid == element.iprt)
         {
             continue;
         }
 
-        float dist = vtmp.dot(vcam);
+        const Vector3f vtmp = (do_reflect ? element.ref_pos : element.pos) - cam.getPosition();
+        const float dist = vtmp.dot(vcam);
         if (dist > 0)
         {
-            _lst[count].iobj = _lst[i].iobj;
-            _lst[count].iprt = _lst[i].iprt;
-            _lst[count].dist = dist;
-            count++;
+            element.dist = dist;
+            sorter.push(Ego::RadixSort<uint32_t, uint32_t>::getKey(dist), i);
         }
     }
+    sorter.sort();
 
-    // use qsort to sort the list in-place
-    if (count > 1)
+    _order.clear();
+    for (const auto& element : sorter.getElements())
     {
-        std::sort(_lst.begin(), _lst.end(), Compare());
+        _order.push_back(element.value);
     }
 
     return gfx_success;
@@ -39,9 +39,9 @@ struct EntityList
 {
     /**
      * @brief
-     *    The (fixed) capacity of a do list.
+     *    The capacity of a do list, enough for all objects and particles which may be alive at the same time.
      */
-    static constexpr size_t CAPACITY = OBJECTS_MAX + PARTICLES_MAX;
+    static size_t getCapacity();
     /**
      * @brief
      *    An eleemnt of a do list.
@@ -49,57 +49,80 @@ struct EntityList
     struct element_t
     {
         element_t(const element_t& other)
-            : iobj(other.iobj), iprt(other.iprt), dist(other.dist)
+            : iobj(other.iobj), iprt(other.iprt), dist(other.dist), pos(other.pos), ref_pos(other.ref_pos)
         { }
         element_t(ObjectRef iobj, ParticleRef iprt)
-            : iobj(iobj), iprt(iprt), dist(0.0f)
+            : iobj(iobj), iprt(iprt), dist(0.0f), pos(), ref_pos()
         { }
 
         ObjectRef iobj;
         ParticleRef iprt;
         float dist;
-    };
-    struct Compare {
-        bool operator()(const element_t& x, const element_t& y) const {
-            return x.dist < y.dist;
-        }
+        Vector3f pos;      ///< The cached position of the entity.
+        Vector3f ref_pos;  ///< The cached position of the reflection of the entity.
     };
 protected:
 
     /**
     * @brief
-    *  An array of dolist elements.
+    *  An array of dolist elements in the order they were added.
     */
     std::vector<element_t> _lst;
 
+    /**
+    * @brief
+    *  The indices of the dolist elements in drawing order.
+    */
+    std::vector<uint32_t> _order;
+
+    /**
+    * @brief
+    *  Are the cached positions of the dolist elements up to date?
+    */
+    bool _gathered;
+
+    /**
+    * @brief
+    *  Cache the positions of all entities, one handler lookup per entity.
+    */
+    void gather();
+
 public:
     EntityList();
     void init();
     
     const element_t& get(size_t index) const
     {
-        if (index >= _lst.size())
+        if (index >= _order.size())
         {
             throw std::out_of_range("index out of range");
         }
-        return _lst[index];
+        return _lst[_order[index]];
     }
 
     element_t& get(size_t index)
     {
-        if (index >= _lst.size())
+        if (index >= _order.size())
         {
             throw std::out_of_range("index out of range");
         }
-        return _lst[index];
+        return _lst[_order[index]];
     }
     
     size_t getSize() const
     {
-        return _lst.size();
+        return _order.size();
     }
 
     gfx_rv reset();
+    /**
+     * @brief
+     *  Order the entities from the closest to the farthest. Entities behind the camera are left out.
+     *  The positions of the entities are gathered by the first sort after entities were added, the
+     *  reflected and the unreflected sort share them.
+     * @param reflect
+     *  if @a true, the entities are ordered by the positions of their reflections
+     */
     gfx_rv sort(Camera& camera, const bool reflect);
 
     gfx_rv test_obj(const Object& obj);
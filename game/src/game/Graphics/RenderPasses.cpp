@@ -40,6 +40,7 @@
 #include "egolib/FileFormats/Globals.hpp"
 #include "game/Module/Module.hpp"
 #include "game/Entities/_Include.hpp"
+#include "egolib/Core/RadixSort.hpp"
 
 namespace Ego {
 namespace Graphics {
@@ -47,100 +48,107 @@ namespace RenderPasses {
 
 namespace Internal {
 
-ElementV2::ElementV2()
-    : ElementV2(std::numeric_limits<float>::infinity(), 
-                Index1D::Invalid, 
-                std::numeric_limits<uint32_t>::max()) {
-}
-
-ElementV2::ElementV2(float distance, const Index1D& tileIndex, uint32_t textureIndex)
-	: distance(distance), tileIndex(tileIndex), textureIndex(textureIndex) {
-}
-
-ElementV2::ElementV2(const ElementV2& other)
-	: ElementV2(other.getDistance(), other.getTileIndex(), other.getTextureIndex()) {
-}
-
-const ElementV2& ElementV2::operator=(const ElementV2& other) {
-	distance = other.getDistance();
-	tileIndex = other.getTileIndex();
-	textureIndex = other.getTextureIndex();
-	return *this;
-}
-
-float ElementV2::getDistance() const {
-    return distance;
-}
-
-const Index1D& ElementV2::getTileIndex() const {
-    return tileIndex;
-}
-
-uint32_t ElementV2::getTextureIndex() const {
-    return textureIndex;
-}
-
-bool ElementV2::compare(const ElementV2& x, const ElementV2& y) {
-	int result = (int)x.getTextureIndex() - (int)y.getTextureIndex();
-	if (result < 0) {
-		return true;
-	} else if (result > 0) {
-		return false;
-	} else {
-        float result = x.getDistance() - y.getDistance();
-		if (result < 0.0f) {
-			return true;
-		} else {
-			return false;
-		}
-	}
-}
-
 void TileListV2::render(const ego_mesh_t& mesh, const Graphics::renderlist_lst_t& rlst)
 {
+	// kept between frames to avoid re-allocating every frame
+	static RadixSort<Index1D> sorter;
+	static std::vector<std::pair<size_t, size_t>> ranges;
+
 	size_t tcnt = mesh._tmem.getInfo().getTileCount();
 
 	if (0 == rlst.size) {
 		return;
 	}
 
-	// insert the rlst values into lst_vals
-	std::vector<ElementV2> lst_vals(rlst.size);
+	// key the tiles by texture (high bits) and by distance (low bits)
+	sorter.clear();
 	for (size_t i = 0; i < rlst.size; ++i)
 	{
-        uint32_t textureIndex;
 		if (rlst.lst[i]._index >= tcnt)
 		{
-			textureIndex = std::numeric_limits<uint32_t>::max();
+			continue;
 		}
-		else
+		const ego_tile_info_t& tile = mesh._tmem.get(rlst.lst[i]._index);
+		if (tile.isFanOff())
 		{
-			const ego_tile_info_t& tile = mesh._tmem.get(rlst.lst[i]._index);
-
-			int img = TILE_GET_LOWER_BITS(tile._img);
-			if (tile._type >= tile_dict.offset)
-			{
-				img += Ego::Graphics::MESH_IMG_COUNT;
-			}
+			continue;
+		}
 
-			textureIndex = img;
+		uint64_t textureIndex = TILE_GET_LOWER_BITS(tile._img);
+		if (tile._type >= tile_dict.offset)
+		{
+			textureIndex += Ego::Graphics::MESH_IMG_COUNT;
 		}
-        lst_vals[i] = ElementV2(rlst.lst[i]._distance, rlst.lst[i]._index, textureIndex);
+
+		sorter.push((textureIndex << 32) | RadixSort<Index1D>::getKey(rlst.lst[i]._distance), rlst.lst[i]._index);
 	}
+	sorter.sort();
 
-	std::sort(lst_vals.begin(), lst_vals.end(), ElementV2::compare);
+	const auto& elements = sorter.getElements();
+	const mesh_buffers_t& buffers = mesh._tmem._buffers;
+	size_t drawCalls = 0;
 
 	// restart the mesh texture code
 	TileRenderer::invalidate();
 
-	for (size_t i = 0; i < rlst.size; ++i)
+	// the buffers are uploaded when the scene is initialized
+	if (buffers._vertices)
 	{
-		Index1D tmp_itile = lst_vals[i].getTileIndex();
+		Ego::OpenGL::PushClientAttrib pca(GL_CLIENT_VERTEX_ARRAY_BIT);
+		{
+			auto& renderer = Ego::Renderer::get();
+
+			// Per-vertex coloring.
+			renderer.setGouraudShadingEnabled(gfx.gouraudShading_enable); // GL_LIGHTING_BIT
 
-		gfx_rv render_rv = render_fan(mesh, tmp_itile);
-		if (egoboo_config_t::get().debug_developerMode_enable.getValue() && gfx_error == render_rv)
+			std::vector<Ego::VertexBuffer *> vertexBuffers = { buffers._vertices.get() };
+			if (gfx.gouraudShading_enable) {
+				vertexBuffers.push_back(buffers._colours.get());
+			}
+
+			// Draw the triangles of all tiles sharing a texture with a single call, keeping their order.
+			for (size_t begin = 0, end = 0; begin < elements.size(); begin = end)
+			{
+				const uint64_t textureIndex = elements[begin].key >> 32;
+				ranges.clear();
+				for (end = begin; end < elements.size() && (elements[end].key >> 32) == textureIndex; ++end)
+				{
+					const auto& tileIndices = buffers._tileIndices[elements[end].value.getI()];
+					if (0 == tileIndices.second)
+					{
+						continue;
+					}
+					// tiles following each other in the index buffer are merged
+					if (!ranges.empty() && ranges.back().first + ranges.back().second == tileIndices.first)
+					{
+						ranges.back().second += tileIndices.second;
+					}
+					else
+					{
+						ranges.push_back(tileIndices);
+					}
+				}
+				if (ranges.empty())
+				{
+					continue;
+				}
+
+				// bind the correct texture
+				TileRenderer::bind(mesh.getTileInfo(elements[begin].value));
+
+				renderer.render(vertexBuffers, *buffers._indices, Ego::PrimitiveType::Triangles, ranges);
+				drawCalls++;
+			}
+		}
+	}
+
+	render_scene_mesh_timer.count(drawCalls);
+
+	if (egoboo_config_t::get().debug_mesh_renderNormals.getValue())
+	{
+		for (const auto& element : elements)
 		{
-			Log::get().warn("%s - error rendering tile %d.\n", __FUNCTION__, tmp_itile.getI());
+			render_fan_normals(mesh, element.value);
 		}
 	}
 
@@ -148,79 +156,28 @@ void TileListV2::render(const ego_mesh_t& mesh, const Graphics::renderlist_lst_t
 	TileRenderer::invalidate();
 }
 
-gfx_rv TileListV2::render_fan(const ego_mesh_t& mesh, const Index1D& i) {
-    /// @author ZZ
-    /// @details This function draws a mesh itile
-    /// Optimized to use gl*Pointer() and glArrayElement() for vertex presentation
-
-    // grab a pointer to the tile
-    const ego_tile_info_t& ptile = mesh.getTileInfo(i);
-
+void TileListV2::render_fan_normals(const ego_mesh_t& mesh, const Index1D& tileIndex) {
+    const ego_tile_info_t& ptile = mesh.getTileInfo(tileIndex);
     const tile_mem_t& ptmem = mesh._tmem;
 
-    // do not render the itile if the image image is invalid
-    if (ptile.isFanOff())  return gfx_success;
-
-    tile_definition_t *pdef = tile_dict.get(ptile._type);
-    if (NULL == pdef) return gfx_fail;
-
-    // bind the correct texture
-    TileRenderer::bind(ptile);
-
-    {
-        Ego::OpenGL::PushClientAttrib pca(GL_CLIENT_VERTEX_ARRAY_BIT);
+    TileRenderer::invalidate();
+    auto& renderer = Ego::Renderer::get();
+    renderer.getTextureUnit().setActivated(nullptr);
+    renderer.setColour(Ego::Colour4f::white());
+    for (size_t i = ptile._vrtstart, j = 0; j < 4; ++i, ++j) {
+        glBegin(GL_LINES);
         {
-            // Per-vertex coloring.
-            Ego::Renderer::get().setGouraudShadingEnabled(gfx.gouraudShading_enable); // GL_LIGHTING_BIT
-
-                                                                                      /// @note claforte@> Put this in an initialization function.
-            GL_DEBUG(glEnableClientState)(GL_VERTEX_ARRAY);
-            GL_DEBUG(glVertexPointer)(3, GL_FLOAT, 0, &(ptmem._plst[ptile._vrtstart]));
+            glVertex3fv(ptmem._plst[i]);
+            glVertex3f
+                (
+                    ptmem._plst[i][XX] + Info<float>::Grid::Size()*(ptile._ncache[j][XX]),
+                    ptmem._plst[i][YY] + Info<float>::Grid::Size()*(ptile._ncache[j][YY]),
+                    ptmem._plst[i][ZZ] + Info<float>::Grid::Size()*(ptile._ncache[j][ZZ])
+                    );
 
-            GL_DEBUG(glEnableClientState)(GL_TEXTURE_COORD_ARRAY);
-            GL_DEBUG(glTexCoordPointer)(2, GL_FLOAT, 0, &(ptmem._tlst[ptile._vrtstart]));
-
-            if (gfx.gouraudShading_enable) {
-                GL_DEBUG(glEnableClientState)(GL_COLOR_ARRAY);
-                GL_DEBUG(glColorPointer)(3, GL_FLOAT, 0, &(ptmem._clst[ptile._vrtstart]));
-            } else {
-                GL_DEBUG(glDisableClientState)(GL_COLOR_ARRAY);
-            }
-            // grab some model info
-            uint16_t commands = pdef->command_count;
-
-            // Render each command
-            for (size_t cnt = 0, entry = 0; cnt < commands; cnt++) {
-                uint8_t numEntries = pdef->command_entries[cnt];
-
-                GL_DEBUG(glDrawElements)(GL_TRIANGLE_FAN, numEntries, GL_UNSIGNED_SHORT, &(pdef->command_verts[entry]));
-                entry += numEntries;
-            }
         }
+        glEnd();
     }
-
-    if (egoboo_config_t::get().debug_mesh_renderNormals.getValue()) {
-        TileRenderer::invalidate();
-        auto& renderer = Ego::Renderer::get();
-        renderer.getTextureUnit().setActivated(nullptr);
-        renderer.setColour(Ego::Colour4f::white());
-        for (size_t i = ptile._vrtstart, j = 0; j < 4; ++i, ++j) {
-            glBegin(GL_LINES);
-            {
-                glVertex3fv(ptmem._plst[i]);
-                glVertex3f
-                    (
-                        ptmem._plst[i][XX] + Info<float>::Grid::Size()*(ptile._ncache[j][XX]),
-                        ptmem._plst[i][YY] + Info<float>::Grid::Size()*(ptile._ncache[j][YY]),
-                        ptmem._plst[i][ZZ] + Info<float>::Grid::Size()*(ptile._ncache[j][ZZ])
-                        );
-
-            }
-            glEnd();
-        }
-    }
-
-    return gfx_success;
 }
 
 gfx_rv TileListV2::render_hmap_fan(const ego_mesh_t * mesh, const Index1D& tileIndex) {
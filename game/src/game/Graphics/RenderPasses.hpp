@@ -32,30 +32,15 @@ namespace RenderPasses {
 
 namespace Internal {
 
-struct ElementV2 {
-private:
-    float distance;
-    Index1D tileIndex;
-    uint32_t textureIndex;
-public:
-    ElementV2();
-    ElementV2(float distance, const Index1D& tileIndex, uint32_t textureIndex);
-    ElementV2(const ElementV2& other);
-    const ElementV2& operator=(const ElementV2& other);
-public:
-    float getDistance() const;
-    const Index1D& getTileIndex() const;
-    uint32_t getTextureIndex() const;
-public:
-    static bool compare(const ElementV2& x, const ElementV2& y);
-};
-
 struct TileListV2 {
+    /// @brief Draw the tiles of a render list.
+    /// @remark The tiles are sorted by texture and then by distance, all tiles sharing a texture are drawn with a single draw call
+    /// from the buffers of the mesh.
     static void render(const ego_mesh_t& mesh, const Graphics::renderlist_lst_t& rlst);
-    /// @brief Draw a fan.
+    /// @brief Draw the normals of a fan.
     /// @param mesh the mesh
     /// @param tileIndex the tile index
-    static gfx_rv render_fan(const ego_mesh_t& mesh, const Index1D& tileIndex);
+    static void render_fan_normals(const ego_mesh_t& mesh, const Index1D& tileIndex);
     /// @brief Draw a heightmap fan.
     /// @param mesh the mesh
     /// @param tileIndex the tile index
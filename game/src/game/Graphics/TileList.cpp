@@ -50,7 +50,10 @@ TileList::TileList() :
 	_water(),
 
 	_renderTiles(),
-	_lastRenderTiles()
+	_lastRenderTiles(),
+	_renderBlocks(),
+	_renderBlockCount(0),
+	_renderArea()
 {}
 
 TileList::~TileList()
@@ -80,6 +83,8 @@ gfx_rv TileList::reset()
 	// Clear out the "in render list" flag for the old mesh.
 	_lastRenderTiles = _renderTiles;
 	_renderTiles.reset();
+	_renderBlocks.assign(_mesh->_tmem._blocks.getBlockCountX() * _mesh->_tmem._blocks.getBlockCountY(), false);
+	_renderBlockCount = 0;
 
 	// Re-initialize the renderlist.
 	auto mesh = _mesh;
@@ -112,8 +117,8 @@ gfx_rv TileList::insert(const Index1D& index, const ::Camera &cam)
 
 	int ix = index.getI() % _mesh->_info.getTileCountX();
 	int iy = index.getI() / _mesh->_info.getTileCountX();
-	float dx = (ix + Info<float>::Grid::Size() * 0.5f) - cam.getCenter()[kX];
-	float dy = (iy + Info<float>::Grid::Size() * 0.5f) - cam.getCenter()[kY];
+	float dx = (ix + 0.5f) * Info<float>::Grid::Size() - cam.getCenter()[kX];
+	float dy = (iy + 0.5f) * Info<float>::Grid::Size() - cam.getCenter()[kY];
 	float distance = dx * dx + dy * dy;
 
 	// Put each tile in basic list
@@ -158,6 +163,13 @@ void TileList::setMesh(std::shared_ptr<ego_mesh_t> mesh)
 
 gfx_rv TileList::add(const Index1D& index, ::Camera& camera)
 {
+	// only tiles which made it into the lists are in the render list
+	gfx_rv retval = insert(index, camera);
+	if (gfx_success != retval)
+	{
+		return gfx_error == retval ? gfx_error : gfx_success;
+	}
+
 	_renderTiles[index.getI()] = true;
 
 	// if the tile was not in the renderlist last frame, then we need to force a lighting update of this tile
@@ -167,11 +179,6 @@ gfx_rv TileList::add(const Index1D& index, ::Camera& camera)
 		tile._lightingCache.setLastFrame(-1);
 	}
 
-	if (gfx_error == insert(index, camera))
-	{
-		return gfx_error;
-	}
-
 	return gfx_success;
 }
 
@@ -181,5 +188,49 @@ bool TileList::inRenderList(const Index1D& index) const
 	return _renderTiles[index.getI()];
 }
 
+void TileList::addBlock(size_t block)
+{
+	if (block >= _renderBlocks.size() || _renderBlocks[block]) return;
+	_renderBlocks[block] = true;
+
+	const size_t countX = _mesh->_tmem._blocks.getBlockCountX();
+	const Vector2f min((block % countX) * Info<float>::Block::Size(), (block / countX) * Info<float>::Block::Size());
+	const AABB2f area(min, min + Vector2f(Info<float>::Block::Size(), Info<float>::Block::Size()));
+	if (0 == _renderBlockCount++) {
+		_renderArea = area;
+	} else {
+		_renderArea.join(area);
+	}
+}
+
+bool TileList::inRenderBlocks(const AABB2f& bounds) const
+{
+	if (0 == _renderBlockCount) return false;
+
+	// the blocks below the bounds, entities off the mesh are kept with the blocks at its border
+	const int countX = _mesh->_tmem._blocks.getBlockCountX(),
+		      countY = _mesh->_tmem._blocks.getBlockCountY();
+	const int minX = Ego::Math::constrain<int>(std::floor(bounds.getMin()[kX] / Info<float>::Block::Size()), 0, countX - 1),
+		      minY = Ego::Math::constrain<int>(std::floor(bounds.getMin()[kY] / Info<float>::Block::Size()), 0, countY - 1),
+		      maxX = Ego::Math::constrain<int>(std::floor(bounds.getMax()[kX] / Info<float>::Block::Size()), 0, countX - 1),
+		      maxY = Ego::Math::constrain<int>(std::floor(bounds.getMax()[kY] / Info<float>::Block::Size()), 0, countY - 1);
+	for (int y = minY; y <= maxY; ++y) {
+		for (int x = minX; x <= maxX; ++x) {
+			if (_renderBlocks[y * countX + x]) return true;
+		}
+	}
+	return false;
+}
+
+size_t TileList::getRenderBlockCount() const
+{
+	return _renderBlockCount;
+}
+
+const AABB2f& TileList::getRenderArea() const
+{
+	return _renderArea;
+}
+
 }
 }
@@ -58,8 +58,9 @@ struct renderlist_lst_t
 	*    The maximum capacity of a renderlist
 	*    i.e. the maximum number of tiles in a render list
 	*    i.e. the maximum number of tiles to draw.
+	*    The tiles in view of all cameras of a split screen share one list.
 	*/
-	static const size_t CAPACITY = 1024;
+	static const size_t CAPACITY = 1024 * MAX_LOCAL_PLAYERS;
 	size_t size;                          ///< The number of entries.
 	std::array<element_t, CAPACITY> lst;  ///< The entries.
 
@@ -143,9 +144,42 @@ struct TileList
 	**/
 	bool inRenderList(const Index1D& index) const;
 
+	/**
+	* @brief
+	*	mark a block of the mesh as in view
+	* @param block
+	*	the index of the block
+	**/
+	void addBlock(size_t block);
+
+	/**
+	* @brief
+	*	check whether an entity stands on a block in view
+	* @param bounds
+	*	the 2D bounds of the entity
+	* @return
+	*	true if any block below the bounds is in view
+	**/
+	bool inRenderBlocks(const AABB2f& bounds) const;
+
+	/**
+	* @return
+	*	the number of blocks in view
+	**/
+	size_t getRenderBlockCount() const;
+
+	/**
+	* @return
+	*	the 2D bounds of all blocks in view, only meaningful if getRenderBlockCount() is not zero
+	**/
+	const AABB2f& getRenderArea() const;
+
 private:
 	std::bitset<MAP_TILE_MAX> _renderTiles;		//index of all tiles to be rendered
 	std::bitset<MAP_TILE_MAX> _lastRenderTiles; //index of all tiles that were rendered last frame
+	std::vector<bool> _renderBlocks;            //index of all blocks in view
+	size_t _renderBlockCount;                   //number of blocks in view
+	AABB2f _renderArea;                         //2D bounds of all blocks in view
 };
 
 }
@@ -197,6 +197,9 @@ void Passage::flashColor(uint8_t color)
             ptile._vertexLightingCache.setNeedUpdate(true);
             ptile._vertexLightingCache._lastFrame = -1;
         }
+
+        // let the flash fade back to the grid lighting
+        ptile._lightingCache.setNeedUpdate(true);
     }
 }
 
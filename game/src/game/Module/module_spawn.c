@@ -71,9 +71,9 @@ void activate_spawn_file_vfs()
             }
 
             //Spit out a warning if they break the limit
-            if ( objectsToSpawn.size() >= OBJECTS_MAX )
+            if ( objectsToSpawn.size() >= _currentModule->getObjectHandler().getCapacity() )
             {
-				Log::get().warn("Too many objects in file \"%s\"! Maximum number of objects is %d.\n", ctxt.getLoadName().c_str(), OBJECTS_MAX );
+				Log::get().warn("Too many objects in file \"%s\"! Maximum number of objects is %" PRIuZ ".\n", ctxt.getLoadName().c_str(), _currentModule->getObjectHandler().getCapacity() );
                 break;
             }
 
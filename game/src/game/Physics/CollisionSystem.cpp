@@ -53,6 +53,7 @@ void CollisionSystem::update()
         particle->phys.clear();
     }
 
+    updateBroadphase();
     updateObjectCollisions();
     updateParticleCollisions();
 
@@ -255,20 +256,50 @@ void CollisionSystem::update()
     }
 }
 
-void CollisionSystem::updateObjectCollisions()
+void CollisionSystem::updateBroadphase()
 {
-    std::unordered_set<std::shared_ptr<Object>> handledObjects;
-
-    //Detect character -> character collisions
+    //Objects pair with Objects and Particles, Particles only with Objects
     for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator()) {
+        if (!object->canCollide()) {
+            continue;
+        }
+
+        // use the object velocity to figure out where the volume that the object will occupy during this update
+        oct_bb_t tmp_oct;
+        phys_expand_chr_bb(object.get(), 0.0f, 1.0f, tmp_oct);
+        AABB2f aabb2d = AABB2f(Vector2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Vector2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
+        aabb2d.join(object->getAABB2D());
+
+        _broadphase.update(getObjectKey(object->getObjRef()), aabb2d, BROADPHASE_OBJECT, BROADPHASE_OBJECT | BROADPHASE_PARTICLE);
+    }
+
+    for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator()) {
+        if (!particle->canCollide()) {
+            continue;
+        }
+
+        oct_bb_t tmp_oct;
+        phys_expand_prt_bb(particle.get(), 0.0f, 1.0f, tmp_oct);
+        const AABB2f aabb2d = AABB2f(Vector2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Vector2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
+
+        _broadphase.update(getParticleKey(particle->getParticleID()), aabb2d, BROADPHASE_PARTICLE, BROADPHASE_OBJECT);
+    }
+
+    //Only elements that moved across another one's bounds change the pairs
+    _broadphase.commit();
+}
 
-        //Can we collide?
+void CollisionSystem::updateObjectCollisions()
+{
+    //Keep the object list locked, removals and spawns are deferred until all collisions are handled
+    ObjectHandler::ObjectIterator iterator = _currentModule->getObjectHandler().iterator();
+
+    //First check if objects are still attached to their Platform
+    for(const std::shared_ptr<Object> &object : iterator) {
         if (!object->canCollide()) {
             continue;
         }
-        handledObjects.insert(object);
 
-        //First check if this object is still attached to it's Platform
         const std::shared_ptr<Object> &platform = _currentModule->getObjectHandler()[object->onwhichplatform_ref];
         if(platform)
         {
@@ -278,69 +309,72 @@ void CollisionSystem::updateObjectCollisions()
                 object->getObjectPhysics().detachFromPlatform();
             }
         }
+    }
 
-        //TODO: Remove this messy block and replace it with something better
-        // use the object velocity to figure out where the volume that the object will occupy during this update
-        // convert the oct_bb_t to a correct BSP_aabb_t
-        oct_bb_t tmp_oct;
-        phys_expand_chr_bb(object.get(), 0.0f, 1.0f, tmp_oct);
-        const AABB2f aabb2d = AABB2f(Vector2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Vector2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
+    //Detect character -> character collisions, Object pairs are sorted behind all Particle pairs
+    const std::vector<SweepAndPrune::Pair> &pairs = _broadphase.getPairs();
+    auto it = std::lower_bound(pairs.begin(), pairs.end(), SweepAndPrune::Pair(getObjectKey(ObjectRef(0)), 0));
+    for (; it != pairs.end(); ++it)
+    {
+        const std::shared_ptr<Object> &object = _currentModule->getObjectHandler()[getObjectRef(it->first)];
+        const std::shared_ptr<Object> &other = _currentModule->getObjectHandler()[getObjectRef(it->second)];
+        if (!object || !other) {
+            continue;
+        }
+
+        //Can they collide?
+        if (!object->canCollide() || !other->canCollide()) {
+            continue;
+        }
 
         //Do not collide scenery with other scenery objects - unless they can use platforms,
         //for example boxes stacked on top of other boxes
-        bool canCollideWithScenery = !object->isScenery() || object->canuseplatforms;
-
-        // Check collisions to nearby Objects
-        std::vector<std::shared_ptr<Object>> possibleCollisions;
-        _currentModule->getObjectHandler().findObjects(aabb2d, possibleCollisions, canCollideWithScenery);
-        for (const std::shared_ptr<Object> &other : possibleCollisions)
-        {
-            //Skip possible interactions that have already been handled earlier this iteration
-            if(handledObjects.find(other) != handledObjects.end()) {
-                continue;
-            }
-
-            //Can it collide?
-            if(!other->canCollide()) {
-                continue;
-            }
+        if (object->isScenery() && other->isScenery() && !object->canuseplatforms && !other->canuseplatforms) {
+            continue;
+        }
 
-            //Detect any collisions and handle it if needed
-            float tmin, tmax;
-            if(detectCollision(object, other, &tmin, &tmax)) {
-                handleCollision(object, other, tmin, tmax);
-            }
+        //Detect any collisions and handle it if needed
+        float tmin, tmax;
+        if(detectCollision(object, other, &tmin, &tmax)) {
+            handleCollision(object, other, tmin, tmax);
         }
     }
 }
 
 void CollisionSystem::updateParticleCollisions()
 {
-    //Check collisions with particles
-    for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
+    //Keep both lists locked while collisions are handled
+    ObjectHandler::ObjectIterator objects = _currentModule->getObjectHandler().iterator();
+    ParticleHandler::ParticleIterator particles = ParticleHandler::get().iterator();
+
+    //First check if Particles are still attached to a platform
+    for(const std::shared_ptr<Ego::Particle> &particle : particles)
     {
         if(!particle->canCollide()) {
             continue;
         }
 
-        //First check if this Particle is still attached to a platform
         if (particle->onwhichplatform_update < update_wld && _currentModule->getObjectHandler().exists(particle->onwhichplatform_ref)) {
             particle->getParticlePhysics().detachFromPlatform();
         }
+    }
 
-        // use the object velocity to figure out where the volume that the object will occupy during this update
-        // convert the oct_bb_t to a correct AABB2f
-        oct_bb_t   tmp_oct;
-        phys_expand_prt_bb(particle.get(), 0.0f, 1.0f, tmp_oct);
-        const AABB2f aabb2d = AABB2f(Vector2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Vector2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
-
-        //Detect collisions with nearby Objects
-        std::vector<std::shared_ptr<Object>> possibleCollisions;
-         _currentModule->getObjectHandler().findObjects(aabb2d, possibleCollisions, true);
-        for (const std::shared_ptr<Object> &object : possibleCollisions)
+    //Detect collisions with nearby Objects, the pairs of a Particle are adjacent
+    const std::vector<SweepAndPrune::Pair> &pairs = _broadphase.getPairs();
+    const auto end = std::lower_bound(pairs.begin(), pairs.end(), SweepAndPrune::Pair(getObjectKey(ObjectRef(0)), 0));
+    for (auto it = pairs.begin(); it != end;)
+    {
+        const SweepAndPrune::Key particleKey = it->first;
+        const std::shared_ptr<Ego::Particle> &particle = ParticleHandler::get()[getParticleRef(particleKey)];
+        for (; it != end && it->first == particleKey; ++it)
         {
+            if(!particle || !particle->canCollide()) {
+                continue;
+            }
+
             //Is it a valid collision?
-            if(!object->canCollide()) {
+            const std::shared_ptr<Object> &object = _currentModule->getObjectHandler()[getObjectRef(it->second)];
+            if(!object || !object->canCollide()) {
                 continue;
             }
 
@@ -351,7 +385,7 @@ void CollisionSystem::updateParticleCollisions()
                 do_chr_prt_collision(object, particle, tmin, tmax);
             }
         }
-    }    
+    }
 }
 
 bool CollisionSystem::detectCollision(const std::shared_ptr<Ego::Particle> &particle, const std::shared_ptr<Object> &object, float *tmin, float *tmax) const
@@ -20,6 +20,7 @@
 
 #include "IdLib/IdLib.hpp"
 #include "egolib/egolib.h"
+#include "egolib/Core/SweepAndPrune.hpp"
 
 //Forward declarations
 namespace Ego { class Particle; }
@@ -54,6 +55,23 @@ public:
     void update();
 
 private:
+    /// Broadphase groups
+    static const uint32_t BROADPHASE_OBJECT = 1 << 0;
+    static const uint32_t BROADPHASE_PARTICLE = 1 << 1;
+
+    /// Broadphase keys, Particle keys are smaller than Object keys
+    static SweepAndPrune::Key getParticleKey(const ParticleRef ref) { return ref.get(); }
+    static SweepAndPrune::Key getObjectKey(const ObjectRef ref) { return (SweepAndPrune::Key(1) << 32) | ref.get(); }
+    static ParticleRef getParticleRef(const SweepAndPrune::Key key) { return ParticleRef(static_cast<size_t>(key)); }
+    static ObjectRef getObjectRef(const SweepAndPrune::Key key) { return ObjectRef(static_cast<size_t>(key & 0xFFFFFFFF)); }
+
+    /**
+    * @brief
+    *   Feed the volume every Object and Particle occupies during this update to the broadphase
+    *   and update the pairs of possibly colliding entities
+    **/
+    void updateBroadphase();
+
     /**
     * @brief
     *   Detects if a collision occurs between two Objects
@@ -114,6 +132,9 @@ protected:
 
     CollisionSystem();
     ~CollisionSystem();
+
+private:
+    SweepAndPrune _broadphase;      ///< Pairs of Objects and Particles whose swept bounds overlap
 };
 
 } //namespace Physics
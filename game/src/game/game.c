@@ -26,6 +26,7 @@
 
 #include "egolib/egolib.h"
 #include "egolib/FileFormats/Globals.hpp"
+#include "egolib/Core/OrderedTaskRunner.hpp"
 
 #include "game/GUI/MiniMap.hpp"
 #include "game/GameStates/PlayingState.hpp"
@@ -50,6 +51,7 @@
 #include "game/Entities/ObjectHandler.hpp"
 #include "game/Entities/ParticleHandler.hpp"
 #include "game/GUI/MessageLog.hpp"
+#include "egolib/FileFormats/Replay.hpp"
 
 //--------------------------------------------------------------------------------------------
 //Global variables! eww! TODO: remove these
@@ -70,6 +72,12 @@ AnimatedTilesState g_animatedTilesState;
 
 import_list_t g_importList;
 
+// replays, the armed ones are picked up by the next call of game_begin_module()
+static std::unique_ptr<Ego::ReplayRecorder> _replayRecorderArmed = nullptr;
+static std::unique_ptr<Ego::ReplayRecorder> _replayRecorder = nullptr;
+static std::shared_ptr<Ego::ReplayPlayback> _replayPlaybackArmed = nullptr;
+static std::shared_ptr<Ego::ReplayPlayback> _replayPlayback = nullptr;
+
 uint32_t clock_chr_stat   = 0;
 uint32_t update_wld       = 0;
 
@@ -455,9 +463,9 @@ int update_game()
     InputSystem::read_mouse();
     InputSystem::read_joysticks();
 
-    //Rebuild the quadtree for fast object lookup
-    _currentModule->getObjectHandler().updateQuadTree(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
-		                                                          _currentModule->getMeshPointer()->_info.getTileCountY()*Info<float>::Grid::Size());
+    //Update the spatial grid for fast object lookup
+    _currentModule->getObjectHandler().updateSpatialGrid(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
+		                                                             _currentModule->getMeshPointer()->_info.getTileCountY()*Info<float>::Grid::Size());
 
     //---- begin the code for updating misc. game stuff
     {
@@ -782,7 +790,19 @@ void WeatherState::animate()
 //--------------------------------------------------------------------------------------------
 void readPlayerInput()
 {
-    for(const std::shared_ptr<Ego::Player>& player : _currentModule->getPlayerList()) {
+    //Advance the replay, it holds the latches of every player for this update
+    if (_replayPlayback && !_replayPlayback->nextTick()) {
+        if (_replayPlayback->isTruncated()) {
+            Log::get().warn("Replay ends with a truncated record after %u updates\n", _replayPlayback->getTickCount());
+        } else {
+            Log::get().info("Replay finished after %u updates\n", _replayPlayback->getTickCount());
+        }
+        _replayPlayback.reset();
+    }
+
+    const std::vector<std::shared_ptr<Ego::Player>>& players = _currentModule->getPlayerList();
+    for(size_t i = 0; i < players.size(); ++i) {
+        const std::shared_ptr<Ego::Player>& player = players[i];
 
         //Only valid players
         const std::shared_ptr<Object> &pchr = player->getObject();
@@ -790,18 +810,28 @@ void readPlayerInput()
             continue;
         }
 
-        //Read input from the device controlling the player into object latches
-        player->updateLatches();
+        if (_replayPlayback) {
+            //Recorded latches replace the input device
+            pchr->latch = _replayPlayback->getLatch(i);
+        }
+        else {
+            //Read input from the device controlling the player into object latches
+            player->updateLatches();
+
+            //Press space to respawn!
+            if (keyb.is_key_down(SDLK_SPACE)
+                && (local_stats.allpladead || _currentModule->canRespawnAnyTime())
+                && _currentModule->isRespawnValid()
+                && egoboo_config_t::get().game_difficulty.getValue() < Ego::GameDifficulty::Hard
+                && !keyb.chat_mode
+                && player->getInputDevice() != nullptr)
+            {
+                pchr->latch.b[LATCHBUTTON_RESPAWN] = true;
+            }
+        }
 
-        //Press space to respawn!
-        if (keyb.is_key_down(SDLK_SPACE)
-            && (local_stats.allpladead || _currentModule->canRespawnAnyTime())
-            && _currentModule->isRespawnValid()
-            && egoboo_config_t::get().game_difficulty.getValue() < Ego::GameDifficulty::Hard
-            && !keyb.chat_mode
-            && player->getInputDevice() != nullptr)
-        {
-            pchr->latch.b[LATCHBUTTON_RESPAWN] = true;
+        if (_replayRecorder) {
+            _replayRecorder->recordLatch(i, pchr->latch);
         }
 
         // Let players respawn
@@ -826,6 +856,10 @@ void readPlayerInput()
             pchr->latch.b[LATCHBUTTON_RESPAWN] = false;
         }
    }
+
+    if (_replayRecorder) {
+        _replayRecorder->endTick();
+    }
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1074,7 +1108,11 @@ void game_load_profile_ai()
         // Load the AI script for this iobj
         std::string filePath = profile->getPathname() + "/script.txt";
 
-        load_ai_script_vfs( ps, filePath, profile.get(), profile->getAIScript() );
+        std::shared_ptr<script_info_t> script;
+        if (rv_success == load_ai_script_vfs( ps, filePath, profile.get(), script ))
+        {
+            profile->setAIScript(script);
+        }
     }
 }
 
@@ -1086,16 +1124,20 @@ void game_load_module_profiles( const std::string& modname )
     import_data.slot = -100;
     std::string folderPath = modname + "/objects";
 
+    std::vector<std::string> folderPaths;
     vfs_search_context_t* ctxt = vfs_findFirst(folderPath.c_str(), "obj", VFS_SEARCH_DIR);
     const char* filehandle = vfs_search_context_get_current(ctxt);
 
     while (NULL != ctxt && VALID_CSTR(filehandle)) {
-        ProfileSystem::get().loadOneProfile(filehandle);
+        folderPaths.push_back(filehandle);
 
         ctxt = vfs_findNext(&ctxt);
         filehandle = vfs_search_context_get_current(ctxt);
     }
     vfs_findClose(&ctxt);
+
+    // read the profiles in parallel, they are registered in the order found
+    ProfileSystem::get().loadProfiles(folderPaths);
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1162,6 +1204,10 @@ void game_quit_module()
     // stop the module
     _currentModule.reset(nullptr);
 
+    // close any replay of the module
+    _replayRecorder.reset();
+    _replayPlayback.reset();
+
     // deallocate any dynamically allocated scripting memory
     scripting_system_end();
 
@@ -1178,7 +1224,7 @@ void game_quit_module()
 }
 
 //--------------------------------------------------------------------------------------------
-bool game_begin_module(const std::shared_ptr<ModuleProfile> &module)
+bool game_begin_module(const std::shared_ptr<ModuleProfile> &module, const uint32_t seed)
 {
     /// @author BB
     /// @details all of the initialization code before the module actually starts
@@ -1190,7 +1236,20 @@ bool game_begin_module(const std::shared_ptr<ModuleProfile> &module)
     game_reset_players();
 
     // start the module
-    _currentModule = std::make_unique<GameModule>(module, time(NULL));
+    _currentModule = std::make_unique<GameModule>(module, seed);
+
+    // pick up an armed replay, recording starts with the very same module state
+    _replayPlayback = std::move(_replayPlaybackArmed);
+    _replayRecorder = std::move(_replayRecorderArmed);
+    if (_replayRecorder)
+    {
+        std::vector<std::string> importPlayers;
+        for (size_t i = 0; i < g_importList.count; ++i)
+        {
+            importPlayers.push_back(g_importList.lst[i].srcDir);
+        }
+        _replayRecorder->begin(module->getFolderName(), seed, importPlayers);
+    }
 
     //After loading, spawn all the data and initialize everything
     activate_spawn_file_vfs();           // read and implement the "spawn script" spawn.txt
@@ -1217,6 +1276,57 @@ bool game_begin_module(const std::shared_ptr<ModuleProfile> &module)
     return true;
 }
 
+//--------------------------------------------------------------------------------------------
+void game_set_replay_recorder(std::unique_ptr<Ego::ReplayRecorder> recorder)
+{
+    _replayRecorderArmed = std::move(recorder);
+}
+
+//--------------------------------------------------------------------------------------------
+void game_set_replay_playback(const std::shared_ptr<Ego::ReplayPlayback> &playback)
+{
+    _replayPlaybackArmed = playback;
+}
+
+//--------------------------------------------------------------------------------------------
+bool game_load_players(const std::list<std::string> &players)
+{
+    // blank out any existing data
+    import_list_t::init(g_importList);
+
+    // loop through the selected players and store all the valid data in the list of imported players
+    for(const std::string &loadPath : players)
+    {
+        // get a new import data pointer
+        import_element_t *import_ptr = g_importList.lst + g_importList.count;
+        g_importList.count++;
+
+        //figure out which player we are (1, 2, 3 or 4)
+        import_ptr->local_player_num = g_importList.count-1;
+
+        // set the import info
+        import_ptr->slot            = (import_ptr->local_player_num) * MAX_IMPORT_PER_PLAYER;
+        import_ptr->player          = (import_ptr->local_player_num);
+
+        strncpy( import_ptr->srcDir, loadPath.c_str(), SDL_arraysize( import_ptr->srcDir ) );
+        import_ptr->dstDir[0] = CSTR_END;
+    }
+
+    if(g_importList.count > 0) {
+
+        if(game_copy_imports(&g_importList) == rv_success) {
+            return true;
+        }
+        else {
+            // erase the data in the import folder
+            vfs_removeDirectoryAndContents( "import", VFS_TRUE );
+            return false;
+        }
+    }
+
+    return false;
+}
+
 //--------------------------------------------------------------------------------------------
 bool game_finish_module()
 {
@@ -1244,46 +1354,107 @@ bool game_finish_module()
 }
 
 //--------------------------------------------------------------------------------------------
-void let_all_characters_think()
+static void let_character_think(const std::shared_ptr<Object> &object)
 {
-    /// @author ZZ
-    /// @details This function funst the ai scripts for all eligible objects
-    for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
+    if(object->isTerminated()) {
+        return;
+    }
+
+    //Only inventory items marked as equipment has active AI scripts
+    if(object->isInsideInventory() && !object->getProfile()->isEquipment()) {
+        return;
+    }
+
+    // check for actions that must always be handled
+    bool is_cleanedup = HAS_SOME_BITS( object->ai.alert, ALERTIF_CLEANEDUP );
+    bool is_crushed   = HAS_SOME_BITS( object->ai.alert, ALERTIF_CRUSHED );
+
+    // only let dead/destroyed things think if they have beem crushed/cleanedup
+    if (object->isAlive() || is_crushed || is_cleanedup )
     {
-        if(object->isTerminated()) {
-            continue;
+        // Figure out alerts that weren't already set
+        set_alerts(object->getObjRef());
+
+        // Cleaned up characters shouldn't be alert to anything else
+        if (is_cleanedup) { 
+            object->ai.alert = ALERTIF_CLEANEDUP; 
+            /*object->ai.timer = update_wld + 1;*/ 
         }
 
-        //Only inventory items marked as equipment has active AI scripts
-        if(object->isInsideInventory() && !object->getProfile()->isEquipment()) {
-            continue;
+        // Crushed characters shouldn't be alert to anything else
+        if (is_crushed)  { 
+            object->ai.alert = ALERTIF_CRUSHED; 
+            object->ai.timer = update_wld + 1;  //Prevents IfTimeOut from triggering
         }
-        
-        // check for actions that must always be handled
-        bool is_cleanedup = HAS_SOME_BITS( object->ai.alert, ALERTIF_CLEANEDUP );
-        bool is_crushed   = HAS_SOME_BITS( object->ai.alert, ALERTIF_CRUSHED );
 
-        // only let dead/destroyed things think if they have beem crushed/cleanedup
-        if (object->isAlive() || is_crushed || is_cleanedup )
-        {
-            // Figure out alerts that weren't already set
-            set_alerts(object->getObjRef());
+        scr_run_chr_script(object.get());
+    }
+}
 
-            // Cleaned up characters shouldn't be alert to anything else
-            if (is_cleanedup) { 
-                object->ai.alert = ALERTIF_CLEANEDUP; 
-                /*object->ai.timer = update_wld + 1;*/ 
-            }
+//--------------------------------------------------------------------------------------------
+static bool can_think_concurrently(const std::shared_ptr<Object> &object)
+{
+    /// @details An object may run its script concurrently with other objects if its script only
+    ///          reads shared state, writes its own state and defers everything else to a command
+    ///          buffer (see parser_state_t::classify_parallel).
+    if(object->isTerminated()) {
+        return false;
+    }
 
-            // Crushed characters shouldn't be alert to anything else
-            if (is_crushed)  { 
-                object->ai.alert = ALERTIF_CRUSHED; 
-                object->ai.timer = update_wld + 1;  //Prevents IfTimeOut from triggering
-            }
+    const script_info_t &script = object->getProfile()->getAIScript();
+    if(!script._parallelSafe) {
+        return false;
+    }
+
+    //Mounts copy the latches of their rider
+    if(object->isMount()) {
+        return false;
+    }
+
+    //The state of objects with a hide state is read by Object::isHidden() of other objects
+    if(script._writesState && NOHIDE != object->getProfile()->getHideState()) {
+        return false;
+    }
+
+    return true;
+}
 
-            scr_run_chr_script(object.get());
+//--------------------------------------------------------------------------------------------
+void let_all_characters_think()
+{
+    /// @author ZZ
+    /// @details This function funst the ai scripts for all eligible objects.
+    ///          The scripts run in object order. Consecutive objects which can think concurrently
+    ///          (see can_think_concurrently()) form a batch, the effects they defer through
+    ///          Ego::Core::CommandBuffer::submit() are applied in object order once the batch is
+    ///          done and before the next object runs. Every other object applies its effects
+    ///          right away. This order is the same whether or not the scripts run in parallel.
+
+    // The runners keep their buffers and worker threads alive between updates.
+    static Ego::Core::OrderedTaskRunner serialRunner(0);
+    static std::unique_ptr<Ego::Core::OrderedTaskRunner> parallelRunner = nullptr;
+
+    Ego::Core::OrderedTaskRunner *runner = &serialRunner;
+    if(egoboo_config_t::get().game_parallelAIScripts_enable.getValue() && !debug_scripts)
+    {
+        if(!parallelRunner)
+        {
+            parallelRunner = std::make_unique<Ego::Core::OrderedTaskRunner>(std::max(1u, std::thread::hardware_concurrency()) - 1);
         }
+        runner = parallelRunner.get();
     }
+
+    // The iterator keeps the object list locked while the scripts run, hence objects spawned
+    // or removed by scripts are deferred until all scripts have run.
+    ObjectHandler::ObjectIterator iterator = _currentModule->getObjectHandler().iterator();
+    static std::vector<std::shared_ptr<Object>> objects;
+    objects.assign(iterator.cbegin(), iterator.cend());
+
+    // Initialize the scripting system on this thread before any worker uses it.
+    scripting_system_begin();
+
+    runner->run(objects, can_think_concurrently, let_character_think);
+    objects.clear();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -3083,7 +3254,7 @@ ObjectRef chr_get_lowest_attachment( ObjectRef ichr, bool non_item )
 
     ObjectRef original_object, object;
     original_object = object = ichr;
-    for (size_t cnt = 0; cnt < OBJECTS_MAX; cnt++)
+    for (size_t cnt = 0; cnt < _currentModule->getObjectHandler().getCapacity(); cnt++)
     {
         // check for one of the ending condiitons
         if (non_item && !_currentModule->getObjectHandler().get(object)->isitem)
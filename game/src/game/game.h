@@ -32,6 +32,7 @@
 //--------------------------------------------------------------------------------------------
 
 struct prt_bundle_t;
+namespace Ego { class ReplayRecorder; class ReplayPlayback; }
 
 
 //--------------------------------------------------------------------------------------------
@@ -268,7 +269,16 @@ void game_quit_module();
 
 /// the hook for exporting all the current players and reloading them
 bool game_finish_module();
-bool game_begin_module(const std::shared_ptr<ModuleProfile> &module);
+bool game_begin_module(const std::shared_ptr<ModuleProfile> &module, const uint32_t seed = time(NULL));
+
+/// copy the saved characters into the import folder for the next module
+bool game_load_players(const std::list<std::string> &players);
+
+/// Replays
+/// @brief Record the player input of the next module started.
+void game_set_replay_recorder(std::unique_ptr<Ego::ReplayRecorder> recorder);
+/// @brief Feed the player input of the next module started from a replay instead of the input devices.
+void game_set_replay_playback(const std::shared_ptr<Ego::ReplayPlayback> &playback);
 void game_load_module_profiles(const std::string& modname);
 void game_load_global_profiles();
 
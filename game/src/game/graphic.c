@@ -45,6 +45,7 @@
 #include "egolib/FileFormats/Globals.hpp"
 #include "game/Graphics/TextureAtlasManager.hpp"
 #include "game/Module/Passage.hpp"
+#include "egolib/Core/OrderedTaskRunner.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -72,6 +73,8 @@ Clock<ClockPolicy::NonRecursive>  gfx_make_tileList_timer("gfx.make.tileList", 5
 Clock<ClockPolicy::NonRecursive>  gfx_make_entityList_timer("gfx.make.entityList", 512);
 Clock<ClockPolicy::NonRecursive>  do_grid_lighting_timer("do.grid.lighting", 512);
 Clock<ClockPolicy::NonRecursive>  light_fans_timer("light.fans", 512);
+/// Profiling timer for uploading the mesh buffers. It also counts the Bytes uploaded.
+Clock<ClockPolicy::NonRecursive>  upload_mesh_buffers_timer("upload.mesh.buffers", 512);
 Clock<ClockPolicy::NonRecursive>  gfx_update_all_chr_instance_timer("gfx.update.all.chr.instance", 512);
 Clock<ClockPolicy::NonRecursive>  update_all_prt_instance_timer("update.all.prt.instance", 512);
 
@@ -84,12 +87,11 @@ Uint32          menu_frame_all = 0;             ///< The total number of frames
 
 gfx_config_t     gfx;
 
-float            indextoenvirox[EGO_NORMAL_COUNT];
-
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
 static gfx_error_stack_t gfx_error_stack = GFX_ERROR_STACK_INIT;
+static std::mutex gfx_error_mutex;   ///< errors may be added by the workers of gfx_update_all_chr_instance()
 static bool _ogl_initialized = false;
 
 // Interface stuff
@@ -103,6 +105,10 @@ static bool  gfx_page_clear_requested = true;
 const static float DYNALIGHT_KEEP = 0.9f;
 
 static dynalist_t _dynalist;
+static Ego::Graphics::TileList _sharedTileList;   ///< the tiles in view of any camera
+
+std::vector<dynalight_data_t> GridIllumination::_lastLights;
+LightingVector GridIllumination::_lastGlobalLighting = {0};
 
 //--------------------------------------------------------------------------------------------
 
@@ -117,6 +123,7 @@ void reinitClocks() {
 	gfx_make_entityList_timer.reinit();
 	do_grid_lighting_timer.reinit();
 	light_fans_timer.reinit();
+	upload_mesh_buffers_timer.reinit();
 	gfx_update_all_chr_instance_timer.reinit();
 	update_all_prt_instance_timer.reinit();
 
@@ -134,7 +141,7 @@ void reinitClocks() {
 
 static void _flip_pages();
 
-static gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el, dynalist_t& dyl, Camera& cam);
+static gfx_rv render_scene_init(const std::vector<std::shared_ptr<Camera>>& cameras, dynalist_t& dyl);
 static gfx_rv render_scene_mesh(Camera& cam, const Ego::Graphics::TileList& tl, const Ego::Graphics::EntityList& el);
 static gfx_rv render_scene(Camera& cam, Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el);
 
@@ -146,9 +153,19 @@ static gfx_rv render_scene(Camera& cam, Ego::Graphics::TileList& tl, Ego::Graphi
  * @param camera
  *	the camera
  */
-static gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, Camera& camera);
+static gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, const Ego::Graphics::TileList& tl, Camera& camera);
 static gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& camera);
-static gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& camera);
+static void gfx_warn_tiles_dropped();
+/**
+ * @brief
+ *  Put the tiles in the tile lists of all cameras into one tile list.
+ * @param tl
+ *  the tile list
+ * @param cameras
+ *  the cameras, their tile lists have to be up to date
+ */
+static gfx_rv gfx_make_sharedTileList(Ego::Graphics::TileList& tl, const std::vector<std::shared_ptr<Camera>>& cameras);
+static gfx_rv gfx_make_dynalist(dynalist_t& dyl, const std::vector<std::shared_ptr<Camera>>& cameras);
 
 static float draw_fps(float y);
 static float draw_help(float y);
@@ -157,7 +174,8 @@ static float draw_timer(float y);
 static float draw_game_status(float y);
 static void  draw_hud();
 
-static gfx_rv update_one_chr_instance(Object * pchr);
+static gfx_rv interpolate_one_chr_instance(Object * pchr);
+static gfx_rv update_one_chr_instance(Object * pchr, gfx_rv interpolated);
 static gfx_rv gfx_update_all_chr_instance();
 static gfx_rv gfx_update_flashing(Ego::Graphics::EntityList& el);
 
@@ -174,8 +192,16 @@ static void   gfx_init_blip_data();
 void GFX::initialize()
 {
     // Initialize SDL and initialize OpenGL.
-    GFX::initializeSDLGraphics(); ///< @todo Error handling.
-    GFX::initializeOpenGL();      ///< @todo Error handling.
+    if (!Ego::Core::System::get().isHeadless()) {
+        GFX::initializeSDLGraphics(); ///< @todo Error handling.
+        GFX::initializeOpenGL();      ///< @todo Error handling.
+    } else {
+        // A headless system has no window and no render state to set up.
+        // The game logic still loads textures and queries the renderer,
+        // so only start-up the null renderer and the texture manager.
+        Ego::Renderer::initialize();
+        TextureManager::initialize();
+    }
 
 	// Initialize the font manager.
     Ego::FontManager::initialize();
@@ -255,8 +281,10 @@ int GFX::initializeOpenGL()
 
     // set up environment mapping
     /// @todo: this isn't used anywhere
-    GL_DEBUG(glTexGeni)(GL_S, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);  // Set The Texture Generation Mode For S To Sphere Mapping (NEW)
-    GL_DEBUG(glTexGeni)(GL_T, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);  // Set The Texture Generation Mode For T To Sphere Mapping (NEW)
+    if (!Ego::Core::System::get().isHeadless()) {
+        GL_DEBUG(glTexGeni)(GL_S, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);  // Set The Texture Generation Mode For S To Sphere Mapping (NEW)
+        GL_DEBUG(glTexGeni)(GL_T, GL_TEXTURE_GEN_MODE, GL_SPHERE_MAP);  // Set The Texture Generation Mode For T To Sphere Mapping (NEW)
+    }
 
     //Initialize the motion blur buffer
     renderer.getAccumulationBuffer().setClearValue(Colour4f(0.0f, 0.0f, 0.0f, 1.0f));
@@ -288,8 +316,6 @@ void gfx_system_render_world(std::shared_ptr<Camera> camera, std::shared_ptr<Ego
 {
     gfx_error_state_t * err_tmp;
 
-    gfx_error_clear();
-
     if (!camera)
     {
         throw std::invalid_argument("nullptr == camera");
@@ -302,6 +328,9 @@ void gfx_system_render_world(std::shared_ptr<Camera> camera, std::shared_ptr<Ego
         throw std::invalid_argument("nullptr == entityList");
     }
 
+    // the particle billboards face this camera
+    update_all_prt_billboards(*camera, *entityList);
+
     Renderer3D::begin3D(*camera);
     {
 		Ego::Graphics::RenderPasses::g_background.run(*camera, *tileList, *entityList);
@@ -350,13 +379,28 @@ void gfx_system_render_world(std::shared_ptr<Camera> camera, std::shared_ptr<Ego
     }
 }
 
+//--------------------------------------------------------------------------------------------
+void gfx_system_prepare_world(const std::vector<std::shared_ptr<Camera>>& cameras)
+{
+    gfx_error_clear();
+
+    if (cameras.empty())
+    {
+        return;
+    }
+
+    // errors are reported by gfx_system_render_world()
+	ClockScope<ClockPolicy::NonRecursive> clockScope(render_scene_init_timer);
+    render_scene_init(cameras, _dynalist);
+}
+
 //--------------------------------------------------------------------------------------------
 void gfx_system_main()
 {
     /// @author ZZ
     /// @details This function does all the drawing stuff
 
-    CameraSystem::get()->renderAll(gfx_system_render_world);
+    CameraSystem::get()->renderAll(gfx_system_prepare_world, gfx_system_render_world);
 
     draw_hud();
 
@@ -400,21 +444,6 @@ void gfx_system_release_all_graphics()
     TextureManager::get().release_all();
 }
 
-//--------------------------------------------------------------------------------------------
-void gfx_system_make_enviro()
-{
-    /// @author ZZ
-    /// @details This function sets up the environment mapping table
-
-    // Find the environment map positions
-    for (size_t i = 0; i < EGO_NORMAL_COUNT; ++i)
-    {
-        float x = MD2Model::getMD2Normal(i, 0);
-        float y = MD2Model::getMD2Normal(i, 1);
-        indextoenvirox[i] = std::atan2(y, x) * Ego::Math::invTwoPi<float>();
-    }
-}
-
 //--------------------------------------------------------------------------------------------
 void gfx_system_reload_all_textures()
 {
@@ -666,7 +695,7 @@ float draw_debug(float y)
         os.str(std::string()); os << "~~FREEPRT: " << ParticleHandler::get().getFreeCount();
         y = _gameEngine->getUIManager()->drawBitmapFontString(0, y, os.str(), 0, 1.0f);
         
-        os.str(std::string()); os << "~~FREECHR: " << OBJECTS_MAX - _currentModule->getObjectHandler().getObjectCount();
+        os.str(std::string()); os << "~~FREECHR: " << _currentModule->getObjectHandler().getCapacity() - _currentModule->getObjectHandler().getObjectCount();
         y = _gameEngine->getUIManager()->drawBitmapFontString(0, y, os.str(), 0, 1.0f);
 
         os.str(std::string()); os << "~~EXPORT:  " << (_currentModule->isExportValid() ? "TRUE" : "FALSE");
@@ -833,21 +862,35 @@ void draw_mouse_cursor()
 //--------------------------------------------------------------------------------------------
 // render_scene FUNCTIONS
 //--------------------------------------------------------------------------------------------
-gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el, dynalist_t& dyl, Camera& cam)
+gfx_rv render_scene_init(const std::vector<std::shared_ptr<Camera>>& cameras, dynalist_t& dyl)
 {
     // assume the best;
     gfx_rv retval = gfx_success;
 
     {
 		ClockScope<ClockPolicy::NonRecursive> scope(gfx_make_tileList_timer);
-        // Which tiles can be displayed
-        if (gfx_error == gfx_make_tileList(tl, cam))
+        // Which tiles can be displayed by each camera
+        for (const std::shared_ptr<Camera>& camera : cameras)
+        {
+            if (gfx_error == gfx_make_tileList(*camera->getTileList(), *camera))
+            {
+                retval = gfx_error;
+            }
+        }
+    }
+
+    // The tiles in view of any camera are lit once. With a single camera, these are the tiles of that camera.
+    Ego::Graphics::TileList *tl = cameras.front()->getTileList().get();
+    if (cameras.size() > 1)
+    {
+        if (gfx_error == gfx_make_sharedTileList(_sharedTileList, cameras))
         {
             retval = gfx_error;
         }
+        tl = &_sharedTileList;
     }
 
-    auto mesh = tl.getMesh();
+    auto mesh = tl->getMesh();
     if (!mesh)
     {
 		throw Id::RuntimeErrorException(__FILE__, __LINE__, "tile list is not attached to a mesh");
@@ -855,10 +898,19 @@ gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList&
 
     {
 		ClockScope<ClockPolicy::NonRecursive> scope(gfx_make_entityList_timer);
+        // An entity list only resets the flags of its own entities,
+        // hence all lists are reset before any list is filled.
+        for (const std::shared_ptr<Camera>& camera : cameras)
+        {
+            camera->getEntityList()->reset();
+        }
         // determine which objects are visible
-        if (gfx_error == gfx_make_entityList(el, cam))
+        for (const std::shared_ptr<Camera>& camera : cameras)
         {
-            retval = gfx_error;
+            if (gfx_error == gfx_make_entityList(*camera->getEntityList(), *camera->getTileList(), *camera))
+            {
+                retval = gfx_error;
+            }
         }
     }
 
@@ -868,7 +920,7 @@ gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList&
     {
 		ClockScope<ClockPolicy::NonRecursive> scope(do_grid_lighting_timer);
         // figure out the terrain lighting
-		if (gfx_error == GridIllumination::do_grid_lighting(tl, dyl, cam))
+		if (gfx_error == GridIllumination::do_grid_lighting(*tl, dyl, cameras))
         {
             retval = gfx_error;
         }
@@ -877,7 +929,13 @@ gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList&
     {
 		ClockScope<ClockPolicy::NonRecursive> scope(light_fans_timer);
         // apply the lighting to the characters and particles
-		GridIllumination::light_fans(tl);
+		GridIllumination::light_fans(*tl);
+    }
+
+    {
+		ClockScope<ClockPolicy::NonRecursive> scope(upload_mesh_buffers_timer);
+        // upload the modified mesh colours
+		upload_mesh_buffers_timer.count(mesh->_tmem._buffers.upload(mesh->_tmem));
     }
 
     {
@@ -891,19 +949,26 @@ gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList&
 
     {
 		ClockScope<ClockPolicy::NonRecursive> scope(update_all_prt_instance_timer);
-        // make sure the particles are ready to draw
-        if (gfx_error == update_all_prt_instance(cam))
+        // make sure the particles are ready to draw,
+        // the billboards are turned towards the other cameras when they render
+        if (gfx_error == update_all_prt_instance(*cameras.front()))
         {
             retval = gfx_error;
         }
     }
 
     // do the flashing for kursed objects
-    if (gfx_error == gfx_update_flashing(el))
+    for (const std::shared_ptr<Camera>& camera : cameras)
     {
-        retval = gfx_error;
+        if (gfx_error == gfx_update_flashing(*camera->getEntityList()))
+        {
+            retval = gfx_error;
+        }
     }
 
+    // do not keep the mesh alive
+    _sharedTileList.setMesh(nullptr);
+
     return retval;
 }
 
@@ -975,13 +1040,6 @@ gfx_rv render_scene(Camera& cam, Ego::Graphics::TileList& tl, Ego::Graphics::Ent
 {
     // assume the best
     gfx_rv retval = gfx_success;
-    {
-		ClockScope<ClockPolicy::NonRecursive> clockScope(render_scene_init_timer);
-        if (gfx_error == render_scene_init(tl, el, _dynalist, cam))
-        {
-            retval = gfx_error;
-        }
-    }
     {
 		ClockScope<ClockPolicy::NonRecursive> clockScope(render_scene_mesh_timer);
         {
@@ -1128,6 +1186,8 @@ egolib_rv gfx_error_add(const char * file, const char * function, int line, int
 {
     gfx_error_state_t * pstate;
 
+    std::lock_guard<std::mutex> lock(gfx_error_mutex);
+
     // too many errors?
     if (gfx_error_stack.count >= GFX_ERROR_MAX) return rv_fail;
 
@@ -1152,6 +1212,8 @@ gfx_error_state_t * gfx_error_pop()
 {
     gfx_error_state_t * retval;
 
+    std::lock_guard<std::mutex> lock(gfx_error_mutex);
+
     if (0 == gfx_error_stack.count || gfx_error_stack.count >= GFX_ERROR_MAX) return NULL;
 
     gfx_error_stack.count--;
@@ -1163,41 +1225,12 @@ gfx_error_state_t * gfx_error_pop()
 //--------------------------------------------------------------------------------------------
 void gfx_error_clear()
 {
+    std::lock_guard<std::mutex> lock(gfx_error_mutex);
     gfx_error_stack.count = 0;
 }
 
 //--------------------------------------------------------------------------------------------
 // grid_lighting FUNCTIONS
-//--------------------------------------------------------------------------------------------
-float GridIllumination::grid_lighting_test(const ego_mesh_t& mesh, GLXvector3f pos, float& low_diff, float& hgh_diff)
-{
-    const lighting_cache_t *cache_list[4];
-
-    int ix = std::floor(pos[XX] / Info<float>::Grid::Size());
-    int iy = std::floor(pos[YY] / Info<float>::Grid::Size());
-
-    Index1D fan[4];
-    fan[0] = mesh.getTileIndex(Index2D(ix, iy));
-    fan[1] = mesh.getTileIndex(Index2D(ix + 1, iy));
-    fan[2] = mesh.getTileIndex(Index2D(ix, iy + 1));
-    fan[3] = mesh.getTileIndex(Index2D(ix + 1, iy + 1));
-
-    for (size_t cnt = 0; cnt < 4; cnt++)
-    {
-        cache_list[cnt] = nullptr;
-		if (fan[cnt] == Index1D::Invalid) {
-			cache_list[cnt] = nullptr;
-		} else {
-			cache_list[cnt] = &(mesh.getTileInfo(fan[cnt])._cache);
-		}
-    }
-
-    float u = pos[XX] / Info<float>::Grid::Size() - ix;
-    float v = pos[YY] / Info<float>::Grid::Size() - iy;
-
-    return lighting_cache_test(cache_list, u, v, low_diff, hgh_diff);
-}
-
 //--------------------------------------------------------------------------------------------
 float GridIllumination::light_corners(ego_mesh_t& mesh, ego_tile_info_t& tile, bool reflective, float mesh_lighting_keep)
 {
@@ -1221,6 +1254,7 @@ float GridIllumination::light_corners(ego_mesh_t& mesh, ego_tile_info_t& tile, b
 	light_cache_t& d2_cache = tile._vertexLightingCache._d2_cache;
 
 	float max_delta = 0.0f;
+	bool settled = true;
 	for (size_t corner = 0; corner < 4; corner++)
 	{
 		GLXvector3f& pnrm = ncache[corner];
@@ -1241,6 +1275,13 @@ float GridIllumination::light_corners(ego_mesh_t& mesh, ego_tile_info_t& tile, b
 			light_old = plight;
 			plight = light_old * mesh_lighting_keep + light_new * (1.0f - mesh_lighting_keep);
 
+			// the lighting settled once the remaining difference is not visible
+			if (std::abs(light_new - plight) < 0.5f)
+			{
+				plight = light_new;
+			}
+			settled = false;
+
 			// measure the actual delta
 			delta = std::abs(light_old - plight);
 
@@ -1266,8 +1307,8 @@ float GridIllumination::light_corners(ego_mesh_t& mesh, ego_tile_info_t& tile, b
 		max_delta = std::max(max_delta, pdelta1);
 	}
 
-	// un-mark the lcache
-	tile._lightingCache.setNeedUpdate(false);
+	// un-mark the lcache once the lighting settled
+	tile._lightingCache.setNeedUpdate(!settled);
 	tile._lightingCache.setLastFrame(game_frame_all);
 
 	return max_delta;
@@ -1303,60 +1344,6 @@ bool GridIllumination::grid_lighting_interpolate(const ego_mesh_t& mesh, lightin
     return lighting_cache_t::lighting_cache_interpolate(dst, cache_list, u, v);
 }
 
-void GridIllumination::test_one_corner(const ego_mesh_t& mesh, GLXvector3f pos, float& pdelta)
-{
-	// interpolate the lighting for the given corner of the mesh
-	float low_delta, hgh_delta;
-	pdelta = grid_lighting_test(mesh, pos, low_delta, hgh_delta);
-
-	// determine the weighting
-	float hgh_wt, low_wt;
-	hgh_wt = (pos[ZZ] - mesh._tmem._bbox.getMin()[kZ]) / (mesh._tmem._bbox.getMax()[kZ] - mesh._tmem._bbox.getMin()[kZ]);
-	hgh_wt = Ego::Math::constrain(hgh_wt, 0.0f, 1.0f);
-	low_wt = 1.0f - hgh_wt;
-
-	pdelta = low_wt * low_delta + hgh_wt * hgh_delta;
-}
-
-bool GridIllumination::test_corners(const ego_mesh_t& mesh, ego_tile_info_t& tile, float threshold)
-{
-	if (threshold < 0.0f) threshold = 0.0f;
-
-	// get the lighting and per-vertex lighting cache for this tile
-	light_cache_t& lcache = tile._lightingCache._contents;
-	light_cache_t& d1_cache = tile._vertexLightingCache._d1_cache;
-
-	bool retval = false;
-	for (size_t corner = 0; corner < 4; corner++)
-	{
-		float& pdelta = d1_cache[corner];
-		float& plight = lcache[corner];
-		GLXvector3f& ppos = mesh._tmem._plst[tile._vrtstart + corner];
-
-		float delta;
-		test_one_corner(mesh, ppos, delta);
-
-		if (0.0f == plight)
-		{
-			delta = 10.0f;
-		}
-		else
-		{
-			delta /= plight;
-			delta = Ego::Math::constrain(delta, 0.0f, 10.0f);
-		}
-
-		pdelta += delta;
-
-		if (pdelta > threshold)
-		{
-			retval = true;
-		}
-	}
-
-	return retval;
-}
-
 void GridIllumination::light_one_corner(ego_mesh_t& mesh, ego_tile_info_t& tile, const bool reflective, const Vector3f& pos, const Vector3f& nrm, float& plight)
 {
 	// interpolate the lighting for the given corner of the mesh
@@ -1507,57 +1494,13 @@ void _flip_pages()
 //--------------------------------------------------------------------------------------------
 // LIGHTING FUNCTIONS
 //--------------------------------------------------------------------------------------------
-gfx_rv GridIllumination::light_fans_throttle_update(ego_mesh_t * mesh, ego_tile_info_t& tile, const Index1D& tileIndex, float threshold)
-{
-    bool       retval = false;
-
-    if (!mesh)
-    {
-		throw Id::RuntimeErrorException(__FILE__, __LINE__, "nullptr == mesh");
-    }
-	tile_mem_t& tmem = mesh->_tmem;
-
-#if defined(CLIP_LIGHT_FANS) && !defined(CLIP_ALL_LIGHT_FANS)
-
-    // visible fans based on the update "need"
-    retval = test_corners(*mesh, tile, threshold);
-
-    // update every 4 fans even if there is no need
-    if (!retval)
-    {
-        // use a kind of checkerboard pattern
-        int ix = tileIndex.getI() % tmem.getInfo().getTileCountX();
-        int iy = tileIndex.getI() / tmem.getInfo().getTileCountX();
-        if (0 != (((ix ^ iy) + game_frame_all) & 0x03))
-        {
-            retval = true;
-        }
-    }
-
-#else
-    retval = true;
-#endif
-
-    return retval ? gfx_success : gfx_fail;
-}
-
 //--------------------------------------------------------------------------------------------
 void GridIllumination::light_fans_update_lcache(Ego::Graphics::TileList& tl)
 {
-	const int frame_skip = 1 << 2; // 1 << 2 ~ 2^2 ~ 4. 
-#if defined(CLIP_ALL_LIGHT_FANS)
-	const int frame_mask = frame_skip - 1; // 4 - 1 = 3 = binary(11).
-#endif
-
-	/// @note we are measuring the change in the intensity at the corner of a tile (the "delta") as
-	/// a fraction of the current intensity. This is because your eye is much more sensitive to
-	/// intensity differences when the intensity is low.
-	///
-	/// @note it is normally assumed that 64 colors of gray can make a smoothly colored black and white picture
-	/// which means that the threshold could be set as low as 1/64 = 0.015625.
-	const float delta_threshold = 0.05f;
-	
-	bool is_valid;
+	/// @note The corner lighting is blended with its previous value, hence a tile is relit in every frame
+	/// until its lighting settled. Otherwise a tile is only relit if a light affecting its grid changed
+	/// (see update_dirty()) or if it entered the render list.
+	const float local_mesh_lighting_keep = 0.9f;
 
 	auto mesh = tl.getMesh();
 	if (!mesh)
@@ -1565,20 +1508,7 @@ void GridIllumination::light_fans_update_lcache(Ego::Graphics::TileList& tl)
 		throw Id::RuntimeErrorException(__FILE__, __LINE__, "tile list not attached to a mesh");
 	}
 
-#if defined(CLIP_ALL_LIGHT_FANS)
-	// Update all visible fans once every 4 frames.
-	if (0 != (game_frame_all & frame_mask)) {
-		return;
-}
-#endif
-
-#if !defined(CLIP_LIGHT_FANS)
-    // update only every frame
-	float local_mesh_lighting_keep = 0.9f;
-#else
-    // update only every 4 frames
-	float local_mesh_lighting_keep = std::pow(0.9f, frame_skip);
-#endif
+	size_t relit = 0;
 
     // cache the grid lighting
     for (size_t entry = 0; entry < tl._all.size; entry++)
@@ -1589,31 +1519,8 @@ void GridIllumination::light_fans_update_lcache(Ego::Graphics::TileList& tl)
         // grab a pointer to the tile
 		ego_tile_info_t& ptile = mesh->getTileInfo(fan);
 
-        // Test to see whether the lcache was already updated
-        // - ptile->_lcache_frame < 0 means that the cache value is invalid.
-        // - ptile->_lcache_frame is updated inside ego_mesh_light_corners()
-#if defined(CLIP_LIGHT_FANS)
-        // clip the updated on each individual tile
-        is_valid = ptile._lightingCache.isValid(game_frame_all, frame_skip);
-#else
-        // let the function clip all tile updates
-        is_valid = ptile._lightingCache.isValid(game_frame_all);
-#endif
-	if (is_valid)
-        {
-            continue;
-        }
-
-        // If no update was requested ...
-        if (!ptile._lightingCache.getNeedUpdate())
-        {
-			// ... do we need one?
-            gfx_rv light_fans_rv = light_fans_throttle_update(mesh.get(), ptile, fan, delta_threshold);
-            ptile._lightingCache.setNeedUpdate(gfx_success == light_fans_rv);
-        }
-
-		// If there is still no need for an update, go to the next tile.
-		if (!ptile._lightingCache.getNeedUpdate()) {
+		// If there is no need for an update or if the lcache was already updated in this frame, go to the next tile.
+		if (!ptile._lightingCache.getNeedUpdate() || ptile._lightingCache.isValid(game_frame_all)) {
 			continue;
 		}
 
@@ -1623,15 +1530,13 @@ void GridIllumination::light_fans_update_lcache(Ego::Graphics::TileList& tl)
         // light the corners of this tile
         float delta = GridIllumination::light_corners(*mesh, ptile, reflective, local_mesh_lighting_keep);
 
-#if defined(CLIP_LIGHT_FANS)
-        // Use the actual maximum change in the intensity at a tile corner to
-        // signal whether we need to calculate the next stage.
-        ptile._vertexLightingCache.setNeedUpdate(delta > delta_threshold);
-#else
         // make sure that ego_mesh_light_corners() did not return an "error value"
         ptile._vertexLightingCache.setNeedUpdate(delta > 0.0f);
-#endif
+
+		relit++;
     }
+
+	light_fans_timer.count(relit);
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1762,6 +1667,9 @@ void GridIllumination::light_fans_update_clst(Ego::Graphics::TileList& tl)
 				= INV_FF<float>() * Ego::Math::constrain(light, 0.0f, 255.0f);
         }
 
+        // the colours have to be uploaded again
+        ptmem._buffers.invalidateColours(ptile._vrtstart, numberOfVertices);
+
         // clear out the deltas
         ptile._vertexLightingCache._d1_cache.fill(0.0f);
         ptile._vertexLightingCache._d2_cache.fill(0.0f);
@@ -1849,20 +1757,14 @@ void dynalist_t::init(dynalist_t& self) {
 }
 
 //--------------------------------------------------------------------------------------------
-gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
+gfx_rv gfx_make_dynalist(dynalist_t& dyl, const std::vector<std::shared_ptr<Camera>>& cameras)
 {
     /// @author ZZ
     /// @details This function figures out which particles are visible, and it sets up dynamic
-    ///    lighting
-
-    size_t    tnc;
-	Vector3f  vdist;
-
-    float         distance = 0.0f;
-    dynalight_data_t * plight = NULL;
+    ///    lighting. The lights nearest to any of the cameras are kept.
 
-    float         distance_max = 0.0f;
-    dynalight_data_t * plight_max = NULL;
+    // the lights which are on, kept to avoid re-allocating every frame
+    static std::vector<dynalight_data_t> candidates;
 
     // HACK: if dynalist is ahead of the game by 30 frames or more, reset and force an update
     if ((Uint32)(dyl.frame + 30) >= game_frame_all)
@@ -1876,6 +1778,7 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
 
     // Don't really make a list, just set to visible or not
     dynalist_t::init(dyl);
+    candidates.clear();
 
     for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
     {
@@ -1886,60 +1789,28 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
         // is the light on?
         if (!pprt_dyna.on || 0.0f == pprt_dyna.level) continue;
 
-        // reset the dynalight pointer
-        plight = NULL;
+        dynalight_data_t light;
+        light.pos = particle->getPosition();
+        light.level = pprt_dyna.level;
+        light.falloff = pprt_dyna.falloff;
 
-        // find the distance to the camera
-        vdist = particle->getPosition() - cam.getTrackPosition();
-        distance = vdist.length_2();
-
-        // insert the dynalight
-        if (dyl.size < gfx.dynalist_max && dyl.size < TOTAL_MAX_DYNA)
+        // find the distance to the nearest camera
+        light.distance = std::numeric_limits<float>::max();
+        for (const std::shared_ptr<Camera>& camera : cameras)
         {
-            if (0 == dyl.size)
-            {
-                distance_max = distance;
-            }
-            else
-            {
-                distance_max = std::max(distance_max, distance);
-            }
-
-            // grab a new light from the list
-            plight = dyl.lst + dyl.size;
-            dyl.size++;
-
-            if (distance_max == distance)
-            {
-                plight_max = plight;
-            }
+            light.distance = std::min(light.distance, (light.pos - camera->getTrackPosition()).length_2());
         }
-        else if (distance < distance_max)
-        {
-            plight = plight_max;
 
-            // find the new maximum distance
-            distance_max = dyl.lst[0].distance;
-            plight_max = dyl.lst + 0;
-            for (tnc = 1; tnc < gfx.dynalist_max; tnc++)
-            {
-                if (dyl.lst[tnc].distance > distance_max)
-                {
-                    plight_max = dyl.lst + tnc;
-                    distance_max = plight->distance;
-                }
-            }
-        }
-
-        if (NULL != plight)
-        {
-            plight->distance = distance;
-            plight->pos = particle->getPosition();
-            plight->level = pprt_dyna.level;
-            plight->falloff = pprt_dyna.falloff;
-        }
+        candidates.push_back(light);
     }
 
+    // keep the nearest lights
+    const size_t count = std::min(candidates.size(), std::min<size_t>(gfx.dynalist_max, TOTAL_MAX_DYNA));
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                      [](const dynalight_data_t& x, const dynalight_data_t& y) { return x.distance < y.distance; });
+    std::copy(candidates.begin(), candidates.begin() + count, dyl.lst);
+    dyl.size = count;
+
     // the list is updated, so update the frame count
     dyl.frame = game_frame_all;
 
@@ -1947,7 +1818,7 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
 }
 
 //--------------------------------------------------------------------------------------------
-gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_t& dyl, Camera& cam)
+gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_t& dyl, const std::vector<std::shared_ptr<Camera>>& cameras)
 {
     /// @author ZZ
     /// @details Do all tile lighting, dynamic and global
@@ -1963,9 +1834,17 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
 
     size_t               reg_count = 0;
     dynalight_registry_t reg[TOTAL_MAX_DYNA];
+    size_t               relit = 0;
+
+    // the lights affecting the grids, kept to avoid re-allocating every frame
+    static std::vector<dynalight_data_t> lights;
+    lights.clear();
+
+    // the lights standing in for all dynalights with flat lighting, one per camera
+    static std::vector<dynalight_data_t> fake_dynalights;
+    fake_dynalights.clear();
 
     ego_frect_t mesh_bound, light_bound;
-    dynalight_data_t fake_dynalight;
 
 	auto mesh = tl.getMesh();
     if (!mesh)
@@ -2002,14 +1881,11 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
     reg_count = 0;
 
     // refresh the dynamic light list
-    gfx_make_dynalist(dyl, cam);
+    gfx_make_dynalist(dyl, cameras);
 
     // assume no dynamic lighting
     needs_dynalight = false;
 
-    // assume no "extra help" for systems with only flat lighting
-    dynalight_data_t::init(fake_dynalight);
-
     // initialize the light_bound
     light_bound.xmin = tmem._edge_x;
     light_bound.xmax = 0;
@@ -2028,7 +1904,9 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
 
             if (pdyna.falloff <= 0.0f || 0.0f == pdyna.level) continue;
 
-            radius = std::sqrt(pdyna.falloff * 765.0f * 0.5f);
+            lights.push_back(pdyna);
+
+            radius = dynalight_data_t::getRadius(pdyna);
 
             // find the intersection with the frustum boundary
             ftmp.xmin = std::max(pdyna.pos[kX] - radius, mesh_bound.xmin);
@@ -2058,39 +1936,49 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
     }
     else
     {
-        float dyna_weight = 0.0f;
-        float dyna_weight_sum = 0.0f;
-
-        // evaluate all the lights at the camera position
-        for (cnt = 0; cnt < dyl.size; cnt++)
+        // one light per camera represents the sum of all dynalights seen from that camera
+        for (size_t camera = 0; camera < cameras.size() && reg_count < TOTAL_MAX_DYNA; camera++)
         {
-			dynalight_data_t& pdyna = dyl.lst[cnt];
+            const Vector3f& center = cameras[camera]->getCenter();
 
-            // evaluate the intensity at the camera
-			Vector3f diff = pdyna.pos - cam.getCenter() - Vector3f(0.0f, 0.0f, 90.0f); // evaluate at the "head height" of a character
+            float dyna_weight = 0.0f;
+            float dyna_weight_sum = 0.0f;
 
-            dyna_weight = std::abs(dyna_lighting_intensity(&pdyna, diff));
+            dynalight_data_t fake_dynalight;
+            dynalight_data_t::init(fake_dynalight);
 
-            fake_dynalight.distance += dyna_weight * pdyna.distance;
-            fake_dynalight.falloff += dyna_weight * pdyna.falloff;
-            fake_dynalight.level += dyna_weight * pdyna.level;
-            fake_dynalight.pos += (pdyna.pos - cam.getCenter()) * dyna_weight;
+            // evaluate all the lights at the camera position
+            for (cnt = 0; cnt < dyl.size; cnt++)
+            {
+                dynalight_data_t& pdyna = dyl.lst[cnt];
 
-            dyna_weight_sum += dyna_weight;
-        }
+                // evaluate the intensity at the camera
+                Vector3f diff = pdyna.pos - center - Vector3f(0.0f, 0.0f, 90.0f); // evaluate at the "head height" of a character
+
+                dyna_weight = std::abs(dyna_lighting_intensity(&pdyna, diff));
+
+                fake_dynalight.distance += dyna_weight * pdyna.distance;
+                fake_dynalight.falloff += dyna_weight * pdyna.falloff;
+                fake_dynalight.level += dyna_weight * pdyna.level;
+                fake_dynalight.pos += (pdyna.pos - center) * dyna_weight;
+
+                dyna_weight_sum += dyna_weight;
+            }
+
+            if (dyna_weight_sum <= 0.0f) continue;
 
-        // use a single dynalight to represent the sum of all dynalights
-        if (dyna_weight_sum > 0.0f)
-        {
             float radius;
             ego_frect_t ftmp;
 
             fake_dynalight.distance /= dyna_weight_sum;
             fake_dynalight.falloff /= dyna_weight_sum;
             fake_dynalight.level /= dyna_weight_sum;
-            fake_dynalight.pos = (fake_dynalight.pos * (1.0/dyna_weight_sum)) + cam.getCenter();
+            fake_dynalight.pos = (fake_dynalight.pos * (1.0/dyna_weight_sum)) + center;
+
+            lights.push_back(fake_dynalight);
+            fake_dynalights.push_back(fake_dynalight);
 
-            radius = std::sqrt(fake_dynalight.falloff * 765.0f * 0.5f);
+            radius = dynalight_data_t::getRadius(fake_dynalight);
 
             // find the intersection with the frustum boundary
             ftmp.xmin = std::max(fake_dynalight.pos[kX] - radius, mesh_bound.xmin);
@@ -2098,12 +1986,15 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
             ftmp.ymin = std::max(fake_dynalight.pos[kY] - radius, mesh_bound.ymin);
             ftmp.ymax = std::min(fake_dynalight.pos[kY] + radius, mesh_bound.ymax);
 
-            // make a fake light bound
-            light_bound = ftmp;
+            // extend the light bound by the fake light bound
+            light_bound.xmin = std::min(light_bound.xmin, ftmp.xmin);
+            light_bound.xmax = std::max(light_bound.xmax, ftmp.xmax);
+            light_bound.ymin = std::min(light_bound.ymin, ftmp.ymin);
+            light_bound.ymax = std::max(light_bound.ymax, ftmp.ymax);
 
-            // register the fake dynalight
+            // register the fake dynalight, negative references index the fake dynalights
             reg[reg_count].bound = ftmp;
-            reg[reg_count].reference = -1;
+            reg[reg_count].reference = -(int)fake_dynalights.size();
             reg_count++;
 
             // let the downstream calc know we are coming
@@ -2114,14 +2005,15 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
     // sum up the lighting from global sources
     sum_global_lighting(global_lighting);
 
+    // find the grids affected by a change of the lighting
+    update_dirty(*mesh, lights, global_lighting);
+
     // make the grids update their lighting every 4 frames
     local_keep = 0.0f; //std::pow(DYNALIGHT_KEEP, 4);
 
     // Add to base light level in normal mode
     for (size_t entry = 0; entry < tl._all.size; entry++)
     {
-        bool resist_lighting_calculation = true;
-
         int                dynalight_count = 0;
 
         // grab each grid box in the "frustum"
@@ -2133,16 +2025,13 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
         // do not update this more than once a frame
         if (ptile._cache_frame >= 0 && (uint32_t)ptile._cache_frame >= game_frame_all) continue;
 
+        // Only grids affected by a change of the lighting are recalculated,
+        // all other grids keep their lighting.
+        if (!ptile._cache_dirty) continue;
+
         ix = fan.getI() % pinfo.getTileCountX();
         iy = fan.getI() / pinfo.getTileCountX();
 
-        // Resist the lighting calculation?
-        // This is a speedup for lighting calculations so that
-        // not every light-tile calculation is done every single frame
-        resist_lighting_calculation = (0 != (((ix + iy) ^ game_frame_all) & 0x03));
-
-        if (resist_lighting_calculation) continue;
-
         // this is not a "bad" grid box, so grab the lighting info
         lighting_cache_t& pcache_old = ptile._cache;
 
@@ -2193,7 +2082,7 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
                         tnc = reg[cnt].reference;
                         if (tnc < 0)
                         {
-                            pdyna = &fake_dynalight;
+                            pdyna = &fake_dynalights[-tnc - 1];
                         }
                         else
                         {
@@ -2224,55 +2113,176 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
         pcache_old.max_light();
 
         ptile._cache_frame = game_frame_all;
+        ptile._cache_dirty = false;
+        relit++;
     }
 
+    do_grid_lighting_timer.count(relit);
+
     return gfx_success;
 }
+
+void GridIllumination::mark_dirty(ego_mesh_t& mesh, const dynalight_data_t& light)
+{
+    const Ego::MeshInfo& info = mesh._info;
+    const float radius = dynalight_data_t::getRadius(light);
+
+    // the grids whose rectangle intersects the bound of the light
+    // and the tiles interpolating their corner lighting from these grids
+    const float maxX = static_cast<float>(info.getTileCountX() - 1),
+                maxY = static_cast<float>(info.getTileCountY() - 1);
+    const int ixmin = static_cast<int>(Ego::Math::constrain(std::floor((light.pos[kX] - radius) / Info<float>::Grid::Size() - 0.5f) - 1.0f, 0.0f, maxX)),
+              ixmax = static_cast<int>(Ego::Math::constrain(std::ceil((light.pos[kX] + radius) / Info<float>::Grid::Size() + 0.5f), 0.0f, maxX)),
+              iymin = static_cast<int>(Ego::Math::constrain(std::floor((light.pos[kY] - radius) / Info<float>::Grid::Size() - 0.5f) - 1.0f, 0.0f, maxY)),
+              iymax = static_cast<int>(Ego::Math::constrain(std::ceil((light.pos[kY] + radius) / Info<float>::Grid::Size() + 0.5f), 0.0f, maxY));
+
+    for (int iy = iymin; iy <= iymax; ++iy)
+    {
+        for (int ix = ixmin; ix <= ixmax; ++ix)
+        {
+            ego_tile_info_t& tile = mesh._tmem.get(Index2D(ix, iy));
+            tile._cache_dirty = true;
+            tile._lightingCache.setNeedUpdate(true);
+        }
+    }
+}
+
+void GridIllumination::update_dirty(ego_mesh_t& mesh, const std::vector<dynalight_data_t>& lights, const LightingVector& globalLighting)
+{
+    // a change of the global lighting affects all grids
+    if (globalLighting != _lastGlobalLighting)
+    {
+        for (ego_tile_info_t& tile : mesh._tmem.getAllTiles())
+        {
+            tile._cache_dirty = true;
+            tile._lightingCache.setNeedUpdate(true);
+        }
+        _lastGlobalLighting = globalLighting;
+    }
+
+    // a light which moved or changed is both a light which disappeared and a light which appeared
+    for (const dynalight_data_t& lastLight : _lastLights)
+    {
+        if (std::none_of(lights.begin(), lights.end(), [&lastLight](const dynalight_data_t& light) { return dynalight_data_t::equals(light, lastLight); }))
+        {
+            mark_dirty(mesh, lastLight);
+        }
+    }
+    for (const dynalight_data_t& light : lights)
+    {
+        if (std::none_of(_lastLights.begin(), _lastLights.end(), [&light](const dynalight_data_t& lastLight) { return dynalight_data_t::equals(light, lastLight); }))
+        {
+            mark_dirty(mesh, light);
+        }
+    }
+    _lastLights = lights;
+}
+//--------------------------------------------------------------------------------------------
+void gfx_warn_tiles_dropped()
+{
+    // only once, it would flood the log every frame
+    static bool warned = false;
+    if (!warned)
+    {
+        Log::get().warn("%s:%d: the tile list is full, the tiles farthest from the cameras are not drawn\n", __FILE__, __LINE__);
+        warned = true;
+    }
+}
+
 //--------------------------------------------------------------------------------------------
 gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& cam)
 {
-	// @a true if clipping is enabled, @a false otherwise.
-	static const bool clippingEnabled = true;
+    // reset the renderlist
+    if (gfx_error == tl.reset())
+    {
+        return gfx_error;
+    }
+
+    // cull the blocks and the tiles of the mesh against the view frustum
+    static std::vector<size_t> blocks;
+    static std::vector<Index1D> tiles;
+    blocks.clear();
+    tiles.clear();
+    auto mesh = tl.getMesh();
+    mesh->_tmem._blocks.cull(mesh->_tmem, cam.getFrustum(), blocks, tiles);
 
-    // Because the main loop of the program will always flip the
-    // page before rendering the 1st frame of the actual game,
-    // game_frame_all will always start at 1
-    if (1 != (game_frame_all & 3))
+    // the tile list holds a limited number of tiles, keep the tiles nearest to the camera
+    if (tiles.size() > Ego::Graphics::renderlist_lst_t::CAPACITY)
     {
-        return gfx_success;
+        const size_t tileCountX = mesh->_info.getTileCountX();
+        const Vector3f& center = cam.getCenter();
+        auto distance = [tileCountX, &center](const Index1D& index)
+        {
+            const float dx = (index.getI() % tileCountX + 0.5f) * Info<float>::Grid::Size() - center[kX],
+                        dy = (index.getI() / tileCountX + 0.5f) * Info<float>::Grid::Size() - center[kY];
+            return dx * dx + dy * dy;
+        };
+        std::nth_element(tiles.begin(), tiles.begin() + Ego::Graphics::renderlist_lst_t::CAPACITY, tiles.end(),
+                         [&distance](const Index1D& x, const Index1D& y) { return distance(x) < distance(y); });
+        gfx_warn_tiles_dropped();
+        tiles.resize(Ego::Graphics::renderlist_lst_t::CAPACITY);
     }
 
-    // reset the renderlist
+    for (size_t block : blocks)
+    {
+        tl.addBlock(block);
+    }
+    for (const Index1D& tile : tiles)
+    {
+        if (gfx_error == tl.add(tile, cam))
+        {
+            return gfx_error;
+        }
+    }
+
+    return gfx_success;
+}
+
+//--------------------------------------------------------------------------------------------
+gfx_rv gfx_make_sharedTileList(Ego::Graphics::TileList& tl, const std::vector<std::shared_ptr<Camera>>& cameras)
+{
+    tl.setMesh(cameras.front()->getTileList()->getMesh());
     if (gfx_error == tl.reset())
     {
         return gfx_error;
     }
 
-    // get the tiles in the center of the view (TODO: calculate actual tile view from camera frustrum)
-	int startX, startY, endX, endY;
-	if (clippingEnabled)
-	{
-		static const float offset = 10;
-		float centerX = cam.getTrackPosition()[kX] / Info<float>::Grid::Size();
-		float centerY = cam.getTrackPosition()[kY] / Info<float>::Grid::Size();
-		startX = Ego::Math::constrain<int>(centerX - offset, 0, _currentModule->getMeshPointer()->_info.getTileCountX());
-		startY = Ego::Math::constrain<int>(centerY - offset, 0, _currentModule->getMeshPointer()->_info.getTileCountY());
-		endX = Ego::Math::constrain<int>(centerX + offset, 0, _currentModule->getMeshPointer()->_info.getTileCountX());
-		endY = Ego::Math::constrain<int>(centerY + offset, 0, _currentModule->getMeshPointer()->_info.getTileCountY());
-	}
-	else
-	{
-		startX = 0;
-		startY = 0;
-		endX = _currentModule->getMeshPointer()->_info.getTileCountX();
-		endY = _currentModule->getMeshPointer()->_info.getTileCountY();
-	}
-    for(size_t x = startX; x < endX; ++x) {
-        for(size_t y = startY; y < endY; ++y) {
-            if (gfx_error == tl.add(x + y * _currentModule->getMeshPointer()->_info.getTileCountX(), cam))
-            {
-                return gfx_error;
-            }        
+    // the tiles in view of each camera with their distances to that camera
+    struct candidate_t
+    {
+        Index1D index;
+        float distance;
+        Camera *camera;
+    };
+    static std::vector<candidate_t> candidates;
+    candidates.clear();
+    for (const std::shared_ptr<Camera>& camera : cameras)
+    {
+        const Ego::Graphics::TileList& cameraTileList = *camera->getTileList();
+        for (size_t i = 0; i < cameraTileList._all.size; ++i)
+        {
+            candidates.push_back({cameraTileList._all.lst[i]._index, cameraTileList._all.lst[i]._distance, camera.get()});
+        }
+    }
+
+    // the tile list holds a limited number of tiles, keep the tiles nearest to any camera
+    std::sort(candidates.begin(), candidates.end(),
+              [](const candidate_t& x, const candidate_t& y) { return x.distance < y.distance; });
+
+    for (const candidate_t& candidate : candidates)
+    {
+        // in view of a nearer camera
+        if (tl.inRenderList(candidate.index)) continue;
+
+        if (tl._all.size >= Ego::Graphics::renderlist_lst_t::CAPACITY)
+        {
+            gfx_warn_tiles_dropped();
+            break;
+        }
+
+        if (gfx_error == tl.add(candidate.index, *candidate.camera))
+        {
+            return gfx_error;
         }
     }
 
@@ -2280,9 +2290,9 @@ gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& cam)
 }
 
 //--------------------------------------------------------------------------------------------
-gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, Camera& cam)
+gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, const Ego::Graphics::TileList& tl, Camera& cam)
 {
-	if (el.getSize() >= Ego::Graphics::EntityList::CAPACITY)
+	if (el.getSize() >= Ego::Graphics::EntityList::getCapacity())
     {
         gfx_error_add(__FILE__, __FUNCTION__, __LINE__, 0, "invalid entity list size");
         return gfx_error;
@@ -2291,36 +2301,72 @@ gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, Camera& cam)
     // Remove all entities from the entity list.
     el.reset();
 
-    // collide the characters with the frustum
-    std::vector<std::shared_ptr<Object>> visibleObjects = 
-        _currentModule->getObjectHandler().findObjects(
-            cam.getCenter()[kX], 
-            cam.getCenter()[kY], 
-			Info<float>::Grid::Size() * 10,  //@todo: use camera view size here instead
-            true);
+    // nothing is in view
+    if (0 == tl.getRenderBlockCount())
+    {
+        return gfx_success;
+    }
+
+    // the characters standing on the blocks in view
+    static std::vector<std::shared_ptr<Object>> visibleObjects;
+    visibleObjects.clear();
+    _currentModule->getObjectHandler().findObjects(tl.getRenderArea(), visibleObjects, true);
 
-    for(const std::shared_ptr<Object> object : visibleObjects) {
+    for(const std::shared_ptr<Object>& object : visibleObjects) {
         if (!el.test_obj(*object.get())) continue;
 
+        if (!tl.inRenderBlocks(object->getAABB2D())) continue;
+
         if (gfx_error == el.add_obj_raw(*object.get()))
         {
             return gfx_error;
         }
     }
 
-    // collide the particles with the frustum
-    for(const std::shared_ptr<Ego::Particle> particle : ParticleHandler::get().iterator())
+    // collide the particles with the blocks in view
+    static std::vector<std::shared_ptr<Ego::Particle>> candidates;
+    static std::vector<float> x, y, z, radius;
+    static std::vector<uint32_t> visible;
+    candidates.clear();
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+    for(const std::shared_ptr<Ego::Particle>& particle : ParticleHandler::get().iterator())
     {
         if (!el.test_prt(particle)) continue;
 
-        if(Ego::Math::Relation::outside != cam.getFrustum().intersects(Sphere3f(particle->getPosition(), particle->bump_real.size_big), false))
+        const float size = particle->bump_real.size_big;
+        const AABB2f bounds(Vector2f(particle->getPosX() - size, particle->getPosY() - size),
+                            Vector2f(particle->getPosX() + size, particle->getPosY() + size));
+        if (!tl.inRenderBlocks(bounds)) continue;
+
+        candidates.push_back(particle);
+        x.push_back(particle->getPosX());
+        y.push_back(particle->getPosY());
+        z.push_back(particle->getPosZ());
+        radius.push_back(size);
+    }
+
+    // collide the remaining particles with the frustum in one batch
+    visible.resize((candidates.size() + 31) / 32);
+    cam.getFrustum().intersects_spheres(x.data(), y.data(), z.data(), radius.data(), candidates.size(), false, visible.data());
+
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+        if (0 == (visible[i / 32] & (1u << (i % 32)))) continue;
+
+        // the list might have been filled up in the meantime
+        if (!el.test_prt(candidates[i])) continue;
+
+        if (gfx_error == el.add_prt_raw(candidates[i]))
         {
-            if (gfx_error == el.add_prt_raw(particle))
-            {
-                return gfx_error;
-            }
+            candidates.clear();
+            return gfx_error;
         }
     }
+    // do not keep the particles alive
+    candidates.clear();
 
     return gfx_success;
 }
@@ -2383,7 +2429,7 @@ gfx_rv gfx_update_flashing(Ego::Graphics::EntityList& el)
 {
     gfx_rv retval;
 
-    if (el.getSize() >= Ego::Graphics::EntityList::CAPACITY)
+    if (el.getSize() >= Ego::Graphics::EntityList::getCapacity())
     {
         gfx_error_add(__FILE__, __FUNCTION__, __LINE__, 0, "invalid entity list size");
         return gfx_error;
@@ -2429,43 +2475,95 @@ gfx_rv gfx_update_flashing(Ego::Graphics::EntityList& el)
 //--------------------------------------------------------------------------------------------
 gfx_rv gfx_update_all_chr_instance()
 {
-    gfx_rv retval;
-    gfx_rv tmp_rv;
-
-    // assume the best
-    retval = gfx_success;
-
-    for (const std::shared_ptr<Object> &pchr : _currentModule->getObjectHandler().iterator())
+    // Gather the objects to update. The iterator keeps the object list locked until the update is done.
+    ObjectHandler::ObjectIterator iterator = _currentModule->getObjectHandler().iterator();
+    auto mesh = _currentModule->getMeshPointer();
+    static std::vector<std::shared_ptr<Object>> objects;
+    for (const std::shared_ptr<Object> &pchr : iterator)
     {
         //Dont do terminated characters
         if (pchr->isTerminated()) {
             continue;
         }
 
-		auto mesh = _currentModule->getMeshPointer();
         if (!mesh->grid_is_valid(pchr->getTile())) continue;
 
-        tmp_rv = update_one_chr_instance(pchr.get());
+        objects.push_back(pchr);
+    }
+
+    // Interpolate the vertices of all instances. This only touches the instance itself,
+    // hence the instances are interpolated concurrently.
+    static std::vector<gfx_rv> interpolated;
+    interpolated.assign(objects.size(), gfx_success);
+    if (!egoboo_config_t::get().graphic_parallelInstanceUpdate_enable.getValue())
+    {
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            interpolated[i] = interpolate_one_chr_instance(objects[i].get());
+        }
+    }
+    else
+    {
+        // The runner keeps its worker threads alive between frames.
+        static std::unique_ptr<Ego::Core::OrderedTaskRunner> runner = nullptr;
+        if (!runner)
+        {
+            runner = std::make_unique<Ego::Core::OrderedTaskRunner>(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        }
+
+        static std::vector<size_t> indices;
+        indices.resize(objects.size());
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            indices[i] = i;
+        }
+        runner->run(indices, [](size_t) { return true; },
+                    [](size_t i) { interpolated[i] = interpolate_one_chr_instance(objects[i].get()); });
+    }
+
+    // Update the matrices, the lighting and the collision volumes in order on this thread.
+    // These read and write the holders of held items and overlays.
+    bool error = false;
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        gfx_rv tmp_rv = update_one_chr_instance(objects[i].get(), interpolated[i]);
 
         // deal with return values
         if (gfx_error == tmp_rv)
         {
-            retval = gfx_error;
+            error = true;
         }
         else if (gfx_success == tmp_rv)
         {
             // the instance has changed, refresh the collision bound
-            pchr->getObjectPhysics().updateCollisionSize(true);
+            objects[i]->getObjectPhysics().updateCollisionSize(true);
         }
     }
+    objects.clear();
 
-    return retval;
+    return error ? gfx_error : gfx_success;
 }
 
 //--------------------------------------------------------------------------------------------
 // chr_instance_t FUNCTIONS
 //--------------------------------------------------------------------------------------------
-gfx_rv update_one_chr_instance(Object *pchr)
+gfx_rv interpolate_one_chr_instance(Object *pchr)
+{
+    /// @details Writes the vertex list, the vertex cache and the bounding box of the instance
+    ///          and reads the MD2 model of the instance, nothing else.
+    chr_instance_t& pinst = pchr->inst;
+
+    // only update once per frame
+    if (pinst.update_frame >= 0 && (Uint32)pinst.update_frame >= game_frame_all)
+    {
+        return gfx_success;
+    }
+
+    // make sure that the vertices are interpolated
+    return chr_instance_t::update_vertices(pinst, -1, -1, true);
+}
+
+gfx_rv update_one_chr_instance(Object *pchr, gfx_rv interpolated)
 {
     if (!pchr || pchr->isTerminated())
     {
@@ -2480,8 +2578,8 @@ gfx_rv update_one_chr_instance(Object *pchr)
         return gfx_success;
     }
 
-    // make sure that the vertices are interpolated
-    gfx_rv retval = chr_instance_t::update_vertices(pinst, -1, -1, true);
+    // the vertices were interpolated by interpolate_one_chr_instance()
+    gfx_rv retval = interpolated;
     if (gfx_error == retval)
     {
         return gfx_error;
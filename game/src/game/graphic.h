@@ -157,7 +157,8 @@ extern Uint32          menu_frame_all;             ///< The total number of fram
 
 extern gfx_config_t gfx;
 
-extern float           indextoenvirox[EGO_NORMAL_COUNT];                    ///< Environment map
+/// Profiling timer for rendering the mesh. It also counts the draw calls of the mesh tiles.
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> render_scene_mesh_timer;
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -228,12 +229,14 @@ void gfx_system_main();
 /// the stored state of the texture and its surface, the backing OpenGL texture needs to be
 /// reconstructed.
 void gfx_system_reload_all_textures();
-void gfx_system_make_enviro();
 void gfx_system_init_all_graphics();
 void gfx_system_release_all_graphics();
 void gfx_system_load_assets();
 
-// the render engine callback
+// the render engine callbacks
+/// Prepare everything shared by the cameras rendering this frame: cull the mesh and the entities for each camera,
+/// light the union of the visible tiles and update the visible instances once.
+void gfx_system_prepare_world(const std::vector<std::shared_ptr<Camera>>& cameras);
 void gfx_system_render_world(const std::shared_ptr<Camera> camera, std::shared_ptr<Ego::Graphics::TileList> tl, std::shared_ptr<Ego::Graphics::EntityList> el);
 
 void gfx_request_clear_screen();
@@ -271,15 +274,19 @@ struct GridIllumination {
 private:
     static float grid_get_mix(float u0, float u, float v0, float v);
     static float ego_mesh_interpolate_vertex(const ego_tile_info_t& info, const GLXvector3f& position);
-	static void test_one_corner(const ego_mesh_t& mesh, GLXvector3f pos, float& pdelta);
-	static bool test_corners(const ego_mesh_t& mesh, ego_tile_info_t& tile, float threshold);
 	static void light_one_corner(ego_mesh_t& mesh, ego_tile_info_t& tile, const bool reflective, const Vector3f& pos, const Vector3f& nrm, float& plight);
-	static float grid_lighting_test(const ego_mesh_t& mesh, GLXvector3f pos, float& low_diff, float& hgh_diff);
 	static void light_fans_update_clst(Ego::Graphics::TileList& tl);
-	static gfx_rv light_fans_throttle_update(ego_mesh_t * mesh, ego_tile_info_t& tile, const Index1D& tileIndex, float threshold);
 	static void light_fans_update_lcache(Ego::Graphics::TileList& tl);
+	/// @brief Mark the grids within the reach of a light as dirty.
+	static void mark_dirty(ego_mesh_t& mesh, const dynalight_data_t& light);
+	/// @brief Mark the grids affected by lights which appeared, disappeared, moved or changed as dirty.
+	static void update_dirty(ego_mesh_t& mesh, const std::vector<dynalight_data_t>& lights, const LightingVector& globalLighting);
+	/// The lights of the last call to update_dirty().
+	static std::vector<dynalight_data_t> _lastLights;
+	/// The global lighting of the last call to update_dirty().
+	static LightingVector _lastGlobalLighting;
 public:
-	static gfx_rv do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_t& dyl, Camera& cam);
+	static gfx_rv do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_t& dyl, const std::vector<std::shared_ptr<Camera>>& cameras);
 	static void light_fans(Ego::Graphics::TileList& tl);
 	static float light_corners(ego_mesh_t& mesh, ego_tile_info_t& tile, bool reflective, float mesh_lighting_keep);
 	static bool grid_lighting_interpolate(const ego_mesh_t& mesh, lighting_cache_t& dst, const Vector2f& pos);
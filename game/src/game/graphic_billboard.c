@@ -99,17 +99,19 @@ std::shared_ptr<Billboard> BillboardSystem::makeBillboard(Time::Seconds lifetime
     auto billboard = std::make_shared<Billboard>(Time::now<Time::Unit::Ticks>() + lifetime_secs * TICKS_PER_SEC, texture, size);
     billboard->_tint = tint;
 
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
     if (HAS_SOME_BITS(options, Billboard::Flags::RandomPosition))
     {
         // make a random offset from the character
-        billboard->_offset = Vector3f(Random::nextFloat() * 2 - 1, Random::nextFloat() * 2 - 1, Random::nextFloat() * 2 - 1)
+        billboard->_offset = Vector3f(unit(_offsetGenerator), unit(_offsetGenerator), unit(_offsetGenerator))
             * (Info<float>::Grid::Size() / 5.0f);
     }
 
     if (HAS_SOME_BITS(options, Billboard::Flags::RandomVelocity))
     {
         // make the text fly away in a random direction
-        billboard->_offset_add += Vector3f(Random::nextFloat() * 2 - 1, Random::nextFloat() * 2 - 1, Random::nextFloat() * 2 - 1)
+        billboard->_offset_add += Vector3f(unit(_offsetGenerator), unit(_offsetGenerator), unit(_offsetGenerator))
             * (2.0f * Info<float>::Grid::Size() / lifetime_secs / GameEngine::GAME_TARGET_UPS);
     }
 
@@ -148,7 +150,8 @@ BillboardSystem *BillboardSystem::singleton = nullptr;
 
 BillboardSystem::BillboardSystem() :
     _billboardList(), 
-    vertexBuffer(4, Ego::GraphicsUtilities::get<Ego::VertexFormat::P3FT2F>()) {
+    vertexBuffer(4, Ego::GraphicsUtilities::get<Ego::VertexFormat::P3FT2F>()),
+    _offsetGenerator() {
 }
 
 BillboardSystem::~BillboardSystem() {
@@ -288,10 +291,15 @@ std::shared_ptr<Billboard> BillboardSystem::makeBillboard(ObjectRef obj_ref, con
         return nullptr;
     }
 
+    // Nobody looks at the text in headless mode, do not render it.
+    if (Ego::Core::System::get().isHeadless()) {
+        return nullptr;
+    }
+
     // Pre-render the text.
     std::shared_ptr<Ego::Texture> tex;
     try {
-        tex = std::make_shared<Ego::OpenGL::Texture>();
+        tex = Ego::Renderer::get().createTexture();
     } catch (...) {
         return nullptr;
     }
@@ -154,6 +154,9 @@ private:
     };
     // A vertex buffer used by the billboard system.
     Ego::VertexBuffer vertexBuffer;
+    // The random offsets and velocities of billboards are purely cosmetic and must not advance
+    // the game's random number generator: headless replays make no billboards at all.
+    std::mt19937 _offsetGenerator;
 
 private:
 
@@ -64,7 +64,7 @@ gfx_rv MadRenderer::render_enviro( Camera& cam, const std::shared_ptr<Object>& p
 
 	if (nullptr == ptex)
 	{
-		ptex = pinst.texture;
+		ptex = pinst.texture ? pinst.texture.get_ptr() : nullptr;
 	}
 
     float uoffset = pinst.uoffset - cam.getTurnZ_turns();
@@ -205,7 +205,7 @@ gfx_rv MadRenderer::render_tex(Camera& camera, const std::shared_ptr<Object>& pc
     const std::shared_ptr<MD2Model> &pmd2 = pchr->getProfile()->getModel()->getMD2();
 
     // To make life easier
-    std::shared_ptr<const Ego::Texture> ptex = pinst.texture;
+    std::shared_ptr<const Ego::Texture> ptex = pinst.texture ? pinst.texture.get_ptr() : nullptr;
 
     float uoffset = pinst.uoffset * INV_FFFF<float>();
     float voffset = pinst.voffset * INV_FFFF<float>();
@@ -969,79 +969,21 @@ gfx_rv chr_instance_t::needs_update(chr_instance_t& self, int vmin, int vmax, bo
     return (!(*verts_match) || !( *frames_match )) ? gfx_success : gfx_fail;
 }
 
-void chr_instance_t::interpolate_vertices_raw( GLvertex dst_ary[], const std::vector<MD2_Vertex> &lst_ary, const std::vector<MD2_Vertex> &nxt_ary, int vmin, int vmax, float flip )
+void chr_instance_t::interpolate_vertices_raw( GLvertex dst_ary[], const MD2_VertexArrays &lst_ary, const MD2_VertexArrays &nxt_ary, int vmin, int vmax, float flip )
 {
     /// raw indicates no bounds checking, so be careful
 
-    int i;
-
-    GLvertex     * dst;
-
     if ( 0.0f == flip )
     {
-        for ( i = vmin; i <= vmax; i++ )
-        {
-            dst     = dst_ary + i;
-            const MD2_Vertex &srcLast = lst_ary[i];
-
-			dst->pos[XX] = srcLast.pos[kX];
-			dst->pos[YY] = srcLast.pos[kY];
-			dst->pos[ZZ] = srcLast.pos[kZ];
-            dst->pos[WW] = 1.0f;
-
-			dst->nrm[XX] = srcLast.nrm[kX];
-			dst->nrm[YY] = srcLast.nrm[kY];
-			dst->nrm[ZZ] = srcLast.nrm[kZ];
-
-            dst->env[XX] = indextoenvirox[srcLast.normal];
-            dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
-        }
+        MD2_VertexArrays::interpolate(dst_ary, lst_ary, lst_ary, vmin, vmax + 1, 0.0f);
     }
     else if ( 1.0f == flip )
     {
-        for ( i = vmin; i <= vmax; i++ )
-        {
-            dst     = dst_ary + i;
-            const MD2_Vertex &srcNext = nxt_ary[i];
-
-			dst->pos[XX] = srcNext.pos[kX];
-			dst->pos[YY] = srcNext.pos[kY];
-			dst->pos[ZZ] = srcNext.pos[kZ];
-            dst->pos[WW] = 1.0f;
-
-            dst->nrm[XX] = srcNext.nrm[kX];
-            dst->nrm[YY] = srcNext.nrm[kY];
-            dst->nrm[ZZ] = srcNext.nrm[kZ];
-
-            dst->env[XX] = indextoenvirox[srcNext.normal];
-            dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
-        }
+        MD2_VertexArrays::interpolate(dst_ary, nxt_ary, nxt_ary, vmin, vmax + 1, 0.0f);
     }
     else
     {
-        Uint16 vrta_lst, vrta_nxt;
-
-        for ( i = vmin; i <= vmax; i++ )
-        {
-            dst     = dst_ary + i;
-            const MD2_Vertex &srcLast = lst_ary[i];
-            const MD2_Vertex &srcNext = nxt_ary[i];
-
-            dst->pos[XX] = srcLast.pos[kX] + ( srcNext.pos[kX] - srcLast.pos[kX] ) * flip;
-            dst->pos[YY] = srcLast.pos[kY] + ( srcNext.pos[kY] - srcLast.pos[kY] ) * flip;
-            dst->pos[ZZ] = srcLast.pos[kZ] + ( srcNext.pos[kZ] - srcLast.pos[kZ] ) * flip;
-            dst->pos[WW] = 1.0f;
-
-            dst->nrm[XX] = srcLast.nrm[kX] + ( srcNext.nrm[kX] - srcLast.nrm[kX] ) * flip;
-            dst->nrm[YY] = srcLast.nrm[kY] + ( srcNext.nrm[kY] - srcLast.nrm[kY] ) * flip;
-            dst->nrm[ZZ] = srcLast.nrm[kZ] + ( srcNext.nrm[kZ] - srcLast.nrm[kZ] ) * flip;
-
-            vrta_lst = srcLast.normal;
-            vrta_nxt = srcNext.normal;
-
-            dst->env[XX] = indextoenvirox[vrta_lst] + ( indextoenvirox[vrta_nxt] - indextoenvirox[vrta_lst] ) * flip;
-            dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
-        }
+        MD2_VertexArrays::interpolate(dst_ary, lst_ary, nxt_ary, vmin, vmax + 1, flip);
     }
 }
 
@@ -1158,13 +1100,13 @@ gfx_rv chr_instance_t::update_vertices(chr_instance_t& self, int vmin, int vmax,
     // interpolate the 1st dirty region
     if ( vdirty1_min >= 0 && vdirty1_max >= 0 )
     {
-		chr_instance_t::interpolate_vertices_raw(self.vrt_lst, lastFrame.vertexList, nextFrame.vertexList, vdirty1_min, vdirty1_max, loc_flip);
+		chr_instance_t::interpolate_vertices_raw(self.vrt_lst, lastFrame.vertices, nextFrame.vertices, vdirty1_min, vdirty1_max, loc_flip);
     }
 
     // interpolate the 2nd dirty region
     if ( vdirty2_min >= 0 && vdirty2_max >= 0 )
     {
-		chr_instance_t::interpolate_vertices_raw(self.vrt_lst, lastFrame.vertexList, nextFrame.vertexList, vdirty2_min, vdirty2_max, loc_flip);
+		chr_instance_t::interpolate_vertices_raw(self.vrt_lst, lastFrame.vertices, nextFrame.vertices, vdirty2_min, vdirty2_max, loc_flip);
     }
 
     // update the saved parameters
@@ -1549,7 +1491,7 @@ chr_instance_t::chr_instance_t() :
 
     colorshift(),
 
-    texture(nullptr),
+    texture(),
     uoffset(0),
     voffset(0),
 
@@ -1867,8 +1809,8 @@ float chr_instance_t::get_remaining_flip(chr_instance_t& self)
 
 gfx_rv chr_instance_t::set_texture(chr_instance_t& self, const Ego::DeferredTexture& itex)
 {
-	// get the texture
-	self.texture = itex.get_ptr();
+	// the texture is streamed in, resolve it when drawing
+	self.texture = itex;
 
 	return gfx_success;
 }
@@ -357,7 +357,7 @@ struct chr_instance_t
     colorshift_t     colorshift;
 
     // texture info
-    std::shared_ptr<const Ego::Texture> texture;  ///< The texture of the character's skin
+    Ego::DeferredTexture texture;                 ///< The texture of the character's skin
     SFP8_T uoffset;                               ///< For moving textures (8.8 fixed point)
     SFP8_T voffset;                               ///< For moving textures (8.8 fixed point)
 
@@ -445,7 +445,7 @@ private:
 	static gfx_rv needs_update(chr_instance_t& self, int vmin, int vmax, bool *verts_match, bool *frames_match);
 	static gfx_rv set_frame(chr_instance_t& self, int frame);
 	static void clear_cache(chr_instance_t& self);
-	static void interpolate_vertices_raw(GLvertex dst_ary[], const std::vector<MD2_Vertex> &lst_ary, const std::vector<MD2_Vertex> &nxt_ary, int vmin, int vmax, float flip);
+	static void interpolate_vertices_raw(GLvertex dst_ary[], const MD2_VertexArrays &lst_ary, const MD2_VertexArrays &nxt_ary, int vmin, int vmax, float flip);
 };
 
 //--------------------------------------------------------------------------------------------
@@ -80,6 +80,7 @@ void prt_set_texture_params(const std::shared_ptr<const Ego::Texture>& texture,
 //--------------------------------------------------------------------------------------------
 
 Uint32 instance_update = std::numeric_limits<Uint32>::max();
+static uint32_t instance_camera = std::numeric_limits<uint32_t>::max();   ///< the ID of the camera the billboards were last calculated for
 
 //--------------------------------------------------------------------------------------------
 static gfx_rv prt_instance_update(Camera& camera, const ParticleRef particle, Uint8 trans, bool do_lighting);
@@ -495,6 +496,7 @@ gfx_rv update_all_prt_instance(Camera& camera)
     // only one update per frame
     if (instance_update == update_wld) return gfx_success;
     instance_update = update_wld;
+    instance_camera = camera.getID();
 
     // assume the best
     gfx_rv retval = gfx_success;
@@ -526,6 +528,32 @@ gfx_rv update_all_prt_instance(Camera& camera)
     return retval;
 }
 
+gfx_rv update_all_prt_billboards(Camera& camera, const Ego::Graphics::EntityList& el)
+{
+    // the billboards already face this camera
+    if (instance_camera == camera.getID()) return gfx_success;
+    instance_camera = camera.getID();
+
+    // assume the best
+    gfx_rv retval = gfx_success;
+
+    for (size_t i = 0, n = el.getSize(); i < n; ++i)
+    {
+        const ParticleRef iprt = el.get(i).iprt;
+        if (ParticleRef::Invalid == iprt) continue;
+
+        const std::shared_ptr<Ego::Particle>& particle = ParticleHandler::get()[iprt];
+        if (!particle || particle->isTerminated() || !particle->inst.valid) continue;
+
+        if (gfx_error == prt_instance_t::update_vertices(particle->inst, camera, particle.get()))
+        {
+            retval = gfx_error;
+        }
+    }
+
+    return retval;
+}
+
 gfx_rv prt_instance_t::update_vertices(prt_instance_t& inst, Camera& camera, Ego::Particle *pprt)
 {
     inst.valid = false;
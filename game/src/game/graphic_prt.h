@@ -168,4 +168,8 @@ gfx_rv render_one_prt_ref(const ParticleRef iprt);
 void render_all_prt_bbox();
 void render_all_prt_attachment();
 gfx_rv update_all_prt_instance(Camera& cam);
+/// Turn the billboards of the particles in an entity list towards a camera. The lighting of the
+/// instances is kept, it is the same for all cameras. Nothing is done if update_all_prt_instance()
+/// or this function last calculated the billboards for that camera.
+gfx_rv update_all_prt_billboards(Camera& cam, const Ego::Graphics::EntityList& el);
 
@@ -540,3 +540,14 @@ void dynalight_data_t::init(dynalight_data_t& self)
 	self.level = 0.0f;
 	self.pos = Vector3f::zero();
 }
+
+bool dynalight_data_t::equals(const dynalight_data_t& x, const dynalight_data_t& y)
+{
+	return x.pos == y.pos && x.level == y.level && x.falloff == y.falloff;
+}
+
+float dynalight_data_t::getRadius(const dynalight_data_t& self)
+{
+	// see dyna_lighting_intensity(), the lighting is zero at y^2 = r^2 * 2 / 765 / falloff = 1
+	return std::sqrt(self.falloff * 765.0f * 0.5f);
+}
@@ -127,6 +127,10 @@ struct dynalight_data_t
     float    falloff;       ///< Light radius
 
 	static void init(dynalight_data_t& self);
+	/// @brief Get if two lights light the same area with the same intensity, the distance to the camera is ignored.
+	static bool equals(const dynalight_data_t& x, const dynalight_data_t& y);
+	/// @brief Get the radius beyond which a light does not contribute to the lighting.
+	static float getRadius(const dynalight_data_t& self);
 };
 
 //--------------------------------------------------------------------------------------------
@@ -96,6 +96,125 @@ void tile_mem_t::computeVertexIndices(const tile_dictionary_t& dict)
 
 //--------------------------------------------------------------------------------------------
 
+mesh_buffers_t::mesh_buffers_t()
+	: _vertices(), _colours(), _indices(), _tileIndices() {
+}
+
+void mesh_buffers_t::invalidateColours(size_t vertex, size_t numberOfVertices) {
+	if (!_colours) {
+		return;
+	}
+	_colours->invalidate(vertex * sizeof(GLXvector3f), numberOfVertices * sizeof(GLXvector3f));
+}
+
+void mesh_buffers_t::create(const tile_mem_t& tmem) {
+	static const Ego::VertexDescriptor vertexDescriptor({
+		Ego::VertexElementDescriptor(0, Ego::VertexElementDescriptor::Syntax::F3, Ego::VertexElementDescriptor::Semantics::Position),
+		Ego::VertexElementDescriptor(3 * sizeof(float), Ego::VertexElementDescriptor::Syntax::F2, Ego::VertexElementDescriptor::Semantics::Texture)
+	});
+	static const Ego::VertexDescriptor colourDescriptor({
+		Ego::VertexElementDescriptor(0, Ego::VertexElementDescriptor::Syntax::F3, Ego::VertexElementDescriptor::Semantics::Colour)
+	});
+
+	const size_t numberOfVertices = tmem.getInfo().getVertexCount();
+
+	// Interleave the positions and the texture coordinates.
+	_vertices = std::make_unique<Ego::VertexBuffer>(numberOfVertices, vertexDescriptor);
+	{
+		Ego::VertexBufferScopedLock lock(*_vertices);
+		float *vertex = lock.get<float>();
+		for (size_t i = 0; i < numberOfVertices; ++i, vertex += 5) {
+			vertex[0] = tmem._plst[i][XX];
+			vertex[1] = tmem._plst[i][YY];
+			vertex[2] = tmem._plst[i][ZZ];
+			vertex[3] = tmem._tlst[i][SS];
+			vertex[4] = tmem._tlst[i][TT];
+		}
+	}
+
+	// The colours are copied by upload().
+	_colours = std::make_unique<Ego::VertexBuffer>(numberOfVertices, colourDescriptor);
+
+	// Turn the fans of all tiles into triangles.
+	std::vector<uint32_t> indices;
+	_tileIndices.assign(tmem.getInfo().getTileCount(), std::make_pair(0, 0));
+	for (Index1D i = 0; i < tmem.getInfo().getTileCount(); ++i) {
+		const ego_tile_info_t& tile = tmem.get(i);
+		const size_t first = indices.size();
+		const tile_definition_t *pdef = tile_dict.get(tile._type);
+		if (nullptr != pdef) {
+			const uint32_t vrtstart = tile._vrtstart;
+			for (size_t cnt = 0, entry = 0; cnt < pdef->command_count; cnt++) {
+				const uint8_t numEntries = pdef->command_entries[cnt];
+				for (size_t j = 2; j < numEntries; ++j) {
+					indices.push_back(vrtstart + pdef->command_verts[entry]);
+					indices.push_back(vrtstart + pdef->command_verts[entry + j - 1]);
+					indices.push_back(vrtstart + pdef->command_verts[entry + j]);
+				}
+				entry += numEntries;
+			}
+		}
+		_tileIndices[i.getI()] = std::make_pair(first, indices.size() - first);
+	}
+	_indices = std::make_unique<Ego::IndexBuffer>(indices.size(), Ego::IndexDescriptor(Ego::IndexDescriptor::Syntax::U32));
+	{
+		Ego::BufferScopedLock lock(*_indices);
+		std::copy(indices.begin(), indices.end(), lock.get<uint32_t>());
+	}
+}
+
+size_t mesh_buffers_t::upload(const tile_mem_t& tmem) {
+	if (!_vertices) {
+		create(tmem);
+	}
+
+	// Copy the modified colours.
+	{
+		Ego::VertexBufferScopedLock lock(*_colours);
+		char *colours = lock.get<char>();
+		const char *clst = reinterpret_cast<const char *>(tmem._clst.get());
+		for (const auto& range : _colours->getInvalidRanges()) {
+			std::copy(clst + range.offset, clst + range.offset + range.size, colours + range.offset);
+		}
+	}
+
+	auto& renderer = Ego::Renderer::get();
+	size_t uploaded = 0;
+	uploaded += renderer.upload(*_vertices);
+	uploaded += renderer.upload(*_colours);
+	uploaded += renderer.upload(*_indices);
+	return uploaded;
+}
+
+//--------------------------------------------------------------------------------------------
+
+/// The height above the tiles of a block within which entities are in view with the block.
+static const float BLOCK_HEADROOM = 4.0f * Info<float>::Grid::Size();
+
+/// Get the bounding box of a tile.
+static AABB3f get_tile_box(const tile_mem_t& tmem, const Index1D& index)
+{
+	const ego_tile_info_t& tile = tmem.get(index);
+	if (!tile._oct.isEmpty()) {
+		return tile._oct.toAABB();
+	}
+	// A tile without geometry, use its footprint at the bottom of the mesh.
+	const float x = (index.getI() % tmem.getInfo().getTileCountX()) * Info<float>::Grid::Size(),
+		        y = (index.getI() / tmem.getInfo().getTileCountX()) * Info<float>::Grid::Size(),
+		        z = tmem._bbox.getMin()[kZ];
+	return AABB3f(Vector3f(x, y, z), Vector3f(x + Info<float>::Grid::Size(), y + Info<float>::Grid::Size(), z));
+}
+
+void mesh_blocks_t::build(const tile_mem_t& tmem) {
+	Ego::MeshBlocks::build(tmem.getInfo(), [&tmem](const Index1D& index) { return get_tile_box(tmem, index); }, BLOCK_HEADROOM);
+}
+
+void mesh_blocks_t::cull(const tile_mem_t& tmem, const Ego::Graphics::Frustum& frustum, std::vector<size_t>& blocks, std::vector<Index1D>& tiles) const {
+	Ego::MeshBlocks::cull(tmem.getInfo(), [&tmem](const Index1D& index) { return get_tile_box(tmem, index); }, frustum, blocks, tiles);
+}
+
+//--------------------------------------------------------------------------------------------
+
 std::shared_ptr<ego_mesh_t> MeshLoader::convert(const map_t& source) const
 {
     // Create a mesh.
@@ -270,6 +389,9 @@ void ego_mesh_t::make_bbox()
         // Add the bounds of the tile to the bounds of the mesh.
         _tmem._bbox.join(poct.toAABB());
     }
+
+    // Build the bounding boxes of the blocks from the bounds of the tiles.
+    _tmem._blocks.build(_tmem);
 }
 
 //--------------------------------------------------------------------------------------------
@@ -615,7 +737,7 @@ ego_tile_info_t::ego_tile_info_t() :
 	_lightingCache(),
 	_vertexLightingCache(),
     _oct(),
-	_base_fx(0), _pass_fx(0), _a(0), _l(0), _cache_frame(-1), _twist(TWIST_FLAT)
+	_base_fx(0), _pass_fx(0), _a(0), _l(0), _cache_frame(-1), _cache_dirty(true), _twist(TWIST_FLAT)
 {
     //ctor
 }
@@ -840,6 +962,36 @@ bool ego_mesh_t::tile_has_bits( const Index2D& i, const BIT_FIELD bits ) const
     return HAS_SOME_BITS(fx, bits);
 }
 
+mesh_path_grid_t::mesh_path_grid_t(const std::shared_ptr<const ego_mesh_t>& mesh)
+	: _mesh(mesh) {
+}
+
+int mesh_path_grid_t::getTileCountX() const {
+	return static_cast<int>(_mesh->_info.getTileCountX());
+}
+
+int mesh_path_grid_t::getTileCountY() const {
+	return static_cast<int>(_mesh->_info.getTileCountY());
+}
+
+bool mesh_path_grid_t::isStopped(int x, int y, uint32_t stoppedBy) const {
+	return _mesh->tile_has_bits(Index2D(x, y), stoppedBy);
+}
+
+bool mesh_path_grid_t::isWalkable(int32_t tile, uint32_t stoppedBy) const {
+	// Do not walk into pits, walls or impassable tiles.
+	const ego_tile_info_t& ptile = _mesh->getTileInfo(Index1D(tile));
+	return !ptile.isFanOff() && !HAS_SOME_BITS(ptile.getFX(), stoppedBy);
+}
+
+std::shared_ptr<const void> mesh_path_grid_t::getOwner() const {
+	return _mesh;
+}
+
+uint32_t mesh_path_grid_t::getRevision() const {
+	return _mesh->getFXRevision();
+}
+
 bool ego_mesh_t::grid_is_valid(const Index1D& i) const
 {
 	g_meshStats.boundTests++;
@@ -910,6 +1062,7 @@ bool ego_mesh_t::clear_fx( const Index1D& i, const BIT_FIELD flags )
 
     if (_tmem.get(i).removeFX(flags)) {
         _fxlists.dirty = true;
+        _fxRevision++;
         return true;
     } else {
         return false;
@@ -931,6 +1084,7 @@ bool ego_mesh_t::add_fx(const Index1D& i, const BIT_FIELD flags)
     if ( retval )
     {
         _fxlists.dirty = true;
+        _fxRevision++;
     }
 
     return retval;
@@ -1259,7 +1413,7 @@ BIT_FIELD ego_mesh_t::hit_wall(const Vector3f& pos, const float radius, const BI
 }
 
 ego_mesh_t::ego_mesh_t(const Ego::MeshInfo& mesh_info)
-	: _info(mesh_info), _tmem(mesh_info), _fxlists(mesh_info) {
+	: _info(mesh_info), _tmem(mesh_info), _fxlists(mesh_info), _fxRevision(0) {
 }
 
 ego_mesh_t::~ego_mesh_t() {
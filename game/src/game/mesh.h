@@ -24,6 +24,10 @@
 #include "game/egoboo.h"
 #include "game/lighting.h"
 #include "egolib/Mesh/Info.hpp"
+#include "egolib/Mesh/Blocks.hpp"
+#include "egolib/AI/PathGrid.hpp"
+#include "egolib/Graphics/VertexBuffer.hpp"
+#include "egolib/Graphics/IndexBuffer.hpp"
 
 //--------------------------------------------------------------------------------------------
 // external types
@@ -245,6 +249,7 @@ public:
 	uint8_t            _a, _l;                 ///< the raw mesh lighting... pretty much ignored
 	lighting_cache_t _cache;                   ///< the per-grid lighting info
 	int              _cache_frame;             ///< the last frame in which the cache was calculated
+	bool             _cache_dirty;             ///< the cache has to be recalculated because a light affecting it changed
 
 };
 
@@ -254,6 +259,58 @@ inline bool TILE_HAS_INVALID_IMAGE(const ego_tile_info_t& tileInfo) {
 
 //--------------------------------------------------------------------------------------------
 
+struct tile_mem_t;
+
+/// The GPU-side copy of the vertex lists of a mesh.
+/// The positions, the texture coordinates and the triangles of all tiles are uploaded once,
+/// the colours of a tile are uploaded again whenever its lighting changed.
+struct mesh_buffers_t
+{
+	std::unique_ptr<Ego::VertexBuffer> _vertices;          ///< the positions and texture coordinates
+	std::unique_ptr<Ego::VertexBuffer> _colours;           ///< the colours
+	std::unique_ptr<Ego::IndexBuffer> _indices;            ///< the triangles of all tiles
+	std::vector<std::pair<size_t, size_t>> _tileIndices;   ///< per tile the first index and the number of indices of its triangles
+
+	mesh_buffers_t();
+
+	/**
+	 * @brief Mark the colours of a range of vertices as modified.
+	 * @param vertex the index of the first vertex
+	 * @param numberOfVertices the number of vertices
+	 */
+	void invalidateColours(size_t vertex, size_t numberOfVertices);
+
+	/**
+	 * @brief Upload the modified colours. The buffers are created and uploaded as a whole by the first upload.
+	 * @param tmem the tile memory
+	 * @return the number of Bytes uploaded
+	 */
+	size_t upload(const tile_mem_t& tmem);
+
+private:
+	void create(const tile_mem_t& tmem);
+};
+
+/// The hierarchy of bounding boxes over the blocks of a mesh. The boxes are raised by some headroom above the
+/// tiles such that the entities standing on a block are in view if the block is in view.
+struct mesh_blocks_t : public Ego::MeshBlocks
+{
+	/**
+	 * @brief Build the boxes from the bounding boxes of the tiles.
+	 * @param tmem the tile memory
+	 */
+	void build(const tile_mem_t& tmem);
+
+	/**
+	 * @brief Cull the blocks and the tiles against a frustum.
+	 * @param tmem the tile memory
+	 * @param frustum the frustum
+	 * @param blocks receives the indices of the blocks which are not outside of the frustum
+	 * @param tiles receives the indices of the tiles which are not outside of the frustum
+	 */
+	void cull(const tile_mem_t& tmem, const Ego::Graphics::Frustum& frustum, std::vector<size_t>& blocks, std::vector<Index1D>& tiles) const;
+};
+
 /// A wrapper for the dynamically allocated mesh memory
 struct tile_mem_t
 {
@@ -270,6 +327,9 @@ public:
     std::unique_ptr<GLXvector3f[]> _nlst;                 ///< the normal list
     std::unique_ptr<GLXvector3f[]> _clst;                 ///< the color list (for lighting the mesh)
 
+	mesh_buffers_t _buffers;                              ///< the GPU-side copy of the vertex lists
+	mesh_blocks_t _blocks;                                ///< the bounding boxes of the blocks
+
 	tile_mem_t(const Ego::MeshInfo& info);
 	~tile_mem_t();
 
@@ -424,6 +484,12 @@ public:
 
 	bool clear_fx(const Index1D& i, const BIT_FIELD flags);
 	bool add_fx(const Index1D& i, const BIT_FIELD flags);
+
+	/// @brief Get the revision of the tile FX bits.
+	/// @return a counter which is incremented whenever add_fx() or clear_fx() change the FX bits of a tile
+	uint32_t getFXRevision() const {
+		return _fxRevision;
+	}
 	Uint8 get_twist(const Index1D& i) const;
 
 	/// @todo @a pos and @a radius should be passed as a sphere.
@@ -476,6 +542,23 @@ private:
 	/// Set the bounding box for each tile, and for the entire mesh
 	void make_bbox();
 
+	uint32_t _fxRevision;	///< Incremented whenever the FX bits of a tile change
+};
+
+/// The tiles of a mesh as seen by path finding.
+struct mesh_path_grid_t : public PathGrid
+{
+	mesh_path_grid_t(const std::shared_ptr<const ego_mesh_t>& mesh);
+
+	int getTileCountX() const override;
+	int getTileCountY() const override;
+	bool isStopped(int x, int y, uint32_t stoppedBy) const override;
+	bool isWalkable(int32_t tile, uint32_t stoppedBy) const override;
+	std::shared_ptr<const void> getOwner() const override;
+	uint32_t getRevision() const override;
+
+private:
+	std::shared_ptr<const ego_mesh_t> _mesh;
 };
 
 /// Some look-up tables for meshes (and independent of the particular mesh).
@@ -39,9 +39,16 @@ struct CompilerEntry : Entry {
 }
 
 static bool load_ai_codes_vfs();
+static uint64_t hash_compiler();
+static const std::unordered_set<uint32_t>& get_parallel_safe_functions();
+static const std::unordered_set<uint32_t>& get_deferred_functions();
+
+/// The format version of the cached compiled scripts, bump it if the compiler output changes
+static const uint32_t SCRIPT_CACHE_VERSION = 3;
 
 parser_state_t::parser_state_t()
-	: _token(), _linebuffer()
+	: _token(), _constants(), _hasPendingConstant(false), _pendingConstant(),
+	  _scriptCache("/cache/scripts", "scrc", SCRIPT_CACHE_VERSION), _compiledScripts(), _linebuffer()
 {
 	_line_count = 0;
 
@@ -49,6 +56,8 @@ parser_state_t::parser_state_t()
 	_load_buffer[0] = '\0';
 
     load_ai_codes_vfs();
+    const uint64_t compilerHash = hash_compiler();
+    _scriptCache = Ego::CacheFile("/cache/scripts", "scrc", SCRIPT_CACHE_VERSION ^ static_cast<uint32_t>(compilerHash ^ (compilerHash >> 32)));
     debug_script_file = vfs_openWrite("/debug/script_debug.txt");
 
     _error = false;
@@ -377,6 +386,40 @@ size_t parser_state_t::fix_operators( linebuffer_t& buffer )
 }
 
 //--------------------------------------------------------------------------------------------
+/// Get the slot number of the object profile referenced by "#name", the profile is loaded if necessary
+static PRO_REF resolve_object_reference(const std::string& obj_name)
+{
+    // Convert reference to slot number
+    for (const auto &element : ProfileSystem::get().getLoadedProfiles())
+    {
+        const std::shared_ptr<ObjectProfile> &profile = element.second;
+        if(profile == nullptr) continue;
+
+        //is this the object we are looking for?
+        if (Ego::isSuffix(profile->getPathname(), obj_name))
+        {
+            return profile->getSlotNumber();
+        }
+    }
+
+    // We need to load the object
+    std::string loadname = "mp_objects/" + obj_name;
+
+    //find first free slot number
+    for (PRO_REF ipro = MAX_IMPORT_PER_PLAYER * 4; ipro < INVALID_PRO_REF; ipro++ )
+    {
+        //skip loaded profiles
+        if (ProfileSystem::get().isValidProfileID(ipro)) continue;
+
+        //found a free slot
+        PRO_REF loaded = ProfileSystem::get().loadOneProfile(loadname, REF_TO_INT(ipro));
+        if (loaded == ipro) return loaded;
+    }
+
+    // Invalid profile
+    return INVALID_PRO_REF;
+}
+
 size_t parser_state_t::parse_token(Token& tok, ObjectProfile *ppro, script_info_t& script, size_t read)
 {
     /// @author ZZ
@@ -391,6 +434,7 @@ size_t parser_state_t::parse_token(Token& tok, ObjectProfile *ppro, script_info_
 
     // Reset the token
 	tok = Token();
+    _hasPendingConstant = false;
 
     // Check bounds
 	if ( read >= _linebuffer.size() )
@@ -534,40 +578,10 @@ size_t parser_state_t::parse_token(Token& tok, ObjectProfile *ppro, script_info_
             //remove the reference symbol to figure out the actual folder name we are looking for
             std::string obj_name = str + 1;
 
-            // Invalid profile as default
-            tok.setValue(INVALID_PRO_REF);
-
-            // Convert reference to slot number
-            for (const auto &element : ProfileSystem::get().getLoadedProfiles())
-            {
-                const std::shared_ptr<ObjectProfile> &profile = element.second;
-                if(profile == nullptr) continue;
-
-
-                //is this the object we are looking for?
-                if (Ego::isSuffix(profile->getPathname(), obj_name))
-                {
-                    tok.setValue(profile->getSlotNumber());
-                    break;
-                }
-            }
-
-            // Do we need to load the object?
-            if (!ProfileSystem::get().isValidProfileID((PRO_REF)tok.getValue()))
-            {
-                std::string loadname = "mp_objects/" + obj_name;
-
-                //find first free slot number
-                for (PRO_REF ipro = MAX_IMPORT_PER_PLAYER * 4; ipro < INVALID_PRO_REF; ipro++ )
-                {
-                    //skip loaded profiles
-                    if (ProfileSystem::get().isValidProfileID(ipro)) continue;
-
-                    //found a free slot
-                    tok.setValue(ProfileSystem::get().loadOneProfile(loadname, REF_TO_INT(ipro)));
-                    if (tok.getValue() == ipro) break;
-                }
-            }
+            tok.setValue(resolve_object_reference(obj_name));
+            _hasPendingConstant = true;
+            _pendingConstant._kind = script_constant_t::Kind::Object;
+            _pendingConstant._text = obj_name;
 
             // Failed to load object!
             if (!ProfileSystem::get().isValidProfileID((PRO_REF)tok.getValue()))
@@ -588,6 +602,9 @@ size_t parser_state_t::parse_token(Token& tok, ObjectProfile *ppro, script_info_
             // a normal string
             // if this is a new string, add this message to the avalible messages of the object
             tok.setValue(ppro->addMessage(str, true));
+            _hasPendingConstant = true;
+            _pendingConstant._kind = script_constant_t::Kind::Message;
+            _pendingConstant._text = str;
 
             tok.setType(Token::Type::Constant);
             tok.setIndex(MAX_OPCODE);
@@ -651,6 +668,14 @@ void parser_state_t::emit_opcode( Token& tok, const BIT_FIELD highbits, script_i
     // emit the opcode
     if (!script._instructions.isFull())
     {
+        // remember where string constants go, they are bound per object profile
+        if (_hasPendingConstant)
+        {
+            _pendingConstant._index = script._instructions.getLength();
+            _pendingConstant._highbits = loc_highbits;
+            _constants.push_back(_pendingConstant);
+            _hasPendingConstant = false;
+        }
 		script._instructions.append(Instruction(loc_highbits | tok.getValue()));
     }
     else
@@ -891,6 +916,108 @@ void parser_state_t::parse_jumps( script_info_t& script )
     }
 }
 
+//--------------------------------------------------------------------------------------------
+/// The functions which write nothing but the state of the running object and do not read the
+/// A.I. state of other objects, see parser_state_t::classify_parallel()
+static const std::unordered_set<uint32_t>& get_parallel_safe_functions()
+{
+    using namespace Ego;
+    static const std::unordered_set<uint32_t> functions =
+    {
+        // alerts and timers
+        IfSpawned, IfTimeOut, IfAtWaypoint, IfAtLastWaypoint, IfAttacked, IfBumped, IfOrdered,
+        IfCalledForHelp, IfKilled, IfTargetKilled, IfHealed, IfGrabbed, IfDropped, IfReaffirmed,
+        IfLeaderKilled, IfUsed, IfCleanedUp, IfScoredAHit, IfDisaffirmed, IfChanged, IfInWater,
+        IfBored, IfTooMuchBaggage, IfGrogged, IfDazed, IfNotDropped, IfBlocked, IfHitGround,
+        IfThrown, IfCrushed, IfNotPutAway, IfTakenOut, IfHitVulnerable, IfLevelUp, SetTime,
+        // local storage
+        SetContent, GetContent, IfContentIs, SetState, GetState, IfStateIs, IfStateIsNot,
+        IfStateIsOdd, IfStateIs0, IfStateIs1, IfStateIs2, IfStateIs3, IfStateIs4, IfStateIs5,
+        IfStateIs6, IfStateIs7, IfStateIs8, IfStateIs9, IfStateIs10, IfStateIs11, IfStateIs12,
+        IfStateIs13, IfStateIs14, IfStateIs15, SetXY, GetXY, AddXY, GetAttackTurn, GetDamageType,
+        IfSomeoneIsStealing,
+        // control flow and arithmetic
+        Else, End, DoNothing, IfXIsLessThanY, IfYIsLessThanX, IfXIsEqualToY, IfDistanceIsMoreThanTurn,
+        // movement
+        ClearWaypoints, AddWaypoint, Run, Walk, Sneak, Stop, SetSpeedPercent, SetTurnModeToVelocity,
+        SetTurnModeToWatch, SetTurnModeToSpin, SetTurnModeToWatchTarget,
+        // targeting
+        SetTargetToSelf, SetOldTarget, SetOwnerToTarget, SetTargetToOldTarget, SetTargetToWhoeverAttacked,
+        SetTargetToWhoeverBumped, SetTargetToWhoeverIsHolding, SetTargetToNearbyEnemy,
+        SetTargetToWideEnemy, SetTargetToDistantEnemy, SetTargetToNearestEnemy, SetTargetToNearestFriend,
+        IfTargetIsSelf, IfTargetIsOldTarget, IfTargetIsOnOtherTeam, IfTargetIsOnHatedTeam, IfTargetHasID,
+        IfTargetHoldingItemID, IfTargetIsAlive, IfTargetIsAPlayer, IfTargetIsHurt, IfTargetIsMale,
+        IfTargetIsFemale, IfFacingTarget,
+        // self queries
+        IfSitting, IfUnarmed, IfAmmoOut, IfEquipped, IfKursed, IfNameIsKnown, IfHoldingItemID,
+    };
+    return functions;
+}
+
+/// These submit their effects on other objects and on the audio and message systems through
+/// Ego::Core::CommandBuffer::submit(), and their results do not depend on those effects
+static const std::unordered_set<uint32_t>& get_deferred_functions()
+{
+    using namespace Ego;
+    static const std::unordered_set<uint32_t> functions =
+    {
+        PlaySound, PlaySoundVolume, PlayFullSound, DebugMessage, DamageTarget, FlashTarget, BlackTarget,
+    };
+    return functions;
+}
+
+//--------------------------------------------------------------------------------------------
+void parser_state_t::classify_parallel( script_info_t& script )
+{
+    /// @details This function determines if a script may run concurrently with other scripts.
+    ///          Only functions which write nothing but the state of the running object and
+    ///          which do not read the A.I. state of other objects are allowed, besides functions
+    ///          which defer their other effects to a command buffer.
+
+    using namespace Ego;
+    const std::unordered_set<uint32_t>& parallelSafeFunctions = get_parallel_safe_functions();
+    const std::unordered_set<uint32_t>& deferredFunctions = get_deferred_functions();
+
+    script._parallelSafe = true;
+    script._writesState = false;
+
+    uint32_t index     = 0;
+    uint32_t index_end = script._instructions.getLength();
+    while ( index < index_end )
+    {
+        auto value = script._instructions[index];
+
+        // Was it a function
+        if (value.isInv())
+        {
+            uint32_t function = value & Instruction::VALUEBITS;
+            if ( 0 == parallelSafeFunctions.count( function ) && 0 == deferredFunctions.count( function ) ) script._parallelSafe = false;
+            if ( SetState == function ) script._writesState = true;
+
+            // Skip the jump
+            index += 2;
+        }
+        else
+        {
+            // Operations cover each operand
+            index++;
+            if ( index >= index_end ) break;
+            uint32_t operand_count = Ego::Math::clipBits<8>( script._instructions[index]._value );
+            index++;
+            for ( uint32_t i = 0; i < operand_count && index < index_end; ++i, ++index )
+            {
+                auto operand = script._instructions[index];
+
+                // The random number generator is shared by everyone
+                if ( !operand.isLdc() && VARRAND == ( operand & Instruction::VALUEBITS ) )
+                {
+                    script._parallelSafe = false;
+                }
+            }
+        }
+    }
+}
+
 //--------------------------------------------------------------------------------------------
 bool load_ai_codes_vfs()
 {
@@ -1597,33 +1724,139 @@ bool load_ai_codes_vfs()
 }
 
 //--------------------------------------------------------------------------------------------
-egolib_rv load_ai_script_vfs0(parser_state_t& ps, const std::string& loadname, ObjectProfile *ppro, script_info_t& script)
+uint64_t hash_compiler()
+{
+    std::ostringstream table;
+    for (int i = 0; i < OpList.count; ++i)
+    {
+        table << OpList.ary[i].cName << ' ' << static_cast<int>(OpList.ary[i]._type) << ' ' << OpList.ary[i].iValue << '\n';
+    }
+
+    // the classification is cached with the script
+    for (const std::unordered_set<uint32_t> *functions : { &get_parallel_safe_functions(), &get_deferred_functions() })
+    {
+        std::vector<uint32_t> sorted(functions->begin(), functions->end());
+        std::sort(sorted.begin(), sorted.end());
+        for (uint32_t function : sorted)
+        {
+            table << function << ' ';
+        }
+        table << '\n';
+    }
+
+    const std::string text = table.str();
+    return Ego::CacheFile::hashBytes(text.data(), text.size());
+}
+
+//--------------------------------------------------------------------------------------------
+std::shared_ptr<compiled_script_t> parser_state_t::compile(const std::string& loadname, ObjectProfile *ppro)
+{
+    // the same source text compiles to the same script
+    const uint64_t sourceHash = Ego::CacheFile::hashBytes(reinterpret_cast<const char *>(_load_buffer.data()), _load_buffer_count);
+    std::shared_ptr<compiled_script_t>& compiled = _compiledScripts[sourceHash];
+    if (compiled)
+    {
+        return compiled;
+    }
+
+    compiled = std::make_shared<compiled_script_t>();
+    compiled->_script = std::make_shared<script_info_t>();
+    script_info_t& script = *compiled->_script;
+
+    // save the filename for error logging
+    script._name = loadname;
+
+    // use the script compiled by an earlier run unless the source file or the compiler changed
+    const bool cached = _scriptCache.load(loadname, [&](Ego::CacheArchive& archive)
+    {
+        compiled->transfer(archive);
+    });
+    if (cached)
+    {
+        script.decode();
+        return compiled;
+    }
+
+    // we have parsed nothing yet
+    script._instructions._length = 0;
+    compiled->_constants.clear();
+    _constants.clear();
+    _hasPendingConstant = false;
+
+    // parse/compile the scripts
+    parse_line_by_line(ppro, script);
+
+    // determine the correct jumps
+    parse_jumps(script);
+
+    // determine if the script may run concurrently with other scripts
+    classify_parallel(script);
+
+    // decode the instructions for the interpreter
+    script.decode();
+
+    compiled->_constants.swap(_constants);
+
+    // scripts with errors are compiled again next time to report the errors again
+    if (!get_error())
+    {
+        _scriptCache.store(loadname, [&](Ego::CacheArchive& archive)
+        {
+            compiled->transfer(archive);
+        });
+    }
+
+    return compiled;
+}
+
+std::shared_ptr<script_info_t> parser_state_t::bind(const compiled_script_t& compiled, const std::string& loadname, ObjectProfile *ppro)
+{
+    std::shared_ptr<script_info_t> script = compiled.bind([ppro](const script_constant_t& constant) -> uint32_t
+    {
+        switch (constant._kind)
+        {
+            case script_constant_t::Kind::Message:
+                return ppro->addMessage(constant._text, true);
+            case script_constant_t::Kind::Object:
+                return resolve_object_reference(constant._text);
+            default:
+                return 0;
+        }
+    }, loadname);
+
+    // a patched copy
+    if (script != compiled._script)
+    {
+        script->decode();
+    }
+    return script;
+}
+
+void parser_state_t::clearCompiledScripts()
+{
+    _compiledScripts.clear();
+}
+
+//--------------------------------------------------------------------------------------------
+egolib_rv load_ai_script_vfs0(parser_state_t& ps, const std::string& loadname, ObjectProfile *ppro, std::shared_ptr<script_info_t>& script)
 {
 	ps.clear_error();
 	ps._line_count = 0;
 
-    std::shared_ptr<vfs_FILE> fileread(vfs_openRead(loadname.c_str()), [](vfs_FILE *pFile){ if(pFile) vfs_close(pFile); });
+	//Reset read buffer first
+	ps._load_buffer.fill(CSTR_END);
+	ps._load_buffer_count = 0;
 
-	// No such file
-	if (!fileread)
+	char *data = nullptr;
+	size_t file_size = 0;
+	if (!vfs_readEntireFile(loadname, &data, &file_size))
 	{
 		Log::Entry e(Log::Level::Warning, __FILE__, __LINE__, __FUNCTION__);
 		e << "AI script `" << loadname << "` was not found" << Log::EndOfEntry;
 		Log::get() << e;
 		return rv_fail;
 	}
-
-	// load the file
-	size_t file_size = vfs_fileLength(fileread.get());
-	if (-1 == file_size) {
-		Log::Entry e(Log::Level::Error,__FILE__, __LINE__, __FUNCTION__);
-		e << "unable to load AI script `" << loadname << "`" << Log::EndOfEntry;
-		Log::get() << e;
-		return rv_fail;
-	}
-
-	//Reset read buffer first
-	ps._load_buffer.fill(CSTR_END);
+	std::unique_ptr<char, void(*)(void *)> fileData(data, std::free);
 
 	if (file_size > ps._load_buffer.size()) {
 		Log::Entry e(Log::Level::Error, __FILE__, __LINE__, __FUNCTION__);
@@ -1633,8 +1866,9 @@ egolib_rv load_ai_script_vfs0(parser_state_t& ps, const std::string& loadname, O
 		return rv_fail;
 	}
 
-	ps._load_buffer_count = (int)vfs_read(ps._load_buffer.data(), 1, file_size, fileread.get());
-    fileread = nullptr;
+	std::copy(data, data + file_size, ps._load_buffer.begin());
+	ps._load_buffer_count = file_size;
+	fileData = nullptr;
 
 	// if the file is empty, use the default script
 	if (0 == ps._load_buffer_count)
@@ -1645,21 +1879,14 @@ egolib_rv load_ai_script_vfs0(parser_state_t& ps, const std::string& loadname, O
 		return rv_fail;
 	}
 
-	// save the filename for error logging
-	script._name = loadname;
-
-	// we have parsed nothing yet
-	script._instructions._length = 0;
-
-	// parse/compile the scripts
-	ps.parse_line_by_line(ppro, script);
-
-	// determine the correct jumps
-	parser_state_t::parse_jumps(script);
+	// compile the script once and bind its constants to this object profile
+	std::shared_ptr<compiled_script_t> compiled = ps.compile(loadname, ppro);
+	script = parser_state_t::bind(*compiled, loadname, ppro);
 
 	return rv_success;
 }
-egolib_rv load_ai_script_vfs(parser_state_t& ps, const std::string& loadname, ObjectProfile *ppro, script_info_t& script)
+
+egolib_rv load_ai_script_vfs(parser_state_t& ps, const std::string& loadname, ObjectProfile *ppro, std::shared_ptr<script_info_t>& script)
 {
 	/// @author ZZ
 	/// @details This function loads a script to memory
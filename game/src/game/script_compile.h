@@ -24,6 +24,7 @@
 #include "game/script_scanner.hpp"
 #include "game/egoboo.h"
 #include "egolib/Script/script.h"
+#include "egolib/Script/CompiledScript.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -175,6 +176,20 @@ public:
     int _line_count;
 
 protected:
+    /// The string constants of the script being compiled
+    std::vector<script_constant_t> _constants;
+    /// The string constant parsed by the last call to parse_token(), if any
+    bool _hasPendingConstant;
+    script_constant_t _pendingConstant;
+
+    /// The compiled scripts of earlier runs. The format version includes a hash of the opcode
+    /// table and of the functions classify_parallel() allows, so scripts cached by a different
+    /// compiler are rejected.
+    Ego::CacheFile _scriptCache;
+
+    /// Compiled scripts by the hash of their source text
+    std::unordered_map<uint64_t, std::shared_ptr<compiled_script_t>> _compiledScripts;
+
     // @brief Skip '\n', '\r', '\n\r' or '\r\n'.
     // @return @a true if input symbols were consumed, @a false otherwise
     // @post @a read was incremented by the number of input symbols consumed
@@ -233,6 +248,7 @@ private:
 	static Uint32 jump_goto(int index, int index_end, script_info_t& script);
 public:
 	static void parse_jumps(script_info_t& script);
+	static void classify_parallel(script_info_t& script);
 
 private:
 	size_t parse_token(Token& tok, ObjectProfile *ppro, script_info_t& script, size_t read);
@@ -249,6 +265,30 @@ private:
 public:
 	void parse_line_by_line(ObjectProfile *ppro, script_info_t& script);
 
+	/**
+	 * @brief
+	 *  Get the compiled script for the source text in the load buffer.
+	 * @remark
+	 *  A script is only compiled once per source text. Otherwise the compiled script cached on disk
+	 *  is used if the source file did not change and the compiler is the same (see _scriptCache),
+	 *  only if that fails the source text is compiled.
+	 */
+	std::shared_ptr<compiled_script_t> compile(const std::string& loadname, ObjectProfile *ppro);
+	/**
+	 * @brief
+	 *  Bind the string constants of a compiled script to an object profile.
+	 * @return
+	 *  the script of the compiled script if all constants are bound to the values it was compiled
+	 *  with, otherwise a copy of the script with the constants patched
+	 */
+	static std::shared_ptr<script_info_t> bind(const compiled_script_t& compiled, const std::string& loadname, ObjectProfile *ppro);
+
+	/**
+	 * @brief
+	 *  Clear the compiled scripts, e.g. when a module is unloaded.
+	 */
+	void clearCompiledScripts();
+
 };
 
 //--------------------------------------------------------------------------------------------
@@ -263,10 +303,10 @@ public:
  * @param objectProfile
  *  the object profile
  * @param script
- * the script
+ *  receives the script, which may be shared with other profiles loading the same script
  * @remark
  *  A call to this function tries to load the script.
  *		If this fails, then it tries to load the default script.
  *			If this fails, then the call to this function fails.
  */
-egolib_rv load_ai_script_vfs(parser_state_t& ps, const std::string& loadname, ObjectProfile *ppro, script_info_t& script);
+egolib_rv load_ai_script_vfs(parser_state_t& ps, const std::string& loadname, ObjectProfile *ppro, std::shared_ptr<script_info_t>& script);
@@ -48,6 +48,7 @@
 #include "game/Physics/PhysicalConstants.hpp"
 #include "egolib/Script/Interpreter/SafeCast.hpp"
 #include "game/GUI/MiniMap.hpp"
+#include "egolib/Core/CommandBuffer.hpp"
 
 /**
  * @brief Convert a value of type \f$Value\f$ value into a bit index.
@@ -1009,7 +1010,7 @@ Uint8 scr_Else( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    returncode = ( ppro->getAIScript().indent >= ppro->getAIScript().indent_last );
+    returncode = ( state.indent >= state.indent_last );
 
     SCRIPT_FUNCTION_END();
 }
@@ -1568,8 +1569,16 @@ Uint8 scr_DamageTarget( script_state_t& state, ai_state_t& self )
     tmp_damage.base = state.argument;
     tmp_damage.rand = 1;
 
-    target->damage(ATK_FRONT, tmp_damage, static_cast<DamageType>(pchr->damagetarget_damagetype), 
-        pchr->team, _currentModule->getObjectHandler()[self.getSelf()], false, false, true);
+    const ObjectRef targetRef = self.getTarget(), attackerRef = self.getSelf();
+    const DamageType damageType = static_cast<DamageType>(pchr->damagetarget_damagetype);
+    const TEAM_REF team = pchr->team;
+    Ego::Core::CommandBuffer::submit([targetRef, attackerRef, tmp_damage, damageType, team]()
+    {
+        const std::shared_ptr<Object> &target = _currentModule->getObjectHandler()[targetRef];
+        if(target) {
+            target->damage(ATK_FRONT, tmp_damage, damageType, team, _currentModule->getObjectHandler()[attackerRef], false, false, true);
+        }
+    });
 
     SCRIPT_FUNCTION_END();
 }
@@ -2163,7 +2172,9 @@ Uint8 scr_PlaySound( script_state_t& state, ai_state_t& self )
 
     if ( pchr->getOldPosition()[kZ] > PITNOSOUND )
     {
-        AudioSystem::get().playSound(pchr->getOldPosition(), ppro->getSoundID(state.argument));
+        const Vector3f position = pchr->getOldPosition();
+        const SoundID sound = ppro->getSoundID(state.argument);
+        Ego::Core::CommandBuffer::submit([position, sound]() { AudioSystem::get().playSound(position, sound); });
     }
 
     SCRIPT_FUNCTION_END();
@@ -3032,13 +3043,17 @@ Uint8 scr_FlashTarget( script_state_t& state, ai_state_t& self )
     /// @author ZZ
     /// @details This function makes the target flash
 
-    Object * pself_target;
-
     SCRIPT_FUNCTION_BEGIN();
 
-    SCRIPT_REQUIRE_TARGET( pself_target );
+    if ( !_currentModule->getObjectHandler().exists( self.getTarget() ) ) return false;
 
-    FlashObject( pself_target, 255 );
+    const ObjectRef targetRef = self.getTarget();
+    Ego::Core::CommandBuffer::submit([targetRef]()
+    {
+        // the target might be gone by the time the buffer is applied
+        Object *ptarget = _currentModule->getObjectHandler().get( targetRef );
+        if ( nullptr != ptarget ) FlashObject( ptarget, 255 );
+    });
 
     SCRIPT_FUNCTION_END();
 }
@@ -3561,10 +3576,17 @@ Uint8 scr_DebugMessage( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    DisplayMsg_printf( "aistate %d, aicontent %d, target %" PRIuZ, self.state, self.content, self.getTarget().get() );
-    DisplayMsg_printf( "tmpx %d, tmpy %d", state.x, state.y );
-    DisplayMsg_printf( "tmpdistance %d, tmpturn %d", state.distance, state.turn );
-    DisplayMsg_printf( "tmpargument %d, selfturn %d", state.argument, pchr->ori.facing_z );
+    const int aistate = self.state, aicontent = self.content;
+    const size_t target = self.getTarget().get();
+    const int x = state.x, y = state.y, distance = state.distance, turn = state.turn, argument = state.argument;
+    const int facing_z = pchr->ori.facing_z;
+    Ego::Core::CommandBuffer::submit([=]()
+    {
+        DisplayMsg_printf( "aistate %d, aicontent %d, target %" PRIuZ, aistate, aicontent, target );
+        DisplayMsg_printf( "tmpx %d, tmpy %d", x, y );
+        DisplayMsg_printf( "tmpdistance %d, tmpturn %d", distance, turn );
+        DisplayMsg_printf( "tmpargument %d, selfturn %d", argument, facing_z );
+    });
 
     SCRIPT_FUNCTION_END();
 }
@@ -3576,13 +3598,17 @@ Uint8 scr_BlackTarget( script_state_t& state, ai_state_t& self )
     /// @author ZZ
     /// @details  The opposite of FlashTarget, causing the target to turn black
 
-    Object * pself_target;
-
     SCRIPT_FUNCTION_BEGIN();
 
-    SCRIPT_REQUIRE_TARGET( pself_target );
+    if ( !_currentModule->getObjectHandler().exists( self.getTarget() ) ) return false;
 
-    FlashObject( pself_target, 0 );
+    const ObjectRef targetRef = self.getTarget();
+    Ego::Core::CommandBuffer::submit([targetRef]()
+    {
+        // the target might be gone by the time the buffer is applied
+        Object *ptarget = _currentModule->getObjectHandler().get( targetRef );
+        if ( nullptr != ptarget ) FlashObject( ptarget, 0 );
+    });
 
     SCRIPT_FUNCTION_END();
 }
@@ -4616,12 +4642,18 @@ Uint8 scr_PlaySoundVolume( script_state_t& state, ai_state_t& self )
 
     if ( state.distance > 0 )
     {
-        int channel = AudioSystem::get().playSound(pchr->getOldPosition(), ppro->getSoundID(Interpreter::safeCast<int>(state.argument)));
-
-        if ( channel != INVALID_SOUND_CHANNEL )
+        const Vector3f position = pchr->getOldPosition();
+        const SoundID sound = ppro->getSoundID(Interpreter::safeCast<int>(state.argument));
+        const int volume = ( 128 * Interpreter::safeCast<int>(state.distance) ) / 100;
+        Ego::Core::CommandBuffer::submit([position, sound, volume]()
         {
-            Mix_Volume( channel, ( 128 * Interpreter::safeCast<int>(state.distance) ) / 100 );
-        }
+            int channel = AudioSystem::get().playSound(position, sound);
+
+            if ( channel != INVALID_SOUND_CHANNEL )
+            {
+                Mix_Volume( channel, volume );
+            }
+        });
     }
 
     SCRIPT_FUNCTION_END();
@@ -5458,7 +5490,8 @@ Uint8 scr_PlayFullSound( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    AudioSystem::get().playSoundFull(ppro->getSoundID(state.argument));
+    const SoundID sound = ppro->getSoundID(state.argument);
+    Ego::Core::CommandBuffer::submit([sound]() { AudioSystem::get().playSoundFull(sound); });
 
     SCRIPT_FUNCTION_END();
 }
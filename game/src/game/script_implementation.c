@@ -248,11 +248,8 @@ bool FindPath( waypoint_list_t& wplst, Object * pchr, float dst_x, float dst_y,
 #ifdef DEBUG_ASTAR
         printf( "Finding a path from %d,%d to %d,%d: \n", src_ix, src_iy, dst_ix, dst_iy );
 #endif
-        //Try to find a path with the AStar algorithm
-        if ( g_astar.find_path( _currentModule->getMeshPointer(), pchr->stoppedby, src_ix, src_iy, dst_ix, dst_iy ) )
-        {
-            returncode = g_astar.get_path( dst_x, dst_y, wplst);
-        }
+        //Try to find a path with the AStar algorithm, sharing recent searches with other characters
+        returncode = g_pathService.find_path( mesh_path_grid_t(_currentModule->getMeshPointer()), pchr->stoppedby, src_ix, src_iy, dst_ix, dst_iy, dst_x, dst_y, wplst );
 
         if ( NULL != used_astar_ptr )
         {